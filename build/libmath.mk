@@ -16,6 +16,7 @@ MATH_SOURCES = \
 	$(MATH_SRC_DIR)/SelfTimingKalmanFilter1d.cpp \
 	$(MATH_SRC_DIR)/XYDataStore.cpp \
 	$(MATH_SRC_DIR)/ConvexFilter.cpp \
+	$(MATH_SRC_DIR)/TimeSeries.cpp \
 	$(MATH_SRC_DIR)/Histogram.cpp
 
 $(eval $(call link-library,math,MATH))
@@ -0,0 +1,10 @@
+# Build rules for the hot path instrumentation library
+
+PROFILER_SOURCES = \
+	$(SRC)/Profiler/TimingHistogram.cpp \
+	$(SRC)/Profiler/Profiler.cpp \
+	$(SRC)/Profiler/Dump.cpp
+
+PROFILER_DEPENDS = IO UTIL
+
+$(eval $(call link-library,libprofiler,PROFILER))
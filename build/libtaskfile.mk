@@ -3,6 +3,7 @@ TASKFILE_SOURCES = \
 	$(SRC)/Task/XCTrackTaskDecoder.cpp \
 	$(SRC)/Task/XCTrackTaskFile.cpp \
 	$(SRC)/Task/TaskFile.cpp \
+	$(SRC)/Task/TaskIndex.cpp \
 	$(SRC)/Task/TaskFileXCSoar.cpp \
 	$(SRC)/Task/TaskFileSeeYou.cpp \
 	$(SRC)/Task/TaskFileIGC.cpp \
@@ -7,6 +7,7 @@ THREAD_SOURCES = \
 	$(THREAD_SRC_DIR)/SuspensibleThread.cpp \
 	$(THREAD_SRC_DIR)/RecursivelySuspensibleThread.cpp \
 	$(THREAD_SRC_DIR)/WorkerThread.cpp \
+	$(THREAD_SRC_DIR)/WorkerPool.cpp \
 	$(THREAD_SRC_DIR)/StandbyThread.cpp \
 	$(THREAD_SRC_DIR)/Debug.cpp
 
@@ -12,6 +12,6 @@ TOPO_SOURCES = \
 
 TOPO_CPPFLAGS_INTERNAL = $(SCREEN_CPPFLAGS)
 
-TOPO_DEPENDS = SHAPELIB
+TOPO_DEPENDS = SHAPELIB PROFILER
 
 $(eval $(call link-library,libtopo,TOPO))
@@ -75,8 +75,8 @@ TEST_NAMES = \
 	TestWaypoints \
 	test_pressure \
 	test_task \
-	TestOverwritingRingBuffer \
-	TestDateTime TestRoughTime TestWrapClock \
+	TestOverwritingRingBuffer TestThinningQueue TestSkyLinesQueue \
+	TestDateTime TestRoughTime TestWrapClock TestDutyScheduler \
 	TestPolylineDecoder \
 	TestTransponderCode \
 	TestMath \
@@ -85,7 +85,7 @@ TEST_NAMES = \
 	TestGrahamScan \
 	TestUnits TestEarth TestSunEphemeris \
 	TestValidity TestUTM \
-	TestAllocatedGrid \
+	TestAllocatedGrid TestFlatHashMap \
 	TestRadixTree TestGeoBounds TestGeoClip \
 	TestLogger TestGRecord TestClimbAvCalc \
 	TestWaypointReader TestThermalBase \
@@ -94,14 +94,21 @@ TEST_NAMES = \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
 	TestMacCready TestOrderedTask TestAATPoint TestTaskSave\
+	TestTaskIndex \
+	TestStartCandidates \
 	TestPlanes \
 	TestTaskPoint \
 	TestTaskWaypoint \
 	TestTeamCode \
 	TestZeroFinder \
 	TestAirspaceParser \
+	TestAirspaceWarningManager \
+	TestAirspaceSorter \
+	TestAirspaceRoute \
+	TestAirspaceWarningSnapshot \
 	TestMETARParser \
 	TestIGCParser \
+	TestXMLParser \
 	TestStrings TestUTF8 \
 	TestCRC16 TestCRC8 \
 	TestUnitsFormatter \
@@ -113,8 +120,13 @@ TEST_NAMES = \
 	TestNMEAFormatter \
 	TestLXNToIGC \
 	TestLeastSquares \
+	TestTimeSeries \
+	TestRaspMapLRU \
+	TestVarioSynthesiser \
+	TestWorkerPool \
 	TestHexString \
-	TestThermalBand
+	TestThermalBand \
+	TestTimingHistogram
 
 ifeq ($(TARGET_IS_ANDROID),n)
 # These programs are broken on Android because they require Java code
@@ -123,6 +135,12 @@ TEST_NAMES += \
 	TestDriver
 endif
 
+ifeq ($(TARGET),UNIX)
+# the cloud server is only built for UNIX
+TEST_NAMES += \
+	TestCloudJournal
+endif
+
 TESTS = $(call name-to-bin,$(TEST_NAMES))
 
 TEST_HEX_STRING_SOURCES = \
@@ -148,6 +166,39 @@ TEST_LEASTSQUARES_SOURCES = \
 	$(TEST_SRC_DIR)/TestLeastSquares.cpp
 $(eval $(call link-program,TestLeastSquares,TEST_LEASTSQUARES))
 
+TEST_TIME_SERIES_SOURCES = \
+	$(SRC)/Math/TimeSeries.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTimeSeries.cpp
+$(eval $(call link-program,TestTimeSeries,TEST_TIME_SERIES))
+
+TEST_RASP_MAP_LRU_SOURCES = \
+	$(SRC)/Weather/Rasp/RaspMapLRU.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestRaspMapLRU.cpp
+TEST_RASP_MAP_LRU_DEPENDS = TERRAIN GEO MATH UTIL
+$(eval $(call link-program,TestRaspMapLRU,TEST_RASP_MAP_LRU))
+
+TEST_CLOUD_JOURNAL_SOURCES = \
+	$(SRC)/Tracking/SkyLines/Assemble.cpp \
+	$(SRC)/Cloud/Serialiser.cpp \
+	$(SRC)/Cloud/Client.cpp \
+	$(SRC)/Cloud/Thermal.cpp \
+	$(SRC)/Cloud/Data.cpp \
+	$(SRC)/Cloud/Journal.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestCloudJournal.cpp
+TEST_CLOUD_JOURNAL_DEPENDS = LIBNET IO OS GEO MATH UTIL
+$(eval $(call link-program,TestCloudJournal,TEST_CLOUD_JOURNAL))
+
+TEST_VARIO_SYNTHESISER_SOURCES = \
+	$(SRC)/Audio/ToneSynthesiser.cpp \
+	$(SRC)/Audio/VarioSynthesiser.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestVarioSynthesiser.cpp
+TEST_VARIO_SYNTHESISER_DEPENDS = MATH
+$(eval $(call link-program,TestVarioSynthesiser,TEST_VARIO_SYNTHESISER))
+
 TEST_THERMALBAND_SOURCES = \
 $(ENGINE_SRC_DIR)/ThermalBand/ThermalBand.cpp \
 $(ENGINE_SRC_DIR)/ThermalBand/ThermalSlice.cpp \
@@ -163,6 +214,18 @@ TEST_OVERWRITING_RING_BUFFER_SOURCES = \
 TEST_OVERWRITING_RING_BUFFER_DEPENDS = MATH
 $(eval $(call link-program,TestOverwritingRingBuffer,TEST_OVERWRITING_RING_BUFFER))
 
+TEST_THINNING_QUEUE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestThinningQueue.cpp
+TEST_THINNING_QUEUE_DEPENDS = MATH
+$(eval $(call link-program,TestThinningQueue,TEST_THINNING_QUEUE))
+
+TEST_SKYLINES_QUEUE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSkyLinesQueue.cpp
+TEST_SKYLINES_QUEUE_DEPENDS = MATH
+$(eval $(call link-program,TestSkyLinesQueue,TEST_SKYLINES_QUEUE))
+
 TEST_IGC_PARSER_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -191,6 +254,52 @@ TEST_AIRSPACE_PARSER_LDADD = $(FAKE_LIBS)
 TEST_AIRSPACE_PARSER_DEPENDS = IO OS AIRSPACE UNITS ZZIP GEO MATH UTIL UNITS
 $(eval $(call link-program,TestAirspaceParser,TEST_AIRSPACE_PARSER))
 
+TEST_XML_PARSER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestXMLParser.cpp
+TEST_XML_PARSER_DEPENDS = XML IO UTIL
+$(eval $(call link-program,TestXMLParser,TEST_XML_PARSER))
+
+TEST_AIRSPACE_WARNING_MANAGER_SOURCES = \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/Aircraft.cpp \
+	$(TEST_SRC_DIR)/FakeDialogs.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/AllocationCounter.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAirspaceWarningManager.cpp
+TEST_AIRSPACE_WARNING_MANAGER_LDADD = $(FAKE_LIBS)
+TEST_AIRSPACE_WARNING_MANAGER_DEPENDS = AIRSPACE TASK WAYPOINT GLIDE IO OS UNITS ZZIP GEO MATH TIME UTIL
+$(eval $(call link-program,TestAirspaceWarningManager,TEST_AIRSPACE_WARNING_MANAGER))
+
+TEST_AIRSPACE_SORTER_SOURCES = \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAirspaceSorter.cpp
+TEST_AIRSPACE_SORTER_DEPENDS = AIRSPACE GLIDE GEO MATH UTIL
+$(eval $(call link-program,TestAirspaceSorter,TEST_AIRSPACE_SORTER))
+
+TEST_AIRSPACE_ROUTE_SOURCES = \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAirspaceRoute.cpp
+TEST_AIRSPACE_ROUTE_DEPENDS = ROUTE TERRAIN AIRSPACE GLIDE IO OS ZZIP GEO MATH UTIL
+$(eval $(call link-program,TestAirspaceRoute,TEST_AIRSPACE_ROUTE))
+
+TEST_AIRSPACE_WARNING_SNAPSHOT_SOURCES = \
+	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
+	$(SRC)/Airspace/ActivePredicate.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/Aircraft.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAirspaceWarningSnapshot.cpp
+TEST_AIRSPACE_WARNING_SNAPSHOT_DEPENDS = AIRSPACE GLIDE GEO MATH UTIL
+$(eval $(call link-program,TestAirspaceWarningSnapshot,TEST_AIRSPACE_WARNING_SNAPSHOT))
+
 TEST_DATE_TIME_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestDateTime.cpp
@@ -223,6 +332,12 @@ TEST_WRAP_CLOCK_SOURCES = \
 TEST_WRAP_CLOCK_DEPENDS = MATH TIME
 $(eval $(call link-program,TestWrapClock,TEST_WRAP_CLOCK))
 
+TEST_DUTY_SCHEDULER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestDutyScheduler.cpp
+TEST_DUTY_SCHEDULER_DEPENDS = MATH
+$(eval $(call link-program,TestDutyScheduler,TEST_DUTY_SCHEDULER))
+
 TEST_PROFILE_SOURCES = \
 	$(SRC)/LocalPath.cpp \
 	$(SRC)/Profile/Profile.cpp \
@@ -249,6 +364,26 @@ TEST_ORDERED_TASK_OBJS = $(call SRC_TO_OBJ,$(TEST_ORDERED_TASK_SOURCES))
 TEST_ORDERED_TASK_DEPENDS = TASK ROUTE GLIDE WAYPOINT GEO TIME MATH UTIL
 $(eval $(call link-program,TestOrderedTask,TEST_ORDERED_TASK))
 
+TEST_START_CANDIDATES_SOURCES = \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestStartCandidates.cpp
+TEST_START_CANDIDATES_DEPENDS = TASK GEO TIME MATH UTIL
+$(eval $(call link-program,TestStartCandidates,TEST_START_CANDIDATES))
+
+TEST_WORKER_POOL_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestWorkerPool.cpp
+TEST_WORKER_POOL_DEPENDS = THREAD UTIL
+$(eval $(call link-program,TestWorkerPool,TEST_WORKER_POOL))
+
+TEST_TIMING_HISTOGRAM_SOURCES = \
+	$(SRC)/Profiler/TimingHistogram.cpp \
+	$(SRC)/Profiler/Profiler.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTimingHistogram.cpp
+$(eval $(call link-program,TestTimingHistogram,TEST_TIMING_HISTOGRAM))
+
 TEST_AAT_POINT_SOURCES = \
 	$(SRC)/Engine/Util/Gradient.cpp \
 	$(SRC)/Engine/Navigation/Aircraft.cpp \
@@ -269,6 +404,14 @@ TEST_TASK_SAVE_OBJS = $(call SRC_TO_OBJ,$(TEST_TASK_SAVE_SOURCES))
 TEST_TASK_SAVE_DEPENDS = TASK TASKFILE ROUTE GLIDE WAYPOINT GEO TIME MATH UTIL XML
 $(eval $(call link-program,TestTaskSave,TEST_TASK_SAVE))
 
+TEST_TASK_INDEX_SOURCES = \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/XML/Node.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTaskIndex.cpp
+TEST_TASK_INDEX_DEPENDS = TASKFILE TASK ROUTE GLIDE WAYPOINT IO OS GEO TIME MATH UTIL XML
+$(eval $(call link-program,TestTaskIndex,TEST_TASK_INDEX))
+
 TEST_PLANES_SOURCES = \
 	$(SRC)/Polar/Parser.cpp \
 	$(SRC)/Plane/PlaneFileGlue.cpp \
@@ -315,7 +458,7 @@ TEST_REACH_SOURCES = \
 	$(TEST_SRC_DIR)/Printing.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/test_reach.cpp
-TEST_REACH_DEPENDS = TERRAIN OPERATION IO ZZIP OS ROUTE GLIDE GEO MATH UTIL
+TEST_REACH_DEPENDS = TERRAIN OPERATION IO ZZIP OS ROUTE GLIDE GEO MATH THREAD UTIL
 $(eval $(call link-program,test_reach,TEST_REACH))
 
 TEST_ROUTE_SOURCES = \
@@ -611,6 +754,12 @@ TEST_ALLOCATED_GRID_SOURCES = \
 TEST_ALLOCATED_GRID_DEPENDS = UTIL
 $(eval $(call link-program,TestAllocatedGrid,TEST_ALLOCATED_GRID))
 
+TEST_FLAT_HASH_MAP_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlatHashMap.cpp
+TEST_FLAT_HASH_MAP_DEPENDS = UTIL
+$(eval $(call link-program,TestFlatHashMap,TEST_FLAT_HASH_MAP))
+
 TEST_RADIX_TREE_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestRadixTree.cpp
@@ -706,6 +855,10 @@ check: $(TESTS) | $(OUT)/test/dirstamp
 check-no-build: $(OUT)/test/dirstamp
 	$(PERL) $(TEST_SRC_DIR)/testall.pl $(TESTS)
 
+.PHONY: bench
+bench: $(TARGET_BIN_DIR)/RunBenchmarks$(TARGET_EXEEXT)
+	$(Q)$< test/data
+
 DEBUG_PROGRAM_NAMES = \
 	test_reach \
 	test_route \
@@ -714,6 +867,7 @@ DEBUG_PROGRAM_NAMES = \
 	FlightTable \
 	BenchmarkProjection \
 	BenchmarkFAITriangleSector \
+	RunBenchmarks \
 	DumpTextInflate \
 	DumpHexColor \
 	RunXMLParser \
@@ -755,6 +909,7 @@ DEBUG_PROGRAM_NAMES += \
 	RunCirclingWind RunWindEKF RunWindComputer \
 	RunExternalWind \
 	RunTask \
+	ScorePEVStarts \
 	LoadImage ViewImage \
 	RunCanvas RunMapWindow \
 	RunListControl \
@@ -799,7 +954,7 @@ DEBUG_PROGRAM_NAMES += DownloadFile \
 	UploadFile \
 	RunWeGlideClient \
 	RunTimClient \
-	RunNOAADownloader RunSkyLinesTracking RunLiveTrack24
+	RunNOAADownloader RunSkyLinesTracking RunSkyLinesLoad RunLiveTrack24
 endif
 
 ifeq ($(TARGET_IS_LINUX),y)
@@ -868,7 +1023,7 @@ DEBUG_REPLAY_DEPENDS = DRIVER ASYNC LIBNET IO OS THREAD TIME
 BENCHMARK_PROJECTION_SOURCES = \
 	$(SRC)/Projection/Projection.cpp \
 	$(TEST_SRC_DIR)/BenchmarkProjection.cpp
-BENCHMARK_PROJECTION_DEPENDS = MATH
+BENCHMARK_PROJECTION_DEPENDS = GEO MATH
 BENCHMARK_PROJECTION_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,BenchmarkProjection,BENCHMARK_PROJECTION))
 
@@ -986,6 +1141,17 @@ RUN_SL_TRACKING_SOURCES = \
 RUN_SL_TRACKING_DEPENDS = $(DEBUG_REPLAY_DEPENDS)
 $(eval $(call link-program,RunSkyLinesTracking,RUN_SL_TRACKING))
 
+RUN_SL_LOAD_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/net/SocketError.cxx \
+	$(SRC)/Tracking/SkyLines/Client.cpp \
+	$(SRC)/Tracking/SkyLines/Assemble.cpp \
+	$(SRC)/Formatter/NMEAFormatter.cpp \
+	$(SRC)/TransponderCode.cpp \
+	$(TEST_SRC_DIR)/RunSkyLinesLoad.cpp
+RUN_SL_LOAD_DEPENDS = $(DEBUG_REPLAY_DEPENDS)
+$(eval $(call link-program,RunSkyLinesLoad,RUN_SL_LOAD))
+
 RUN_LIVETRACK24_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/net/SocketError.cxx \
@@ -1514,6 +1680,18 @@ RUN_TASK_SOURCES = \
 RUN_TASK_DEPENDS = $(DEBUG_REPLAY_DEPENDS) TASKFILE WAYPOINTFILE GLIDE GEO MATH UTIL IO TIME
 $(eval $(call link-program,RunTask,RUN_TASK))
 
+SCORE_PEV_STARTS_SOURCES = \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/TransponderCode.cpp \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/ScorePEVStarts.cpp
+SCORE_PEV_STARTS_DEPENDS = $(DEBUG_REPLAY_DEPENDS) TASKFILE WAYPOINTFILE GLIDE GEO MATH UTIL IO OS THREAD TIME
+$(eval $(call link-program,ScorePEVStarts,SCORE_PEV_STARTS))
+
 RUN_TRACE_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/IGC/IGCParser.cpp \
@@ -1541,6 +1719,17 @@ RUN_CONTEST_SOURCES = \
 RUN_CONTEST_DEPENDS = $(DEBUG_REPLAY_DEPENDS) CONTEST UTIL GEO MATH TIME
 $(eval $(call link-program,RunContestAnalysis,RUN_CONTEST))
 
+RUN_BENCHMARKS_SOURCES = \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/Aircraft.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Point.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Trace.cpp \
+	$(TEST_SRC_DIR)/AllocationCounter.cpp \
+	$(TEST_SRC_DIR)/RunBenchmarks.cpp
+RUN_BENCHMARKS_DEPENDS = CONTEST ROUTE AIRSPACE TASK WAYPOINT TERRAIN OPERATION IO ZZIP OS THREAD GLIDE GEO MATH TIME UTIL
+$(eval $(call link-program,RunBenchmarks,RUN_BENCHMARKS))
+
 RUN_WAVE_COMPUTER_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/Computer/WaveComputer.cpp \
@@ -1653,6 +1842,8 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Projection/CompareProjection.cpp \
 	$(SRC)/Weather/Rasp/RaspStore.cpp \
 	$(SRC)/Weather/Rasp/RaspCache.cpp \
+	$(SRC)/Weather/Rasp/RaspMapCache.cpp \
+	$(SRC)/Weather/Rasp/RaspMapLRU.cpp \
 	$(SRC)/Weather/Rasp/RaspRenderer.cpp \
 	$(SRC)/Weather/Rasp/RaspStyle.cpp \
 	$(SRC)/Renderer/FAITriangleAreaRenderer.cpp \
@@ -1699,6 +1890,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(SRC)/Task/ProtectedRoutePlanner.cpp \
 	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Task/VisibilityGraphThread.cpp \
 	$(SRC)/Units/Units.cpp \
 	$(SRC)/Units/Settings.cpp \
 	$(SRC)/Formatter/Units.cpp \
@@ -2044,8 +2236,10 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/UIUtil/GestureManager.cpp \
 	$(SRC)/Task/DefaultTask.cpp \
 	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/PublishedTask.cpp \
 	$(SRC)/Task/ProtectedRoutePlanner.cpp \
 	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Task/VisibilityGraphThread.cpp \
 	$(SRC)/Waypoint/Factory.cpp \
 	$(SRC)/RadioFrequency.cpp \
 	$(SRC)/Math/Screen.cpp \
@@ -2265,6 +2459,7 @@ RUN_TASK_EDITOR_DIALOG_SOURCES = \
 	$(MORE_SCREEN_SOURCES) \
 	$(SRC)/Look/GlobalFonts.cpp \
 	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/PublishedTask.cpp \
 	$(SRC)/LocalPath.cpp \
 	$(SRC)/UtilsFont.cpp \
 	$(SRC)/Units/Units.cpp \
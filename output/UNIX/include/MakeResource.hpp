@@ -0,0 +1,251 @@
+MAKE_RESOURCE(IDI_XCSOAR, xcsoarswift, 100);
+MAKE_RESOURCE(IDB_ABORT, mode_abort, 101);
+MAKE_RESOURCE(IDB_ABORT_HD, mode_abort_160, 102);
+MAKE_RESOURCE(IDB_ABORT_UHD, mode_abort_300, 103);
+#define IDB_ABORT_ALL IDB_ABORT, IDB_ABORT_HD, IDB_ABORT_UHD
+MAKE_RESOURCE(IDB_AIRPORT_REACHABLE, alt_reachable_airport, 104);
+MAKE_RESOURCE(IDB_AIRPORT_REACHABLE_HD, alt_reachable_airport_160, 105);
+MAKE_RESOURCE(IDB_AIRPORT_REACHABLE_UHD, alt_reachable_airport_300, 106);
+#define IDB_AIRPORT_REACHABLE_ALL IDB_AIRPORT_REACHABLE, IDB_AIRPORT_REACHABLE_HD, IDB_AIRPORT_REACHABLE_UHD
+MAKE_RESOURCE(IDB_AIRPORT_MARGINAL, alt_marginal_airport, 107);
+MAKE_RESOURCE(IDB_AIRPORT_MARGINAL_HD, alt_marginal_airport_160, 108);
+MAKE_RESOURCE(IDB_AIRPORT_MARGINAL_UHD, alt_marginal_airport_300, 109);
+#define IDB_AIRPORT_MARGINAL_ALL IDB_AIRPORT_MARGINAL, IDB_AIRPORT_MARGINAL_HD, IDB_AIRPORT_MARGINAL_UHD
+MAKE_RESOURCE(IDB_AIRPORT_UNREACHABLE, alt_landable_airport, 110);
+MAKE_RESOURCE(IDB_AIRPORT_UNREACHABLE_HD, alt_landable_airport_160, 111);
+MAKE_RESOURCE(IDB_AIRPORT_UNREACHABLE_UHD, alt_landable_airport_300, 112);
+#define IDB_AIRPORT_UNREACHABLE_ALL IDB_AIRPORT_UNREACHABLE, IDB_AIRPORT_UNREACHABLE_HD, IDB_AIRPORT_UNREACHABLE_UHD
+MAKE_RESOURCE(IDB_AIRPORT_MARGINAL2, alt2_marginal_airport, 113);
+MAKE_RESOURCE(IDB_AIRPORT_MARGINAL2_HD, alt2_marginal_airport_160, 114);
+MAKE_RESOURCE(IDB_AIRPORT_MARGINAL2_UHD, alt2_marginal_airport_300, 115);
+#define IDB_AIRPORT_MARGINAL2_ALL IDB_AIRPORT_MARGINAL2, IDB_AIRPORT_MARGINAL2_HD, IDB_AIRPORT_MARGINAL2_UHD
+MAKE_RESOURCE(IDB_AIRPORT_UNREACHABLE2, alt2_landable_airport, 116);
+MAKE_RESOURCE(IDB_AIRPORT_UNREACHABLE2_HD, alt2_landable_airport_160, 117);
+MAKE_RESOURCE(IDB_AIRPORT_UNREACHABLE2_UHD, alt2_landable_airport_300, 118);
+#define IDB_AIRPORT_UNREACHABLE2_ALL IDB_AIRPORT_UNREACHABLE2, IDB_AIRPORT_UNREACHABLE2_HD, IDB_AIRPORT_UNREACHABLE2_UHD
+MAKE_RESOURCE(IDB_AIRSPACEI, airspace_intercept, 119);
+MAKE_RESOURCE(IDB_AIRSPACEI_HD, airspace_intercept_160, 120);
+MAKE_RESOURCE(IDB_AIRSPACEI_UHD, airspace_intercept_300, 121);
+#define IDB_AIRSPACEI_ALL IDB_AIRSPACEI, IDB_AIRSPACEI_HD, IDB_AIRSPACEI_UHD
+MAKE_RESOURCE(IDB_CRUISE, mode_cruise, 122);
+MAKE_RESOURCE(IDB_CRUISE_HD, mode_cruise_160, 123);
+MAKE_RESOURCE(IDB_CRUISE_UHD, mode_cruise_300, 124);
+#define IDB_CRUISE_ALL IDB_CRUISE, IDB_CRUISE_HD, IDB_CRUISE_UHD
+MAKE_RESOURCE(IDB_CLIMB, mode_climb, 125);
+MAKE_RESOURCE(IDB_CLIMB_HD, mode_climb_160, 126);
+MAKE_RESOURCE(IDB_CLIMB_UHD, mode_climb_300, 127);
+#define IDB_CLIMB_ALL IDB_CLIMB, IDB_CLIMB_HD, IDB_CLIMB_UHD
+MAKE_RESOURCE(IDB_CLIMBSMALL, climb_12, 128);
+MAKE_RESOURCE(IDB_CLIMBSMALLINV, climb_12inv, 129);
+MAKE_RESOURCE(IDB_FOLDER, folder, 130);
+MAKE_RESOURCE(IDB_FOLDER_HD, folder_160, 131);
+MAKE_RESOURCE(IDB_FOLDER_UHD, folder_300, 132);
+#define IDB_FOLDER_ALL IDB_FOLDER, IDB_FOLDER_HD, IDB_FOLDER_UHD
+MAKE_RESOURCE(IDB_SETTINGS, settings, 133);
+MAKE_RESOURCE(IDB_SETTINGS_HD, settings_160, 134);
+MAKE_RESOURCE(IDB_SETTINGS_UHD, settings_300, 135);
+#define IDB_SETTINGS_ALL IDB_SETTINGS, IDB_SETTINGS_HD, IDB_SETTINGS_UHD
+MAKE_RESOURCE(IDB_TASK, task, 136);
+MAKE_RESOURCE(IDB_TASK_HD, task_160, 137);
+MAKE_RESOURCE(IDB_TASK_UHD, task_300, 138);
+#define IDB_TASK_ALL IDB_TASK, IDB_TASK_HD, IDB_TASK_UHD
+MAKE_RESOURCE(IDB_CALCULATOR, calculator, 139);
+MAKE_RESOURCE(IDB_CALCULATOR_HD, calculator_160, 140);
+MAKE_RESOURCE(IDB_CALCULATOR_UHD, calculator_300, 141);
+#define IDB_CALCULATOR_ALL IDB_CALCULATOR, IDB_CALCULATOR_HD, IDB_CALCULATOR_UHD
+MAKE_RESOURCE(IDB_WRENCH, wrench, 142);
+MAKE_RESOURCE(IDB_WRENCH_HD, wrench_160, 143);
+MAKE_RESOURCE(IDB_WRENCH_UHD, wrench_300, 144);
+#define IDB_WRENCH_ALL IDB_WRENCH, IDB_WRENCH_HD, IDB_WRENCH_UHD
+MAKE_RESOURCE(IDB_GLOBE, globe, 145);
+MAKE_RESOURCE(IDB_GLOBE_HD, globe_160, 146);
+MAKE_RESOURCE(IDB_GLOBE_UHD, globe_300, 147);
+#define IDB_GLOBE_ALL IDB_GLOBE, IDB_GLOBE_HD, IDB_GLOBE_UHD
+MAKE_RESOURCE(IDB_DEVICE, device, 148);
+MAKE_RESOURCE(IDB_DEVICE_HD, device_160, 149);
+MAKE_RESOURCE(IDB_DEVICE_UHD, device_300, 150);
+#define IDB_DEVICE_ALL IDB_DEVICE, IDB_DEVICE_HD, IDB_DEVICE_UHD
+MAKE_RESOURCE(IDB_RULES, rules, 151);
+MAKE_RESOURCE(IDB_RULES_HD, rules_160, 152);
+MAKE_RESOURCE(IDB_RULES_UHD, rules_300, 153);
+#define IDB_RULES_ALL IDB_RULES, IDB_RULES_HD, IDB_RULES_UHD
+MAKE_RESOURCE(IDB_CLOCK, clock, 154);
+MAKE_RESOURCE(IDB_CLOCK_HD, clock_160, 155);
+MAKE_RESOURCE(IDB_CLOCK_UHD, clock_300, 156);
+#define IDB_CLOCK_ALL IDB_CLOCK, IDB_CLOCK_HD, IDB_CLOCK_UHD
+MAKE_RESOURCE(IDB_DIALOGTITLE, dialog_title_red, 157);
+MAKE_RESOURCE(IDB_FINALGLIDE, mode_finalglide, 158);
+MAKE_RESOURCE(IDB_FINALGLIDE_HD, mode_finalglide_160, 159);
+MAKE_RESOURCE(IDB_FINALGLIDE_UHD, mode_finalglide_300, 160);
+#define IDB_FINALGLIDE_ALL IDB_FINALGLIDE, IDB_FINALGLIDE_HD, IDB_FINALGLIDE_UHD
+MAKE_RESOURCE(IDB_TRAFFIC_SAFE, flarm_traffic, 161);
+MAKE_RESOURCE(IDB_TRAFFIC_SAFE_HD, flarm_traffic_160, 162);
+MAKE_RESOURCE(IDB_TRAFFIC_SAFE_UHD, flarm_traffic_300, 163);
+#define IDB_TRAFFIC_SAFE_ALL IDB_TRAFFIC_SAFE, IDB_TRAFFIC_SAFE_HD, IDB_TRAFFIC_SAFE_UHD
+MAKE_RESOURCE(IDB_TRAFFIC_WARNING, flarm_warning, 164);
+MAKE_RESOURCE(IDB_TRAFFIC_WARNING_HD, flarm_warning_160, 165);
+MAKE_RESOURCE(IDB_TRAFFIC_WARNING_UHD, flarm_warning_300, 166);
+#define IDB_TRAFFIC_WARNING_ALL IDB_TRAFFIC_WARNING, IDB_TRAFFIC_WARNING_HD, IDB_TRAFFIC_WARNING_UHD
+MAKE_RESOURCE(IDB_TRAFFIC_ALARM, flarm_alarm, 167);
+MAKE_RESOURCE(IDB_TRAFFIC_ALARM_HD, flarm_alarm_160, 168);
+MAKE_RESOURCE(IDB_TRAFFIC_ALARM_UHD, flarm_alarm_300, 169);
+#define IDB_TRAFFIC_ALARM_ALL IDB_TRAFFIC_ALARM, IDB_TRAFFIC_ALARM_HD, IDB_TRAFFIC_ALARM_UHD
+MAKE_RESOURCE(IDB_GPSSTATUS1, gps_acquiring, 170);
+MAKE_RESOURCE(IDB_GPSSTATUS1_HD, gps_acquiring_160, 171);
+MAKE_RESOURCE(IDB_GPSSTATUS1_UHD, gps_acquiring_300, 172);
+#define IDB_GPSSTATUS1_ALL IDB_GPSSTATUS1, IDB_GPSSTATUS1_HD, IDB_GPSSTATUS1_UHD
+MAKE_RESOURCE(IDB_GPSSTATUS2, gps_disconnected, 173);
+MAKE_RESOURCE(IDB_GPSSTATUS2_HD, gps_disconnected_160, 174);
+MAKE_RESOURCE(IDB_GPSSTATUS2_UHD, gps_disconnected_300, 175);
+#define IDB_GPSSTATUS2_ALL IDB_GPSSTATUS2, IDB_GPSSTATUS2_HD, IDB_GPSSTATUS2_UHD
+MAKE_RESOURCE(IDB_LANDABLE, winpilot_landable, 176);
+MAKE_RESOURCE(IDB_LANDABLE_HD, winpilot_landable_160, 177);
+MAKE_RESOURCE(IDB_LANDABLE_UHD, winpilot_landable_300, 178);
+#define IDB_LANDABLE_ALL IDB_LANDABLE, IDB_LANDABLE_HD, IDB_LANDABLE_UHD
+MAKE_RESOURCE(IDB_LAUNCHER1, launcher_red_640_1, 179);
+MAKE_RESOURCE(IDB_LAUNCHER2, launcher_red_640_2, 180);
+MAKE_RESOURCE(IDB_MAPSCALE_LEFT, scalearrow_left, 181);
+MAKE_RESOURCE(IDB_MAPSCALE_LEFT_HD, scalearrow_left_160, 182);
+MAKE_RESOURCE(IDB_MAPSCALE_LEFT_UHD, scalearrow_left_300, 183);
+#define IDB_MAPSCALE_LEFT_ALL IDB_MAPSCALE_LEFT, IDB_MAPSCALE_LEFT_HD, IDB_MAPSCALE_LEFT_UHD
+MAKE_RESOURCE(IDB_MAPSCALE_RIGHT, scalearrow_right, 184);
+MAKE_RESOURCE(IDB_MAPSCALE_RIGHT_HD, scalearrow_right_160, 185);
+MAKE_RESOURCE(IDB_MAPSCALE_RIGHT_UHD, scalearrow_right_300, 186);
+#define IDB_MAPSCALE_RIGHT_ALL IDB_MAPSCALE_RIGHT, IDB_MAPSCALE_RIGHT_HD, IDB_MAPSCALE_RIGHT_UHD
+MAKE_RESOURCE(IDB_MARK, map_flag, 187);
+MAKE_RESOURCE(IDB_MARK_HD, map_flag_160, 188);
+MAKE_RESOURCE(IDB_MARK_UHD, map_flag_300, 189);
+#define IDB_MARK_ALL IDB_MARK, IDB_MARK_HD, IDB_MARK_UHD
+MAKE_RESOURCE(IDB_OBSTACLE, map_obstacle, 190);
+MAKE_RESOURCE(IDB_OBSTACLE_HD, map_obstacle_160, 191);
+MAKE_RESOURCE(IDB_OBSTACLE_UHD, map_obstacle_300, 192);
+#define IDB_OBSTACLE_ALL IDB_OBSTACLE, IDB_OBSTACLE_HD, IDB_OBSTACLE_UHD
+MAKE_RESOURCE(IDB_OUTFIELD_REACHABLE, alt_reachable_field, 193);
+MAKE_RESOURCE(IDB_OUTFIELD_REACHABLE_HD, alt_reachable_field_160, 194);
+MAKE_RESOURCE(IDB_OUTFIELD_REACHABLE_UHD, alt_reachable_field_300, 195);
+#define IDB_OUTFIELD_REACHABLE_ALL IDB_OUTFIELD_REACHABLE, IDB_OUTFIELD_REACHABLE_HD, IDB_OUTFIELD_REACHABLE_UHD
+MAKE_RESOURCE(IDB_OUTFIELD_MARGINAL, alt_marginal_field, 196);
+MAKE_RESOURCE(IDB_OUTFIELD_MARGINAL_HD, alt_marginal_field_160, 197);
+MAKE_RESOURCE(IDB_OUTFIELD_MARGINAL_UHD, alt_marginal_field_300, 198);
+#define IDB_OUTFIELD_MARGINAL_ALL IDB_OUTFIELD_MARGINAL, IDB_OUTFIELD_MARGINAL_HD, IDB_OUTFIELD_MARGINAL_UHD
+MAKE_RESOURCE(IDB_OUTFIELD_UNREACHABLE, alt_landable_field, 199);
+MAKE_RESOURCE(IDB_OUTFIELD_UNREACHABLE_HD, alt_landable_field_160, 200);
+MAKE_RESOURCE(IDB_OUTFIELD_UNREACHABLE_UHD, alt_landable_field_300, 201);
+#define IDB_OUTFIELD_UNREACHABLE_ALL IDB_OUTFIELD_UNREACHABLE, IDB_OUTFIELD_UNREACHABLE_HD, IDB_OUTFIELD_UNREACHABLE_UHD
+MAKE_RESOURCE(IDB_OUTFIELD_MARGINAL2, alt2_marginal_field, 202);
+MAKE_RESOURCE(IDB_OUTFIELD_MARGINAL2_HD, alt2_marginal_field_160, 203);
+MAKE_RESOURCE(IDB_OUTFIELD_MARGINAL2_UHD, alt2_marginal_field_300, 204);
+#define IDB_OUTFIELD_MARGINAL2_ALL IDB_OUTFIELD_MARGINAL2, IDB_OUTFIELD_MARGINAL2_HD, IDB_OUTFIELD_MARGINAL2_UHD
+MAKE_RESOURCE(IDB_OUTFIELD_UNREACHABLE2, alt2_landable_field, 205);
+MAKE_RESOURCE(IDB_OUTFIELD_UNREACHABLE2_HD, alt2_landable_field_160, 206);
+MAKE_RESOURCE(IDB_OUTFIELD_UNREACHABLE2_UHD, alt2_landable_field_300, 207);
+#define IDB_OUTFIELD_UNREACHABLE2_ALL IDB_OUTFIELD_UNREACHABLE2, IDB_OUTFIELD_UNREACHABLE2_HD, IDB_OUTFIELD_UNREACHABLE2_UHD
+MAKE_RESOURCE(IDB_MOUNTAIN_PASS, map_pass, 208);
+MAKE_RESOURCE(IDB_MOUNTAIN_PASS_HD, map_pass_160, 209);
+MAKE_RESOURCE(IDB_MOUNTAIN_PASS_UHD, map_pass_300, 210);
+#define IDB_MOUNTAIN_PASS_ALL IDB_MOUNTAIN_PASS, IDB_MOUNTAIN_PASS_HD, IDB_MOUNTAIN_PASS_UHD
+MAKE_RESOURCE(IDB_PROGRESSBORDER, progress_border_red, 211);
+MAKE_RESOURCE(IDB_REACHABLE, winpilot_reachable, 212);
+MAKE_RESOURCE(IDB_REACHABLE_HD, winpilot_reachable_160, 213);
+MAKE_RESOURCE(IDB_REACHABLE_UHD, winpilot_reachable_300, 214);
+#define IDB_REACHABLE_ALL IDB_REACHABLE, IDB_REACHABLE_HD, IDB_REACHABLE_UHD
+MAKE_RESOURCE(IDB_MARGINAL, winpilot_marginal, 215);
+MAKE_RESOURCE(IDB_MARGINAL_HD, winpilot_marginal_160, 216);
+MAKE_RESOURCE(IDB_MARGINAL_UHD, winpilot_marginal_300, 217);
+#define IDB_MARGINAL_ALL IDB_MARGINAL, IDB_MARGINAL_HD, IDB_MARGINAL_UHD
+MAKE_RESOURCE(IDB_SMALL, map_small, 218);
+MAKE_RESOURCE(IDB_SMALL_HD, map_small_160, 219);
+MAKE_RESOURCE(IDB_SMALL_UHD, map_small_300, 220);
+#define IDB_SMALL_ALL IDB_SMALL, IDB_SMALL_HD, IDB_SMALL_UHD
+MAKE_RESOURCE(IDB_LOGO_HD, logo_red_160, 221);
+MAKE_RESOURCE(IDB_LOGO, logo_red_80, 222);
+MAKE_RESOURCE(IDB_TARGET, map_target, 223);
+MAKE_RESOURCE(IDB_TARGET_HD, map_target_160, 224);
+MAKE_RESOURCE(IDB_TARGET_UHD, map_target_300, 225);
+#define IDB_TARGET_ALL IDB_TARGET, IDB_TARGET_HD, IDB_TARGET_UHD
+MAKE_RESOURCE(IDB_TEAMMATE_POS, map_teammate, 226);
+MAKE_RESOURCE(IDB_TEAMMATE_POS_HD, map_teammate_160, 227);
+MAKE_RESOURCE(IDB_TEAMMATE_POS_UHD, map_teammate_300, 228);
+#define IDB_TEAMMATE_POS_ALL IDB_TEAMMATE_POS, IDB_TEAMMATE_POS_HD, IDB_TEAMMATE_POS_UHD
+MAKE_RESOURCE(IDB_TERRAINWARNING, map_terrainw, 229);
+MAKE_RESOURCE(IDB_TERRAINWARNING_HD, map_terrainw_160, 230);
+MAKE_RESOURCE(IDB_TERRAINWARNING_UHD, map_terrainw_300, 231);
+#define IDB_TERRAINWARNING_ALL IDB_TERRAINWARNING, IDB_TERRAINWARNING_HD, IDB_TERRAINWARNING_UHD
+MAKE_RESOURCE(IDB_THERMALSOURCE, map_thermal_source, 232);
+MAKE_RESOURCE(IDB_THERMALSOURCE_HD, map_thermal_source_160, 233);
+MAKE_RESOURCE(IDB_THERMALSOURCE_UHD, map_thermal_source_300, 234);
+#define IDB_THERMALSOURCE_ALL IDB_THERMALSOURCE, IDB_THERMALSOURCE_HD, IDB_THERMALSOURCE_UHD
+MAKE_RESOURCE(IDB_TOWN, map_town, 235);
+MAKE_RESOURCE(IDB_TOWN_HD, map_town_160, 236);
+MAKE_RESOURCE(IDB_TOWN_UHD, map_town_300, 237);
+#define IDB_TOWN_ALL IDB_TOWN, IDB_TOWN_HD, IDB_TOWN_UHD
+MAKE_RESOURCE(IDB_TURNPOINT, map_turnpoint, 238);
+MAKE_RESOURCE(IDB_TURNPOINT_HD, map_turnpoint_160, 239);
+MAKE_RESOURCE(IDB_TURNPOINT_UHD, map_turnpoint_300, 240);
+#define IDB_TURNPOINT_ALL IDB_TURNPOINT, IDB_TURNPOINT_HD, IDB_TURNPOINT_UHD
+MAKE_RESOURCE(IDB_TASKTURNPOINT, map_taskturnpoint, 241);
+MAKE_RESOURCE(IDB_TASKTURNPOINT_HD, map_taskturnpoint_160, 242);
+MAKE_RESOURCE(IDB_TASKTURNPOINT_UHD, map_taskturnpoint_300, 243);
+#define IDB_TASKTURNPOINT_ALL IDB_TASKTURNPOINT, IDB_TASKTURNPOINT_HD, IDB_TASKTURNPOINT_UHD
+MAKE_RESOURCE(IDB_MOUNTAIN_TOP, map_mountain_top, 244);
+MAKE_RESOURCE(IDB_MOUNTAIN_TOP_HD, map_mountain_top_160, 245);
+MAKE_RESOURCE(IDB_MOUNTAIN_TOP_UHD, map_mountain_top_300, 246);
+#define IDB_MOUNTAIN_TOP_ALL IDB_MOUNTAIN_TOP, IDB_MOUNTAIN_TOP_HD, IDB_MOUNTAIN_TOP_UHD
+MAKE_RESOURCE(IDB_BRIDGE, map_bridge, 247);
+MAKE_RESOURCE(IDB_BRIDGE_HD, map_bridge_160, 248);
+MAKE_RESOURCE(IDB_BRIDGE_UHD, map_bridge_300, 249);
+#define IDB_BRIDGE_ALL IDB_BRIDGE, IDB_BRIDGE_HD, IDB_BRIDGE_UHD
+MAKE_RESOURCE(IDB_TUNNEL, map_tunnel, 250);
+MAKE_RESOURCE(IDB_TUNNEL_HD, map_tunnel_160, 251);
+MAKE_RESOURCE(IDB_TUNNEL_UHD, map_tunnel_300, 252);
+#define IDB_TUNNEL_ALL IDB_TUNNEL, IDB_TUNNEL_HD, IDB_TUNNEL_UHD
+MAKE_RESOURCE(IDB_TOWER, map_tower, 253);
+MAKE_RESOURCE(IDB_TOWER_HD, map_tower_160, 254);
+MAKE_RESOURCE(IDB_TOWER_UHD, map_tower_300, 255);
+#define IDB_TOWER_ALL IDB_TOWER, IDB_TOWER_HD, IDB_TOWER_UHD
+MAKE_RESOURCE(IDB_POWER_PLANT, map_power_plant, 256);
+MAKE_RESOURCE(IDB_POWER_PLANT_HD, map_power_plant_160, 257);
+MAKE_RESOURCE(IDB_POWER_PLANT_UHD, map_power_plant_300, 258);
+#define IDB_POWER_PLANT_ALL IDB_POWER_PLANT, IDB_POWER_PLANT_HD, IDB_POWER_PLANT_UHD
+MAKE_RESOURCE(IDB_THERMAL_HOTSPOT, map_thermal_hotspot, 259);
+MAKE_RESOURCE(IDB_THERMAL_HOTSPOT_HD, map_thermal_hotspot_160, 260);
+MAKE_RESOURCE(IDB_THERMAL_HOTSPOT_UHD, map_thermal_hotspot_300, 261);
+#define IDB_THERMAL_HOTSPOT_ALL IDB_THERMAL_HOTSPOT, IDB_THERMAL_HOTSPOT_HD, IDB_THERMAL_HOTSPOT_UHD
+MAKE_RESOURCE(IDB_VOR, map_vor, 262);
+MAKE_RESOURCE(IDB_VOR_HD, map_vor_160, 263);
+MAKE_RESOURCE(IDB_VOR_UHD, map_vor_300, 264);
+#define IDB_VOR_ALL IDB_VOR, IDB_VOR_HD, IDB_VOR_UHD
+MAKE_RESOURCE(IDB_NDB, map_ndb, 265);
+MAKE_RESOURCE(IDB_NDB_HD, map_ndb_160, 266);
+MAKE_RESOURCE(IDB_NDB_UHD, map_ndb_300, 267);
+#define IDB_NDB_ALL IDB_NDB, IDB_NDB_HD, IDB_NDB_UHD
+MAKE_RESOURCE(IDB_DAM, map_dam, 268);
+MAKE_RESOURCE(IDB_DAM_HD, map_dam_160, 269);
+MAKE_RESOURCE(IDB_DAM_UHD, map_dam_300, 270);
+#define IDB_DAM_ALL IDB_DAM, IDB_DAM_HD, IDB_DAM_UHD
+MAKE_RESOURCE(IDB_CASTLE, map_castle, 271);
+MAKE_RESOURCE(IDB_CASTLE_HD, map_castle_160, 272);
+MAKE_RESOURCE(IDB_CASTLE_UHD, map_castle_300, 273);
+#define IDB_CASTLE_ALL IDB_CASTLE, IDB_CASTLE_HD, IDB_CASTLE_UHD
+MAKE_RESOURCE(IDB_INTERSECTION, map_intersection, 274);
+MAKE_RESOURCE(IDB_INTERSECTION_HD, map_intersection_160, 275);
+MAKE_RESOURCE(IDB_INTERSECTION_UHD, map_intersection_300, 276);
+#define IDB_INTERSECTION_ALL IDB_INTERSECTION, IDB_INTERSECTION_HD, IDB_INTERSECTION_UHD
+MAKE_RESOURCE(IDB_REPORTING_POINT, map_reporting_point, 277);
+MAKE_RESOURCE(IDB_REPORTING_POINT_HD, map_reporting_point_160, 278);
+MAKE_RESOURCE(IDB_REPORTING_POINT_UHD, map_reporting_point_300, 279);
+#define IDB_REPORTING_POINT_ALL IDB_REPORTING_POINT, IDB_REPORTING_POINT_HD, IDB_REPORTING_POINT_UHD
+MAKE_RESOURCE(IDB_PGTAKEOFF, map_pgtakeoff, 280);
+MAKE_RESOURCE(IDB_PGTAKEOFF_HD, map_pgtakeoff_160, 281);
+MAKE_RESOURCE(IDB_PGTAKEOFF_UHD, map_pgtakeoff_300, 282);
+#define IDB_PGTAKEOFF_ALL IDB_PGTAKEOFF, IDB_PGTAKEOFF_HD, IDB_PGTAKEOFF_UHD
+MAKE_RESOURCE(IDB_PGLANDING, map_pglanding, 283);
+MAKE_RESOURCE(IDB_PGLANDING_HD, map_pglanding_160, 284);
+MAKE_RESOURCE(IDB_PGLANDING_UHD, map_pglanding_300, 285);
+#define IDB_PGLANDING_ALL IDB_PGLANDING, IDB_PGLANDING_HD, IDB_PGLANDING_UHD
+MAKE_RESOURCE(IDB_TITLE, title_red_110, 286);
+MAKE_RESOURCE(IDB_TITLE_HD, title_red_320, 287);
+MAKE_RESOURCE(IDB_WEATHER_STATION, map_weather_station, 288);
+MAKE_RESOURCE(IDB_WEATHER_STATION_HD, map_weather_station_160, 289);
+MAKE_RESOURCE(IDB_WEATHER_STATION_UHD, map_weather_station_300, 290);
+#define IDB_WEATHER_STATION_ALL IDB_WEATHER_STATION, IDB_WEATHER_STATION_HD, IDB_WEATHER_STATION_UHD
@@ -3,16 +3,21 @@
 
 #include "ActivePredicate.hpp"
 #include "ProtectedAirspaceWarningManager.hpp"
-#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "AirspaceWarningSnapshot.hpp"
 #include "Engine/Airspace/AbstractAirspace.hpp"
 
+ActiveAirspacePredicate::ActiveAirspacePredicate(const ProtectedAirspaceWarningManager *warnings) noexcept
+{
+  if (warnings != nullptr)
+    snapshot = warnings->GetSnapshot();
+}
+
 bool
 ActiveAirspacePredicate::operator()(const AbstractAirspace &airspace) const
 {
-  if (warnings != nullptr) {
-    ProtectedAirspaceWarningManager::Lease lease(*warnings);
-    return lease->IsActive(airspace);
-  } else
+  if (snapshot != nullptr)
+    return snapshot->IsActive(airspace);
+  else
     /* fallback */
     return airspace.IsActive();
 }
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <memory>
+
 class ProtectedAirspaceWarningManager;
+class AirspaceWarningSnapshot;
 class AbstractAirspace;
 
 /**
@@ -13,14 +16,16 @@ class AbstractAirspace;
  * The ProtectedAirspaceWarningManager attribute is optional.  It will
  * only query AbstractAirspace::IsActive() if the
  * ProtectedAirspaceWarningManager is nullptr.
+ *
+ * The warning state is obtained once, when the predicate is
+ * constructed; it is meant to be used for one query.
  */
 class ActiveAirspacePredicate {
-  const ProtectedAirspaceWarningManager *warnings;
+  std::shared_ptr<const AirspaceWarningSnapshot> snapshot;
 
 public:
-  constexpr
-  ActiveAirspacePredicate(const ProtectedAirspaceWarningManager *_warnings)
-    :warnings(_warnings) {}
+  explicit
+  ActiveAirspacePredicate(const ProtectedAirspaceWarningManager *warnings) noexcept;
 
   [[gnu::pure]]
   bool operator()(const AbstractAirspace &airspace) const;
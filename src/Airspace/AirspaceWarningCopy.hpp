@@ -4,6 +4,7 @@
 #pragma once
 
 #include "ProtectedAirspaceWarningManager.hpp"
+#include "AirspaceWarningSnapshot.hpp"
 #include "Engine/Airspace/AbstractAirspace.hpp"
 #include "Engine/Airspace/AirspaceWarningManager.hpp"
 #include "util/StaticArray.hxx"
@@ -41,9 +42,15 @@ public:
       Visit(i);
   }
 
+  void Visit(const AirspaceWarningSnapshot &snapshot) noexcept {
+    serial = snapshot.GetSerial();
+
+    for (const auto &i : snapshot)
+      Visit(i);
+  }
+
   void Visit(const ProtectedAirspaceWarningManager &awm) noexcept {
-    const ProtectedAirspaceWarningManager::Lease lease(awm);
-    Visit(lease);
+    Visit(*awm.GetSnapshot());
   }
 
   const StaticArray<GeoPoint,32> &GetLocations() const noexcept {
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Engine/Airspace/AirspaceWarning.hpp"
+#include "Engine/Airspace/AirspaceWarningConfig.hpp"
+#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "util/Serial.hpp"
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * An immutable copy of the #AirspaceWarningManager state, published
+ * by the calculation thread after each update.  Readers obtain it
+ * from ProtectedAirspaceWarningManager::GetSnapshot() and may keep
+ * it as long as they like without holding any lock.
+ *
+ * The warnings are stored contiguously, in the same order as in the
+ * manager, i.e. most severe first.
+ */
+class AirspaceWarningSnapshot {
+  std::vector<AirspaceWarning> warnings;
+
+  AirspaceWarningConfig config;
+
+  Serial serial;
+
+public:
+  using const_iterator = std::vector<AirspaceWarning>::const_iterator;
+
+  /**
+   * Construct an empty snapshot.
+   */
+  AirspaceWarningSnapshot() noexcept {
+    config.SetDefaults();
+  }
+
+  explicit AirspaceWarningSnapshot(const AirspaceWarningManager &awm) noexcept
+    :warnings(awm.begin(), awm.end()),
+     config(awm.GetConfig()),
+     serial(awm.GetSerial()) {}
+
+  /**
+   * @see AirspaceWarningManager::GetSerial()
+   */
+  Serial GetSerial() const noexcept {
+    return serial;
+  }
+
+  bool empty() const noexcept {
+    return warnings.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return warnings.size();
+  }
+
+  const_iterator begin() const noexcept {
+    return warnings.begin();
+  }
+
+  const_iterator end() const noexcept {
+    return warnings.end();
+  }
+
+  const AirspaceWarning &operator[](std::size_t i) const noexcept {
+    return warnings[i];
+  }
+
+  /**
+   * Returns the highest priority warning or nullptr if there is no
+   * warning.
+   */
+  const AirspaceWarning *GetTop() const noexcept {
+    return warnings.empty() ? nullptr : &warnings.front();
+  }
+
+  [[gnu::pure]]
+  const AirspaceWarning *Find(const AbstractAirspace &airspace) const noexcept {
+    auto i = std::find_if(warnings.begin(), warnings.end(),
+                          [&airspace](const AirspaceWarning &w){
+                            return &w.GetAirspace() == &airspace;
+                          });
+    return i != warnings.end() ? &*i : nullptr;
+  }
+
+  /**
+   * @see AirspaceWarningManager::GetAckDay()
+   */
+  [[gnu::pure]]
+  bool GetAckDay(const AbstractAirspace &airspace) const noexcept {
+    const AirspaceWarning *warning = Find(airspace);
+    return warning != nullptr && warning->GetAckDay();
+  }
+
+  /**
+   * @see AirspaceWarningManager::IsActive()
+   */
+  [[gnu::pure]]
+  bool IsActive(const AbstractAirspace &airspace) const noexcept {
+    return airspace.IsActive() &&
+      config.IsClassEnabled(airspace.GetClass()) &&
+      !GetAckDay(airspace);
+  }
+};
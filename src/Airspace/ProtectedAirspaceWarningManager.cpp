@@ -2,8 +2,19 @@
 // Copyright The XCSoar Project
 
 #include "Airspace/ProtectedAirspaceWarningManager.hpp"
+#include "Airspace/AirspaceWarningSnapshot.hpp"
 #include "Airspace/AirspaceWarningManager.hpp"
 
+#include <mutex>
+
+ProtectedAirspaceWarningManager::ProtectedAirspaceWarningManager(AirspaceWarningManager &awm) noexcept
+  :Guard<AirspaceWarningManager>(awm),
+   snapshot(std::make_shared<const AirspaceWarningSnapshot>())
+{
+}
+
+ProtectedAirspaceWarningManager::~ProtectedAirspaceWarningManager() noexcept = default;
+
 const FlatProjection &
 ProtectedAirspaceWarningManager::GetProjection() const noexcept
 {
@@ -12,71 +23,171 @@ ProtectedAirspaceWarningManager::GetProjection() const noexcept
   return lease->GetProjection();
 }
 
+std::shared_ptr<const AirspaceWarningSnapshot>
+ProtectedAirspaceWarningManager::GetSnapshot() const noexcept
+{
+  const std::lock_guard lock{snapshot_mutex};
+  return snapshot;
+}
+
+void
+ProtectedAirspaceWarningManager::PublishSnapshot(const AirspaceWarningManager &awm) noexcept
+{
+  /* copy outside of the snapshot mutex, and free the old snapshot
+     after releasing it */
+  std::shared_ptr<const AirspaceWarningSnapshot> s =
+    std::make_shared<const AirspaceWarningSnapshot>(awm);
+
+  {
+    const std::lock_guard lock{snapshot_mutex};
+    snapshot.swap(s);
+  }
+}
+
+inline void
+ProtectedAirspaceWarningManager::Apply(AirspaceWarningManager &awm,
+                                       const Command &command) noexcept
+{
+  switch (command.type) {
+  case Command::Type::ACKNOWLEDGE:
+    awm.Acknowledge(command.airspace);
+    break;
+
+  case Command::Type::ACKNOWLEDGE_ALL:
+    awm.AcknowledgeAll();
+    break;
+
+  case Command::Type::ACKNOWLEDGE_DAY:
+    awm.AcknowledgeDay(command.airspace, command.set);
+    break;
+
+  case Command::Type::ACKNOWLEDGE_WARNING:
+    awm.AcknowledgeWarning(command.airspace, command.set);
+    break;
+
+  case Command::Type::ACKNOWLEDGE_INSIDE:
+    awm.AcknowledgeInside(command.airspace, command.set);
+    break;
+
+  case Command::Type::ENABLE:
+    if (AirspaceWarning *warning = awm.GetWarningPtr(*command.airspace)) {
+      warning->AcknowledgeInside(false);
+      warning->AcknowledgeWarning(false);
+      warning->AcknowledgeDay(false);
+    }
+    break;
+  }
+}
+
+void
+ProtectedAirspaceWarningManager::ProcessCommands() noexcept
+{
+  std::vector<Command> pending;
+
+  while (true) {
+    {
+      const std::lock_guard lock{command_mutex};
+      if (commands.empty())
+        return;
+    }
+
+    const std::unique_lock lock{mutex, std::try_to_lock};
+    if (!lock.owns_lock())
+      /* somebody else is busy with the manager; the calculation
+         thread will pick up the commands later */
+      return;
+
+    {
+      const std::lock_guard command_lock{command_mutex};
+      pending.swap(commands);
+    }
+
+    for (const auto &i : pending)
+      Apply(value, i);
+    pending.clear();
+
+    PublishSnapshot(value);
+  }
+}
+
+void
+ProtectedAirspaceWarningManager::Submit(Command::Type type,
+                                        ConstAirspacePtr airspace,
+                                        bool set) noexcept
+{
+  {
+    const std::lock_guard lock{command_mutex};
+    commands.push_back({type, set, std::move(airspace)});
+  }
+
+  ProcessCommands();
+}
+
 void
 ProtectedAirspaceWarningManager::Clear() noexcept
 {
   ExclusiveLease lease(*this);
   lease->clear();
+  PublishSnapshot(lease);
 }
 
 void
 ProtectedAirspaceWarningManager::AcknowledgeAll() noexcept
 {
-  ExclusiveLease lease(*this);
-  lease->AcknowledgeAll();
+  Submit(Command::Type::ACKNOWLEDGE_ALL, nullptr);
 }
 
 bool
 ProtectedAirspaceWarningManager::IsEmpty() const noexcept
 {
-  Lease lease(*this);
-  return lease->empty();
+  return GetSnapshot()->empty();
 }
 
 bool
 ProtectedAirspaceWarningManager::GetAckDay(const AbstractAirspace &airspace) const noexcept
 {
-  Lease lease(*this);
-  return lease->GetAckDay(airspace);
+  return GetSnapshot()->GetAckDay(airspace);
 }
 
 void
 ProtectedAirspaceWarningManager::AcknowledgeDay(ConstAirspacePtr airspace,
                                                 const bool set) noexcept
 {
-  ExclusiveLease lease(*this);
-  lease->AcknowledgeDay(std::move(airspace), set);
+  Submit(Command::Type::ACKNOWLEDGE_DAY, std::move(airspace), set);
 }
 
 void
 ProtectedAirspaceWarningManager::AcknowledgeWarning(ConstAirspacePtr airspace,
                                                     const bool set) noexcept
 {
-  ExclusiveLease lease(*this);
-  lease->AcknowledgeWarning(std::move(airspace), set);
+  Submit(Command::Type::ACKNOWLEDGE_WARNING, std::move(airspace), set);
 }
 
 void
 ProtectedAirspaceWarningManager::AcknowledgeInside(ConstAirspacePtr airspace,
                                                    const bool set) noexcept
 {
-  ExclusiveLease lease(*this);
-  lease->AcknowledgeInside(std::move(airspace), set);
+  Submit(Command::Type::ACKNOWLEDGE_INSIDE, std::move(airspace), set);
 }
 
 void
 ProtectedAirspaceWarningManager::Acknowledge(ConstAirspacePtr airspace) noexcept
 {
-  ExclusiveLease lease(*this);
-  lease->Acknowledge(std::move(airspace));
+  Submit(Command::Type::ACKNOWLEDGE, std::move(airspace));
+}
+
+void
+ProtectedAirspaceWarningManager::Enable(ConstAirspacePtr airspace) noexcept
+{
+  Submit(Command::Type::ENABLE, std::move(airspace));
 }
 
 std::optional<AirspaceWarning>
 ProtectedAirspaceWarningManager::GetTopWarning() const noexcept
 {
-  const Lease lease(*this);
-  if (auto i = lease->begin(); i != lease->end())
-    return *i;
+  const auto s = GetSnapshot();
+  if (const AirspaceWarning *top = s->GetTop())
+    return *top;
 
   return std::nullopt;
 }
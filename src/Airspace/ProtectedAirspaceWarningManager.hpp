@@ -5,25 +5,90 @@
 
 #include "Engine/Airspace/Ptr.hpp"
 #include "thread/Guard.hpp"
+#include "thread/Mutex.hxx"
 
+#include <cstdint>
+#include <memory>
 #include <optional>
+#include <vector>
 
 class AirspaceWarning;
 class AirspaceWarningManager;
+class AirspaceWarningSnapshot;
 class FlatProjection;
 
+/**
+ * Shares the #AirspaceWarningManager owned by the calculation thread
+ * with the rest of the program.
+ *
+ * Readers should use GetSnapshot() instead of a #Lease; it returns
+ * the state published by the last PublishSnapshot() call and never
+ * waits for the calculation thread.
+ *
+ * Acknowledgements are queued and applied by whoever gets the
+ * exclusive lock first: the calling thread if the manager is idle,
+ * else the calculation thread in its next ProcessCommands() call.
+ */
 class ProtectedAirspaceWarningManager : public Guard<AirspaceWarningManager> {
+  struct Command {
+    enum class Type : uint8_t {
+      ACKNOWLEDGE,
+      ACKNOWLEDGE_ALL,
+      ACKNOWLEDGE_DAY,
+      ACKNOWLEDGE_WARNING,
+      ACKNOWLEDGE_INSIDE,
+      ENABLE,
+    } type;
+
+    bool set;
+
+    ConstAirspacePtr airspace;
+  };
+
+  /**
+   * Protects #commands.
+   */
+  Mutex command_mutex;
+
+  std::vector<Command> commands;
+
+  /**
+   * Protects #snapshot.  It is only held while copying the pointer.
+   */
+  mutable Mutex snapshot_mutex;
+
+  std::shared_ptr<const AirspaceWarningSnapshot> snapshot;
+
 public:
-  explicit ProtectedAirspaceWarningManager(AirspaceWarningManager &awm) noexcept
-    :Guard<AirspaceWarningManager>(awm) {}
+  explicit ProtectedAirspaceWarningManager(AirspaceWarningManager &awm) noexcept;
+  ~ProtectedAirspaceWarningManager() noexcept;
 
   [[gnu::pure]]
   const FlatProjection &GetProjection() const noexcept;
 
+  /**
+   * Returns the most recently published state.  Never returns
+   * nullptr.
+   */
+  std::shared_ptr<const AirspaceWarningSnapshot> GetSnapshot() const noexcept;
+
+  /**
+   * Publish a new snapshot of the given manager.  The caller must
+   * hold a lease.
+   */
+  void PublishSnapshot(const AirspaceWarningManager &awm) noexcept;
+
+  /**
+   * Apply all queued commands and publish a new snapshot if there
+   * were any.  Returns without doing anything if another thread
+   * holds the lock; that thread (or the next call) will take care
+   * of them.
+   */
+  void ProcessCommands() noexcept;
+
   void Clear() noexcept;
   void AcknowledgeAll() noexcept;
 
-  [[gnu::pure]]
   bool GetAckDay(const AbstractAirspace &airspace) const noexcept;
 
   void AcknowledgeDay(ConstAirspacePtr airspace, bool set=true) noexcept;
@@ -31,13 +96,23 @@ public:
   void AcknowledgeInside(ConstAirspacePtr airspace, bool set=true) noexcept;
   void Acknowledge(ConstAirspacePtr airspace) noexcept;
 
-  [[gnu::pure]]
+  /**
+   * Cancel all acknowledgements of the given airspace.
+   */
+  void Enable(ConstAirspacePtr airspace) noexcept;
+
   bool IsEmpty() const noexcept;
 
   /**
    * Returns a copy of the highest priority warning, or an empty
    * instance if there is no warning.
    */
-  [[gnu::pure]]
   std::optional<AirspaceWarning> GetTopWarning() const noexcept;
+
+private:
+  void Submit(Command::Type type, ConstAirspacePtr airspace,
+              bool set=true) noexcept;
+
+  static void Apply(AirspaceWarningManager &awm,
+                    const Command &command) noexcept;
 };
@@ -4,33 +4,128 @@
 #include "ToneSynthesiser.hpp"
 #include "Math/FastTrig.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 
+/**
+ * The phase is a 32 bit fixed-point value; this is the shift which
+ * converts it to an #ISINETABLE index.
+ */
+static constexpr unsigned PHASE_SHIFT =
+  32 - std::bit_width(INT_ANGLE_RANGE - 1);
+
+/**
+ * #ISINETABLE values range from -1024 to 1024; this shift scales the
+ * product with the gain back to the sample range.
+ */
+static constexpr unsigned SINE_SHIFT = 10;
+
+/**
+ * Frequency and volume changes are ramped over this duration [ms].
+ */
+static constexpr unsigned RAMP_MS = 5;
+
+static constexpr int32_t
+VolumeToGain(unsigned volume) noexcept
+{
+  return 32767 * std::min(volume, 100U) / 100;
+}
+
+[[gnu::always_inline]]
+static inline int16_t
+SineSample(uint32_t phase, int32_t gain) noexcept
+{
+  return (ISINETABLE[phase >> PHASE_SHIFT] * gain) >> SINE_SHIFT;
+}
+
+ToneSynthesiser::ToneSynthesiser(unsigned _sample_rate) noexcept
+  :gain(VolumeToGain(volume)), target_gain(gain),
+   sample_rate(_sample_rate)
+{
+}
+
 void
 ToneSynthesiser::SetTone(unsigned tone_hz)
 {
-  increment = ISINETABLE.size() * tone_hz / sample_rate;
+  target_increment = (uint64_t(tone_hz) << 32) / sample_rate;
+
+  if (increment == 0)
+    /* no tone yet: nothing to ramp from */
+    increment = target_increment;
+  else
+    StartRamp();
 }
 
 void
-ToneSynthesiser::Synthesise(int16_t *buffer, size_t n)
+ToneSynthesiser::StartRamp() noexcept
+{
+  const unsigned length = std::max(sample_rate * RAMP_MS / 1000, 1U);
+
+  increment_step = (int64_t(target_increment) - int64_t(increment)) / length;
+  gain_step = (target_gain - gain) / int32_t(length);
+  ramp_remaining = length;
+}
+
+inline void
+ToneSynthesiser::SynthesiseSteady(int16_t *buffer, size_t n) noexcept
 {
-  assert(angle < ISINETABLE.size());
+  /* each sample depends only on its index, which allows the compiler
+     to vectorise this loop */
+  const uint32_t p = phase, inc = increment;
+  const int32_t g = gain;
+
+  for (size_t i = 0; i < n; ++i)
+    buffer[i] = SineSample(p + uint32_t(i) * inc, g);
+
+  phase = p + uint32_t(n) * inc;
+}
+
+inline void
+ToneSynthesiser::SynthesiseRamp(int16_t *buffer, size_t n) noexcept
+{
+  assert(n <= ramp_remaining);
 
   for (int16_t *end = buffer + n; buffer != end; ++buffer) {
-    *buffer = ISINETABLE[angle] * (32767 / 1024) * (int)volume / 100;
-    angle = (angle + increment) & (ISINETABLE.size() - 1);
+    *buffer = SineSample(phase, gain);
+    phase += increment;
+    increment += increment_step;
+    gain += gain_step;
+  }
+
+  ramp_remaining -= n;
+  if (ramp_remaining == 0) {
+    /* eliminate the rounding error of the steps */
+    increment = target_increment;
+    gain = target_gain;
   }
 }
 
+void
+ToneSynthesiser::Synthesise(int16_t *buffer, size_t n)
+{
+  if (const int32_t new_gain = VolumeToGain(volume.load(std::memory_order_relaxed));
+      new_gain != target_gain) {
+    target_gain = new_gain;
+    StartRamp();
+  }
+
+  if (ramp_remaining > 0) {
+    const size_t o = std::min(n, size_t(ramp_remaining));
+    SynthesiseRamp(buffer, o);
+    buffer += o;
+    n -= o;
+  }
+
+  SynthesiseSteady(buffer, n);
+}
+
 unsigned
 ToneSynthesiser::ToZero() const
 {
-  assert(angle < ISINETABLE.size());
-
-  if (angle < increment)
+  if (increment == 0 || phase < increment)
     /* close enough */
     return 0;
 
-  return (ISINETABLE.size() - angle) / increment;
+  return ((uint64_t(1) << 32) - phase) / increment;
 }
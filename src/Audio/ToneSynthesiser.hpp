@@ -5,28 +5,65 @@
 
 #include "PCMSynthesiser.hpp"
 
+#include <atomic>
+#include <cstdint>
+
 /**
  * This class generates tones with a sine wave.
+ *
+ * Changes of frequency and volume are not applied abruptly; they are
+ * ramped linearly over a few milliseconds to avoid clicking noise.
  */
 class ToneSynthesiser : public PCMSynthesiser {
-  unsigned volume = 100, angle = 0, increment = 0;
+  /**
+   * The volume requested by SetVolume().  This may be modified by
+   * another thread while Synthesise() runs.
+   */
+  std::atomic_uint volume = 100;
+
+  /**
+   * The phase of the sine wave.  The upper 12 bits are the index into
+   * #ISINETABLE.
+   */
+  uint32_t phase = 0;
+
+  /**
+   * The current and the requested phase increment per sample.
+   */
+  uint32_t increment = 0, target_increment = 0;
+
+  /**
+   * The current and the requested amplitude (0..32767).
+   */
+  int32_t gain, target_gain;
+
+  /**
+   * Per-sample steps of the running ramp.
+   */
+  int32_t increment_step, gain_step;
+
+  /**
+   * The number of samples remaining in the running ramp; zero if
+   * frequency and volume are steady.
+   */
+  unsigned ramp_remaining = 0;
 
 public:
-  explicit ToneSynthesiser(unsigned _sample_rate) : sample_rate(_sample_rate) {
-  }
+  explicit ToneSynthesiser(unsigned _sample_rate) noexcept;
 
   unsigned GetSampleRate() const {
     return sample_rate;
   }
 
   /**
-   * Set the (software) volume of the generated tone.
+   * Set the (software) volume of the generated tone.  This method is
+   * thread-safe.
    *
    * @param _volume the new volume level, 0 indicating muted, 100
    * means full volume
    */
   void SetVolume(unsigned _volume) {
-    volume = _volume;
+    volume.store(_volume, std::memory_order_relaxed);
   }
 
   void SetTone(unsigned tone_hz);
@@ -48,6 +85,19 @@ protected:
    * Start a new period.
    */
   void Restart() {
-    angle = 0;
+    phase = 0;
   }
+
+private:
+  void StartRamp() noexcept;
+
+  /**
+   * Generate samples with constant frequency and volume.
+   */
+  void SynthesiseSteady(int16_t *buffer, size_t n) noexcept;
+
+  /**
+   * Generate samples of the running ramp.
+   */
+  void SynthesiseRamp(int16_t *buffer, size_t n) noexcept;
 };
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <mutex>
 
 /**
  * The minimum and maximum vario range for the constants below [cm/s].
@@ -15,6 +16,10 @@ static constexpr int min_vario = -500, max_vario = 500;
 unsigned
 VarioSynthesiser::VarioToFrequency(int ivario)
 {
+  const unsigned min_frequency = settings.min_frequency;
+  const unsigned zero_frequency = settings.zero_frequency;
+  const unsigned max_frequency = settings.max_frequency;
+
   return ivario > 0
     ? (zero_frequency + (unsigned)ivario * (max_frequency - zero_frequency)
        / (unsigned)max_vario)
@@ -22,15 +27,46 @@ VarioSynthesiser::VarioToFrequency(int ivario)
 }
 
 void
-VarioSynthesiser::SetVario(double vario)
+VarioSynthesiser::SetVario(double vario) noexcept
 {
-  const std::lock_guard lock{mutex};
-
   const int ivario = std::clamp((int)(vario * 100), min_vario, max_vario);
+  mailbox.store(ivario, std::memory_order_relaxed);
+}
 
-  if (dead_band_enabled && InDeadBand(ivario)) {
+inline bool
+VarioSynthesiser::ReceiveSettings() noexcept
+{
+  if (!settings_modified.load(std::memory_order_acquire))
+    return false;
+
+  /* the audio thread must not wait for the UI thread; if the mutex
+     is busy, try again in the next period */
+  std::unique_lock lock{settings_mutex, std::try_to_lock};
+  if (!lock.owns_lock())
+    return false;
+
+  settings = pending_settings;
+  settings_modified.store(false, std::memory_order_relaxed);
+  return true;
+}
+
+inline void
+VarioSynthesiser::ApplyMailbox(int value) noexcept
+{
+  current_value = value;
+
+  if (value == MAILBOX_SILENCE)
+    ApplySilence();
+  else
+    ApplyVario(value);
+}
+
+void
+VarioSynthesiser::ApplyVario(int ivario) noexcept
+{
+  if (settings.dead_band_enabled && InDeadBand(ivario)) {
     /* inside the "dead band" */
-    UnsafeSetSilence();
+    ApplySilence();
     return;
   }
 
@@ -42,8 +78,8 @@ VarioSynthesiser::SetVario(double vario)
        periodically */
 
     const unsigned period_ms = sample_rate
-      * (min_period_ms + (max_vario - ivario)
-         * (max_period_ms - min_period_ms) / max_vario)
+      * (settings.min_period_ms + (max_vario - ivario)
+         * (settings.max_period_ms - settings.min_period_ms) / max_vario)
       / 1000;
 
     silence_count = period_ms / 3;
@@ -65,14 +101,7 @@ VarioSynthesiser::SetVario(double vario)
 }
 
 void
-VarioSynthesiser::SetSilence()
-{
-  const std::lock_guard lock{mutex};
-  UnsafeSetSilence();
-}
-
-void
-VarioSynthesiser::UnsafeSetSilence()
+VarioSynthesiser::ApplySilence() noexcept
 {
   audible_count = 0;
   silence_count = 1;
@@ -86,11 +115,18 @@ VarioSynthesiser::UnsafeSetSilence()
   silence_remaining = 0;
 }
 
-
 void
 VarioSynthesiser::Synthesise(int16_t *buffer, size_t n)
 {
-  const std::lock_guard lock{mutex};
+  const bool settings_changed = ReceiveSettings();
+
+  if (const int value = mailbox.exchange(MAILBOX_EMPTY,
+                                        std::memory_order_relaxed);
+      value != MAILBOX_EMPTY)
+    ApplyMailbox(value);
+  else if (settings_changed)
+    /* recalculate the current tone with the new settings */
+    ApplyMailbox(current_value);
 
   assert(audible_count > 0 || silence_count > 0);
 
@@ -6,120 +6,183 @@
 #include "ToneSynthesiser.hpp"
 #include "thread/Mutex.hxx"
 
+#include <atomic>
+#include <climits>
+
 /**
  * This class generates vario sound.
+ *
+ * SetVario() and SetSilence() only post the new value to a lock-free
+ * mailbox; it is picked up at the beginning of the next Synthesise()
+ * call in the audio thread.  The other setters modify
+ * #pending_settings, which Synthesise() copies to #settings unless
+ * the mutex is busy (it never waits for it).  All attributes below
+ * #settings are owned by the audio thread.
  */
 class VarioSynthesiser final : public ToneSynthesiser {
+  struct Settings {
+    bool dead_band_enabled = false;
+
+    /**
+     * The tone frequency for #min_vario.
+     */
+    unsigned min_frequency = 200;
+
+    /**
+     * The tone frequency for stationary altitude.
+     */
+    unsigned zero_frequency = 500;
+
+    /**
+     * The tone frequency for #max_vario.
+     */
+    unsigned max_frequency = 1500;
+
+    /**
+     * The minimum silence+audible period for #max_vario.
+     */
+    unsigned min_period_ms = 150;
+
+    /**
+     * The maximum silence+audible period for #min_vario.
+     */
+    unsigned max_period_ms = 600;
+
+    /**
+     * The vario range of the "dead band" during which no sound is
+     * emitted [cm/s].
+     */
+    int min_dead = -30, max_dead = 10;
+  };
+
   /**
-   * This mutex protects all atttributes below.  It is locked
-   * automatically by all public methods.
+   * Special #mailbox value: no update since the last Synthesise()
+   * call.
    */
-  Mutex mutex;
+  static constexpr int MAILBOX_EMPTY = INT_MAX;
 
   /**
-   * The number of audible samples in each period.
+   * Special #mailbox value: SetSilence() was called.
    */
-  size_t audible_count;
+  static constexpr int MAILBOX_SILENCE = INT_MIN;
 
   /**
-   * The number of silent samples in each period.  If this is zero,
-   * then no silence will be generated (continuous tone).
+   * The most recent vario value [cm/s] posted by SetVario(), or one
+   * of the special values above.
    */
-  size_t silence_count;
+  std::atomic_int mailbox = MAILBOX_EMPTY;
 
   /**
-   * The number of audible/silence samples remaining in the current
-   * period.  These two attributes will be reset to the according
-   * _count value when both reach zero.
+   * Protects #pending_settings.
    */
-  size_t audible_remaining, silence_remaining;
+  Mutex settings_mutex;
 
-  bool dead_band_enabled;
+  /**
+   * Settings written by the setters, to be applied by the next
+   * Synthesise() call.  Protected by #settings_mutex.
+   */
+  Settings pending_settings;
 
   /**
-   * The tone frequency for #min_vario.
+   * Has #pending_settings been modified since Synthesise() has copied
+   * it?
    */
-  unsigned min_frequency;
+  std::atomic_bool settings_modified = false;
 
   /**
-   * The tone frequency for stationary altitude.
+   * The settings used by the audio thread.
    */
-  unsigned zero_frequency;
+  Settings settings;
 
   /**
-   * The tone frequency for #max_vario.
+   * The last value applied from the #mailbox; it is applied again
+   * when the settings change.
    */
-  unsigned max_frequency;
+  int current_value = MAILBOX_SILENCE;
 
   /**
-   * The minimum silence+audible period for #max_vario.
+   * The number of audible samples in each period.
    */
-  unsigned min_period_ms;
+  size_t audible_count;
 
   /**
-   * The maximum silence+audible period for #min_vario.
+   * The number of silent samples in each period.  If this is zero,
+   * then no silence will be generated (continuous tone).
    */
-  unsigned max_period_ms;
+  size_t silence_count;
 
   /**
-   * The vario range of the "dead band" during which no sound is emitted
-   * [cm/s].
+   * The number of audible/silence samples remaining in the current
+   * period.  These two attributes will be reset to the according
+   * _count value when both reach zero.
    */
-  int min_dead, max_dead;
+  size_t audible_remaining, silence_remaining;
 
 public:
   explicit VarioSynthesiser(unsigned sample_rate)
     :ToneSynthesiser(sample_rate),
      audible_count(0), silence_count(1),
-     audible_remaining(0), silence_remaining(0),
-     dead_band_enabled(false),
-     min_frequency(200), zero_frequency(500), max_frequency(1500),
-     min_period_ms(150), max_period_ms(600),
-     min_dead(-30), max_dead(10) {}
+     audible_remaining(0), silence_remaining(0) {}
 
   /**
-   * Update the vario value.  This calculates a new tone frequency and
-   * a new "silence" rate (for positive vario values).
+   * Update the vario value.  The next Synthesise() call calculates a
+   * new tone frequency and a new "silence" rate (for positive vario
+   * values).  This method is thread-safe and does not block.
    *
    * @param vario the current vario value [m/s]
    */
-  void SetVario(double vario);
+  void SetVario(double vario) noexcept;
 
   /**
-   * Produce silence from now on.
+   * Produce silence from now on.  This method is thread-safe and does
+   * not block.
    */
-  void SetSilence();
+  void SetSilence() noexcept {
+    mailbox.store(MAILBOX_SILENCE, std::memory_order_relaxed);
+  }
 
   /**
-   * Enable/disable the dead band silence
+   * Enable/disable the dead band silence.  Takes effect at the next
+   * Synthesise() call.
    */
-  void SetDeadBand(bool enabled) {
-    dead_band_enabled = enabled;
+  void SetDeadBand(bool enabled) noexcept {
+    const std::lock_guard lock{settings_mutex};
+    pending_settings.dead_band_enabled = enabled;
+    settings_modified.store(true, std::memory_order_release);
   }
 
   /**
-   * Set the base frequencies for minimum, zero and maximum lift
+   * Set the base frequencies for minimum, zero and maximum lift.
+   * Takes effect at the next Synthesise() call.
    */
-  void SetFrequencies(unsigned min, unsigned zero, unsigned max) {
-    min_frequency = min;
-    zero_frequency = zero;
-    max_frequency = max;
+  void SetFrequencies(unsigned min, unsigned zero, unsigned max) noexcept {
+    const std::lock_guard lock{settings_mutex};
+    pending_settings.min_frequency = min;
+    pending_settings.zero_frequency = zero;
+    pending_settings.max_frequency = max;
+    settings_modified.store(true, std::memory_order_release);
   }
 
   /**
-   * Set the time periods for minimum and maximum lift
+   * Set the time periods for minimum and maximum lift.  Takes effect
+   * at the next Synthesise() call.
    */
-  void SetPeriods(unsigned min, unsigned max) {
-    min_period_ms = min;
-    max_period_ms = max;
+  void SetPeriods(unsigned min, unsigned max) noexcept {
+    const std::lock_guard lock{settings_mutex};
+    pending_settings.min_period_ms = min;
+    pending_settings.max_period_ms = max;
+    settings_modified.store(true, std::memory_order_release);
   }
 
   /**
-   * Set the vario range of the "dead band" during which no sound is emitted
+   * Set the vario range of the "dead band" during which no sound is
+   * emitted.  Takes effect at the next Synthesise() call.
    */
-  void SetDeadBandRange(double min, double max) {
-    min_dead = (int)(min * 100);
-    max_dead = (int)(max * 100);
+  void SetDeadBandRange(double min, double max) noexcept {
+    const std::lock_guard lock{settings_mutex};
+    pending_settings.min_dead = (int)(min * 100);
+    pending_settings.max_dead = (int)(max * 100);
+    settings_modified.store(true, std::memory_order_release);
   }
 
   /* methods from class PCMSynthesiser */
@@ -127,9 +190,29 @@ public:
 
 private:
   /**
-   * Same as SetSilence(), but doesn't lock the mutex.
+   * Copy #pending_settings to #settings if it has been modified and
+   * #settings_mutex is not busy.
+   *
+   * @return true if the settings have been updated
+   */
+  bool ReceiveSettings() noexcept;
+
+  /**
+   * Apply a value received from the #mailbox.
+   */
+  void ApplyMailbox(int value) noexcept;
+
+  /**
+   * Apply a vario value from SetVario().
+   *
+   * @param ivario the current vario value [cm/s]
+   */
+  void ApplyVario(int ivario) noexcept;
+
+  /**
+   * Apply SetSilence().
    */
-  void UnsafeSetSilence();
+  void ApplySilence() noexcept;
 
   /**
    * Convert a vario value to a tone frequency.
@@ -140,6 +223,6 @@ private:
   unsigned VarioToFrequency(int ivario);
 
   bool InDeadBand(int ivario) {
-    return ivario >= min_dead && ivario <= max_dead;
+    return ivario >= settings.min_dead && ivario <= settings.max_dead;
   }
 };
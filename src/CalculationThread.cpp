@@ -6,6 +6,7 @@
 #include "Protection.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Hardware/CPU.hpp"
+#include "Profiler/Profiler.hpp"
 
 /**
  * Constructor of the CalculationThread class
@@ -55,6 +56,8 @@ CalculationThread::SetScreenDistanceMeters(double new_value) noexcept
 void
 CalculationThread::Tick() noexcept
 {
+  const Profiler::ScopeTimer timer{Profiler::Section::CALCULATION};
+
 #ifdef HAVE_CPU_FREQUENCY
   const ScopeLockCPU cpu;
 #endif
@@ -94,6 +94,21 @@ CloudClientContainer::Insert(CloudClient &client)
   rtree.insert(client.shared_from_this());
 }
 
+void
+CloudClientContainer::Restore(const CloudClient &client)
+{
+  auto *existing = Find(client.key);
+  if (existing == nullptr) {
+    Insert(*std::make_shared<CloudClient>(client));
+
+    if (client.id >= next_id)
+      next_id = client.id + 1;
+  } else {
+    Refresh(*existing, client.address, client.location, client.altitude);
+    existing->stamp = client.stamp;
+  }
+}
+
 void
 CloudClientContainer::Remove(CloudClient &client)
 {
@@ -190,11 +205,12 @@ CloudClient::Load(Deserialiser &s)
 }
 
 void
-CloudClientContainer::Save(Serialiser &s) const
+CloudClientContainer::Save(Serialiser &s, unsigned next_id,
+                           std::span<const CloudClient> clients)
 {
   s.Write32(next_id);
 
-  for (const auto &client : list) {
+  for (const auto &client : clients) {
     s.Write8(1);
     client.Save(s);
   }
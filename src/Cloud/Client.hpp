@@ -13,6 +13,7 @@
 #include <boost/range/iterator_range_core.hpp>
 #include <memory>
 #include <chrono>
+#include <span>
 
 class Serialiser;
 class Deserialiser;
@@ -196,6 +197,10 @@ public:
     return list.empty();
   }
 
+  unsigned GetNextId() const {
+    return next_id;
+  }
+
   /**
    * For iteration over the list of all clients in unspecified order.
    * The iterators get invalidated by all modifying calls.
@@ -230,6 +235,12 @@ public:
 
   void Insert(CloudClient &client);
 
+  /**
+   * Apply a client state loaded from the journal: refresh the
+   * existing client with the same key, or insert a copy.
+   */
+  void Restore(const CloudClient &client);
+
   /**
    * Remove a #CloudClient and its data.  Be careful - the given reference
    * is invalidated, unless the caller holds another #CloudClientPtr.
@@ -244,6 +255,12 @@ public:
   [[gnu::pure]]
   query_iterator_range QueryWithinRange(GeoPoint location, double range) const;
 
-  void Save(Serialiser &s) const;
+  /**
+   * Save the given clients (e.g. a copy of this container's
+   * clients) in the format understood by Load().
+   */
+  static void Save(Serialiser &s, unsigned next_id,
+                   std::span<const CloudClient> clients);
+
   void Load(Deserialiser &s);
 };
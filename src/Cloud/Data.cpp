@@ -5,6 +5,8 @@
 #include "Dump.hpp"
 #include "Serialiser.hpp"
 #include "net/ToString.hxx"
+#include "io/FileOutputStream.hxx"
+#include "system/Path.hpp"
 
 #include <iostream>
 #include <iomanip>
@@ -14,7 +16,7 @@ using std::cerr;
 using std::endl;
 
 static constexpr uint32_t CLOUD_MAGIC = 0x5753f60f;
-static constexpr uint32_t CLOUD_VERSION = 1;
+static constexpr uint32_t CLOUD_VERSION = 2;
 
 void
 CloudData::DumpClients()
@@ -31,13 +33,37 @@ CloudData::DumpClients()
 }
 
 void
-CloudData::Save(Serialiser &s) const
+CloudData::Expire(std::chrono::steady_clock::time_point now)
+{
+  clients.Expire(now - MAX_CLIENT_AGE);
+  thermals.Expire(now - MAX_THERMAL_AGE);
+}
+
+CloudSnapshot
+CloudData::MakeSnapshot(uint32_t _generation) const
+{
+  CloudSnapshot snapshot;
+  snapshot.generation = _generation;
+  snapshot.next_client_id = clients.GetNextId();
+
+  for (const auto &client : clients)
+    snapshot.clients.push_back(client);
+
+  for (const auto &thermal : thermals)
+    snapshot.thermals.push_back(thermal.shared_from_this());
+
+  return snapshot;
+}
+
+void
+CloudSnapshot::Save(Serialiser &s) const
 {
   s.Write32(CLOUD_MAGIC);
   s.Write32(CLOUD_VERSION);
-  clients.Save(s);
+  s.Write32(generation);
+  CloudClientContainer::Save(s, next_client_id, clients);
   s.Write8(1);
-  thermals.Save(s);
+  CloudThermalContainer::Save(s, thermals);
   s.Write8(0);
 }
 
@@ -47,7 +73,13 @@ CloudData::Load(Deserialiser &s)
   if (s.Read32() != CLOUD_MAGIC)
     throw std::runtime_error("Bad magic");
 
-  if (s.Read32() != CLOUD_VERSION)
+  /* version 1 had no journal */
+  const uint32_t version = s.Read32();
+  if (version == 1)
+    generation = 0;
+  else if (version == CLOUD_VERSION)
+    generation = s.Read32();
+  else
     throw std::runtime_error("Bad version");
 
   clients.Load(s);
@@ -57,3 +89,17 @@ CloudData::Load(Deserialiser &s)
     s.Read8();
   }
 }
+
+void
+SaveCloudSnapshot(Path path, const CloudSnapshot &snapshot)
+{
+  FileOutputStream fos(path);
+
+  {
+    Serialiser s(fos);
+    snapshot.Save(s);
+    s.Flush();
+  }
+
+  fos.Commit();
+}
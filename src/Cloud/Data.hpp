@@ -6,15 +6,68 @@
 #include "Client.hpp"
 #include "Thermal.hpp"
 
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
 class Serialiser;
 class Deserialiser;
+class Path;
+
+/**
+ * Clients which have not sent anything for this long are removed.
+ */
+static constexpr std::chrono::steady_clock::duration MAX_CLIENT_AGE = std::chrono::minutes(10);
+
+static constexpr std::chrono::steady_clock::duration MAX_THERMAL_AGE = std::chrono::minutes(30);
+
+/**
+ * A copy of #CloudData which can be saved by another thread while
+ * the original is being modified.  Thermals are never modified after
+ * they have been created, so they are shared instead of copied.
+ */
+struct CloudSnapshot {
+  /**
+   * The generation of the first journal whose changes are not
+   * included in this snapshot.
+   */
+  uint32_t generation;
+
+  unsigned next_client_id;
+
+  std::vector<CloudClient> clients;
+  std::vector<std::shared_ptr<const CloudThermal>> thermals;
+
+  void Save(Serialiser &s) const;
+};
 
 struct CloudData {
   CloudClientContainer clients;
   CloudThermalContainer thermals;
 
+  /**
+   * The generation of the first journal whose changes are not
+   * included in the loaded database; see #CloudSnapshot.
+   */
+  uint32_t generation = 0;
+
   void DumpClients();
 
-  void Save(Serialiser &s) const;
+  /**
+   * Remove clients and thermals which are older than #MAX_CLIENT_AGE
+   * and #MAX_THERMAL_AGE.
+   */
+  void Expire(std::chrono::steady_clock::time_point now);
+
+  CloudSnapshot MakeSnapshot(uint32_t generation) const;
+
   void Load(Deserialiser &s);
 };
+
+/**
+ * Save a snapshot to the database file.
+ *
+ * Throws on error.
+ */
+void
+SaveCloudSnapshot(Path path, const CloudSnapshot &snapshot);
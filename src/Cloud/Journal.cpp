@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Journal.hpp"
+#include "Data.hpp"
+#include "Serialiser.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/FileReader.hxx"
+#include "io/StringOutputStream.hxx"
+#include "system/Error.hxx"
+#include "system/FileUtil.hpp"
+#include "util/SpanCast.hxx"
+
+#include <stdexcept>
+
+static constexpr uint32_t JOURNAL_MAGIC = 0x4a6e6c31;
+
+enum class JournalRecord : uint8_t {
+  HEADER = 1,
+  CLIENT = 2,
+  THERMAL = 3,
+};
+
+/**
+ * The records appended since the last CloudJournal::Take() call.
+ */
+struct CloudJournal::Buffer {
+  StringOutputStream stream;
+  Serialiser serialiser{stream};
+};
+
+CloudJournal::CloudJournal(Path db_path) noexcept
+  :path(db_path + ".journal"),
+   old_path(db_path + ".journal.old") {}
+
+CloudJournal::~CloudJournal() noexcept
+{
+  try {
+    Flush();
+    Close();
+  } catch (...) {
+  }
+}
+
+void
+CloudJournal::Close()
+{
+  if (file == nullptr)
+    return;
+
+  auto f = std::move(file);
+  f->Commit();
+}
+
+/**
+ * Append the contents of one file to another one which already
+ * exists.
+ */
+static void
+AppendFile(Path dest_path, Path src_path)
+{
+  FileReader src(src_path);
+  FileOutputStream dest(dest_path,
+                        FileOutputStream::Mode::APPEND_EXISTING);
+
+  std::byte buffer[16384];
+  std::size_t nbytes;
+  while ((nbytes = src.Read(buffer)) > 0)
+    dest.Write({buffer, nbytes});
+
+  dest.Commit();
+}
+
+void
+CloudJournal::Start(uint32_t generation)
+{
+  Close();
+
+  if (File::Exists(path)) {
+    if (File::Exists(old_path)) {
+      AppendFile(old_path, path);
+      File::Delete(path);
+    } else if (!File::Rename(path, old_path))
+      throw MakeErrno("Failed to rename journal");
+  }
+
+  file = std::make_unique<FileOutputStream>(path,
+                                            FileOutputStream::Mode::APPEND_OR_CREATE);
+
+  Serialiser s(*file);
+  s.Write8(uint8_t(JournalRecord::HEADER));
+  s.Write32(JOURNAL_MAGIC);
+  s.Write32(generation);
+  s.Flush();
+}
+
+void
+CloudJournal::DeleteOld() noexcept
+{
+  File::Delete(old_path);
+}
+
+void
+CloudJournal::Append(const CloudClient &client)
+{
+  if (buffer == nullptr)
+    buffer = std::make_unique<Buffer>();
+
+  buffer->serialiser.Write8(uint8_t(JournalRecord::CLIENT));
+  client.Save(buffer->serialiser);
+  dirty = true;
+}
+
+void
+CloudJournal::Append(const CloudThermal &thermal)
+{
+  if (buffer == nullptr)
+    buffer = std::make_unique<Buffer>();
+
+  buffer->serialiser.Write8(uint8_t(JournalRecord::THERMAL));
+  thermal.Save(buffer->serialiser);
+  dirty = true;
+}
+
+std::string
+CloudJournal::Take()
+{
+  dirty = false;
+
+  if (buffer == nullptr)
+    return {};
+
+  buffer->serialiser.Flush();
+
+  /* the next Append() creates a new buffer (and a new Serialiser
+     time base) */
+  const auto taken = std::move(buffer);
+  return std::move(taken->stream).GetValue();
+}
+
+void
+CloudJournal::Write(std::string_view records)
+{
+  if (file != nullptr && !records.empty())
+    file->Write(AsBytes(records));
+}
+
+void
+ReplayCloudJournal(Path path, CloudData &data)
+{
+  FileReader fr(path);
+  Deserialiser s(fr);
+
+  /* records before the first header are ignored */
+  bool apply = false;
+
+  while (!s.IsEOF()) {
+    switch (JournalRecord(s.Read8())) {
+    case JournalRecord::HEADER:
+      if (s.Read32() != JOURNAL_MAGIC)
+        throw std::runtime_error("Bad journal magic");
+
+      /* skip segments whose changes are already included in the
+         database */
+      apply = s.Read32() >= data.generation;
+      break;
+
+    case JournalRecord::CLIENT:
+      {
+        const auto client = CloudClient::Load(s);
+        if (apply)
+          data.clients.Restore(client);
+      }
+      break;
+
+    case JournalRecord::THERMAL:
+      {
+        auto thermal = std::make_shared<CloudThermal>(CloudThermal::Load(s));
+        if (apply)
+          data.thermals.Insert(*thermal);
+      }
+      break;
+
+    default:
+      throw std::runtime_error("Malformed journal");
+    }
+  }
+}
+
+void
+CompactCloudDatabase(Path db_path, Path journal_path, uint32_t generation)
+{
+  CloudData data;
+
+  {
+    FileReader fr(db_path);
+    Deserialiser s(fr);
+    data.Load(s);
+  }
+
+  if (File::Exists(journal_path))
+    ReplayCloudJournal(journal_path, data);
+
+  data.Expire(std::chrono::steady_clock::now());
+
+  SaveCloudSnapshot(db_path, data.MakeSnapshot(generation));
+}
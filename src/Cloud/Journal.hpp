@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "system/Path.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+class FileOutputStream;
+struct CloudClient;
+struct CloudThermal;
+struct CloudData;
+
+/**
+ * An append-only log of the changes to #CloudData since the last
+ * snapshot was saved.  Appending a record is much cheaper than
+ * saving the whole database, and replaying the journal over the last
+ * snapshot restores the most recent state after a crash.
+ *
+ * The journal consists of segments, each beginning with a header
+ * containing a generation number.  Start() begins a new generation:
+ * the current journal file is moved to the "old" journal, and a
+ * snapshot carrying the new generation number can be saved.  Once
+ * that snapshot has been committed, the old journal is obsolete and
+ * may be deleted.
+ *
+ * Records are appended to a memory buffer.  Take() detaches it
+ * cheaply, and Write() writes it to the file; this way, the lock
+ * which serialises Append() calls does not need to be held during
+ * disk I/O.  Write(), Start() and DeleteOld() access only the files,
+ * and must not be called concurrently with each other.
+ */
+class CloudJournal {
+  const AllocatedPath path, old_path;
+
+  std::unique_ptr<FileOutputStream> file;
+
+  struct Buffer;
+  std::unique_ptr<Buffer> buffer;
+
+  /**
+   * Have records been appended since the last Take() call?
+   */
+  bool dirty = false;
+
+public:
+  explicit CloudJournal(Path db_path) noexcept;
+  ~CloudJournal() noexcept;
+
+  CloudJournal(const CloudJournal &) = delete;
+  CloudJournal &operator=(const CloudJournal &) = delete;
+
+  Path GetPath() const noexcept {
+    return path;
+  }
+
+  Path GetOldPath() const noexcept {
+    return old_path;
+  }
+
+  bool IsDirty() const noexcept {
+    return dirty;
+  }
+
+  /**
+   * Close the current journal file, move its contents to the old
+   * journal and open a new journal file for the given generation.
+   * If the old journal still exists (because the previous snapshot
+   * has not been committed), the current one is appended to it.
+   *
+   * Records which have not been taken yet are not touched; they will
+   * be written to the new journal.
+   *
+   * Throws on error.
+   */
+  void Start(uint32_t generation);
+
+  /**
+   * Delete the old journal after the snapshot which includes its
+   * changes has been committed.
+   */
+  void DeleteOld() noexcept;
+
+  /**
+   * Throws on error.
+   */
+  void Append(const CloudClient &client);
+
+  /**
+   * Throws on error.
+   */
+  void Append(const CloudThermal &thermal);
+
+  /**
+   * Detach the records appended since the last call, to be passed to
+   * Write().  This only swaps buffers, and is meant to be called
+   * while the lock which protects Append() is held.
+   *
+   * Throws on error.
+   */
+  std::string Take();
+
+  /**
+   * Write records obtained from Take() to the current journal file.
+   * They are discarded if no journal has been started.
+   *
+   * Throws on error.
+   */
+  void Write(std::string_view records);
+
+  /**
+   * Write all buffered records to the file.  This is Take() and
+   * Write() for callers which don't share the journal with other
+   * threads.
+   *
+   * Throws on error.
+   */
+  void Flush() {
+    Write(Take());
+  }
+
+private:
+  void Close();
+};
+
+/**
+ * Apply the records of all journal segments which are not older
+ * than CloudData::generation.
+ *
+ * Throws on error (e.g. a record truncated by a crash); the records
+ * before the error have been applied.
+ */
+void
+ReplayCloudJournal(Path path, CloudData &data);
+
+/**
+ * Build a new snapshot from the database file and the given journal,
+ * and save it with the given generation.  Clients and thermals which
+ * have expired are dropped (see CloudData::Expire()).
+ *
+ * Unlike the server at startup, this does not tolerate errors:
+ * saving the snapshot would lose the records which could not be
+ * read.
+ *
+ * Throws on error.
+ */
+void
+CompactCloudDatabase(Path db_path, Path journal_path, uint32_t generation);
@@ -3,6 +3,8 @@
 
 #include "Data.hpp"
 #include "Dump.hpp"
+#include "Journal.hpp"
+#include "SaveThread.hpp"
 #include "Sender.hpp"
 #include "Serialiser.hpp"
 #include "Tracking/SkyLines/Server.hpp"
@@ -11,17 +13,27 @@
 #include "event/Loop.hxx"
 #include "event/CoarseTimerEvent.hxx"
 #include "event/SignalMonitor.hxx"
+#include "thread/SharedMutex.hpp"
+#include "thread/Thread.hpp"
 #include "net/IPv4Address.hxx"
-#include "io/FileOutputStream.hxx"
 #include "io/FileReader.hxx"
+#include "system/FileUtil.hpp"
 #include "util/PrintException.hxx"
 #include "util/Exception.hxx"
 #include "util/Compiler.h"
 #include "util/ScopeExit.hxx"
+#include "util/StaticArray.hxx"
 
 #include <array>
+#include <cstdlib>
+#include <forward_list>
 #include <iostream>
 #include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <signal.h>
 
@@ -30,28 +42,90 @@ static constexpr double TRAFFIC_RANGE = 50000;
 static constexpr double THERMAL_RANGE = 50000;
 
 static constexpr std::chrono::steady_clock::duration MAX_TRAFFIC_AGE = std::chrono::minutes(15);
-static constexpr std::chrono::steady_clock::duration MAX_THERMAL_AGE = std::chrono::minutes(30);
 
 static constexpr std::chrono::steady_clock::duration REQUEST_EXPIRY = std::chrono::minutes(5);
 
+/**
+ * A traffic/thermal request renews #REQUEST_EXPIRY only if it was
+ * renewed longer ago than this.  This way, most requests need only a
+ * shared lock.
+ */
+static constexpr std::chrono::steady_clock::duration REQUEST_REFRESH = std::chrono::minutes(1);
+
+/**
+ * The maximum number of items in one traffic/thermal response.
+ */
+static constexpr std::size_t MAX_TRAFFIC = 64;
+static constexpr std::size_t MAX_THERMALS = 256;
+
 using std::cout;
 using std::cerr;
 using std::endl;
 
-class CloudServer final
-  : public SkyLinesTracking::Server, CloudData
+/**
+ * Write one complete log line (including the newline) with a single
+ * call.  The datagram handlers run in several #CloudListener threads,
+ * and a line inserted piece by piece would interleave with theirs.
+ */
+static void
+WriteLine(std::ostream &stream, const std::ostringstream &line)
 {
+  stream << line.str() << std::flush;
+}
+
+/**
+ * The shared state of the cloud server.  The datagram handlers are
+ * called by #CloudListener instances, which may run in different
+ * threads; they all lock the #mutex, exclusively only if they modify
+ * the data.  Responses are assembled while the lock is held, and
+ * sent (and logged) after it has been released.  Timers and signal
+ * handlers run in the main #EventLoop.
+ */
+class CloudServer final : CloudData {
+  EventLoop &event_loop;
+
   const AllocatedPath db_path;
 
-  CoarseTimerEvent save_timer, expire_timer;
+  /**
+   * Protects #CloudData and the records buffered by the #journal.
+   * The journal files are accessed only by the main thread, without
+   * the lock.
+   */
+  SharedMutex mutex;
+
+  /**
+   * The destination of a response which is sent after the #mutex has
+   * been released.
+   */
+  struct Recipient {
+    StaticSocketAddress address;
+    uint64_t key;
+  };
+
+  /**
+   * Logs all changes since the last snapshot.
+   */
+  CloudJournal journal;
+
+  /**
+   * Saves a snapshot of the data in background.
+   */
+  CloudSaveThread save_thread;
+
+  CoarseTimerEvent save_timer, expire_timer, flush_timer;
 
 public:
-  CloudServer(AllocatedPath &&_db_path, EventLoop &event_loop,
-              SocketAddress bind_address)
-    :SkyLinesTracking::Server(event_loop, bind_address),
+  using Client = SkyLinesTracking::Server::Client;
+
+  CloudServer(AllocatedPath &&_db_path, EventLoop &_event_loop)
+    :event_loop(_event_loop),
      db_path(std::move(_db_path)),
+     journal(db_path),
+     save_thread(event_loop, db_path, journal.GetOldPath(),
+                 BIND_THIS_METHOD(OnSaveDone)),
      save_timer(event_loop, BIND_THIS_METHOD(OnSaveTimer)),
-     expire_timer(event_loop, BIND_THIS_METHOD(OnExpireTimer))
+     expire_timer(event_loop, BIND_THIS_METHOD(OnExpireTimer)),
+     flush_timer(event_loop, BIND_THIS_METHOD(OnFlushTimer))
   {
 #ifndef _WIN32
     SignalMonitorRegister(SIGINT, BIND_THIS_METHOD(OnQuitSignal));
@@ -63,14 +137,79 @@ public:
 #endif
 
     ScheduleSave();
+    ScheduleExpire();
+    ScheduleFlush();
   }
 
+  EventLoop &GetEventLoop() const noexcept {
+    return event_loop;
+  }
+
+  /**
+   * Load the database and replay the journal.
+   */
   void Load();
+
+  /**
+   * Save a snapshot synchronously and start a new journal.  This
+   * copies the data while holding the lock; it is meant for startup
+   * and shutdown, when no worker thread runs.
+   */
   void Save();
 
+  /**
+   * Start saving a snapshot in background and start a new journal.
+   */
+  void StartSave() noexcept;
+
+  /* datagram handlers called by CloudListener; responses are sent
+     through the given server */
+
+  void OnFix(SkyLinesTracking::Server &server, const Client &client,
+             std::chrono::milliseconds time_of_day,
+             const ::GeoPoint &location, int altitude) noexcept;
+
+  void OnTrafficRequest(SkyLinesTracking::Server &server,
+                        const Client &client, bool near) noexcept;
+
+  void OnWaveSubmit(const Client &client,
+                    std::chrono::milliseconds time_of_day,
+                    const ::GeoPoint &a, const ::GeoPoint &b,
+                    int bottom_altitude,
+                    int top_altitude,
+                    double lift) noexcept;
+
+  void OnThermalSubmit(SkyLinesTracking::Server &server,
+                       const Client &client,
+                       std::chrono::milliseconds time_of_day,
+                       const ::GeoPoint &bottom_location,
+                       int bottom_altitude,
+                       const ::GeoPoint &top_location,
+                       int top_altitude,
+                       double lift) noexcept;
+
+  void OnThermalRequest(SkyLinesTracking::Server &server,
+                        const Client &client) noexcept;
+
 private:
+  /**
+   * Shall a request renew the given expiry time?
+   */
+  static bool NeedsRequestRefresh(std::chrono::steady_clock::time_point expiry,
+                                  std::chrono::steady_clock::time_point now) noexcept;
+
+  /**
+   * Start a new journal generation.  The lock is held only while the
+   * buffered records are taken and the generation is incremented.
+   *
+   * @return the new generation
+   */
+  uint32_t Compact();
+
+  void OnSaveDone(std::exception_ptr error) noexcept;
+
   void OnSaveTimer() noexcept {
-    Save();
+    StartSave();
     ScheduleSave();
   }
 
@@ -78,31 +217,135 @@ private:
     save_timer.Schedule(std::chrono::minutes(1));
   }
 
+  /* the expire and flush timers are periodic, because the datagram
+     handlers (which may run in other threads) must not schedule
+     them */
+
   void OnExpireTimer() noexcept {
-    clients.Expire(GetEventLoop().SteadyNow() - std::chrono::minutes(10));
-    if (!clients.empty())
-      ScheduleExpire();
+    const auto now = GetEventLoop().SteadyNow();
+
+    {
+      const std::lock_guard lock{mutex};
+      Expire(now);
+    }
+
+    ScheduleExpire();
   }
 
   void ScheduleExpire() {
     expire_timer.Schedule(std::chrono::minutes(5));
   }
 
+  /**
+   * Caller must lock the mutex.
+   */
+  template<typename T>
+  void Journal(const T &item) noexcept {
+    try {
+      journal.Append(item);
+    } catch (...) {
+      cerr << "Failed to write journal: "
+           << GetFullMessage(std::current_exception()) << endl;
+    }
+  }
+
+  /**
+   * Detach the records appended to the journal, to be written with
+   * WriteJournal() after the mutex has been released.
+   *
+   * Caller must lock the mutex.
+   */
+  std::string TakeJournal() noexcept {
+    try {
+      return journal.Take();
+    } catch (...) {
+      cerr << "Failed to write journal: "
+           << GetFullMessage(std::current_exception()) << endl;
+      return {};
+    }
+  }
+
+  /**
+   * Must be called in the main thread.
+   */
+  void WriteJournal(std::string_view records) noexcept {
+    try {
+      journal.Write(records);
+    } catch (...) {
+      cerr << "Failed to write journal: "
+           << GetFullMessage(std::current_exception()) << endl;
+    }
+  }
+
+  void OnFlushTimer() noexcept {
+    std::string records;
+
+    {
+      const std::lock_guard lock{mutex};
+      if (journal.IsDirty())
+        records = TakeJournal();
+    }
+
+    WriteJournal(records);
+
+    ScheduleFlush();
+  }
+
+  void ScheduleFlush() {
+    flush_timer.Schedule(std::chrono::seconds(1));
+  }
+
+#ifndef _WIN32
+  void OnQuitSignal() noexcept {
+    GetEventLoop().Break();
+  }
+
+  void OnReloadSignal() noexcept {
+    StartSave();
+  }
+
+  void OnDumpSignal() noexcept {
+    const std::lock_guard lock{mutex};
+    DumpClients();
+  }
+#endif
+};
+
+/**
+ * Receives datagrams on one socket and passes them to the
+ * #CloudServer.
+ */
+class CloudListener final : public SkyLinesTracking::Server {
+  CloudServer &cloud;
+
+public:
+  CloudListener(EventLoop &event_loop, SocketAddress bind_address,
+                bool reuse_port, CloudServer &_cloud)
+    :SkyLinesTracking::Server(event_loop, bind_address, reuse_port),
+     cloud(_cloud) {}
+
 protected:
   /* virtual methods from class SkyLinesTracking::Server */
   void OnFix(const Client &client,
              std::chrono::milliseconds time_of_day,
-             const ::GeoPoint &location, int altitude) override;
+             const ::GeoPoint &location, int altitude) override {
+    cloud.OnFix(*this, client, time_of_day, location, altitude);
+  }
 
   void OnTrafficRequest(const Client &client,
-                        bool near) override;
+                        bool near) override {
+    cloud.OnTrafficRequest(*this, client, near);
+  }
 
   void OnWaveSubmit(const Client &client,
                     std::chrono::milliseconds time_of_day,
                     const ::GeoPoint &a, const ::GeoPoint &b,
                     int bottom_altitude,
                     int top_altitude,
-                    double lift) override;
+                    double lift) override {
+    cloud.OnWaveSubmit(client, time_of_day, a, b,
+                       bottom_altitude, top_altitude, lift);
+  }
 
   void OnThermalSubmit(const Client &client,
                        std::chrono::milliseconds time_of_day,
@@ -110,124 +353,212 @@ protected:
                        int bottom_altitude,
                        const ::GeoPoint &top_location,
                        int top_altitude,
-                       double lift) override;
+                       double lift) override {
+    cloud.OnThermalSubmit(*this, client, time_of_day,
+                          bottom_location, bottom_altitude,
+                          top_location, top_altitude, lift);
+  }
 
-  void OnThermalRequest(const Client &client) override;
+  void OnThermalRequest(const Client &client) override {
+    cloud.OnThermalRequest(*this, client);
+  }
 
   void OnSendError(SocketAddress address,
                    std::exception_ptr e) noexcept override {
-    cerr << "Failed to send to " << address
+    std::ostringstream line;
+    line << "Failed to send to " << address
          << ": " << GetFullMessage(e)
-         << endl;
+         << '\n';
+    WriteLine(cerr, line);
   }
 
   void OnError(std::exception_ptr e) override {
-    cerr << GetFullMessage(e) << endl;
-    GetEventLoop().Break();
+    std::ostringstream line;
+    line << GetFullMessage(e) << '\n';
+    WriteLine(cerr, line);
+
+    /* this may be called in a worker thread */
+    cloud.GetEventLoop().InjectBreak();
   }
+};
 
-#ifndef _WIN32
-  void OnQuitSignal() noexcept {
-    GetEventLoop().Break();
+/**
+ * A thread with its own #EventLoop and #CloudListener.  All
+ * listeners bind the same port with SO_REUSEPORT, and the kernel
+ * distributes the incoming datagrams among them.
+ */
+class CloudWorker final : Thread {
+  /* not alive until the thread runs it */
+  EventLoop event_loop{ThreadId::Null()};
+
+  CloudListener listener;
+
+public:
+  CloudWorker(SocketAddress bind_address, CloudServer &cloud)
+    :Thread("CloudWorker"),
+     listener(event_loop, bind_address, true, cloud)
+  {
+    Start();
   }
 
-  void OnReloadSignal() noexcept {
-    Save();
+  ~CloudWorker() noexcept {
+    event_loop.InjectBreak();
+    Join();
   }
 
-  void OnDumpSignal() noexcept {
-    DumpClients();
+private:
+  /* virtual methods from class Thread */
+  void Run() noexcept override {
+    event_loop.SetAlive(true);
+    event_loop.Run();
+
+    /* allow destructing the listener in the main thread */
+    event_loop.SetAlive(false);
   }
-#endif
 };
 
 void
-CloudServer::OnFix(const Client &c,
+CloudServer::OnFix(SkyLinesTracking::Server &server, const Client &c,
                    std::chrono::milliseconds time_of_day,
-                   const ::GeoPoint &location, int altitude)
+                   const ::GeoPoint &location, int altitude) noexcept
 {
   (void)time_of_day; // TODO: use this parameter
 
-  CloudClient *client;
-  if (location.IsValid()) {
-    bool was_empty = clients.empty();
-
-    client = &clients.Make(c.address, c.key, location, altitude);
-
-    cout << "FIX\t"
-         << client->address << '\t'
-         << std::hex << client->key << std::dec << '\t'
-         << client->id << '\t'
-         << client->location << '\t'
-         << client->altitude << 'm'
-         << endl;
-
-    if (was_empty)
-      ScheduleExpire();
-  } else {
-    client = clients.Find(c.key);
-    if (client != nullptr)
+  /* a copy of the client, for sending and logging after the lock
+     has been released */
+  StaticSocketAddress address;
+  unsigned id;
+  ::GeoPoint client_location;
+  int client_altitude;
+
+  std::vector<Recipient> recipients;
+
+  {
+    const std::lock_guard lock{mutex};
+
+    CloudClient *client;
+    if (location.IsValid()) {
+      client = &clients.Make(c.address, c.key, location, altitude);
+      Journal(*client);
+    } else {
+      client = clients.Find(c.key);
+      if (client == nullptr)
+        return;
+
       clients.Refresh(*client, c.address);
+      Journal(*client);
+    }
+
+    address = client->address;
+    id = client->id;
+    client_location = client->location;
+    client_altitude = client->altitude;
+
+    /* collect the clients which are interested in this new traffic
+       location */
+    const auto now = std::chrono::steady_clock::now();
+    for (const auto &i : clients.QueryWithinRange(client_location,
+                                                  TRAFFIC_RANGE)) {
+      if (i->key == c.key)
+        /* ignore this client's own submissions - he knows them
+           already */
+        continue;
+
+      if (now > i->wants_traffic)
+        /* not interested (anymore) */
+        continue;
+
+      recipients.push_back({StaticSocketAddress(i->address), i->key});
+    }
   }
 
-  /* send this new traffic location to all interested clients
-     immediately */
-  const auto now = std::chrono::steady_clock::now();
-  for (const auto &i : clients.QueryWithinRange(location, TRAFFIC_RANGE)) {
-    if (i->key == c.key)
-      /* ignore this client's own submissions - he knows them
-         already */
-      continue;
-
-    if (now > i->wants_traffic)
-      /* not interested (anymore) */
-      continue;
+  if (location.IsValid()) {
+    std::ostringstream line;
+    line << "FIX\t"
+         << SocketAddress{address} << '\t'
+         << std::hex << c.key << std::dec << '\t'
+         << id << '\t'
+         << client_location << '\t'
+         << client_altitude << "m\n";
+    WriteLine(cout, line);
+  }
 
-    TrafficResponseSender s(*this, i->address, i->key);
-    s.Add(client->id, 0, //TODO: time?
-          client->location, client->altitude);
+  /* send it to them immediately */
+  for (const auto &i : recipients) {
+    TrafficResponseSender s(server, i.address, i.key);
+    s.Add(id, 0, //TODO: time?
+          client_location, client_altitude);
     s.Flush();
   }
 }
 
+bool
+CloudServer::NeedsRequestRefresh(std::chrono::steady_clock::time_point expiry,
+                                 std::chrono::steady_clock::time_point now) noexcept
+{
+  return expiry < now + REQUEST_EXPIRY - REQUEST_REFRESH;
+}
+
 void
-CloudServer::OnTrafficRequest(const Client &c, bool near)
+CloudServer::OnTrafficRequest(SkyLinesTracking::Server &server,
+                              const Client &c, bool near) noexcept
 {
   if (!near)
     /* "near" is the only selection flag we know */
     return;
 
-  auto *client = clients.Find(c.key);
-  if (client == nullptr)
-    /* we don't send our data to clients who didn't sent anything to
-       us yet */
-    return;
-
   const auto now = std::chrono::steady_clock::now();
-
-  client->wants_traffic = now + REQUEST_EXPIRY;
-
   const auto min_stamp = now - MAX_TRAFFIC_AGE;
 
-  TrafficResponseSender s(*this, c.address, c.key);
+  struct Traffic {
+    unsigned id;
+    ::GeoPoint location;
+    int altitude;
+  };
 
-  unsigned n = 0;
-  for (const auto &traffic : clients.QueryWithinRange(client->location,
-                                                      TRAFFIC_RANGE)) {
-    if (traffic.get() == client)
-      continue;
-
-    if (traffic->stamp < min_stamp)
-      /* don't send stale traffic, it's probably not there anymore */
-      continue;
+  StaticArray<Traffic, MAX_TRAFFIC> traffic;
+  bool refresh;
 
-    s.Add(traffic->id, 0, //TODO: time?
-          traffic->location, traffic->altitude);
+  {
+    /* this is a read-only query, which may run in all threads at
+       the same time */
+    const std::shared_lock lock{mutex};
+
+    const auto *client = clients.Find(c.key);
+    if (client == nullptr)
+      /* we don't send our data to clients who didn't sent anything to
+         us yet */
+      return;
+
+    refresh = NeedsRequestRefresh(client->wants_traffic, now);
+
+    for (const auto &i : clients.QueryWithinRange(client->location,
+                                                  TRAFFIC_RANGE)) {
+      if (i.get() == client)
+        continue;
+
+      if (i->stamp < min_stamp)
+        /* don't send stale traffic, it's probably not there anymore */
+        continue;
+
+      traffic.append({i->id, i->location, i->altitude});
+      if (traffic.full())
+        break;
+    }
+  }
 
-    if (++n > 64)
-      break;
+  if (refresh) {
+    /* the exclusive lock is needed only about once per minute and
+       client */
+    const std::lock_guard lock{mutex};
+    if (auto *client = clients.Find(c.key))
+      client->wants_traffic = now + REQUEST_EXPIRY;
   }
 
+  TrafficResponseSender s(server, c.address, c.key);
+  for (const auto &i : traffic)
+    s.Add(i.id, 0, //TODO: time?
+          i.location, i.altitude);
   s.Flush();
 }
 
@@ -237,161 +568,301 @@ CloudServer::OnWaveSubmit(const Client &c,
                           const ::GeoPoint &a, const ::GeoPoint &b,
                           int bottom_altitude,
                           int top_altitude,
-                          double lift)
+                          double lift) noexcept
 {
-  auto *client = clients.Find(c.key);
-  if (client == nullptr)
-    /* we don't trust the client if he didn't sent anything to us
-       yet */
-    return;
+  StaticSocketAddress address;
+  unsigned id;
+
+  {
+    const std::shared_lock lock{mutex};
+
+    const auto *client = clients.Find(c.key);
+    if (client == nullptr)
+      /* we don't trust the client if he didn't sent anything to us
+         yet */
+      return;
 
-  cout << "WAVE\t"
-       << client->address << '\t'
-       << std::hex << client->key << std::dec << '\t'
-       << client->id << '\t'
+    address = client->address;
+    id = client->id;
+  }
+
+  std::ostringstream line;
+  line << "WAVE\t"
+       << SocketAddress{address} << '\t'
+       << std::hex << c.key << std::dec << '\t'
+       << id << '\t'
        << a << '\t'
        << b << '\t'
        << bottom_altitude << '-' << top_altitude << "m\t"
-       << lift << "m/s"
-       << endl;
+       << lift << "m/s\n";
+  WriteLine(cout, line);
 }
 
 void
-CloudServer::OnThermalSubmit(const Client &c,
+CloudServer::OnThermalSubmit(SkyLinesTracking::Server &server,
+                             const Client &c,
                              [[maybe_unused]] std::chrono::milliseconds time_of_day,
                              const ::GeoPoint &bottom_location,
                              int bottom_altitude,
                              const ::GeoPoint &top_location,
                              int top_altitude,
-                             double lift)
+                             double lift) noexcept
 {
-  auto *client = clients.Find(c.key);
-  if (client == nullptr)
-    /* we don't trust the client if he didn't sent anything to us
-       yet */
-    return;
-
-  cout << "THERMAL\t"
-       << client->address << '\t'
-       << std::hex << client->key << std::dec << '\t'
-       << client->id << '\t'
-       << top_location << '\t'
-       << bottom_altitude << '-' << top_altitude << "m\t"
-       << lift << "m/s"
-       << endl;
+  StaticSocketAddress address;
+  unsigned id;
+  SkyLinesTracking::Thermal packed;
 
-  const auto &thermal =
-    thermals.Make(c.key,
-                  AGeoPoint(bottom_location, bottom_altitude),
-                  AGeoPoint(top_location, top_altitude),
-                  lift);
+  std::vector<Recipient> recipients;
 
-  /* send this new thermal to all interested clients immediately */
-  const auto now = std::chrono::steady_clock::now();
-  for (const auto &i : clients.QueryWithinRange(bottom_location,
-                                                THERMAL_RANGE)) {
-    if (i->key == c.key)
-      /* ignore this client's own submissions - he knows them
-         already */
-      continue;
+  {
+    const std::lock_guard lock{mutex};
+
+    const auto *client = clients.Find(c.key);
+    if (client == nullptr)
+      /* we don't trust the client if he didn't sent anything to us
+         yet */
+      return;
+
+    address = client->address;
+    id = client->id;
+
+    const auto &thermal =
+      thermals.Make(c.key,
+                    AGeoPoint(bottom_location, bottom_altitude),
+                    AGeoPoint(top_location, top_altitude),
+                    lift);
+    Journal(thermal);
+    packed = thermal.Pack();
+
+    /* collect the clients which are interested in this new
+       thermal */
+    const auto now = std::chrono::steady_clock::now();
+    for (const auto &i : clients.QueryWithinRange(bottom_location,
+                                                  THERMAL_RANGE)) {
+      if (i->key == c.key)
+        /* ignore this client's own submissions - he knows them
+           already */
+        continue;
+
+      if (now > i->wants_thermals)
+        /* not interested (anymore) */
+        continue;
+
+      recipients.push_back({StaticSocketAddress(i->address), i->key});
+    }
+  }
 
-    if (now > i->wants_thermals)
-      /* not interested (anymore) */
-      continue;
+  std::ostringstream line;
+  line << "THERMAL\t"
+       << SocketAddress{address} << '\t'
+       << std::hex << c.key << std::dec << '\t'
+       << id << '\t'
+       << top_location << '\t'
+       << bottom_altitude << '-' << top_altitude << "m\t"
+       << lift << "m/s\n";
+  WriteLine(cout, line);
 
-    ThermalResponseSender s(*this, i->address, i->key);
-    s.Add(thermal.Pack());
+  /* send it to them immediately */
+  for (const auto &i : recipients) {
+    ThermalResponseSender s(server, i.address, i.key);
+    s.Add(packed);
     s.Flush();
   }
 }
 
 void
-CloudServer::OnThermalRequest(const Client &c)
+CloudServer::OnThermalRequest(SkyLinesTracking::Server &server,
+                              const Client &c) noexcept
 {
-  auto *client = clients.Find(c.key);
-  if (client == nullptr)
-    /* we don't send our data to clients who didn't sent anything to
-       us yet */
-    return;
-
   const auto now = std::chrono::steady_clock::now();
-
-  client->wants_thermals = now + REQUEST_EXPIRY;
-
   const auto min_time = now - MAX_THERMAL_AGE;
 
-  ThermalResponseSender s(*this, c.address, c.key);
+  StaticArray<SkyLinesTracking::Thermal, MAX_THERMALS> result;
+  bool refresh;
 
-  unsigned n = 0;
-  for (const auto &thermal : thermals.QueryWithinRange(client->location,
-                                                       THERMAL_RANGE)) {
-    if (thermal->client_key == c.key)
-      /* ignore this client's own submissions - he knows them
-         already */
-      continue;
-
-    if (thermal->time < min_time)
-      /* don't send old thermals, they're useless */
-      continue;
-
-    s.Add(thermal->Pack());
+  {
+    /* this is a read-only query, which may run in all threads at
+       the same time */
+    const std::shared_lock lock{mutex};
+
+    const auto *client = clients.Find(c.key);
+    if (client == nullptr)
+      /* we don't send our data to clients who didn't sent anything to
+         us yet */
+      return;
+
+    refresh = NeedsRequestRefresh(client->wants_thermals, now);
+
+    for (const auto &thermal : thermals.QueryWithinRange(client->location,
+                                                         THERMAL_RANGE)) {
+      if (thermal->client_key == c.key)
+        /* ignore this client's own submissions - he knows them
+           already */
+        continue;
+
+      if (thermal->time < min_time)
+        /* don't send old thermals, they're useless */
+        continue;
+
+      result.append(thermal->Pack());
+      if (result.full())
+        break;
+    }
+  }
 
-    if (++n > 256)
-      break;
+  if (refresh) {
+    const std::lock_guard lock{mutex};
+    if (auto *client = clients.Find(c.key))
+      client->wants_thermals = now + REQUEST_EXPIRY;
   }
 
+  ThermalResponseSender s(server, c.address, c.key);
+  for (const auto &i : result)
+    s.Add(i);
   s.Flush();
 }
 
 void
 CloudServer::Load()
 {
-  FileReader fr(db_path);
-  Deserialiser s(fr);
-  CloudData::Load(s);
+  try {
+    FileReader fr(db_path);
+    Deserialiser s(fr);
+    CloudData::Load(s);
+  } catch (const std::runtime_error &e) {
+    cerr << "Failed to load database" << endl;
+    PrintException(e);
+  }
+
+  for (const Path path : {journal.GetOldPath(), journal.GetPath()}) {
+    if (!File::Exists(path))
+      continue;
+
+    try {
+      ReplayCloudJournal(path, *this);
+    } catch (const std::runtime_error &e) {
+      /* probably truncated by a crash; the records before the
+         error have been applied */
+      cerr << "Failed to replay journal " << path.c_str() << endl;
+      PrintException(e);
+    }
+  }
+}
+
+uint32_t
+CloudServer::Compact()
+{
+  std::string records;
+  uint32_t new_generation;
+
+  {
+    const std::lock_guard lock{mutex};
+    records = TakeJournal();
+
+    /* all changes until now go to the old journal and will be
+       included in the snapshot; the following ones go to the new
+       generation */
+    new_generation = ++generation;
+  }
+
+  WriteJournal(records);
+  journal.Start(new_generation);
+
+  return new_generation;
 }
 
 void
 CloudServer::Save()
 {
+  save_thread.Wait();
+
   cout << "Saving data to " << db_path.c_str() << endl;
 
-  FileOutputStream fos(db_path);
+  const uint32_t new_generation = Compact();
 
   {
-    Serialiser s(fos);
-    CloudData::Save(s);
-    s.Flush();
+    /* this may include changes of the new generation; replaying
+       them over the snapshot is harmless */
+    const std::shared_lock lock{mutex};
+    SaveCloudSnapshot(db_path, MakeSnapshot(new_generation));
+  }
+
+  journal.DeleteOld();
+}
+
+void
+CloudServer::StartSave() noexcept
+{
+  if (save_thread.IsBusy())
+    /* the previous snapshot is still being saved */
+    return;
+
+  cout << "Saving data to " << db_path.c_str() << endl;
+
+  try {
+    save_thread.Save(Compact());
+  } catch (...) {
+    cerr << "Failed to save data: "
+         << GetFullMessage(std::current_exception()) << endl;
+  }
+}
+
+void
+CloudServer::OnSaveDone(std::exception_ptr error) noexcept
+{
+  if (error) {
+    /* keep the old journal; it will be merged into the next one */
+    cerr << "Failed to save data: " << GetFullMessage(error) << endl;
+    return;
   }
 
-  fos.Commit();
+  journal.DeleteOld();
 }
 
 int
 main(int argc, char **argv)
 try {
-  if (argc != 2) {
-    cerr << "Usage: " << argv[0] << " DBPATH" << endl;
+  if (argc < 2 || argc > 3) {
+    cerr << "Usage: " << argv[0] << " DBPATH [THREADS]" << endl;
     return EXIT_FAILURE;
   }
 
   const Path db_path(argv[1]);
 
+  unsigned n_threads = 1;
+  if (argc > 2) {
+    char *endptr;
+    n_threads = strtoul(argv[2], &endptr, 10);
+    if (endptr == argv[2] || *endptr != 0 || n_threads < 1) {
+      cerr << "Invalid number of threads" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   EventLoop event_loop;
   SignalMonitorInit(event_loop);
   AtScopeExit() { SignalMonitorFinish(); };
 
-  CloudServer server(db_path, event_loop,
-                     IPv4Address(CloudServer::GetDefaultPort()));
+  CloudServer server(db_path, event_loop);
 
-  try {
-    server.Load();
-  } catch (const std::runtime_error &e) {
-    cerr << "Failed to load database" << endl;
-    PrintException(e);
-  }
+  server.Load();
+
+  /* fold the replayed journal into a new snapshot */
+  server.Save();
 
-  event_loop.Run();
+  const IPv4Address bind_address(SkyLinesTracking::Server::GetDefaultPort());
+
+  /* the main thread receives, too; with more than one thread, all
+     sockets bind the same port with SO_REUSEPORT */
+  CloudListener listener(event_loop, bind_address, n_threads > 1, server);
+
+  {
+    std::forward_list<CloudWorker> workers;
+    for (unsigned i = 1; i < n_threads; ++i)
+      workers.emplace_front(bind_address, server);
+
+    event_loop.Run();
+  }
 
   server.Save();
 
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "SaveThread.hpp"
+#include "Journal.hpp"
+
+#include <cassert>
+
+void
+CloudSaveThread::Save(uint32_t _generation)
+{
+  assert(!IsBusy());
+
+  generation = _generation;
+  error = {};
+  Start();
+}
+
+void
+CloudSaveThread::Wait() noexcept
+{
+  if (!IsDefined())
+    return;
+
+  Join();
+  done_event.Cancel();
+  OnDone();
+}
+
+void
+CloudSaveThread::OnDone() noexcept
+{
+  if (IsDefined())
+    Join();
+
+  callback(std::exchange(error, {}));
+}
+
+void
+CloudSaveThread::Run() noexcept
+{
+  try {
+    CompactCloudDatabase(path, journal_path, generation);
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  done_event.Schedule();
+}
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "thread/Thread.hpp"
+#include "event/InjectEvent.hxx"
+#include "system/Path.hpp"
+#include "util/BindMethod.hxx"
+
+#include <cstdint>
+#include <exception>
+
+/**
+ * Folds the old journal into the database file in a separate thread
+ * (see CompactCloudDatabase()).  This builds the new snapshot from
+ * the files only, so neither copying the data nor disk I/O needs the
+ * lock which protects the server's #CloudData.
+ */
+class CloudSaveThread final : Thread {
+  const AllocatedPath path, journal_path;
+
+  InjectEvent done_event;
+
+  using Callback = BoundMethod<void(std::exception_ptr error) noexcept>;
+  const Callback callback;
+
+  uint32_t generation;
+
+  std::exception_ptr error;
+
+public:
+  CloudSaveThread(EventLoop &event_loop, Path _path, Path _journal_path,
+                  Callback _callback) noexcept
+    :Thread("CloudSave"), path(_path), journal_path(_journal_path),
+     done_event(event_loop, BIND_THIS_METHOD(OnDone)),
+     callback(_callback) {}
+
+  ~CloudSaveThread() noexcept {
+    if (IsDefined())
+      Join();
+  }
+
+  bool IsBusy() const noexcept {
+    return IsDefined();
+  }
+
+  /**
+   * Start saving a snapshot of the given generation.  The old journal
+   * must be complete and must not be modified until the callback has
+   * been invoked in the event loop thread.  Must not be called while
+   * busy.
+   *
+   * Throws on error.
+   */
+  void Save(uint32_t _generation);
+
+  /**
+   * Wait for the current operation (if any) to finish, and invoke
+   * the callback.
+   */
+  void Wait() noexcept;
+
+private:
+  void OnDone() noexcept;
+
+  /* virtual methods from class Thread */
+  void Run() noexcept override;
+};
@@ -93,6 +93,13 @@ public:
 
   using BufferedReader::Read;
 
+  /**
+   * Has the end of the input been reached?
+   */
+  bool IsEOF() {
+    return Read().empty() && !Fill(true);
+  }
+
   template<typename T>
   void ReadT(T &value) {
     ReadFullT(value);
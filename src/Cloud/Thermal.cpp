@@ -111,13 +111,14 @@ CloudThermal::Load(Deserialiser &s)
 }
 
 void
-CloudThermalContainer::Save(Serialiser &s) const
+CloudThermalContainer::Save(Serialiser &s,
+                            std::span<const std::shared_ptr<const CloudThermal>> thermals)
 {
   s.Write8(1);
 
-  for (const auto &thermal : list) {
+  for (const auto &thermal : thermals) {
     s.Write8(1);
-    thermal.Save(s);
+    thermal->Save(s);
   }
 
   s.Write8(0);
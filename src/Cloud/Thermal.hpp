@@ -10,6 +10,7 @@
 #include <boost/range/iterator_range_core.hpp>
 #include <memory>
 #include <chrono>
+#include <span>
 
 class Serialiser;
 class Deserialiser;
@@ -129,6 +130,12 @@ public:
   [[gnu::pure]]
   query_iterator_range QueryWithinRange(GeoPoint location, double range) const;
 
-  void Save(Serialiser &s) const;
+  /**
+   * Save the given thermals (e.g. a copy of this container's
+   * thermals) in the format understood by Load().
+   */
+  static void Save(Serialiser &s,
+                   std::span<const std::shared_ptr<const CloudThermal>> thermals);
+
   void Load(Deserialiser &s);
 };
@@ -2,9 +2,11 @@
 // Copyright The XCSoar Project
 
 #include "Data.hpp"
+#include "Journal.hpp"
 #include "Serialiser.hpp"
 #include "io/FileOutputStream.hxx"
 #include "io/FileReader.hxx"
+#include "system/FileUtil.hpp"
 #include "io/BufferedOutputStream.hxx"
 #include "util/PrintException.hxx"
 #include "util/Compiler.h"
@@ -151,6 +153,23 @@ try {
     data.Load(s);
   }
 
+  /* apply the changes logged since then */
+
+  {
+    const CloudJournal journal(db_path);
+    for (const Path path : {journal.GetOldPath(), journal.GetPath()}) {
+      if (!File::Exists(path))
+        continue;
+
+      try {
+        ReplayCloudJournal(path, data);
+      } catch (const std::runtime_error &e) {
+        /* the server may be writing the last record right now */
+        PrintException(e);
+      }
+    }
+  }
+
   /* write the clients to KML */
 
   {
@@ -3,8 +3,7 @@
 
 #include "AirspaceEnterMonitor.hpp"
 #include "Airspace/ProtectedAirspaceWarningManager.hpp"
-#include "Engine/Airspace/AirspaceWarning.hpp"
-#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "Airspace/AirspaceWarningSnapshot.hpp"
 #include "Input/InputQueue.hpp"
 
 /**
@@ -42,7 +41,7 @@ ContainsNewItem(const std::set<T> &current,
 
 [[gnu::pure]]
 static std::set<ConstAirspacePtr>
-CollectNearAirspaces(const AirspaceWarningManager &warnings) noexcept
+CollectNearAirspaces(const AirspaceWarningSnapshot &warnings) noexcept
 {
   std::set<ConstAirspacePtr> result;
 
@@ -55,7 +54,7 @@ CollectNearAirspaces(const AirspaceWarningManager &warnings) noexcept
 
 [[gnu::pure]]
 static std::set<ConstAirspacePtr>
-CollectInsideAirspaces(const AirspaceWarningManager &warnings) noexcept
+CollectInsideAirspaces(const AirspaceWarningSnapshot &warnings) noexcept
 {
   std::set<ConstAirspacePtr> result;
 
@@ -67,7 +66,7 @@ CollectInsideAirspaces(const AirspaceWarningManager &warnings) noexcept
 }
 
 inline void
-AirspaceEnterMonitor::Update(const AirspaceWarningManager &warnings) noexcept
+AirspaceEnterMonitor::Update(const AirspaceWarningSnapshot &warnings) noexcept
 {
   const auto serial = warnings.GetSerial();
   if (serial == last_serial)
@@ -92,6 +91,5 @@ AirspaceEnterMonitor::Update([[maybe_unused]] const NMEAInfo &basic,
                              [[maybe_unused]] const DerivedInfo &calculated,
                              [[maybe_unused]] const ComputerSettings &settings) noexcept
 {
-  const ProtectedAirspaceWarningManager::Lease lease{protected_warnings};
-  Update(lease);
+  Update(*protected_warnings.GetSnapshot());
 }
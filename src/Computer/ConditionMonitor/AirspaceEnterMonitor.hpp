@@ -12,7 +12,7 @@ struct NMEAInfo;
 struct DerivedInfo;
 struct ComputerSettings;
 class ProtectedAirspaceWarningManager;
-class AirspaceWarningManager;
+class AirspaceWarningSnapshot;
 
 /** #ConditionMonitor to track/warn on significant changes in wind speed */
 class AirspaceEnterMonitor final {
@@ -30,5 +30,5 @@ public:
               const ComputerSettings &settings) noexcept;
 
 private:
-  void Update(const AirspaceWarningManager &warnings) noexcept;
+  void Update(const AirspaceWarningSnapshot &warnings) noexcept;
 };
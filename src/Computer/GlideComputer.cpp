@@ -6,6 +6,7 @@
 #include "NMEA/Derived.hpp"
 #include "GlideComputerInterface.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
+#include "Profiler/Profiler.hpp"
 
 using namespace std::chrono;
 
@@ -54,6 +55,8 @@ GlideComputer::Initialise()
 bool
 GlideComputer::ProcessGPS(bool force)
 {
+  const Profiler::ScopeTimer timer{Profiler::Section::PROCESS_GPS};
+
   const MoreData &basic = Basic();
   DerivedInfo &calculated = SetCalculated();
   const ComputerSettings &settings = GetComputerSettings();
@@ -141,6 +144,8 @@ GlideComputer::ProcessGPS(bool force)
 void
 GlideComputer::ProcessIdle(bool exhaustive)
 {
+  const Profiler::ScopeTimer timer{Profiler::Section::PROCESS_IDLE};
+
   const MoreData &basic = Basic();
   DerivedInfo &calculated = SetCalculated();
 
@@ -152,8 +157,11 @@ GlideComputer::ProcessIdle(bool exhaustive)
   task_computer.ProcessIdle(basic, calculated, GetComputerSettings(),
                             exhaustive);
 
-  warning_computer.Update(GetComputerSettings(), basic,
-                          calculated, calculated.airspace_warnings);
+  {
+    const Profiler::ScopeTimer warning_timer{Profiler::Section::AIRSPACE_WARNINGS};
+    warning_computer.Update(GetComputerSettings(), basic,
+                            calculated, calculated.airspace_warnings);
+  }
 
   idle_condition_monitors.Update(basic, calculated, GetComputerSettings());
 
@@ -42,7 +42,7 @@ StatsComputer::DoLogging(const MoreData &basic,
     return false;
 
   if (calculated.flight.flying &&
-      stats_clock.CheckAdvance(basic.time, PERIOD)) {
+      barograph_clock.CheckAdvance(basic.time, BAROGRAPH_PERIOD)) {
     flightstats.AddAltitudeTerrain(calculated.flight.flight_time,
                                    calculated.terrain_altitude);
 
@@ -50,7 +50,10 @@ StatsComputer::DoLogging(const MoreData &basic,
       flightstats.AddAltitude(calculated.flight.flight_time,
                               basic.nav_altitude,
                               calculated.task_stats.flight_mode_final_glide);
+  }
 
+  if (calculated.flight.flying &&
+      stats_clock.CheckAdvance(basic.time, PERIOD)) {
     if (calculated.task_stats.task_valid &&
         calculated.task_stats.inst_speed_slow >= 0)
       flightstats.AddTaskSpeed(calculated.flight.flight_time,
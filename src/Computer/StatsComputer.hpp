@@ -15,13 +15,19 @@ struct DerivedInfo;
 class StatsComputer {
   static constexpr std::chrono::steady_clock::duration PERIOD = std::chrono::minutes(1);
 
+  /**
+   * The sampling period of the barograph.  #TimeSeries downsamples
+   * older data, so this can be much shorter than #PERIOD.
+   */
+  static constexpr std::chrono::steady_clock::duration BAROGRAPH_PERIOD = std::chrono::seconds(10);
+
   GeoPoint last_location;
 
   TimeStamp last_climb_start_time, last_cruise_start_time;
   TimeStamp last_thermal_end_time;
 
   FlightStatistics flightstats;
-  GPSClock stats_clock;
+  GPSClock stats_clock, barograph_clock;
 
 public:
   /** Returns the FlightStatistics object */
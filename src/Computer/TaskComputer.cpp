@@ -9,6 +9,7 @@
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
 #include "Settings.hpp"
+#include "Profiler/Profiler.hpp"
 
 #include <algorithm>
 
@@ -59,7 +60,10 @@ TaskComputer::ProcessBasicTask(const MoreData &basic,
     const AircraftState current_as = ToAircraftState(basic, calculated);
     const AircraftState &last_as = valid_last_state ? last_state : current_as;
 
-    _task->Update(current_as, last_as);
+    {
+      const Profiler::ScopeTimer timer{Profiler::Section::TASK};
+      _task->Update(current_as, last_as);
+    }
 
     last_state = current_as;
     valid_last_state = true;
@@ -133,11 +137,15 @@ TaskComputer::ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
   contest.SetPredicted(Predicted(settings_computer.contest, basic,
                                  calculated.task_stats.current_leg));
 
-  if (exhaustive)
-    contest.SolveExhaustive(settings_computer.contest,
-                            calculated.contest_stats);
-  else
-    contest.Solve(settings_computer.contest, calculated.contest_stats);
+  {
+    const Profiler::ScopeTimer timer{Profiler::Section::CONTEST};
+
+    if (exhaustive)
+      contest.SolveExhaustive(settings_computer.contest,
+                              calculated.contest_stats);
+    else
+      contest.Solve(settings_computer.contest, calculated.contest_stats);
+  }
 
   const AircraftState as = ToAircraftState(basic, calculated);
 
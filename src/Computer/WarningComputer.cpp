@@ -25,6 +25,10 @@ WarningComputer::Update(const ComputerSettings &settings_computer,
                         const DerivedInfo &calculated,
                         AirspaceWarningsInfo &result)
 {
+  /* apply acknowledgements which could not be applied by the user
+     interface because we were holding the lock */
+  protected_manager.ProcessCommands();
+
   if (!basic.time_available)
     return;
 
@@ -52,18 +56,28 @@ WarningComputer::Update(const ComputerSettings &settings_computer,
   }
 
   const AircraftState as = ToAircraftState(basic, calculated);
-  ProtectedAirspaceWarningManager::ExclusiveLease lease(protected_manager);
 
-  lease->SetConfig(settings_computer.airspace.warnings);
+  {
+    ProtectedAirspaceWarningManager::ExclusiveLease lease(protected_manager);
+
+    lease->SetConfig(settings_computer.airspace.warnings);
+
+    if (!initialised) {
+      initialised = true;
+      lease->Reset(as);
+    }
+
+    if (lease->Update(as, settings_computer.polar.glide_polar_task,
+                      calculated.task_stats,
+                      calculated.circling,
+                      round<duration<unsigned>>(dt)))
+      result.latest.Update(basic.clock);
 
-  if (!initialised) {
-    initialised = true;
-    lease->Reset(as);
+    /* publish even if the warning list is unchanged, because the
+       intercept solutions move with the aircraft */
+    protected_manager.PublishSnapshot(lease);
   }
 
-  if (lease->Update(as, settings_computer.polar.glide_polar_task,
-                    calculated.task_stats,
-                    calculated.circling,
-                    round<duration<unsigned>>(dt)))
-    result.latest.Update(basic.clock);
+  /* commands submitted while we were holding the lock */
+  protected_manager.ProcessCommands();
 }
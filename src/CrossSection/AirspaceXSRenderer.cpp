@@ -13,13 +13,67 @@
 #include "Engine/Airspace/Airspaces.hpp"
 #include "Navigation/Aircraft.hpp"
 #include "Geo/GeoVector.hpp"
+#include "Geo/Math.hpp"
+#include "Geo/PreparedGeoPoint.hpp"
+#include "TrackOffset.hpp"
 #include "util/StringCompare.hxx"
 
+#include <algorithm>
+#include <limits>
+
+/**
+ * The cached line is longer than the cross-section by this
+ * fraction.
+ */
+static constexpr double EXTRA_LENGTH = 0.25;
+
 /**
- * Local visitor class used for rendering airspaces in the CrossSectionRenderer
+ * Collects the airspaces intersecting with a line, with the
+ * intersections converted to distances from the line's origin.
  */
-class AirspaceIntersectionVisitorSlice final
+class AirspaceIntersectionCollector final
   : public AirspaceIntersectionVisitor
+{
+  std::vector<AirspaceXSRenderer::CachedAirspace> &cache;
+
+  const PreparedGeoPoint origin;
+
+public:
+  AirspaceIntersectionCollector(std::vector<AirspaceXSRenderer::CachedAirspace> &_cache,
+                                const GeoPoint &_origin) noexcept
+    :cache(_cache), origin(_origin) {}
+
+  void Visit(ConstAirspacePtr as) noexcept override {
+    auto &item = cache.emplace_back();
+    item.airspace = std::move(as);
+    item.intervals.reserve(intersections.size());
+
+    for (const auto &i : intersections) {
+      const GeoPoint &p_start = i.first;
+      const GeoPoint &p_end = i.second;
+
+      /* if only one edge was found, the next edge must be beyond
+         the line */
+      item.intervals.emplace_back(GetDistance(p_start),
+                                  p_start == p_end
+                                  ? std::numeric_limits<double>::infinity()
+                                  : GetDistance(p_end));
+    }
+  }
+
+private:
+  [[gnu::pure]]
+  double GetDistance(const GeoPoint &p) const noexcept {
+    double distance;
+    DistanceBearing(origin, p, &distance, nullptr);
+    return distance;
+  }
+};
+
+/**
+ * Local helper class used for rendering airspaces in the CrossSectionRenderer
+ */
+class AirspaceSliceRenderer
 {
   /** Canvas to draw on */
   Canvas &canvas;
@@ -30,29 +84,31 @@ class AirspaceIntersectionVisitorSlice final
 
   const AirspaceLook &airspace_look;
 
-  /** GeoPoint at the left of the CrossSection */
-  const GeoPoint start;
+  /** Distance of the left side of the CrossSection from the origin
+      of the cached intervals */
+  const double offset;
   /** AltitudeState instance used for AGL-based airspaces */
   const AltitudeState& state;
 
 public:
   /**
-   * Constructor of the AirspaceIntersectionVisitorSlice class
+   * Constructor of the AirspaceSliceRenderer class
    * @param _canvas The canvas to draw to
    * @param _chart ChartRenderer instance for scaling coordinates
    * @param _settings settings for colors, pens and brushes
-   * @param _start GeoPoint at the left of the CrossSection
+   * @param _offset distance of the left side of the CrossSection
+   * from the origin of the intervals
    * @param _state AltitudeState instance used for AGL-based airspaces
    */
-  AirspaceIntersectionVisitorSlice(Canvas &_canvas,
-                                   const ChartRenderer &_chart,
-                                   const AirspaceRendererSettings &_settings,
-                                   const AirspaceLook &_airspace_look,
-                                   const GeoPoint _start,
-                                   const AltitudeState& _state) :
+  AirspaceSliceRenderer(Canvas &_canvas,
+                        const ChartRenderer &_chart,
+                        const AirspaceRendererSettings &_settings,
+                        const AirspaceLook &_airspace_look,
+                        double _offset,
+                        const AltitudeState& _state) :
     canvas(_canvas), chart(_chart), settings(_settings),
     airspace_look(_airspace_look),
-    start(_start), state(_state) {}
+    offset(_offset), state(_state) {}
 
   /**
    * Render an airspace box to the canvas
@@ -65,18 +121,14 @@ public:
 
   /**
    * Renders the AbstractAirspace on the canvas
-   * @param as AbstractAirspace to render
+   * @param item the cached airspace to render
    */
-  void Render(const AbstractAirspace &as) const;
-
-  void Visit(ConstAirspacePtr as) noexcept override {
-    Render(*as);
-  }
+  void Render(const AirspaceXSRenderer::CachedAirspace &item) const;
 };
 
 inline void
-AirspaceIntersectionVisitorSlice::RenderBox(const PixelRect rc,
-                                            AirspaceClass type) const
+AirspaceSliceRenderer::RenderBox(const PixelRect rc,
+                                 AirspaceClass type) const
 {
   if (AirspacePreviewRenderer::PrepareFill(canvas, type, airspace_look,
                                            settings)) {
@@ -120,14 +172,11 @@ AirspaceIntersectionVisitorSlice::RenderBox(const PixelRect rc,
 }
 
 inline void
-AirspaceIntersectionVisitorSlice::Render(const AbstractAirspace &as) const
+AirspaceSliceRenderer::Render(const AirspaceXSRenderer::CachedAirspace &item) const
 {
+  const AbstractAirspace &as = *item.airspace;
   AirspaceClass asclass = as.GetClass();
 
-  // No intersections for this airspace
-  if (intersections.empty())
-    return;
-
   if (!IsAirspaceTypeVisible(as, settings))
     return;
 
@@ -139,20 +188,19 @@ AirspaceIntersectionVisitorSlice::Render(const AbstractAirspace &as) const
   else
     rcd.bottom = chart.ScreenY(as.GetBaseAltitude(state));
 
+  const double max_distance = chart.GetXMax();
   int min_x = canvas.GetWidth(), max_x = 0;
 
   // Iterate through the intersections
-  for (const auto &i : intersections) {
-    const GeoPoint &p_start = i.first;
-    const GeoPoint &p_end = i.second;
+  for (const auto &[begin, end] : item.intervals) {
+    const double left = begin - offset, right = end - offset;
 
-    rcd.left = chart.ScreenX(start.Distance(p_start));
+    // skip intersections behind the aircraft or beyond the screen
+    if (right <= 0 || left >= max_distance)
+      continue;
 
-    // only one edge found, next edge must be beyond screen
-    if (p_start == p_end)
-      rcd.right = chart.ScreenX(chart.GetXMax());
-    else
-      rcd.right = chart.ScreenX(start.Distance(p_end));
+    rcd.left = chart.ScreenX(std::max(left, 0.));
+    rcd.right = chart.ScreenX(std::min(right, max_distance));
 
     if (rcd.left < min_x)
       min_x = rcd.left;
@@ -186,17 +234,50 @@ AirspaceIntersectionVisitorSlice::Render(const AbstractAirspace &as) const
 }
 
 
+double
+AirspaceXSRenderer::UpdateCache(const Airspaces &database,
+                                const GeoPoint &start,
+                                const GeoVector &vec) const
+{
+  if (cache_origin.IsValid() && cache_database == &database &&
+      cache_serial == database.GetSerial() &&
+      cache_vector.distance == vec.distance) {
+    const TrackOffset track(cache_origin, cache_vector.bearing, start);
+    const TrackOffset end_track(cache_origin, cache_vector.bearing,
+                                vec.EndPoint(start));
+
+    /* both ends of the cross-section must be close to the cached
+       line, which limits the track change to about asin(1 / 64) */
+    const double max_cross = vec.distance / 64;
+    if (track.along >= 0 && track.along <= vec.distance * EXTRA_LENGTH &&
+        end_track.along > track.along &&
+        track.cross < max_cross && end_track.cross < max_cross)
+      return track.along;
+  }
+
+  cache.clear();
+  cache_database = &database;
+  cache_serial = database.GetSerial();
+  cache_origin = start;
+  cache_vector = vec;
+
+  const GeoVector extended(vec.distance * (1 + EXTRA_LENGTH), vec.bearing);
+  AirspaceIntersectionCollector collector(cache, start);
+  database.VisitIntersecting(start, extended.EndPoint(start), true, collector);
+
+  return 0;
+}
+
 void
 AirspaceXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
                          const Airspaces &database, const GeoPoint &start,
                          const GeoVector &vec, const AircraftState &state) const
 {
-  canvas.Select(*look.name_font);
+  const double offset = UpdateCache(database, start, vec);
 
-  // Create IntersectionVisitor to render to the canvas
-  AirspaceIntersectionVisitorSlice ivisitor(
-      canvas, chart, settings, look, start, state);
+  canvas.Select(*look.name_font);
 
-  // Call visitor with intersecting airspaces
-  database.VisitIntersecting(start, vec.EndPoint(start), true, ivisitor);
+  AirspaceSliceRenderer renderer(canvas, chart, settings, look, offset, state);
+  for (const auto &i : cache)
+    renderer.Render(i);
 }
@@ -4,13 +4,18 @@
 #pragma once
 
 #include "Renderer/AirspaceRendererSettings.hpp"
+#include "Engine/Airspace/Ptr.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Geo/GeoVector.hpp"
+#include "util/Serial.hpp"
+
+#include <utility>
+#include <vector>
 
 struct AirspaceLook;
 class Canvas;
 class ChartRenderer;
 class Airspaces;
-struct GeoPoint;
-struct GeoVector;
 struct AircraftState;
 
 /**
@@ -22,6 +27,34 @@ class AirspaceXSRenderer
 
   const AirspaceLook &look;
 
+public:
+  /**
+   * An airspace intersecting with the cached line.
+   */
+  struct CachedAirspace {
+    ConstAirspacePtr airspace;
+
+    /**
+     * Begin and end of each intersection, as distance from the
+     * line's origin [m].  The end is infinite if it was not found.
+     */
+    std::vector<std::pair<double, double>> intervals;
+  };
+
+private:
+  /**
+   * The airspaces along a line which is longer than the
+   * cross-section, so it can be reused while the aircraft follows a
+   * steady track, until it has moved past the extra length, turned
+   * or the database has changed.
+   */
+  mutable std::vector<CachedAirspace> cache;
+
+  mutable const Airspaces *cache_database = nullptr;
+  mutable Serial cache_serial;
+  mutable GeoPoint cache_origin = GeoPoint::Invalid();
+  mutable GeoVector cache_vector;
+
 public:
   AirspaceXSRenderer(const AirspaceLook &_look): look(_look) {}
 
@@ -33,4 +66,13 @@ public:
   void SetSettings(const AirspaceRendererSettings &_settings) {
     settings = _settings;
   }
+
+private:
+  /**
+   * Make sure the cache covers the given cross-section.
+   *
+   * @return the distance of the start point from #cache_origin [m]
+   */
+  double UpdateCache(const Airspaces &database,
+                     const GeoPoint &start, const GeoVector &vec) const;
 };
@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "CrossSectionRenderer.hpp"
+#include "TrackOffset.hpp"
 #include "Renderer/ChartRenderer.hpp"
 #include "Renderer/GradientRenderer.hpp"
 #include "ui/canvas/Canvas.hpp"
@@ -70,8 +71,8 @@ CrossSectionRenderer::Paint(Canvas &canvas, const PixelRect rc) const
   chart.ScaleYFromValue(hmin);
   chart.ScaleYFromValue(hmax);
 
-  TerrainHeight elevations[NUM_SLICES];
-  UpdateTerrain(elevations);
+  TerrainHeight elevations[NUM_SLICES + 1];
+  const double terrain_offset = UpdateTerrain(elevations);
 
   if (airspace_database != nullptr) {
     const AircraftState aircraft = ToAircraftState(Basic(), Calculated());
@@ -79,7 +80,7 @@ CrossSectionRenderer::Paint(Canvas &canvas, const PixelRect rc) const
                            aircraft);
   }
 
-  terrain_renderer.Draw(canvas, chart, elevations);
+  terrain_renderer.Draw(canvas, chart, elevations, terrain_offset);
   PaintWorking(chart);
   PaintGlide(chart);
   PaintAircraft(canvas, chart, rc);
@@ -92,24 +93,61 @@ CrossSectionRenderer::Paint(Canvas &canvas, const PixelRect rc) const
   chart.Finish();
 }
 
-void
+double
 CrossSectionRenderer::UpdateTerrain(TerrainHeight *elevations) const
 {
   if (terrain == NULL) {
     const auto invalid = TerrainHeight::Invalid();
-    std::fill_n(elevations, NUM_SLICES, invalid);
-    return;
+    std::fill_n(elevations, NUM_SLICES + 1, invalid);
+    return 0;
   }
 
-  const GeoPoint point_diff = vec.EndPoint(start) - start;
-
   RasterTerrain::Lease map(*terrain);
-  for (unsigned i = 0; i < NUM_SLICES; ++i) {
-    const auto slice_distance_factor = double(i) / (NUM_SLICES - 1);
-    const GeoPoint slice_point = start + point_diff * slice_distance_factor;
 
-    elevations[i] = map->GetHeight(slice_point);
+  double offset = 0;
+
+  if (profile_origin.IsValid() && profile_serial == map->GetSerial() &&
+      profile_vector.distance == vec.distance) {
+    const TrackOffset track(profile_origin, profile_vector.bearing, start);
+    const TrackOffset end_track(profile_origin, profile_vector.bearing,
+                                vec.EndPoint(start));
+    const double step = vec.distance / (NUM_SLICES - 1);
+
+    /* both ends of the cross-section must be less than half a slice
+       off the sampled line; this limits the track change to about
+       asin(step / 2 / range) */
+    if (track.along >= 0 && track.along < vec.distance &&
+        end_track.along > track.along &&
+        track.cross < step / 2 && end_track.cross < step / 2) {
+      /* still on the same track: scroll the profile */
+      const unsigned n = unsigned(track.along / step);
+      for (unsigned i = 1; i <= n; ++i)
+        profile.push(map->GetHeight(profile_origin +
+                                    profile_step * double(NUM_SLICES + i)));
+
+      profile_origin = profile_origin + profile_step * double(n);
+      offset = track.along - n * step;
+    } else
+      profile_origin.SetInvalid();
+  } else
+    profile_origin.SetInvalid();
+
+  if (!profile_origin.IsValid()) {
+    /* sample the whole profile */
+    profile_origin = start;
+    profile_vector = vec;
+    profile_step = (vec.EndPoint(start) - start) * (1. / (NUM_SLICES - 1));
+    profile_serial = map->GetSerial();
+
+    profile.clear();
+    for (unsigned i = 0; i <= NUM_SLICES; ++i)
+      profile.push(map->GetHeight(profile_origin + profile_step * double(i)));
   }
+
+  for (const auto &i : profile)
+    *elevations++ = i;
+
+  return offset;
 }
 
 void
@@ -8,6 +8,8 @@
 #include "AirspaceXSRenderer.hpp"
 #include "Engine/GlideSolvers/GlideSettings.hpp"
 #include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "util/OverwritingRingBuffer.hpp"
+#include "util/Serial.hpp"
 
 struct PixelRect;
 struct MoreData;
@@ -51,6 +53,26 @@ protected:
   /** Range and direction of the CrossSection */
   GeoVector vec{50000, Angle::Zero()};
 
+  /**
+   * The terrain profile: #NUM_SLICES+1 samples spaced evenly along
+   * the track, beginning at #profile_origin.  While the aircraft
+   * follows a steady track, the samples it has passed are dropped
+   * and only the newly exposed ones at the far end are looked up.
+   * After a turn, the whole profile is sampled again.
+   */
+  mutable OverwritingRingBuffer<TerrainHeight, NUM_SLICES + 2> profile;
+
+  mutable GeoPoint profile_origin = GeoPoint::Invalid();
+
+  /** The difference between two samples */
+  mutable GeoPoint profile_step;
+
+  /** Range and direction of #profile */
+  mutable GeoVector profile_vector;
+
+  /** The terrain serial of #profile */
+  mutable Serial profile_serial;
+
 public:
   /**
    * Constructor. Initializes most class members.
@@ -119,7 +141,14 @@ public:
   }
 
 protected:
-  void UpdateTerrain(TerrainHeight *elevations) const;
+  /**
+   * Update the cached terrain profile and copy it to the given
+   * buffer.
+   *
+   * @param elevations a buffer for #NUM_SLICES+1 samples
+   * @return the distance of the aircraft from the first sample [m]
+   */
+  double UpdateTerrain(TerrainHeight *elevations) const;
 
   void PaintGlide(ChartRenderer &chart) const;
   void PaintAircraft(Canvas &canvas, const ChartRenderer &chart,
@@ -8,13 +8,19 @@
 #include "Look/CrossSectionLook.hpp"
 #include "util/StaticArray.hxx"
 
+#include <algorithm> // for std::clamp()
+
 void
 TerrainXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
-                        const TerrainHeight *elevations) const
+                        const TerrainHeight *elevations,
+                        double offset) const
 {
+  constexpr unsigned n = CrossSectionRenderer::NUM_SLICES + 1;
+
   const auto max_distance = chart.GetXMax();
+  const auto step = max_distance / (CrossSectionRenderer::NUM_SLICES - 1);
 
-  StaticArray<BulkPixelPoint, CrossSectionRenderer::NUM_SLICES + 2> points;
+  StaticArray<BulkPixelPoint, n + 2> points;
 
   canvas.SelectNullPen();
 
@@ -22,10 +28,8 @@ TerrainXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
   double last_distance = 0;
   const double hmin = chart.GetYMin();
 
-  for (unsigned j = 0; j < CrossSectionRenderer::NUM_SLICES; ++j) {
-    const auto distance_factor =
-        double(j) / (CrossSectionRenderer::NUM_SLICES - 1);
-    const auto distance = distance_factor * max_distance;
+  for (unsigned j = 0; j < n; ++j) {
+    const auto distance = std::clamp(j * step - offset, 0., max_distance);
 
     const TerrainHeight e = elevations[j];
     const TerrainType type = e.GetType();
@@ -57,7 +61,7 @@ TerrainXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
         points.append() = chart.ToScreen({center_distance, hmin});
       }
 
-      if (j + 1 == CrossSectionRenderer::NUM_SLICES) {
+      if (j + 1 == n) {
         // Close and paint last polygon
         points.append() = chart.ToScreen({distance, h});
         points.append() = chart.ToScreen({distance, hmin});
@@ -20,8 +20,14 @@ class TerrainXSRenderer
 public:
   TerrainXSRenderer(const CrossSectionLook &_look): look(_look) {}
 
+  /**
+   * @param elevations #CrossSectionRenderer::NUM_SLICES+1 samples
+   * spaced evenly over the chart range
+   * @param offset the distance of the chart origin from the first
+   * sample [m]
+   */
   void Draw(Canvas &canvas, const ChartRenderer &chart,
-            const TerrainHeight *elevations) const;
+            const TerrainHeight *elevations, double offset) const;
 
 private:
   void DrawPolygon(Canvas &canvas, TerrainType type,
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/GeoPoint.hpp"
+#include "Geo/GeoVector.hpp"
+
+#include <cmath>
+
+/**
+ * The position of a location relative to a straight line, used to
+ * decide whether cached cross-section data which was calculated for
+ * an earlier position on the same track can be reused.
+ */
+struct TrackOffset {
+  /** Distance along the line from its origin [m] */
+  double along;
+
+  /** Distance from the line [m] */
+  double cross;
+
+  TrackOffset(const GeoPoint &origin, Angle bearing,
+              const GeoPoint &location) noexcept {
+    const GeoVector v = origin.DistanceBearing(location);
+    const auto sc = (v.bearing - bearing).SinCos();
+    along = v.distance * sc.second;
+    cross = std::fabs(v.distance * sc.first);
+  }
+};
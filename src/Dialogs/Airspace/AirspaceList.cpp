@@ -44,13 +44,14 @@ class AirspaceListWidget final
     NullBlackboardListener {
   AirspaceFilterWidget &filter_widget;
 
-  AirspaceSelectInfoVector items;
+  AirspaceSearch search;
 
   TwoTextRowsRenderer row_renderer;
 
 public:
-  AirspaceListWidget(AirspaceFilterWidget &_filter_widget)
-    :filter_widget(_filter_widget) {}
+  AirspaceListWidget(AirspaceFilterWidget &_filter_widget,
+                     const Airspaces &airspaces)
+    :filter_widget(_filter_widget), search(airspaces) {}
 
   void UpdateList();
   void FilterMode(bool direction);
@@ -182,6 +183,8 @@ static AirspaceListWidgetState dialog_state;
 void
 AirspaceListWidget::OnAirspaceListEnter(unsigned i)
 {
+  const auto &items = search.GetResult();
+
   if (items.empty()) {
     assert(i == 0);
     return;
@@ -219,9 +222,8 @@ AirspaceListWidget::UpdateList()
   if (dialog_state.distance > 0)
     data.distance = dialog_state.distance;
 
-  items = FilterAirspaces(*airspaces,
-                          CommonInterface::Basic().location,
-                          data);
+  const auto &items = search.Update(CommonInterface::Basic().location,
+                                    data);
 
   GetList().SetLength(std::max((size_t)1, items.size()));
   GetList().Invalidate();
@@ -278,6 +280,8 @@ void
 AirspaceListWidget::OnPaintItem(Canvas &canvas, const PixelRect rc,
                                 unsigned i) noexcept
 {
+  const auto &items = search.GetResult();
+
   if (items.empty()) {
     assert(i == 0);
 
@@ -419,7 +423,8 @@ ShowAirspaceListDialog(const Airspaces &_airspaces,
 
   auto filter_widget = std::make_unique<AirspaceFilterWidget>(look);
 
-  auto list_widget = std::make_unique<AirspaceListWidget>(*filter_widget);
+  auto list_widget = std::make_unique<AirspaceListWidget>(*filter_widget,
+                                                         _airspaces);
 
   auto buttons_widget = std::make_unique<AirspaceListButtons>(look, dialog);
 
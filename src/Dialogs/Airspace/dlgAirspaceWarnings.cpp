@@ -13,7 +13,7 @@
 #include "ui/event/PeriodicTimer.hpp"
 #include "Airspace/AirspaceWarning.hpp"
 #include "Airspace/ProtectedAirspaceWarningManager.hpp"
-#include "Airspace/AirspaceWarningManager.hpp"
+#include "Airspace/AirspaceWarningSnapshot.hpp"
 #include "Formatter/AirspaceFormatter.hpp"
 #include "Engine/Airspace/AbstractAirspace.hpp"
 #include "util/Macros.hpp"
@@ -26,7 +26,7 @@
 
 #include <algorithm>
 #include <cassert>
-#include <vector>
+#include <memory>
 
 #include <stdio.h>
 
@@ -42,7 +42,7 @@ class AirspaceWarningListWidget final
   Button *enable_button;
   Button *radio_button;
 
-  std::vector<AirspaceWarning> warning_list;
+  std::shared_ptr<const AirspaceWarningSnapshot> warning_list;
 
   /**
    * Current list cursor airspace.
@@ -59,6 +59,7 @@ class AirspaceWarningListWidget final
 public:
   AirspaceWarningListWidget(ProtectedAirspaceWarningManager &aw)
     :airspace_warnings(aw),
+     warning_list(aw.GetSnapshot()),
      sound_interval_counter(1)
   {}
 
@@ -133,11 +134,15 @@ AirspaceWarningListWidget::UpdateButtons()
 
   bool ack_expired, ack_day;
 
-  {
-    ProtectedAirspaceWarningManager::ExclusiveLease lease(airspace_warnings);
-    const AirspaceWarning &warning = lease->GetWarning(airspace);
-    ack_expired = warning.IsAckExpired();
-    ack_day = warning.GetAckDay();
+  if (const auto *warning = warning_list->Find(*airspace)) {
+    ack_expired = warning->IsAckExpired();
+    ack_day = warning->GetAckDay();
+  } else {
+    /* not (yet) known to the warning manager: use the state of a new
+       warning */
+    const AirspaceWarning fresh(airspace);
+    ack_expired = fresh.IsAckExpired();
+    ack_day = fresh.GetAckDay();
   }
 
   ack_button->SetVisible(ack_expired);
@@ -159,8 +164,8 @@ AirspaceWarningListWidget::Prepare(ContainerWindow &parent,
 void
 AirspaceWarningListWidget::OnCursorMoved(unsigned i) noexcept
 {
-  selected_airspace = i < warning_list.size()
-    ? warning_list[i].GetAirspacePtr()
+  selected_airspace = i < warning_list->size()
+    ? (*warning_list)[i].GetAirspacePtr()
     : nullptr;
 
   UpdateButtons();
@@ -192,8 +197,8 @@ AirspaceWarningListWidget::OnActivateItem([[maybe_unused]] unsigned i) noexcept
 bool
 AirspaceWarningListWidget::HasWarning() const
 {
-  ProtectedAirspaceWarningManager::Lease lease(airspace_warnings);
-  return std::any_of(lease->begin(), lease->end(),
+  const auto snapshot = airspace_warnings.GetSnapshot();
+  return std::any_of(snapshot->begin(), snapshot->end(),
                      [](const auto &i){ return i.IsActive(); });
 }
 
@@ -241,17 +246,7 @@ AirspaceWarningListWidget::Enable()
   if (airspace == NULL)
     return;
 
-  {
-    ProtectedAirspaceWarningManager::ExclusiveLease lease(airspace_warnings);
-    AirspaceWarning *warning = lease->GetWarningPtr(*airspace);
-    if (warning == NULL)
-      return;
-
-    warning->AcknowledgeInside(false);
-    warning->AcknowledgeWarning(false);
-    warning->AcknowledgeDay(false);
-  }
-
+  airspace_warnings.Enable(airspace);
   UpdateList();
 }
 
@@ -275,7 +270,7 @@ AirspaceWarningListWidget::OnPaintItem(Canvas &canvas,
   // for renderring within the paint_rc area.
   const unsigned padding = Layout::GetTextPadding();
 
-  if (i == 0 && warning_list.empty()) {
+  if (i == 0 && warning_list->empty()) {
     /* the warnings were emptied between the opening of the dialog and
        this refresh, so only need to display "No Warnings" for top
        item, otherwise exit immediately */
@@ -283,9 +278,9 @@ AirspaceWarningListWidget::OnPaintItem(Canvas &canvas,
     return;
   }
 
-  assert(i < warning_list.size());
+  assert(i < warning_list->size());
 
-  const auto &warning = warning_list[i];
+  const auto &warning = (*warning_list)[i];
   const AbstractAirspace &airspace = warning.GetAirspace();
 
   // word "inside" is used as the etalon, because it is longer than "near" and
@@ -383,8 +378,7 @@ AirspaceWarningListWidget::OnPaintItem(Canvas &canvas,
 inline void
 AirspaceWarningListWidget::CopyList()
 {
-  const ProtectedAirspaceWarningManager::Lease lease(airspace_warnings);
-  warning_list = {lease->begin(), lease->end()};
+  warning_list = airspace_warnings.GetSnapshot();
 }
 
 void
@@ -392,17 +386,17 @@ AirspaceWarningListWidget::UpdateList()
 {
   CopyList();
 
-  if (!warning_list.empty()) {
-    GetList().SetLength(warning_list.size());
+  if (!warning_list->empty()) {
+    GetList().SetLength(warning_list->size());
 
     int i = -1;
     if (selected_airspace != NULL) {
-      auto it = std::find_if(warning_list.begin(), warning_list.end(),
+      auto it = std::find_if(warning_list->begin(), warning_list->end(),
                              [this](const auto &i){
                                return &i.GetAirspace() == selected_airspace.get();
                              });
-      if (it != warning_list.end()) {
-        i = std::distance(warning_list.begin(), it);
+      if (it != warning_list->end()) {
+        i = std::distance(warning_list->begin(), it);
         GetList().SetCursorIndex(i);
       }
     }
@@ -416,7 +410,7 @@ AirspaceWarningListWidget::UpdateList()
       CommonInterface::GetComputerSettings().airspace.warnings;
     if (warning_config.repetitive_sound) {
       FloatDuration tt_closest_airspace{1000};
-      for (const auto &i : warning_list) {
+      for (const auto &i : *warning_list) {
         /* Find smallest time to nearest aispace (cannot always rely
            on fact that closest airspace should be in the beginning of
            the list) */
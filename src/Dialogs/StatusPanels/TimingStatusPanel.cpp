@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TimingStatusPanel.hpp"
+#include "Profiler/Profiler.hpp"
+#include "Language/Language.hpp"
+#include "util/StaticString.hxx"
+
+using Profiler::Section;
+
+static constexpr double
+ToMilliseconds(TimingHistogram::Duration d) noexcept
+{
+  return d.count() / 1000.;
+}
+
+void
+TimingStatusPanel::Refresh() noexcept
+{
+  StaticString<64> temp;
+
+  for (unsigned i = 0; i < unsigned(Section::COUNT); ++i) {
+    const auto summary = Profiler::GetSummary(Section(i));
+    if (summary.count == 0) {
+      ClearText(i);
+      continue;
+    }
+
+    /* p50 / p95 / max */
+    temp.Format(_T("%.1f / %.1f / %.1f ms"),
+                ToMilliseconds(summary.p50),
+                ToMilliseconds(summary.p95),
+                ToMilliseconds(summary.max));
+    SetText(i, temp);
+  }
+}
+
+void
+TimingStatusPanel::Prepare([[maybe_unused]] ContainerWindow &parent,
+                           [[maybe_unused]] const PixelRect &rc) noexcept
+{
+  for (unsigned i = 0; i < unsigned(Section::COUNT); ++i)
+    AddReadOnly(gettext(Profiler::GetLabel(Section(i))));
+}
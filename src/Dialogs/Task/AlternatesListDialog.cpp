@@ -7,7 +7,7 @@
 #include "Widget/ListWidget.hpp"
 #include "Look/DialogLook.hpp"
 #include "Task/ProtectedTaskManager.hpp"
-#include "Engine/Task/TaskManager.hpp"
+#include "Task/PublishedTask.hpp"
 #include "Engine/Task/Unordered/AlternateList.hpp"
 #include "Engine/Waypoint/Waypoint.hpp"
 #include "Interface.hpp"
@@ -50,8 +50,7 @@ public:
   }
 
   bool Update() {
-    ProtectedTaskManager::Lease lease(*backend_components->protected_task_manager);
-    alternates = lease->GetAlternates();
+    alternates = backend_components->protected_task_manager->GetPublished()->alternates;
     return !alternates.empty();
   }
 
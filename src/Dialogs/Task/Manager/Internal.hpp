@@ -5,6 +5,7 @@
 
 #include "Widget/TabWidget.hpp"
 #include "Form/Form.hpp"
+#include "Task/TaskIndex.hpp"
 
 #include <memory>
 
@@ -70,6 +71,11 @@ public:
 
   void ShowTaskView(const OrderedTask *task);
 
+  /**
+   * Show the preview of a task which has not been loaded.
+   */
+  void ShowTaskSummary(const TaskIndex::Summary *summary);
+
   void ResetTaskView() {
     ShowTaskView(task.get());
   }
@@ -18,13 +18,15 @@
 #include "system/FileUtil.hpp"
 #include "Language/Language.hpp"
 #include "Interface.hpp"
-#include "Renderer/TextRowRenderer.hpp"
+#include "Renderer/TwoTextRowsRenderer.hpp"
+#include "Formatter/UserUnits.hpp"
 #include "Look/DialogLook.hpp"
 #include "Engine/Task/Ordered/OrderedTask.hpp"
 #include "util/StringCompare.hxx"
 #include "UIGlobals.hpp"
 #include "Components.hpp" // for way_points
 #include "DataComponents.hpp"
+#include "ui/event/Notify.hpp"
 
 #include <cassert>
 
@@ -40,11 +42,18 @@ class TaskListPanel final
 
   TaskManagerDialog &dialog;
 
-  TextRowRenderer row_renderer;
+  TwoTextRowsRenderer row_renderer;
 
   std::unique_ptr<OrderedTask> &active_task;
   bool *task_modified;
 
+  /**
+   * Notified when #task_store has finished parsing the tasks which
+   * were not indexed.  Declared before #task_store, which must stop
+   * its job before this is destroyed.
+   */
+  UI::Notify index_notify{[this]{ OnIndexFinished(); }};
+
   TaskStore task_store;
   unsigned serial;
 
@@ -84,6 +93,9 @@ public:
 
   void RefreshView();
 
+  void ScanTasks();
+  void OnIndexFinished() noexcept;
+
   void LoadTask();
   void DeleteTask();
   void RenameTask();
@@ -157,7 +169,34 @@ TaskListPanel::OnPaintItem(Canvas &canvas, const PixelRect rc,
 {
   assert(DrawListIndex <= task_store.Size());
 
-  row_renderer.DrawTextRow(canvas, rc, task_store.GetName(DrawListIndex));
+  row_renderer.DrawFirstRow(canvas, rc, task_store.GetName(DrawListIndex));
+
+  /* the summary was obtained by Scan(); the list must not load task
+     files while scrolling */
+  const TaskIndex::Summary *task_summary =
+    task_store.GetSummary(DrawListIndex);
+  if (task_summary == nullptr) {
+    if (task_store.IsIndexing())
+      /* placeholder until the task file has been parsed */
+      row_renderer.DrawSecondRow(canvas, rc, _T("..."));
+    return;
+  }
+
+  StaticString<256> turnpoints;
+  turnpoints.clear();
+  for (const auto &name : task_summary->turnpoints) {
+    if (!turnpoints.empty())
+      turnpoints.append(_T(" - "));
+    turnpoints.append(name.c_str());
+  }
+
+  const int x =
+    row_renderer.DrawRightSecondRow(canvas, rc,
+                                    FormatUserDistanceSmart(task_summary->distance_nominal));
+
+  PixelRect text_rc = rc;
+  text_rc.right = x;
+  row_renderer.DrawSecondRow(canvas, text_rc, turnpoints);
 }
 
 void
@@ -167,14 +206,20 @@ TaskListPanel::RefreshView()
 
   dialog.InvalidateTaskView();
 
-  const OrderedTask *ordered_task = get_cursor_task();
-  dialog.ShowTaskView(ordered_task);
+  /* the preview is drawn from the task index; the task file is only
+     parsed when the task gets loaded */
+  const unsigned cursor_index = GetList().GetCursorIndex();
+  const TaskIndex::Summary *task_summary =
+    cursor_index < task_store.Size()
+    ? task_store.GetSummary(cursor_index)
+    : nullptr;
+  dialog.ShowTaskSummary(task_summary);
 
-  if (ordered_task == nullptr) {
+  if (task_summary == nullptr) {
     summary.SetText(_T(""));
   } else {
     TCHAR text[300];
-    OrderedTaskSummary(ordered_task, text, false);
+    OrderedTaskSummary(*task_summary, text);
     summary.SetText(text);
   }
 
@@ -182,6 +227,26 @@ TaskListPanel::RefreshView()
     two_widgets->UpdateLayout();
 }
 
+void
+TaskListPanel::ScanTasks()
+{
+  task_store.Scan(CommonInterface::GetComputerSettings().task,
+                  data_components->waypoints.get(), index_notify, more);
+}
+
+void
+TaskListPanel::OnIndexFinished() noexcept
+{
+  task_store.FinishIndex();
+
+  /* save the index now, so the work is not lost if the dialog is not
+     closed properly */
+  task_store.SaveIndex();
+
+  if (GetList().IsVisible())
+    RefreshView();
+}
+
 void
 TaskListPanel::LoadTask()
 {
@@ -238,7 +303,7 @@ TaskListPanel::DeleteTask()
 
   File::Delete(path);
 
-  task_store.Scan(more);
+  ScanTasks();
   RefreshView();
 }
 
@@ -286,7 +351,7 @@ TaskListPanel::RenameTask()
   File::Rename(task_store.GetPath(cursor_index),
                AllocatedPath::Build(tasks_path, newname));
 
-  task_store.Scan(more);
+  ScanTasks();
   RefreshView();
 }
 
@@ -297,7 +362,7 @@ TaskListPanel::OnMoreClicked()
 
   more_button->SetCaption(more ? _("Less") : _("More"));
 
-  task_store.Scan(more);
+  ScanTasks();
   RefreshView();
 }
 
@@ -307,7 +372,8 @@ TaskListPanel::Prepare(ContainerWindow &parent, const PixelRect &rc) noexcept
   const DialogLook &look = UIGlobals::GetDialogLook();
 
   CreateList(parent, dialog.GetLook(), rc,
-             row_renderer.CalculateLayout(*look.list.font));
+             row_renderer.CalculateLayout(*look.list.font,
+                                          look.small_font));
 
   CreateButtons(buttons->GetButtonPanel());
 
@@ -322,11 +388,9 @@ TaskListPanel::Show(const PixelRect &rc) noexcept
   if (serial != task_list_serial) {
     serial = task_list_serial;
     // Scan XCSoarData for available tasks
-    task_store.Scan(more);
+    ScanTasks();
   }
 
-  dialog.ShowTaskView(get_cursor_task());
-
   GetList().SetCursorIndex(0); // so Save & Declare are always available
   RefreshView();
   ListWidget::Show(rc);
@@ -337,6 +401,8 @@ TaskListPanel::Hide() noexcept
 {
   dialog.ResetTaskView();
 
+  task_store.SaveIndex();
+
   ListWidget::Hide();
 }
 
@@ -160,6 +160,15 @@ TaskManagerDialog::ShowTaskView(const OrderedTask *_task)
   task_view.Invalidate();
 }
 
+void
+TaskManagerDialog::ShowTaskSummary(const TaskIndex::Summary *summary)
+{
+  auto &task_view = (ButtonWidget &)GetExtra();
+  auto &renderer = (TaskMapButtonRenderer &)task_view.GetRenderer();
+  renderer.SetSummary(summary);
+  task_view.Invalidate();
+}
+
 void
 TaskManagerDialog::SwitchToEditTab()
 {
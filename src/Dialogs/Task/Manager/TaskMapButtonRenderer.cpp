@@ -26,11 +26,22 @@ DrawTask(Canvas &canvas, const PixelRect rc,
             true);
 }
 
+static void
+DrawSummary(Canvas &canvas, const PixelRect rc,
+            const MapLook &look, const TaskIndex::Summary &summary) noexcept
+{
+  PaintTaskSummary(canvas, rc, summary,
+                   CommonInterface::GetMapSettings(),
+                   look.task, look.airspace, look.overlay,
+                   data_components->terrain.get(),
+                   data_components->airspaces.get());
+}
+
 void
 TaskMapButtonRenderer::DrawButton(Canvas &canvas, const PixelRect &rc,
                                   ButtonState state) const noexcept
 {
-  if (task == nullptr) {
+  if (task == nullptr && summary == nullptr) {
     canvas.ClearWhite();
     return;
   }
@@ -52,7 +63,10 @@ TaskMapButtonRenderer::DrawButton(Canvas &canvas, const PixelRect &rc,
     buffer.Begin(canvas);
 #endif
 
-    DrawTask(buffer, PixelRect{new_size}, look, *task);
+    if (task != nullptr)
+      DrawTask(buffer, PixelRect{new_size}, look, *task);
+    else
+      DrawSummary(buffer, PixelRect{new_size}, look, *summary);
 
 #ifdef ENABLE_OPENGL
     buffer.Commit(canvas);
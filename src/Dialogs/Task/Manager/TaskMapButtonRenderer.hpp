@@ -5,6 +5,7 @@
 
 #include "Renderer/ButtonRenderer.hpp"
 #include "ui/canvas/BufferCanvas.hpp"
+#include "Task/TaskIndex.hpp"
 
 struct MapLook;
 class OrderedTask;
@@ -21,15 +22,27 @@ class TaskMapButtonRenderer : public ButtonRenderer {
    */
   const OrderedTask *task;
 
+  /**
+   * Shown instead of #task if that is nullptr.
+   */
+  const TaskIndex::Summary *summary;
+
   mutable BufferCanvas buffer;
   mutable PixelSize size;
 
 public:
   explicit TaskMapButtonRenderer(const MapLook &_look) noexcept
-    :look(_look), task(nullptr), size(0, 0) {}
+    :look(_look), task(nullptr), summary(nullptr), size(0, 0) {}
 
   void SetTask(const OrderedTask *_task) noexcept {
     task = _task;
+    summary = nullptr;
+    InvalidateBuffer();
+  }
+
+  void SetSummary(const TaskIndex::Summary *_summary) noexcept {
+    task = nullptr;
+    summary = _summary;
     InvalidateBuffer();
   }
 
@@ -126,6 +126,31 @@ OrderedTaskSummary(const OrderedTask *task, TCHAR *text, bool linebreaks)
   }
 }
 
+void
+OrderedTaskSummary(const TaskIndex::Summary &summary, TCHAR *text)
+{
+  if (summary.turnpoints.empty()) {
+    StringFormatUnsafe(text, _("Task is empty (%s)"),
+                       OrderedTaskFactoryName(summary.type));
+  } else if (summary.has_targets)
+    StringFormatUnsafe(text, _T("%.0f %s, %s %.0f %s, %s %.0f %s (%s)"),
+                       (double)Units::ToUserDistance(summary.distance_nominal),
+                       Units::GetDistanceName(),
+                       _("max."),
+                       (double)Units::ToUserDistance(summary.distance_max),
+                       Units::GetDistanceName(),
+                       _("min."),
+                       (double)Units::ToUserDistance(summary.distance_min),
+                       Units::GetDistanceName(),
+                       OrderedTaskFactoryName(summary.type));
+  else
+    StringFormatUnsafe(text, _T("%s %.0f %s (%s)"),
+                       _("dist."),
+                       (double)Units::ToUserDistance(summary.distance_nominal),
+                       Units::GetDistanceName(),
+                       OrderedTaskFactoryName(summary.type));
+}
+
 void
 OrderedTaskPointLabel(TaskPointType type, const TCHAR *name,
                       unsigned index, TCHAR* buffer)
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "Task/TaskIndex.hpp"
+
 #include <tchar.h>
 #include <cstdint>
 
@@ -19,6 +21,14 @@ class ObservationZonePoint;
 void
 OrderedTaskSummary(const OrderedTask *task, TCHAR *text, bool linebreaks);
 
+/**
+ * Like OrderedTaskSummary(), but from a #TaskIndex::Summary, i.e.
+ * without loading the task.  The shape and the validation errors are
+ * omitted.
+ */
+void
+OrderedTaskSummary(const TaskIndex::Summary &summary, TCHAR *text);
+
 void
 OrderedTaskPointLabel(TaskPointType type, const TCHAR *name,
                       unsigned index, TCHAR *buffer);
@@ -7,6 +7,7 @@
 
 #include "MapWindow/GlueMapWindow.hpp"
 #include "Hardware/CPU.hpp"
+#include "Profiler/Profiler.hpp"
 
 /**
  * Main loop of the DrawThread
@@ -28,6 +29,7 @@ DrawThread::Run() noexcept
     pending = false;
 
     const ScopeUnlock unlock(mutex);
+    const Profiler::ScopeTimer timer{Profiler::Section::DRAW};
 
 #ifdef HAVE_CPU_FREQUENCY
     const ScopeLockCPU cpu;
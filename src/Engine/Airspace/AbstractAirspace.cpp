@@ -157,10 +157,13 @@ AirspaceInterceptSolution
 AbstractAirspace::Intercept(const AircraftState &state,
                             const GeoPoint &end,
                             const FlatProjection &projection,
-                            const AirspaceAircraftPerformance &perf) const noexcept
+                            const AirspaceAircraftPerformance &perf,
+                            AirspaceIntersectionVector &intersections) const noexcept
 {
+  Intersects(state.location, end, projection, intersections);
+
   AirspaceInterceptSolution solution = AirspaceInterceptSolution::Invalid();
-  for (const auto &i : Intersects(state.location, end, projection)) {
+  for (const auto &i : intersections) {
     auto new_solution = Intercept(state, perf, i.first, i.second);
     if (new_solution.IsEarlierThan(solution))
       solution = new_solution;
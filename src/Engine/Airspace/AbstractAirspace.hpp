@@ -141,13 +141,13 @@ public:
    *
    * @param g1 Location of origin of search vector
    * @param end the end of the search vector
-   *
-   * @return Vector of intersection pairs if the line intersects the airspace
+   * @param result receives the intersection pairs (empty if the
+   * line does not intersect the airspace); the caller may reuse it
+   * for many calls to avoid heap allocations
    */
-  [[gnu::pure]]
-  virtual AirspaceIntersectionVector Intersects(const GeoPoint &g1,
-                                                const GeoPoint &end,
-                                                const FlatProjection &projection) const noexcept = 0;
+  virtual void Intersects(const GeoPoint &g1, const GeoPoint &end,
+                          const FlatProjection &projection,
+                          AirspaceIntersectionVector &result) const noexcept = 0;
 
   /**
    * Find location of closest point on boundary to a reference
@@ -305,14 +305,15 @@ public:
    * @param state Aircraft state
    * @param end end point of aircraft path vector
    * @param perf Aircraft performance model
-   * @param solution Solution of intercept (set if intercept possible, else untouched)
-   * @return True if intercept found
+   * @param intersections scratch space for the intersections of the
+   * path vector; reusing it avoids heap allocations
+   * @return the solution (invalid if no intercept was found)
    */
-  [[gnu::pure]]
   AirspaceInterceptSolution Intercept(const AircraftState &state,
                                       const GeoPoint &end,
                                       const FlatProjection &projection,
-                                      const AirspaceAircraftPerformance &perf) const noexcept;
+                                      const AirspaceAircraftPerformance &perf,
+                                      AirspaceIntersectionVector &intersections) const noexcept;
 
 #ifdef DO_PRINT
   friend std::ostream &operator<<(std::ostream &f,
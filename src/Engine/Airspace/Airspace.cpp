@@ -28,12 +28,13 @@ Airspace::IsInside(const GeoPoint &loc) const noexcept
   return airspace->Inside(loc);
 }
 
-AirspaceIntersectionVector
+void
 Airspace::Intersects(const GeoPoint &g1, const GeoPoint &end,
-                     const FlatProjection &projection) const noexcept
+                     const FlatProjection &projection,
+                     AirspaceIntersectionVector &result) const noexcept
 {
   assert(airspace != nullptr);
-  return airspace->Intersects(g1, end, projection);
+  airspace->Intersects(g1, end, projection, result);
 }
 
 void
@@ -70,13 +70,11 @@ public:
    *
    * @param g1 Location of origin of search vector
    * @param end the end of the search vector
-   *
-   * @return true if the line intersects the airspace
+   * @param result receives the intersection pairs
    */
-  [[gnu::pure]]
-  AirspaceIntersectionVector Intersects(const GeoPoint &g1,
-                                        const GeoPoint &end,
-                                        const FlatProjection &projection) const noexcept;
+  void Intersects(const GeoPoint &g1, const GeoPoint &end,
+                  const FlatProjection &projection,
+                  AirspaceIntersectionVector &result) const noexcept;
 
   /**
    * Accessor for contained AbstractAirspace
@@ -31,10 +31,13 @@ AirspaceCircle::Inside(const GeoPoint &loc) const noexcept
   return loc.DistanceS(m_center) <= m_radius;
 }
 
-AirspaceIntersectionVector
+void
 AirspaceCircle::Intersects(const GeoPoint &start, const GeoPoint &end,
-                           const FlatProjection &projection) const noexcept
+                           const FlatProjection &projection,
+                           AirspaceIntersectionVector &result) const noexcept
 {
+  result.clear();
+
   const auto f_radius = projection.ProjectRangeFloat(m_center, m_radius);
   const auto f_center = projection.ProjectFloat(m_center);
   const auto f_start = projection.ProjectFloat(start);
@@ -43,14 +46,14 @@ AirspaceCircle::Intersects(const GeoPoint &start, const GeoPoint &end,
 
   const auto f_p = line.IntersectCircle(f_radius, f_center);
   if (!f_p)
-    return AirspaceIntersectionVector();
+    return;
 
   const auto &f_p1 = f_p->first;
   const auto &f_p2 = f_p->second;
 
   const auto mag = line.GetSquaredDistance();
   if (mag <= 0)
-    return AirspaceIntersectionVector();
+    return;
 
   const auto inv_mag = 1. / mag;
   const auto t1 = FlatLine(f_start, f_p1).DotProduct(line);
@@ -68,7 +71,7 @@ AirspaceCircle::Intersects(const GeoPoint &start, const GeoPoint &end,
   if (t2 >= 0 && in_range)
     sorter.add(t2 * inv_mag, projection.Unproject(f_p2));
 
-  return sorter.all();
+  sorter.all(result);
 }
 
 GeoPoint
@@ -38,9 +38,9 @@ public:
   }
 
   bool Inside(const GeoPoint &loc) const noexcept override;
-  AirspaceIntersectionVector Intersects(const GeoPoint &g1,
-                                        const GeoPoint &end,
-                                        const FlatProjection &projection) const noexcept override;
+  void Intersects(const GeoPoint &g1, const GeoPoint &end,
+                  const FlatProjection &projection,
+                  AirspaceIntersectionVector &result) const noexcept override;
   GeoPoint ClosestPoint(const GeoPoint &loc,
                         const FlatProjection &projection) const noexcept override;
 
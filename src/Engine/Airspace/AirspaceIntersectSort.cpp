@@ -24,10 +24,10 @@ AirspaceIntersectSort::top() const noexcept
   return std::nullopt;
 }
 
-AirspaceIntersectionVector
-AirspaceIntersectSort::all() noexcept
+void
+AirspaceIntersectSort::all(AirspaceIntersectionVector &res) noexcept
 {
-  AirspaceIntersectionVector res;
+  res.clear();
 
   GeoPoint p_last = m_start;
   bool waiting = false;
@@ -61,6 +61,4 @@ AirspaceIntersectSort::all() noexcept
   // fill last point if not matched 
   if (waiting)
     res.emplace_back(p_last, p_last);
-
-  return res;
 }
@@ -5,6 +5,8 @@
 
 #include "Geo/GeoPoint.hpp"
 
+#include <boost/container/small_vector.hpp>
+
 #include <optional>
 #include <queue>
 
@@ -27,7 +29,13 @@ class AirspaceIntersectSort {
     }
   };
 
-  std::priority_queue<Intersection, std::vector<Intersection>, Rank> m_q;
+  /**
+   * The queue keeps a few intersections inline, which is enough for
+   * nearly all lines, so sorting does not need the heap.
+   */
+  std::priority_queue<Intersection,
+                      boost::container::small_vector<Intersection, 8>,
+                      Rank> m_q;
 
   const GeoPoint& m_start;
   const AbstractAirspace &airspace;
@@ -67,9 +75,10 @@ public:
   std::optional<GeoPoint> top() const noexcept;
 
   /**
-   * Return vector of pairs of enter/exit intersections.
+   * Obtain the pairs of enter/exit intersections.
    *
-   * @return vector
+   * @param res the vector to be filled; its old contents are
+   * discarded, but its capacity is reused
    */
-  AirspaceIntersectionVector all() noexcept;
+  void all(AirspaceIntersectionVector &res) noexcept;
 };
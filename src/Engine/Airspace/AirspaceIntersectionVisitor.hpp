@@ -23,16 +23,12 @@ protected:
 
 public:
   /**
-   * Called by Airspaces prior to visiting the airspace to
-   * make available the point to the visitor.
-   *
-   * @param p Sorted vector of intercepts
-   *
-   * @return True if more than one intersection pair
+   * Called by Airspaces prior to visiting the airspace to fill in
+   * the sorted intercepts.  The vector lives as long as the visitor,
+   * so its capacity is reused for all airspaces.
    */
-  bool SetIntersections(AirspaceIntersectionVector &&p) {
-    intersections = std::move(p);
-    return !intersections.empty();
+  AirspaceIntersectionVector &GetIntersections() noexcept {
+    return intersections;
   }
 
 protected:
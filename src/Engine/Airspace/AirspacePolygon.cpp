@@ -58,9 +58,10 @@ AirspacePolygon::Inside(const GeoPoint &loc) const noexcept
   return m_border.IsInside(loc);
 }
 
-AirspaceIntersectionVector
+void
 AirspacePolygon::Intersects(const GeoPoint &start, const GeoPoint &end,
-                            const FlatProjection &projection) const noexcept
+                            const FlatProjection &projection,
+                            AirspaceIntersectionVector &result) const noexcept
 {
   const FlatRay ray(projection.ProjectInteger(start),
                     projection.ProjectInteger(end));
@@ -75,7 +76,7 @@ AirspacePolygon::Intersects(const GeoPoint &start, const GeoPoint &end,
       sorter.add(t, projection.Unproject(ray.Parametric(t)));
   }
 
-  return sorter.all();
+  sorter.all(result);
 }
 
 GeoPoint
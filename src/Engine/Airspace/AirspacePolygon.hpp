@@ -35,9 +35,9 @@ public:
   const GeoPoint GetReferenceLocation() const noexcept override;
   const GeoPoint GetCenter() const noexcept override;
   bool Inside(const GeoPoint &loc) const noexcept override;
-  AirspaceIntersectionVector Intersects(const GeoPoint &g1,
-                                        const GeoPoint &end,
-                                        const FlatProjection &projection) const noexcept override;
+  void Intersects(const GeoPoint &g1, const GeoPoint &end,
+                  const FlatProjection &projection,
+                  AirspaceIntersectionVector &result) const noexcept override;
   GeoPoint ClosestPoint(const GeoPoint &loc,
                         const FlatProjection &projection) const noexcept override;
 
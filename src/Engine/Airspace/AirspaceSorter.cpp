@@ -1,72 +1,69 @@
 #include "AirspaceSorter.hpp"
 #include "Airspace/Airspaces.hpp"
 #include "AbstractAirspace.hpp"
-#include "Predicate/AirspacePredicate.hpp"
-#include "Geo/GeoVector.hpp"
+#include "Geo/Math.hpp"
+#include "Geo/PreparedGeoPoint.hpp"
 #include "util/StringAPI.hxx"
 
 #include <algorithm>
 
 const GeoVector &
-AirspaceSelectInfo::GetVector(const GeoPoint &location,
+AirspaceSelectInfo::GetVector(const PreparedGeoPoint &location,
                               const FlatProjection &projection) const noexcept
 {
   if (!vec.IsValid()) {
-    const auto closest_loc = airspace->ClosestPoint(location, projection);
-    vec = GeoVector(location, closest_loc);
+    const auto closest_loc = airspace->ClosestPoint(location.location,
+                                                    projection);
+    DistanceBearing(location, closest_loc, &vec.distance, &vec.bearing);
   }
 
   return vec;
 }
 
-inline bool
-AirspaceFilterData::Match(const GeoPoint &location,
+const GeoVector &
+AirspaceSelectInfo::GetVector(const GeoPoint &location,
+                              const FlatProjection &projection) const noexcept
+{
+  if (!vec.IsValid())
+    return GetVector(PreparedGeoPoint{location}, projection);
+
+  return vec;
+}
+
+bool
+AirspaceFilterData::Match(const PreparedGeoPoint &location,
                           const FlatProjection &projection,
-                          const AbstractAirspace &as) const noexcept
+                          const AirspaceSelectInfo &info) const noexcept
 {
+  const AbstractAirspace &as = info.GetAirspace();
+
   if (cls != AirspaceClass::AIRSPACECLASSCOUNT && as.GetClass() != cls)
     return false;
 
   if (name_prefix != nullptr && !as.MatchNamePrefix(name_prefix))
     return false;
 
+  if (!HasGeoFilter())
+    return true;
+
+  /* the closest point is calculated only once, and the vector is
+     kept for sorting and for display */
+  const auto &vector = info.GetVector(location, projection);
+
   if (!direction.IsNegative()) {
-    const auto closest = as.ClosestPoint(location, projection);
-    const auto bearing = location.Bearing(closest);
-    auto direction_error = (bearing - direction).AsDelta().Absolute();
+    auto direction_error = (vector.bearing - direction).AsDelta().Absolute();
     if (direction_error > Angle::Degrees(18))
       return false;
   }
 
-  if (distance >= 0) {
-    const auto closest = as.ClosestPoint(location, projection);
-    const auto distance = location.Distance(closest);
-    if (distance > distance)
-      return false;
-  }
+  if (distance >= 0 && vector.distance > distance)
+    return false;
 
   return true;
 }
 
-class AirspaceFilterPredicate final {
-  const GeoPoint location;
-  const FlatProjection &projection;
-  const AirspaceFilterData &filter;
-
-public:
-  AirspaceFilterPredicate(const GeoPoint &_location,
-                          const FlatProjection &_projection,
-                          const AirspaceFilterData &_filter) noexcept
-    :location(_location), projection(_projection), filter(_filter) {}
-
-  [[gnu::pure]]
-  bool operator()(const AbstractAirspace &as) const noexcept {
-    return filter.Match(location, projection, as);
-  }
-};
-
 static void
-SortByDistance(AirspaceSelectInfoVector &vec, const GeoPoint &location,
+SortByDistance(AirspaceSelectInfoVector &vec, const PreparedGeoPoint &location,
                const FlatProjection &projection) noexcept
 {
   auto compare = [&] (const AirspaceSelectInfo &elem1,
@@ -91,24 +88,123 @@ SortByName(AirspaceSelectInfoVector &vec) noexcept
 }
 
 AirspaceSelectInfoVector
-FilterAirspaces(const Airspaces &airspaces, const GeoPoint &location,
+FilterAirspaces(const Airspaces &airspaces, const GeoPoint &_location,
                 const AirspaceFilterData &filter) noexcept
 {
-  const AirspaceFilterPredicate predicate(location, airspaces.GetProjection(),
-                                          filter);
+  const PreparedGeoPoint location{_location};
+  const auto &projection = airspaces.GetProjection();
+
   AirspaceSelectInfoVector result;
 
   auto range = filter.distance < 0
     ? airspaces.QueryAll()
-    : airspaces.QueryWithinRange(location, filter.distance);
-  for (const auto &i : range)
-    if (predicate(i.GetAirspace()))
-      result.emplace_back(i.GetAirspacePtr());
+    : airspaces.QueryWithinRange(_location, filter.distance);
+  for (const auto &i : range) {
+    AirspaceSelectInfo info(i.GetAirspacePtr());
+    if (filter.Match(location, projection, info))
+      result.push_back(std::move(info));
+  }
 
-  if (filter.direction.IsNegative() && filter.distance < 0)
+  if (!filter.HasGeoFilter())
     SortByName(result);
   else
-    SortByDistance(result, location, airspaces.GetProjection());
+    SortByDistance(result, location, projection);
+
+  return result;
+}
+
+inline bool
+AirspaceSearch::IsRefinement(const GeoPoint &_location,
+                             const AirspaceFilterData &filter) const noexcept
+{
+  if (!valid || airspaces.GetSerial() != serial)
+    return false;
+
+  if (cls != AirspaceClass::AIRSPACECLASSCOUNT && filter.cls != cls)
+    return false;
+
+  if (filter.direction != direction || filter.distance != distance)
+    return false;
+
+  if (filter.HasGeoFilter() && _location != search_location) {
+    const double max_displacement = distance >= 0
+      ? distance * MAX_DISPLACEMENT_RATIO
+      : MAX_DISPLACEMENT;
+    if (_location.Distance(search_location) > max_displacement)
+      return false;
+  }
+
+  /* the new name prefix must begin with the old one */
+  const TCHAR *new_prefix = filter.name_prefix != nullptr
+    ? filter.name_prefix
+    : _T("");
+  return StringIsEqualIgnoreCase(new_prefix, name_prefix.c_str(),
+                                 name_prefix.length());
+}
+
+inline void
+AirspaceSearch::UpdateNameIndex() noexcept
+{
+  if (by_name_valid && by_name_serial == airspaces.GetSerial())
+    return;
+
+  by_name.clear();
+  for (const auto &i : airspaces.QueryAll())
+    by_name.emplace_back(i.GetAirspacePtr());
+
+  SortByName(by_name);
+
+  by_name_serial = airspaces.GetSerial();
+  by_name_valid = true;
+}
+
+inline void
+AirspaceSearch::Save(const GeoPoint &_location,
+                     const AirspaceFilterData &filter) noexcept
+{
+  valid = true;
+  serial = airspaces.GetSerial();
+  location = _location;
+  cls = filter.cls;
+  name_prefix = filter.name_prefix != nullptr ? filter.name_prefix : _T("");
+  direction = filter.direction;
+  distance = filter.distance;
+}
+
+const AirspaceSelectInfoVector &
+AirspaceSearch::Update(const GeoPoint &_location,
+                       const AirspaceFilterData &filter) noexcept
+{
+  const PreparedGeoPoint location{_location};
+  const auto &projection = airspaces.GetProjection();
+
+  if (IsRefinement(_location, filter)) {
+    const bool moved = _location != this->location;
+    if (moved)
+      /* the vectors were calculated from the previous location */
+      for (auto &i : result)
+        i.ResetVector();
+
+    std::erase_if(result, [&](const AirspaceSelectInfo &i){
+      return !filter.Match(location, projection, i);
+    });
+
+    if (moved && filter.HasGeoFilter())
+      SortByDistance(result, location, projection);
+  } else {
+    if (!filter.HasGeoFilter()) {
+      UpdateNameIndex();
+
+      result.clear();
+      for (const auto &i : by_name)
+        if (filter.Match(location, projection, i))
+          result.push_back(i);
+    } else
+      result = FilterAirspaces(airspaces, _location, filter);
+
+    search_location = _location;
+  }
 
+  Save(_location, filter);
   return result;
 }
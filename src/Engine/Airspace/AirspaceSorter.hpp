@@ -5,12 +5,15 @@
 
 #include "Ptr.hpp"
 #include "Geo/GeoVector.hpp"
+#include "Geo/GeoPoint.hpp"
 #include "Airspace/AirspaceClass.hpp"
+#include "util/Serial.hpp"
+#include "util/tstring.hpp"
 
 #include <tchar.h>
 #include <vector>
 
-struct GeoPoint;
+struct PreparedGeoPoint;
 class AbstractAirspace;
 class Airspaces;
 class FlatProjection;
@@ -44,6 +47,14 @@ public:
   [[gnu::pure]]
   const GeoVector &GetVector(const GeoPoint &location,
                              const FlatProjection &projection) const noexcept;
+
+  /**
+   * Like GetVector(const GeoPoint &, const FlatProjection &), but
+   * with a precalculated origin for use in loops.
+   */
+  [[gnu::pure]]
+  const GeoVector &GetVector(const PreparedGeoPoint &location,
+                             const FlatProjection &projection) const noexcept;
 };
 
 using AirspaceSelectInfoVector = std::vector<AirspaceSelectInfo>;
@@ -73,10 +84,19 @@ struct AirspaceFilterData {
    */
   double distance = -1;
 
+  /**
+   * Does the airspace match this filter?  If the distance or
+   * direction filter is enabled, this calculates the vector to the
+   * closest point and caches it in the #AirspaceSelectInfo.
+   */
   [[gnu::pure]]
-  bool Match(const GeoPoint &location,
+  bool Match(const PreparedGeoPoint &location,
              const FlatProjection &projection,
-             const AbstractAirspace &as) const noexcept;
+             const AirspaceSelectInfo &info) const noexcept;
+
+  bool HasGeoFilter() const noexcept {
+    return !direction.IsNegative() || distance >= 0;
+  }
 };
 
 /**
@@ -89,3 +109,108 @@ struct AirspaceFilterData {
 AirspaceSelectInfoVector
 FilterAirspaces(const Airspaces &airspaces, const GeoPoint &location,
                 const AirspaceFilterData &filter) noexcept;
+
+/**
+ * Repeats FilterAirspaces() queries on one airspace database, e.g.
+ * while the user types a name into a search dialog.
+ *
+ * A list of all airspaces sorted by name is built once after each
+ * database change, so a name-only query doesn't need to sort.  A
+ * query which only narrows the previous one (a longer name prefix,
+ * or a class on top of a wildcard) filters the previous result,
+ * keeping its order and its cached vectors, instead of searching the
+ * whole database again.
+ *
+ * With a distance or direction filter, the aircraft may move a
+ * little between queries (see #MAX_DISPLACEMENT_RATIO); airspaces
+ * near the edge of the filter may then be missing until the next
+ * full search.
+ */
+class AirspaceSearch {
+  /**
+   * With a geo filter, a query is still a refinement if the aircraft
+   * has moved less than this fraction of the distance filter since
+   * the last full search.
+   */
+  static constexpr double MAX_DISPLACEMENT_RATIO = 0.01;
+
+  /**
+   * The maximum displacement if only the direction filter is
+   * enabled [m].
+   */
+  static constexpr double MAX_DISPLACEMENT = 100;
+
+  const Airspaces &airspaces;
+
+  /**
+   * All airspaces, sorted by name.
+   */
+  AirspaceSelectInfoVector by_name;
+
+  /**
+   * The #Airspaces serial of #by_name.
+   */
+  Serial by_name_serial;
+
+  bool by_name_valid = false;
+
+  /**
+   * Is there a previous result?
+   */
+  bool valid = false;
+
+  /**
+   * The #Airspaces serial of the previous result.
+   */
+  Serial serial;
+
+  /**
+   * The location of the last full search, which is the reference
+   * for #MAX_DISPLACEMENT_RATIO.
+   */
+  GeoPoint search_location;
+
+  /**
+   * The parameters of the previous result.
+   */
+  GeoPoint location;
+  AirspaceClass cls;
+  tstring name_prefix;
+  Angle direction;
+  double distance;
+
+  AirspaceSelectInfoVector result;
+
+public:
+  explicit AirspaceSearch(const Airspaces &_airspaces) noexcept
+    :airspaces(_airspaces) {}
+
+  /**
+   * Discard the previous result.
+   */
+  void Clear() noexcept {
+    valid = false;
+    result.clear();
+  }
+
+  const AirspaceSelectInfoVector &GetResult() const noexcept {
+    return result;
+  }
+
+  /**
+   * @return a filtered list of airspaces, sorted by name or distance
+   * (see FilterAirspaces()); it remains valid until the next call
+   */
+  const AirspaceSelectInfoVector &Update(const GeoPoint &location,
+                                         const AirspaceFilterData &filter) noexcept;
+
+private:
+  [[gnu::pure]]
+  bool IsRefinement(const GeoPoint &location,
+                    const AirspaceFilterData &filter) const noexcept;
+
+  void UpdateNameIndex() noexcept;
+
+  void Save(const GeoPoint &location,
+            const AirspaceFilterData &filter) noexcept;
+};
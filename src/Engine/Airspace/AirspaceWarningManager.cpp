@@ -18,6 +18,10 @@ AirspaceWarningManager::AirspaceWarningManager(const AirspaceWarningConfig &_con
   /* force filter initialisation in the first SetConfig() call */
   config.warning_time = AirspaceWarningConfig::Duration::max();
 
+  /* enough for nearly all vectors, so the buffer does not need to
+     grow during the flight */
+  intersections.reserve(16);
+
   SetConfig(_config);
 }
 
@@ -284,13 +288,19 @@ AirspaceWarningManager::UpdatePredicted(const AircraftState& state,
                                              warning_state, max_time_limit,
                                              ceiling);
 
+  /* lend our buffer to the visitor, so its capacity survives this
+     call */
+  visitor.GetIntersections().swap(intersections);
+
   airspaces.VisitIntersecting(state.location, location_predicted, visitor);
 
   visitor.SetMode(true);
 
-  for (const auto &i : airspaces.QueryInside(state.location)) {
+  airspaces.VisitInside(state.location, [&visitor](const Airspace &i){
     visitor.Visit(i.GetAirspacePtr());
-  }
+  });
+
+  intersections.swap(visitor.GetIntersections());
 
   return visitor.Found();
 }
@@ -378,7 +388,7 @@ AirspaceWarningManager::UpdateInside(const AircraftState& state,
 
   bool found = false;
 
-  for (const auto &i : airspaces.QueryInside(state.location)) {
+  airspaces.VisitInside(state.location, [&](const Airspace &i){
     const auto airspace = i.GetAirspacePtr();
 
     const AltitudeState &altitude = state;
@@ -386,7 +396,7 @@ AirspaceWarningManager::UpdateInside(const AircraftState& state,
         !airspace->IsActive() ||
         !config.IsClassEnabled(airspace->GetClass()) ||
         !airspace->Inside(altitude))
-      continue;
+      return;
 
     AirspaceWarning *warning = GetWarningPtr(*airspace);
 
@@ -395,7 +405,8 @@ AirspaceWarningManager::UpdateInside(const AircraftState& state,
       GeoPoint c = airspace->ClosestPoint(state.location, GetProjection());
       const AirspaceAircraftPerformance perf_glide(glide_polar);
       const AirspaceInterceptSolution solution =
-        airspace->Intercept(state, c, GetProjection(), perf_glide);
+        airspace->Intercept(state, c, GetProjection(), perf_glide,
+                            intersections);
 
       if (warning == nullptr)
         warning = GetNewWarningPtr(airspace);
@@ -403,7 +414,7 @@ AirspaceWarningManager::UpdateInside(const AircraftState& state,
       warning->UpdateSolution(AirspaceWarning::WARNING_INSIDE, solution);
       found = true;
     }
-  }
+  });
 
   return found;
 }
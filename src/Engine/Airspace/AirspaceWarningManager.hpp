@@ -5,6 +5,7 @@
 
 #include "AirspaceWarning.hpp"
 #include "AirspaceWarningConfig.hpp"
+#include "AirspaceIntersectionVector.hpp"
 #include "Util/AircraftStateFilter.hpp"
 #include "time/FloatDuration.hxx"
 #include "util/Serial.hpp"
@@ -43,6 +44,12 @@ class AirspaceWarningManager {
 
   AirspaceWarningList warnings;
 
+  /**
+   * Scratch space for the intersection calculations, kept here so
+   * its capacity is reused on each update.
+   */
+  AirspaceIntersectionVector intersections;
+
   /**
    * This number is incremented each time this object is modified.
    */
@@ -46,23 +46,39 @@ Airspaces::VisitIntersecting(const GeoPoint &loc, const GeoPoint &end,
                              bool include_inside,
                              AirspaceIntersectionVisitor &visitor) const noexcept
 {
-  for (const auto &i : QueryIntersecting(loc, end))
-    if (visitor.SetIntersections(i.Intersects(loc, end, task_projection)))
-      visitor.Visit(i.GetAirspacePtr());
+  if (IsEmpty())
+    // nothing to do
+    return;
+
+  const boost::geometry::model::segment line{
+    task_projection.ProjectInteger(loc),
+    task_projection.ProjectInteger(end),
+  };
+
+  /* this runs on every calculation tick; the query result is
+     consumed by a callback instead of QueryIntersecting()'s
+     type-erased iterator, and the intersection vector is reused, so
+     the steady state does not allocate any memory */
+  auto &intersections = visitor.GetIntersections();
+
+  airspace_tree.query(bgi::intersects(line),
+                      boost::make_function_output_iterator([&](const Airspace &i){
+                        i.Intersects(loc, end, task_projection, intersections);
+                        if (!intersections.empty())
+                          visitor.Visit(i.GetAirspacePtr());
+                      }));
 
   if (include_inside) {
-    for (const auto &i : QueryInside(loc)) {
+    VisitInside(loc, [&](const Airspace &i){
       if (i.IsInside(end)) {
         /* the vector is completely inside the airspace, and thus does
            not intersect with airspace's outline: on caller's request,
            report an intersection */
-        AirspaceIntersectionVector v;
-        v.reserve(1);
-        v.emplace_back(loc, end);
-        visitor.SetIntersections(std::move(v));
+        intersections.clear();
+        intersections.emplace_back(loc, end);
         visitor.Visit(i.GetAirspacePtr());
       }
-    }
+    });
   }
 }
 
@@ -124,6 +140,8 @@ Airspaces::Clear() noexcept
 
   // then delete the tree
   airspace_tree.clear();
+
+  ++serial;
 }
 
 unsigned
@@ -11,6 +11,8 @@
 #include "Geo/Flat/TaskProjection.hpp"
 #include "Atmosphere/Pressure.hpp"
 
+#include <boost/iterator/function_output_iterator.hpp>
+
 #include <deque>
 
 class RasterTerrain;
@@ -166,6 +168,28 @@ public:
   [[gnu::pure]]
   const_iterator_range QueryInside(const GeoPoint &location) const noexcept;
 
+  /**
+   * Call a function for each airspace this location is inside.
+   * Unlike QueryInside(), this does not allocate memory, and is
+   * therefore preferable in code running on every calculation tick.
+   *
+   * @param f a function accepting a "const Airspace &"
+   */
+  template<typename F>
+  void VisitInside(const GeoPoint &location, F &&f) const noexcept {
+    if (IsEmpty())
+      return;
+
+    const auto flat_location = task_projection.ProjectInteger(location);
+    const FlatBoundingBox box(flat_location, flat_location);
+
+    airspace_tree.query(boost::geometry::index::intersects(box),
+                        boost::make_function_output_iterator([&location, &f](const Airspace &as){
+                          if (as.IsInside(location))
+                            f(as);
+                        }));
+  }
+
   /**
    * Query airspaces the aircraft is inside (taking altitude into
    * account).
@@ -4,8 +4,7 @@
 #pragma once
 
 #include "util/ReservablePriorityQueue.hpp"
-
-#include <unordered_map>
+#include "util/FlatHashMap.hpp"
 
 struct AStarPriorityValue
 {
@@ -48,6 +47,9 @@ struct AStarPriorityValue
  * Modifications by John Wharington to track optimal solution
  * @see http://en.giswiki.net/wiki/Dijkstra%27s_algorithm
  *
+ * All containers keep their memory after Clear(), so a long-lived
+ * instance does not allocate after a few searches.
+ *
  * @param m_min Whether this algorithm will search for min or max distance
  */
 template <class Node, class Hash=std::hash<Node>,
@@ -55,21 +57,26 @@ template <class Node, class Hash=std::hash<Node>,
           bool m_min=true>
 class AStar
 {
-  typedef std::unordered_map<Node, AStarPriorityValue, Hash, KeyEqual> node_value_map;
+  struct NodeState {
+    /** The best value found so far */
+    AStarPriorityValue value;
 
-  typedef typename node_value_map::iterator node_value_iterator;
+    /** The predecessor on the best path found so far */
+    Node parent;
+  };
 
-  typedef std::unordered_map<Node, Node, Hash, KeyEqual> node_parent_map;
+  using NodeMap = FlatHashMap<Node, NodeState, Hash, KeyEqual>;
 
   struct NodeValue {
     AStarPriorityValue priority;
 
-    node_value_iterator iterator;
+    /** The index into #nodes */
+    std::size_t index;
 
     constexpr
     NodeValue(const AStarPriorityValue &_priority,
-              node_value_iterator _iterator) noexcept
-      :priority(_priority), iterator(_iterator) {}
+              std::size_t _index) noexcept
+      :priority(_priority), index(_index) {}
   };
 
   struct Rank {
@@ -80,23 +87,20 @@ class AStar
   };
 
   /**
-   * Stores the value of each node.  It is updated by push(), if a
-   * value lower than the current one is found.
-   */
-  node_value_map node_values;
-
-  /**
-   * Stores the predecessor of each node.  It is maintained by
-   * set_predecessor().
+   * Stores the value and the predecessor of each node.  It is updated
+   * by Push(), if a value lower than the current one is found.
    */
-  node_parent_map node_parents;
+  NodeMap nodes;
 
   /**
    * A sorted list of all possible node paths, lowest distance first.
    */
   reservable_priority_queue<NodeValue, std::vector<NodeValue>, Rank> q;
 
-  node_value_iterator cur;
+  /**
+   * The index of the node returned by Pop(), or NodeMap::NPOS.
+   */
+  std::size_t cur = NodeMap::NPOS;
 
 public:
   static constexpr unsigned DEFAULT_QUEUE_SIZE = 1024;
@@ -131,10 +135,9 @@ public:
     // Clear the search queue
     q.clear();
 
-    // Clear the node_parent_map
-    node_parents.clear();
-    // Clear the node_value_map
-    node_values.clear();
+    // Clear the node map
+    nodes.clear();
+    cur = NodeMap::NPOS;
   }
 
   /**
@@ -147,20 +150,30 @@ public:
     return q.empty();
   }
 
+  /**
+   * @return the number of distinct nodes reached so far
+   */
+  [[gnu::pure]]
+  std::size_t GetNodeCount() const noexcept {
+    return nodes.size();
+  }
+
   /**
    * Return top element of queue for processing
    *
-   * @return Node for processing
+   * @return Node for processing; the reference is invalidated by
+   * Link()
    */
   const Node &Pop() noexcept {
-    cur = q.top().iterator;
+    cur = q.top().index;
 
     do { // remove this item
       q.pop();
-    } while (!q.empty() && (q.top().priority > q.top().iterator->second));
+    } while (!q.empty() &&
+             (q.top().priority > nodes[q.top().index].value.value));
     // and all lower rank than this
 
-    return cur->first;
+    return nodes[cur].key;
   }
 
   /**
@@ -185,9 +198,9 @@ public:
    */
   [[gnu::pure]]
   Node GetPredecessor(const Node &node) const noexcept {
-    // Try to find the given node in the node_parent_map
-    const auto it = node_parents.find(node);
-    if (it == node_parents.end())
+    // Try to find the given node in the node map
+    const std::size_t i = nodes.find(node);
+    if (i == NodeMap::NPOS)
       // first entry
       // If the node wasn't found
       // -> Return the given node itself
@@ -195,7 +208,7 @@ public:
 
     // If the node was found
     // -> Return the parent node
-    return it->second;
+    return nodes[i].value.parent;
   }
 
   /** Reserve queue size (if available) */
@@ -209,14 +222,14 @@ public:
    */
   [[gnu::pure]]
   AStarPriorityValue GetNodeValue(const Node &node) const noexcept {
-    if (cur->first == node)
-      return cur->second;
+    if (cur != NodeMap::NPOS && KeyEqual{}(nodes[cur].key, node))
+      return nodes[cur].value.value;
 
-    const auto it = node_values.find(node);
-    if (it == node_values.end())
+    const std::size_t i = nodes.find(node);
+    if (i == NodeMap::NPOS)
       return AStarPriorityValue(0);
 
-    return it->second;
+    return nodes[i].value.value;
   }
 
 private:
@@ -229,37 +242,27 @@ private:
    */
   void Push(const Node &node, const Node &parent,
             const AStarPriorityValue &edge_value) noexcept {
-    // Try to find the given node n in the node_value_map
-    const auto [it, inserted] = node_values.try_emplace(node, edge_value);
+    // Try to find the given node n in the node map
+    const auto [i, inserted] =
+      nodes.try_emplace(node, NodeState{edge_value, parent});
     if (inserted) {
       // first entry
       // If the node wasn't found
-      // -> Insert a new node into the node_value_map
-
-      // Remember the parent node
-      SetPredecessor(node, parent);
-    } else if (it->second > edge_value) {
+      // -> A new entry with the parent node has been inserted
+    } else if (NodeState &state = nodes[i].value;
+               state.value > edge_value) {
       // If the node was found and the new value is smaller
       // -> Replace the value with the new one
-      it->second = edge_value;
+      state.value = edge_value;
       // replace, it's bigger
 
       // Remember the new parent node
-      SetPredecessor(node, parent);
+      state.parent = parent;
     } else
       // If the node was found but the value is higher or equal
       // -> Don't use this new leg
       return;
 
-    q.push(NodeValue(edge_value, it));
-  }
-
-  void SetPredecessor(const Node &node, const Node &parent) noexcept {
-    // Try to find the given node in the node_parent_map
-    auto result = node_parents.try_emplace(node, parent);
-    if (!result.second)
-      // If the node was found
-      // -> Replace the according parent node with the new one
-      result.first->second = parent;
+    q.push(NodeValue(edge_value, i));
   }
 };
@@ -9,6 +9,9 @@
 #include "Airspace/Predicate/AirspacePredicate.hpp"
 #include "Geo/Flat/FlatRay.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 // Airspace query helpers
 
 /**
@@ -178,6 +181,7 @@ AirspaceRoute::Reset() noexcept
   RoutePlanner::Reset();
   m_airspaces.ClearClearances();
   m_airspaces.Clear();
+  ResetVisibilityGraph();
 }
 
 void
@@ -194,8 +198,7 @@ AirspaceRoute::Synchronise(const Airspaces &master,
   // @todo: have margin for h_max to allow for climb
   AirspacePredicateHeightRangeExcludeTwo h_condition(h_min, h_max, origin, destination);
 
-  const auto and_condition = MakeAndPredicate(h_condition,
-                                              std::move(_condition));
+  const auto and_condition = MakeAndPredicate(h_condition, _condition);
   const auto predicate = WrapAirspacePredicate(and_condition);
 
   if (m_airspaces.SynchroniseInRange(master, origin.Middle(destination),
@@ -204,6 +207,8 @@ AirspaceRoute::Synchronise(const Airspaces &master,
     if (!m_airspaces.IsEmpty())
       dirty = true;
   }
+
+  UpdateVisibilityGraph(origin, destination);
 }
 
 inline void
@@ -272,7 +277,131 @@ AirspaceRoute::OnSolve(const AGeoPoint &origin,
     projection.SetCenter(origin);
   } else {
     projection = m_airspaces.GetProjection();
+
+    if (visibility_pending) {
+      auto graph = visibility_builder->Get(visibility_serial);
+      if (graph != nullptr)
+        SetVisibilityGraph(std::move(graph));
+    }
+  }
+}
+
+bool
+AirspaceRoute::ProposePath(const RoutePoint &origin,
+                           const RoutePoint &destination,
+                           bool retry,
+                           std::vector<FlatGeoPoint> &path) noexcept
+{
+  if (!rpolars_route.IsAirspaceEnabled() || visibility == nullptr)
+    return false;
+
+  if (!retry) {
+    visibility_blocked.clear();
+  } else {
+    /* the previous path was blocked; if it was an airspace (and not
+       terrain), avoid it at all altitudes in the next one */
+    if (m_inx.airspace == nullptr ||
+        std::find(visibility_blocked.begin(), visibility_blocked.end(),
+                  m_inx.airspace) != visibility_blocked.end())
+      return false;
+
+    visibility_blocked.push_back(m_inx.airspace);
   }
+
+  /* the altitude along the path, as calculated by
+     RoutePlanner::FollowPath() and checked by IsClear() */
+  const auto altitude_function = [this](FlatGeoPoint from, int altitude,
+                                        FlatGeoPoint to){
+    return rpolars_route.GenerateIntermediate(RoutePoint(from, altitude),
+                                              RoutePoint(to, altitude),
+                                              projection).second.altitude;
+  };
+
+  return visibility->FindPath(origin, origin.altitude, destination,
+                              altitude_function,
+                              visibility_blocked, visibility_ignored, path);
+}
+
+void
+AirspaceRoute::ResetVisibilityGraph() noexcept
+{
+  visibility.reset();
+  visibility_airspaces.clear();
+  visibility_ignored.clear();
+  next_airspaces.clear();
+  visibility_pending = false;
+}
+
+void
+AirspaceRoute::UpdateVisibilityGraph(const AGeoPoint &origin,
+                                     const AGeoPoint &destination) noexcept
+{
+  if (!visibility_enabled)
+    return;
+
+  std::vector<const AbstractAirspace *> current;
+  for (const auto &i : m_airspaces.QueryAll())
+    current.push_back(&i.GetAirspace());
+
+  std::sort(current.begin(), current.end());
+
+  /* RoutePlanner::Solve() keeps the route within this band */
+  const int band_min = std::min(origin.altitude, destination.altitude);
+  const int band_max = std::max(origin.altitude, destination.altitude);
+
+  if (visibility != nullptr &&
+      (band_min < visibility_min || band_max > visibility_max ||
+       !std::includes(visibility_airspaces.begin(), visibility_airspaces.end(),
+                      current.begin(), current.end()))) {
+    /* a new (or newly activated) airspace, or the route may now pass
+       above or below airspaces which are walls in the graph */
+    visibility.reset();
+    visibility_airspaces.clear();
+  }
+
+  /* airspaces which have been deactivated or which are out of range
+     now */
+  visibility_ignored.clear();
+  std::set_difference(visibility_airspaces.begin(), visibility_airspaces.end(),
+                      current.begin(), current.end(),
+                      std::back_inserter(visibility_ignored));
+
+  if (current.empty() ||
+      (current == next_airspaces &&
+       band_min >= next_min && band_max <= next_max))
+    return;
+
+  next_airspaces = std::move(current);
+  next_min = band_min - VISIBILITY_BAND_MARGIN;
+  next_max = band_max + VISIBILITY_BAND_MARGIN;
+
+  const auto &airspace_projection = m_airspaces.GetProjection();
+  AirspaceVisibilityGraph::Obstacles obstacles;
+  for (const auto *airspace : next_airspaces)
+    AirspaceVisibilityGraph::AddObstacle(obstacles, *airspace,
+                                         airspace_projection,
+                                         next_min, next_max);
+
+  if (visibility_builder == nullptr) {
+    SetVisibilityGraph(std::make_shared<const AirspaceVisibilityGraph>
+                       (std::move(obstacles)));
+  } else {
+    visibility_builder->Start(++visibility_serial, std::move(obstacles));
+    visibility_pending = true;
+  }
+}
+
+void
+AirspaceRoute::SetVisibilityGraph(std::shared_ptr<const AirspaceVisibilityGraph> graph) noexcept
+{
+  visibility = std::move(graph);
+  visibility_airspaces = next_airspaces;
+  visibility_min = next_min;
+  visibility_max = next_max;
+  visibility_pending = false;
+
+  /* #next_airspaces are the current ones */
+  visibility_ignored.clear();
 }
 
 /*
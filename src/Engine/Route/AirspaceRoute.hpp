@@ -4,8 +4,12 @@
 #pragma once
 
 #include "TerrainRoute.hpp"
+#include "AirspaceVisibilityGraph.hpp"
 #include "Airspace/Airspaces.hpp"
 
+#include <memory>
+#include <vector>
+
 class AirspaceRoute : public TerrainRoute {
   Airspaces m_airspaces;
 
@@ -24,6 +28,67 @@ class AirspaceRoute : public TerrainRoute {
 
   mutable RouteAirspaceIntersection m_inx;
 
+  /**
+   * The graph is built for a wider altitude band than the route's,
+   * so it need not be rebuilt whenever the aircraft climbs or
+   * descends a little [m].
+   */
+  static constexpr int VISIBILITY_BAND_MARGIN = 250;
+
+  /**
+   * Builds #visibility in background.  If this is nullptr, the graph
+   * is built synchronously by Synchronise().
+   */
+  AirspaceVisibilityGraphBuilder *visibility_builder = nullptr;
+
+  /**
+   * Identifies the last request to #visibility_builder.
+   */
+  unsigned visibility_serial = 0;
+
+  /**
+   * The visibility graph of #visibility_airspaces for the altitude
+   * band #visibility_min..#visibility_max, or nullptr.  It remains
+   * usable while #m_airspaces is a subset and the route stays within
+   * the band: the paths it finds are clear, but they may be longer
+   * than necessary until the graph of the new airspaces is ready.
+   */
+  std::shared_ptr<const AirspaceVisibilityGraph> visibility;
+
+  /**
+   * The airspaces (sorted by address) #visibility was built from.
+   */
+  std::vector<const AbstractAirspace *> visibility_airspaces;
+
+  int visibility_min, visibility_max;
+
+  /**
+   * Those #visibility_airspaces which are not in #m_airspaces, e.g.
+   * because they have been deactivated.
+   */
+  std::vector<const AbstractAirspace *> visibility_ignored;
+
+  /**
+   * The airspaces (sorted by address) and the altitude band of the
+   * graph which was requested last.
+   */
+  std::vector<const AbstractAirspace *> next_airspaces;
+
+  int next_min, next_max;
+
+  /**
+   * Is #visibility_builder building the graph of #next_airspaces?
+   */
+  bool visibility_pending = false;
+
+  bool visibility_enabled = true;
+
+  /**
+   * Airspaces which have blocked a path proposed in the current
+   * Solve() call.
+   */
+  std::vector<const AbstractAirspace *> visibility_blocked;
+
 public:
   friend class PrintHelper;
 
@@ -39,6 +104,34 @@ public:
   [[gnu::pure]]
   unsigned AirspaceSize() const noexcept;
 
+  /**
+   * Build the visibility graph in the given (background) builder
+   * instead of synchronously in Synchronise().  Until it is ready,
+   * routes are found with the previous graph if it is still usable,
+   * or by the A* search.
+   */
+  void SetVisibilityGraphBuilder(AirspaceVisibilityGraphBuilder *builder) noexcept {
+    visibility_builder = builder;
+    ResetVisibilityGraph();
+  }
+
+  /**
+   * Enable or disable the visibility graph.  Without it, every route
+   * is found by the A* search, which allows comparing the results.
+   */
+  void SetVisibilityGraphEnabled(bool enabled) noexcept {
+    visibility_enabled = enabled;
+    ResetVisibilityGraph();
+  }
+
+  /**
+   * Returns the visibility graph of the airspaces between origin and
+   * destination, or nullptr if it is not available (yet).
+   */
+  const AirspaceVisibilityGraph *GetVisibilityGraph() const noexcept {
+    return visibility.get();
+  }
+
 protected:
 
   void OnSolve(const AGeoPoint &origin, const AGeoPoint &destination) noexcept override;
@@ -51,10 +144,34 @@ protected:
   void AddNearby(const RouteLink &e) noexcept override;
   bool CheckSecondary(const RouteLink &e) noexcept override;
 
+  /**
+   * Proposes the shortest path around the airspaces found in the
+   * #visibility graph, avoiding the airspaces which have blocked the
+   * previous proposals.
+   */
+  bool ProposePath(const RoutePoint &origin, const RoutePoint &destination,
+                   bool retry,
+                   std::vector<FlatGeoPoint> &path) noexcept override;
+
 private:
   void AddNearbyAirspace(const RouteAirspaceIntersection &inx,
                          const RouteLink &e) noexcept;
 
+  void ResetVisibilityGraph() noexcept;
+
+  /**
+   * Check whether #visibility is still usable after #m_airspaces or
+   * the altitude band has changed, and start building a new graph if
+   * it is not the one of the current airspaces.
+   */
+  void UpdateVisibilityGraph(const AGeoPoint &origin,
+                             const AGeoPoint &destination) noexcept;
+
+  /**
+   * Use the graph of #next_airspaces.
+   */
+  void SetVisibilityGraph(std::shared_ptr<const AirspaceVisibilityGraph> graph) noexcept;
+
   [[gnu::pure]]
   RouteAirspaceIntersection FirstIntersecting(const RouteLink &e) const noexcept;
 
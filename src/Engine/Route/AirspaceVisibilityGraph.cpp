@@ -0,0 +1,418 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "AirspaceVisibilityGraph.hpp"
+#include "Airspace/AirspaceCircle.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "Math/Util.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+
+static constexpr int64_t
+Cross(FlatGeoPoint a, FlatGeoPoint b) noexcept
+{
+  return int64_t(a.x) * b.y - int64_t(a.y) * b.x;
+}
+
+static constexpr int
+Orientation(FlatGeoPoint a, FlatGeoPoint b, FlatGeoPoint c) noexcept
+{
+  const int64_t cross = Cross(b - a, c - a);
+  return (cross > 0) - (cross < 0);
+}
+
+/**
+ * Is the point inside the (closed, but without a duplicate end
+ * point) polygon?
+ */
+[[gnu::pure]]
+static bool
+IsInsidePolygon(const std::vector<FlatGeoPoint> &polygon,
+                FlatGeoPoint p) noexcept
+{
+  bool inside = false;
+  for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const FlatGeoPoint &a = polygon[i], &b = polygon[j];
+    if ((a.y > p.y) == (b.y > p.y))
+      continue;
+
+    const int64_t lhs = int64_t(p.x - a.x) * (b.y - a.y);
+    const int64_t rhs = int64_t(b.x - a.x) * (p.y - a.y);
+    if (b.y > a.y ? lhs < rhs : lhs > rhs)
+      inside = !inside;
+  }
+
+  return inside;
+}
+
+/**
+ * Does the link cross the border of the polygon?  Touching it is
+ * allowed.
+ */
+[[gnu::pure]]
+static bool
+CrossesPolygon(const std::vector<FlatGeoPoint> &polygon,
+               FlatGeoPoint a, FlatGeoPoint b) noexcept
+{
+  for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const FlatGeoPoint &p = polygon[i], &q = polygon[j];
+    if (Orientation(a, b, p) * Orientation(a, b, q) < 0 &&
+        Orientation(p, q, a) * Orientation(p, q, b) < 0)
+      return true;
+  }
+
+  return false;
+}
+
+static constexpr double
+SquaredDistance(FlatGeoPoint p, FlatPoint center) noexcept
+{
+  const FlatPoint d(p.x - center.x, p.y - center.y);
+  return d.DotProduct(d);
+}
+
+[[gnu::pure]]
+static bool
+IsInside(const AirspaceVisibilityGraph::Obstacle &o, FlatGeoPoint p) noexcept
+{
+  if (o.border.empty())
+    return SquaredDistance(p, o.center) < Square(o.radius);
+
+  return IsInsidePolygon(o.border, p);
+}
+
+[[gnu::pure]]
+static bool
+Crosses(const AirspaceVisibilityGraph::Obstacle &o,
+        FlatGeoPoint a, FlatGeoPoint b) noexcept
+{
+  if (!o.border.empty())
+    return CrossesPolygon(o.border, a, b);
+
+  /* the link crosses the circle if it comes closer to the center
+     than the radius, but does not stay inside */
+  const double r2 = Square(o.radius);
+  if (SquaredDistance(a, o.center) < r2 && SquaredDistance(b, o.center) < r2)
+    return false;
+
+  const FlatPoint pa(a.x - o.center.x, a.y - o.center.y);
+  const FlatPoint d(b.x - a.x, b.y - a.y);
+  const double l2 = d.DotProduct(d);
+  const double t = l2 > 0
+    ? std::clamp(-pa.DotProduct(d) / l2, 0., 1.)
+    : 0.;
+  const FlatPoint nearest = pa + d * t;
+  return nearest.DotProduct(nearest) < r2;
+}
+
+/**
+ * Remove consecutive duplicates, including the end point of a closed
+ * polygon.
+ */
+static void
+RemoveDuplicates(std::vector<FlatGeoPoint> &polygon) noexcept
+{
+  polygon.erase(std::unique(polygon.begin(), polygon.end()), polygon.end());
+
+  if (polygon.size() > 1 && polygon.front() == polygon.back())
+    polygon.pop_back();
+}
+
+void
+AirspaceVisibilityGraph::AddObstacle(Obstacles &obstacles,
+                                     const AbstractAirspace &airspace,
+                                     const FlatProjection &projection,
+                                     int h_min, int h_max) noexcept
+{
+  if (airspace.GetBase().altitude > h_max ||
+      airspace.GetTop().altitude < h_min)
+    return;
+
+  Obstacle o;
+  for (const auto &p : airspace.GetClearance(projection))
+    o.hull.push_back(p.GetFlatLocation());
+
+  RemoveDuplicates(o.hull);
+  if (o.hull.empty())
+    return;
+
+  if (airspace.GetShape() == AbstractAirspace::Shape::CIRCLE) {
+    const auto &circle = (const AirspaceCircle &)airspace;
+    o.center = projection.ProjectFloat(circle.GetCenter());
+    o.radius = projection.ProjectRangeFloat(circle.GetCenter(),
+                                            circle.GetRadius());
+  } else {
+    for (const auto &p : airspace.GetPoints())
+      o.border.push_back(p.GetFlatLocation());
+
+    RemoveDuplicates(o.border);
+    if (o.border.size() < 3)
+      return;
+  }
+
+  o.box = FlatBoundingBox(o.hull.begin(), o.hull.end());
+  o.airspace = &airspace;
+  o.base = (int)airspace.GetBase().altitude;
+  o.top = (int)airspace.GetTop().altitude;
+  o.wall = o.base <= h_min && o.top >= h_max;
+  obstacles.push_back(std::move(o));
+}
+
+AirspaceVisibilityGraph::AirspaceVisibilityGraph(Obstacles &&_obstacles) noexcept
+  :obstacles(std::move(_obstacles))
+{
+  std::size_t n_points = 0;
+  for (const auto &o : obstacles)
+    n_points += o.hull.size();
+
+  if (n_points > MAX_VERTICES)
+    /* too large: without vertices, FindPath() only finds direct
+       links */
+    return;
+
+  for (const auto &o : obstacles) {
+    for (std::size_t i = 0, n = o.hull.size(); i < n; ++i) {
+      const FlatGeoPoint p = o.hull[i];
+
+      /* a vertex inside a wall cannot be part of a path */
+      if (std::any_of(obstacles.begin(), obstacles.end(),
+                      [&o, p](const Obstacle &other){
+                        return other.wall && &other != &o &&
+                          other.box.IsInside(p) &&
+                          IsInside(other, p);
+                      }))
+        continue;
+
+      vertices.push_back({p, 0, 0});
+    }
+  }
+
+  std::vector<std::pair<unsigned, Edge>> pairs;
+  for (unsigned i = 0; i < vertices.size(); ++i) {
+    const Vertex &a = vertices[i];
+
+    for (unsigned j = i + 1; j < vertices.size(); ++j) {
+      const Vertex &b = vertices[j];
+
+      if (a.location == b.location)
+        continue;
+
+      FlatBoundingBox box(a.location);
+      box.Expand(b.location);
+
+      const unsigned first_crossing = crossings.size();
+      bool wall = false;
+      for (unsigned k = 0; k < obstacles.size(); ++k) {
+        const Obstacle &o = obstacles[k];
+        if (!o.box.Overlaps(box) ||
+            !Crosses(o, a.location, b.location))
+          continue;
+
+        if (o.wall) {
+          wall = true;
+          break;
+        }
+
+        crossings.push_back(k);
+      }
+
+      if (wall) {
+        crossings.resize(first_crossing);
+        continue;
+      }
+
+      const unsigned end_crossing = crossings.size();
+      pairs.push_back({i, {j, first_crossing, end_crossing}});
+      pairs.push_back({j, {i, first_crossing, end_crossing}});
+    }
+  }
+
+  std::sort(pairs.begin(), pairs.end(), [](const auto &x, const auto &y){
+    return x.first < y.first;
+  });
+
+  edges.reserve(pairs.size());
+  auto p = pairs.begin();
+  for (unsigned i = 0; i < vertices.size(); ++i) {
+    vertices[i].first_edge = edges.size();
+    for (; p != pairs.end() && p->first == i; ++p)
+      edges.push_back(p->second);
+    vertices[i].end_edge = edges.size();
+  }
+}
+
+bool
+AirspaceVisibilityGraph::IsBlockedBy(unsigned i,
+                                     const std::vector<ObstacleState> &state,
+                                     int altitude_a,
+                                     int altitude_b) const noexcept
+{
+  const Obstacle &o = obstacles[i];
+
+  switch (state[i]) {
+  case ObstacleState::DEFAULT:
+    break;
+
+  case ObstacleState::BLOCKED:
+    return true;
+
+  case ObstacleState::IGNORED:
+    return false;
+  }
+
+  return o.wall ||
+    (o.base <= std::max(altitude_a, altitude_b) &&
+     o.top >= std::min(altitude_a, altitude_b));
+}
+
+bool
+AirspaceVisibilityGraph::IsBlocked(FlatGeoPoint a, int altitude_a,
+                                   FlatGeoPoint b, int altitude_b,
+                                   const std::vector<ObstacleState> &state,
+                                   bool leave_a, bool enter_b) const noexcept
+{
+  FlatBoundingBox box(a);
+  box.Expand(b);
+
+  for (unsigned i = 0; i < obstacles.size(); ++i) {
+    const Obstacle &o = obstacles[i];
+    if (o.box.Overlaps(box) &&
+        IsBlockedBy(i, state, altitude_a, altitude_b) &&
+        Crosses(o, a, b) &&
+        !(leave_a && IsInside(o, a)) &&
+        !(enter_b && IsInside(o, b)))
+      return true;
+  }
+
+  return false;
+}
+
+bool
+AirspaceVisibilityGraph::FindPath(FlatGeoPoint origin, int altitude,
+                                  FlatGeoPoint destination,
+                                  const AltitudeFunction &altitude_function,
+                                  const std::vector<const AbstractAirspace *> &blocked,
+                                  const std::vector<const AbstractAirspace *> &ignored,
+                                  std::vector<FlatGeoPoint> &path) const noexcept
+{
+  path.clear();
+
+  std::vector<ObstacleState> state(obstacles.size(), ObstacleState::DEFAULT);
+  for (unsigned i = 0; i < obstacles.size(); ++i) {
+    const AbstractAirspace *airspace = obstacles[i].airspace;
+    if (std::binary_search(ignored.begin(), ignored.end(), airspace))
+      state[i] = ObstacleState::IGNORED;
+    else if (std::find(blocked.begin(), blocked.end(),
+                       airspace) != blocked.end())
+      state[i] = ObstacleState::BLOCKED;
+  }
+
+  if (!IsBlocked(origin, altitude,
+                 destination, altitude_function(origin, altitude, destination),
+                 state, true, true))
+    return true;
+
+  /* A* search over the vertices; node #n is the destination, and the
+     straight distance to it is the heuristic.  Checking a link is
+     more expensive than the rest, so the queue contains links, and
+     each one is checked only when it is the best candidate for
+     reaching its end (lazy A*).  The route's altitude at each node is
+     determined by the link through which it has been reached. */
+
+  static constexpr unsigned NONE = std::numeric_limits<unsigned>::max();
+  static constexpr unsigned ORIGIN = NONE - 1;
+
+  const unsigned n = vertices.size();
+  std::vector<unsigned> distance(n + 1, NONE), predecessor(n + 1, NONE);
+  std::vector<int> altitudes(n + 1);
+
+  struct Candidate {
+    /**
+     * The length of the route through this link plus the heuristic.
+     */
+    unsigned key;
+
+    unsigned from, to;
+
+    /**
+     * The index in #edges, or NONE for a link from the origin or to
+     * the destination.
+     */
+    unsigned edge;
+
+    constexpr bool operator>(const Candidate &other) const noexcept {
+      return key > other.key;
+    }
+  };
+
+  std::priority_queue<Candidate, std::vector<Candidate>,
+                      std::greater<Candidate>> queue;
+
+  const auto Push = [&](unsigned from, FlatGeoPoint from_location,
+                        unsigned d, unsigned to, unsigned edge){
+    const FlatGeoPoint to_location = to < n
+      ? vertices[to].location
+      : destination;
+    queue.push({d + from_location.Distance(to_location) +
+                to_location.Distance(destination),
+                from, to, edge});
+  };
+
+  for (unsigned i = 0; i < n; ++i)
+    Push(ORIGIN, origin, 0, i, NONE);
+
+  while (!queue.empty()) {
+    const Candidate c = queue.top();
+    queue.pop();
+
+    if (distance[c.to] != NONE)
+      /* already reached through a shorter route */
+      continue;
+
+    const FlatGeoPoint from = c.from == ORIGIN
+      ? origin
+      : vertices[c.from].location;
+    const int from_altitude = c.from == ORIGIN ? altitude : altitudes[c.from];
+    const unsigned from_distance = c.from == ORIGIN ? 0 : distance[c.from];
+
+    const FlatGeoPoint to = c.to < n ? vertices[c.to].location : destination;
+    const int to_altitude = altitude_function(from, from_altitude, to);
+
+    if (c.edge == NONE
+        ? IsBlocked(from, from_altitude, to, to_altitude, state,
+                    c.from == ORIGIN, c.to == n)
+        : std::any_of(crossings.begin() + edges[c.edge].first_crossing,
+                      crossings.begin() + edges[c.edge].end_crossing,
+                      [this, &state, from_altitude, to_altitude](unsigned k){
+                        return IsBlockedBy(k, state,
+                                           from_altitude, to_altitude);
+                      }))
+      continue;
+
+    distance[c.to] = from_distance + from.Distance(to);
+    predecessor[c.to] = c.from;
+    altitudes[c.to] = to_altitude;
+
+    if (c.to == n)
+      break;
+
+    const Vertex &v = vertices[c.to];
+    Push(c.to, to, distance[c.to], n, NONE);
+    for (unsigned e = v.first_edge; e != v.end_edge; ++e)
+      if (distance[edges[e].destination] == NONE)
+        Push(c.to, to, distance[c.to], edges[e].destination, e);
+  }
+
+  if (distance[n] == NONE)
+    return false;
+
+  for (unsigned i = predecessor[n]; i != ORIGIN; i = predecessor[i])
+    path.push_back(vertices[i].location);
+
+  std::reverse(path.begin(), path.end());
+  return true;
+}
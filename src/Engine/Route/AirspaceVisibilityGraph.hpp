@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/Flat/FlatGeoPoint.hpp"
+#include "Geo/Flat/FlatPoint.hpp"
+#include "Geo/Flat/FlatBoundingBox.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class AbstractAirspace;
+class FlatProjection;
+
+/**
+ * The visibility graph of a set of airspaces for an altitude band.
+ * Its nodes are the vertices of the airspaces' clearance hulls (the
+ * points which #AirspaceRoute detours around), and two nodes are
+ * connected if the straight line between them does not cross the
+ * border of an airspace which covers the whole band ("wall"),
+ * because no route within the band can cross such an airspace.  The
+ * hulls are larger than the airspaces, so links through a hull may be
+ * clear, and therefore links are not restricted to tangents.
+ *
+ * Airspaces which cover only a part of the band may or may not block
+ * a route, depending on its altitude.  Each link remembers which of
+ * them it crosses, and FindPath() checks their altitude range.
+ *
+ * Building the graph is expensive (all vertex pairs are tested
+ * against all airspaces), but it is immutable afterwards and may be
+ * shared between threads.  Finding a path around the airspaces is
+ * then a shortest path search which does not query the airspaces
+ * again.
+ */
+class AirspaceVisibilityGraph {
+public:
+  /**
+   * The shape of one airspace.
+   */
+  struct Obstacle {
+    /**
+     * The vertices of the clearance hull (see
+     * AbstractAirspace::GetClearance()).
+     */
+    std::vector<FlatGeoPoint> hull;
+
+    /**
+     * The border of a polygon airspace, which may be concave; empty
+     * for a circle.
+     */
+    std::vector<FlatGeoPoint> border;
+
+    /**
+     * The center and radius of a circle airspace.  Unlike its
+     * #border, which is a polygon around it, these are what
+     * AbstractAirspace::Intersects() uses.
+     */
+    FlatPoint center;
+    double radius;
+
+    /**
+     * The bounding box of #hull.
+     */
+    FlatBoundingBox box;
+
+    /**
+     * Identifies the airspace; it is only compared, never
+     * dereferenced.
+     */
+    const AbstractAirspace *airspace;
+
+    /**
+     * The altitude range of the airspace [m].
+     */
+    int base, top;
+
+    /**
+     * Does the airspace cover the whole altitude band?
+     */
+    bool wall;
+  };
+
+  typedef std::vector<Obstacle> Obstacles;
+
+  /**
+   * Calculates the altitude of a route at the end of a link, given
+   * the altitude at its start.
+   */
+  using AltitudeFunction =
+    std::function<int(FlatGeoPoint from, int altitude, FlatGeoPoint to)>;
+
+  /**
+   * Graphs with more vertices are not built.
+   */
+  static constexpr unsigned MAX_VERTICES = 4096;
+
+private:
+  Obstacles obstacles;
+
+  /**
+   * How FindPath() treats an obstacle.
+   */
+  enum class ObstacleState : uint8_t {
+    /**
+     * Block links within its altitude range.
+     */
+    DEFAULT,
+
+    /**
+     * Block links at all altitudes.
+     */
+    BLOCKED,
+
+    /**
+     * Never block links.
+     */
+    IGNORED,
+  };
+
+  struct Vertex {
+    FlatGeoPoint location;
+
+    /**
+     * The range of #edges leading from this vertex.
+     */
+    unsigned first_edge, end_edge;
+  };
+
+  std::vector<Vertex> vertices;
+
+  struct Edge {
+    unsigned destination;
+
+    /**
+     * The range of #crossings: the obstacles (which are not walls)
+     * this edge crosses.
+     */
+    unsigned first_crossing, end_crossing;
+  };
+
+  std::vector<Edge> edges;
+
+  std::vector<unsigned> crossings;
+
+public:
+  /**
+   * Append the shape of an airspace to the list, unless it does not
+   * overlap the given altitude band, and determine whether it covers
+   * the band.  This is cheap compared to building the graph, and
+   * copies everything needed for it, so the graph may be built in
+   * another thread while the airspaces are being modified.
+   */
+  static void AddObstacle(Obstacles &obstacles,
+                          const AbstractAirspace &airspace,
+                          const FlatProjection &projection,
+                          int h_min, int h_max) noexcept;
+
+  /**
+   * Build the graph.  If there are more than #MAX_VERTICES hull
+   * vertices, it has none, and FindPath() finds only direct links.
+   */
+  explicit AirspaceVisibilityGraph(Obstacles &&_obstacles) noexcept;
+
+  unsigned GetVertexCount() const noexcept {
+    return vertices.size();
+  }
+
+  unsigned GetEdgeCount() const noexcept {
+    return edges.size();
+  }
+
+  /**
+   * Find the shortest path between two points which does not cross
+   * any wall, and which does not cross any other airspace within its
+   * altitude range.  Airspaces containing one of the two points are
+   * ignored for the links from/to that point, so the path may leave
+   * or enter them there.
+   *
+   * @param altitude the altitude at the origin
+   * @param blocked airspaces which shall be avoided at all altitudes
+   * @param ignored airspaces (sorted by address) which shall be
+   * ignored, e.g. because they have been deactivated; links which
+   * were discarded because they cross one of these walls are not
+   * restored
+   * @param path receives the vertices between origin and destination;
+   * it is empty if the direct link is clear
+   * @return false if there is no such path
+   */
+  bool FindPath(FlatGeoPoint origin, int altitude, FlatGeoPoint destination,
+                const AltitudeFunction &altitude_function,
+                const std::vector<const AbstractAirspace *> &blocked,
+                const std::vector<const AbstractAirspace *> &ignored,
+                std::vector<FlatGeoPoint> &path) const noexcept;
+
+private:
+  /**
+   * Does a link crossing the specified obstacle between the given
+   * altitudes cross the airspace?
+   */
+  [[gnu::pure]]
+  bool IsBlockedBy(unsigned i, const std::vector<ObstacleState> &state,
+                   int altitude_a, int altitude_b) const noexcept;
+
+  /**
+   * Does the link cross an airspace?
+   *
+   * @param state the #ObstacleState of each obstacle
+   * @param leave_a ignore airspaces containing the start of the link
+   * @param enter_b ignore airspaces containing the end of the link
+   */
+  [[gnu::pure]]
+  bool IsBlocked(FlatGeoPoint a, int altitude_a,
+                 FlatGeoPoint b, int altitude_b,
+                 const std::vector<ObstacleState> &state,
+                 bool leave_a, bool enter_b) const noexcept;
+};
+
+/**
+ * Builds #AirspaceVisibilityGraph objects, possibly in another
+ * thread.  This allows the route planner to use a background thread
+ * without linking with the thread library.
+ */
+class AirspaceVisibilityGraphBuilder {
+public:
+  /**
+   * Start building a graph.  A previous request which has not been
+   * finished yet may be discarded.
+   *
+   * @param serial an identifier for the airspace set and altitude
+   * band
+   */
+  virtual void Start(unsigned serial,
+                     AirspaceVisibilityGraph::Obstacles &&obstacles) noexcept = 0;
+
+  /**
+   * Obtain the graph built for the given airspace set and altitude
+   * band.
+   *
+   * @return the graph or nullptr if it is not ready yet
+   */
+  virtual std::shared_ptr<const AirspaceVisibilityGraph> Get(unsigned serial) noexcept = 0;
+
+protected:
+  ~AirspaceVisibilityGraphBuilder() noexcept = default;
+};
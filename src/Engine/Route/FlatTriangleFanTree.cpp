@@ -6,8 +6,10 @@
 #include "RouteLink.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "ReachFanParms.hpp"
-#include "util/GlobalSliceAllocator.hxx"
 #include "Geo/Flat/FlatProjection.hpp"
+#include "thread/ParallelExecutor.hpp"
+
+#include <algorithm>
 
 #define REACH_SWEEP (ROUTEPOLAR_Q1-BUFFER)
 
@@ -27,77 +29,231 @@ TooClose(const FlatGeoPoint p1, const FlatGeoPoint p2) noexcept
   return dmax < FlatTriangleFanTree::MIN_STEP;
 }
 
-const FlatBoundingBox &
-FlatTriangleFanTree::CalcBoundingBox() noexcept
+FlatTriangleFanTree &
+FlatTriangleFanTree::operator=(const FlatTriangleFanTree &src) noexcept
 {
-  bb_children = fan.CalcBoundingBox();
+  if (nodes.size() < src.n_nodes)
+    nodes.resize(src.n_nodes);
 
-  for (auto &child : children)
-    bb_children.Merge(child.CalcBoundingBox());
+  /* element-wise assignment reuses the vertex buffers */
+  std::copy_n(src.nodes.begin(), src.n_nodes, nodes.begin());
+  n_nodes = src.n_nodes;
+  return *this;
+}
 
-  return bb_children;
+unsigned
+FlatTriangleFanTree::AllocateNode(uint_least8_t depth) noexcept
+{
+  const unsigned i = n_nodes;
+  if (i == nodes.size())
+    nodes.emplace_back();
+
+  Node &node = nodes[i];
+  node.fan.Clear();
+  node.first_child = node.next_sibling = NONE;
+  node.depth = depth;
+  node.gaps_filled = false;
+  return i;
+}
+
+void
+FlatTriangleFanTree::CommitNode(unsigned parent, unsigned i) noexcept
+{
+  assert(i == n_nodes);
+  assert(parent < i);
+
+  ++n_nodes;
+
+  /* insert at the front of the list, just like the old
+     std::forward_list implementation did; this determines the order
+     in which gaps are filled */
+  nodes[i].next_sibling = nodes[parent].first_child;
+  nodes[parent].first_child = i;
+}
+
+void
+FlatTriangleFanTree::CalcBoundingBoxes() noexcept
+{
+  /* children are always stored after their parent, so a backwards
+     iteration finishes all children before their parent */
+  for (unsigned i = n_nodes; i-- > 0;) {
+    Node &node = nodes[i];
+    node.bb_children = node.fan.CalcBoundingBox();
+
+    for (unsigned c = node.first_child; c != NONE; c = nodes[c].next_sibling)
+      node.bb_children.Merge(nodes[c].bb_children);
+  }
 }
 
 void
 FlatTriangleFanTree::FillReach(const AFlatGeoPoint &origin,
                                ReachFanParms &parms) noexcept
 {
-  gaps_filled = false;
+  Clear();
+
+  const unsigned root = AllocateNode(0);
+  assert(root == 0);
+  ++n_nodes;
 
-  FillReach(origin, 0, ROUTEPOLAR_POINTS, parms);
+  FillReach(root, origin, 0, ROUTEPOLAR_POINTS, parms);
 
   for (parms.set_depth = 0; parms.set_depth < MAX_DEPTH;
       ++parms.set_depth)
-    if (!FillDepth(origin, parms))
+    if (!FillDepth(root, origin, parms))
       // stop searching
       break;
 
-  // this boundingbox update visits the tree recursively
-  CalcBoundingBox();
+  CalcBoundingBoxes();
 }
 
 void
 FlatTriangleFanTree::DummyReach(const AFlatGeoPoint &ao) noexcept
 {
-  assert(children.empty());
+  Clear();
+
+  AllocateNode(0);
+  ++n_nodes;
 
-  fan.AddOrigin(ao, 0);
-  CalcBoundingBox();
+  nodes.front().fan.AddOrigin(ao, 0);
+  CalcBoundingBoxes();
 }
 
 bool
-FlatTriangleFanTree::FillDepth(const AFlatGeoPoint &origin,
+FlatTriangleFanTree::TranslateReach(const FlatTriangleFanTree &reference,
+                                    const FlatProjection &reference_projection,
+                                    const AFlatGeoPoint &origin,
+                                    ReachFanParms &parms) noexcept
+{
+  assert(!reference.IsEmpty());
+  assert(&reference != this);
+
+  Clear();
+
+  const unsigned root = AllocateNode(0);
+  ++n_nodes;
+
+  if (!FillReach(root, origin, 0, ROUTEPOLAR_POINTS, parms))
+    return false;
+
+  /* the displacement in this tree's projection */
+  const GeoPoint reference_origin =
+    reference_projection.Unproject(reference.GetOrigin());
+  const FlatGeoPoint delta{FlatGeoPoint(origin) -
+    parms.projection.ProjectInteger(reference_origin)};
+
+  const Node &reference_root = reference.nodes.front();
+  for (unsigned c = reference_root.first_child; c != NONE;
+       c = reference.nodes[c].next_sibling)
+    RefillTranslated(reference, reference_projection, c, root, delta, parms);
+
+  CalcBoundingBoxes();
+  return true;
+}
+
+void
+FlatTriangleFanTree::RefillTranslated(const FlatTriangleFanTree &src,
+                                      const FlatProjection &src_projection,
+                                      unsigned src_index, unsigned parent,
+                                      FlatGeoPoint delta,
+                                      ReachFanParms &parms) noexcept
+{
+  const Node &src_node = src.nodes[src_index];
+
+  /* the height of a gap origin is the pure glide from the parent's
+     origin, just like in FillGap() */
+  const AFlatGeoPoint parent_origin = nodes[parent].fan.GetOrigin();
+  const GeoPoint src_origin = src_projection.Unproject(src_node.fan.GetOrigin());
+  const FlatGeoPoint p{parms.projection.ProjectInteger(src_origin) + delta};
+  const AFlatGeoPoint x(p, parms.rpolars.CalcGlideArrival(parent_origin, p,
+                                                          parms.projection));
+
+  /* discard gaps whose origin has left the parent fan, or which
+     cannot be reached from the parent's origin any more */
+  if (!nodes[parent].fan.IsInside(p, nodes[parent].IsRoot()))
+    return;
+
+  if (parms.terrain != nullptr) {
+    const AGeoPoint a(parms.projection.Unproject(parent_origin),
+                      parent_origin.altitude);
+    const AGeoPoint b(parms.projection.Unproject(p), x.altitude);
+    if (parms.rpolars.Intersection(a, b, parms.terrain,
+                                   parms.projection).IsValid())
+      return;
+  }
+
+  const unsigned i = AllocateNode(src_node.depth);
+  if (!FillReach(i, x, src_node.index_low, src_node.index_high, parms))
+    return;
+
+  nodes[i].gaps_filled = src_node.gaps_filled;
+  parms.vertex_counter += nodes[i].fan.GetVertices().size();
+  parms.fan_counter++;
+  CommitNode(parent, i);
+
+  for (unsigned c = src_node.first_child; c != NONE;
+       c = src.nodes[c].next_sibling)
+    RefillTranslated(src, src_projection, c, i, delta, parms);
+}
+
+bool
+FlatTriangleFanTree::FillDepth(unsigned i, const AFlatGeoPoint &origin,
                                ReachFanParms &parms) noexcept
 {
-  if (depth == parms.set_depth) {
-    if (gaps_filled)
+  if (nodes[i].depth == parms.set_depth) {
+    if (nodes[i].gaps_filled)
       return true;
-    gaps_filled = true;
+    nodes[i].gaps_filled = true;
 
     if (parms.vertex_counter > MAX_VERTICES)
       return false;
     if (parms.fan_counter > MAX_FANS)
       return false;
 
-    FillGaps(origin, parms);
-  } else if (depth < parms.set_depth) {
-    for (auto &child : children)
-      if (!child.FillDepth(origin, parms))
+    FillGaps(i, origin, parms);
+  } else if (nodes[i].depth < parms.set_depth) {
+    for (unsigned c = nodes[i].first_child; c != NONE;
+         c = nodes[c].next_sibling)
+      if (!FillDepth(c, origin, parms))
         return false; // stop searching
   }
   return true;
 }
 
+/**
+ * Calculate the reach intercepts for a range of polar indices.
+ */
+static void
+ReachInterceptRange(const AFlatGeoPoint &origin, const GeoPoint &geo_origin,
+                    const int index_low, const int index_high,
+                    const ReachFanParms &parms,
+                    FlatGeoPoint *dest) noexcept
+{
+  for (int index = index_low; index < index_high; ++index) {
+    FlatGeoPoint x = parms.ReachIntercept(index, origin, geo_origin);
+    /* if ReachIntercept() did not find anything reasonable it returns
+       a FlatGeoPoint that is almost the same as origin, but differs
+       +/- 1 due to conversion errors. The resulting polygon can have
+       overlapping edges causing triangulation failures. */
+    if (AlmostTheSame(origin, x))
+      x = origin;
+
+    *dest++ = x;
+  }
+}
+
 bool
-FlatTriangleFanTree::FillReach(const AFlatGeoPoint &origin, const int index_low,
-                               const int index_high,
-                               const ReachFanParms &parms) noexcept
+FlatTriangleFanTree::FillFan(FlatTriangleFan &fan, const bool is_root,
+                             const AFlatGeoPoint &origin,
+                             const int index_low, const int index_high,
+                             const ReachFanParms &parms) noexcept
 {
+  assert(index_high - index_low <= int(ROUTEPOLAR_POINTS));
+
   const GeoPoint geo_origin = parms.projection.Unproject(origin);
   fan.SetHeight(origin.altitude);
 
   // fill vector
-  if (!IsRoot()) {
+  if (!is_root) {
     const int index_mid = (index_high + index_low) / 2;
     const FlatGeoPoint x_mid = parms.ReachIntercept(index_mid, origin,
                                                     geo_origin);
@@ -105,45 +261,129 @@ FlatTriangleFanTree::FillReach(const AFlatGeoPoint &origin, const int index_low,
       return false;
   }
 
-  fan.AddOrigin(origin, index_high - index_low);
-  for (int index = index_low; index < index_high; ++index) {
-    FlatGeoPoint x = parms.ReachIntercept(index, origin, geo_origin);
-    /* if ReachIntercept() did not find anything reasonable it returns
-       a FlatGeoPoint that is almost the same as origin, but differs
-       +/- 1 due to conversion errors. The resulting polygon can have
-       overlapping edges causing triangulation failures. */
-    if (AlmostTheSame(origin, x))
-      x = origin;
+  const unsigned n = index_high - index_low;
+  FlatGeoPoint intercepts[ROUTEPOLAR_POINTS];
+
+  if (is_root && parms.executor != nullptr) {
+    /* the root fan spans all directions, and its terrain
+       intersections are the most expensive part of the calculation:
+       split it into angular sectors which are calculated
+       concurrently */
+    const unsigned n_sectors = std::min(parms.executor->GetConcurrency(), n);
+    parms.executor->ForEach(n_sectors, [&](unsigned sector){
+      const int low = index_low + n * sector / n_sectors;
+      const int high = index_low + n * (sector + 1) / n_sectors;
+      ReachInterceptRange(origin, geo_origin, low, high, parms,
+                          intercepts + (low - index_low));
+    });
+  } else
+    ReachInterceptRange(origin, geo_origin, index_low, index_high, parms,
+                        intercepts);
+
+  fan.AddOrigin(origin, n);
+  for (unsigned j = 0; j < n; ++j)
+    fan.AddPoint(intercepts[j]);
+
+  return fan.CommitPoints(is_root);
+}
 
-    fan.AddPoint(x);
+void
+FlatTriangleFanTree::FillGaps(unsigned i, const AFlatGeoPoint &origin,
+                              ReachFanParms &parms) noexcept
+{
+  // worth checking for gaps?
+  if (nodes[i].fan.GetVertices().size() <= 2 ||
+      !parms.rpolars.IsTurningReachEnabled())
+    return;
+
+  if (parms.executor != nullptr) {
+    FillGapsParallel(i, origin, parms);
+    return;
   }
 
-  return fan.CommitPoints(IsRoot());
+  /* CheckGap() may add nodes, which may reallocate the array and
+     invalidate references to the vertices; therefore iterate by
+     index */
+  const auto Vertex = [this, i](std::size_t j){
+    return nodes[i].fan.GetVertices()[j];
+  };
+
+  const std::size_t n_vertices = nodes[i].fan.GetVertices().size();
+
+  // now check gaps
+  RouteLink e_last(RoutePoint(Vertex(0), 0), origin, parms.projection);
+  for (std::size_t j = 1; j < n_vertices; ++j) {
+    const FlatGeoPoint x = Vertex(j), x_last = Vertex(j - 1);
+    if (TooClose(x, origin) || TooClose(x_last, origin))
+      continue;
+
+    const RouteLink e(RoutePoint(x, 0), origin, parms.projection);
+    // check if children need to be added
+    CheckGap(i, origin, e_last, e, parms);
+
+    e_last = e;
+  }
 }
 
 void
-FlatTriangleFanTree::FillGaps(const AFlatGeoPoint &origin,
-                              ReachFanParms &parms) noexcept
+FlatTriangleFanTree::FillGapsParallel(unsigned i, const AFlatGeoPoint &origin,
+                                      ReachFanParms &parms) noexcept
 {
-  // worth checking for gaps?
-  if (const auto vertices = fan.GetVertices();
-      vertices.size() > 2 && parms.rpolars.IsTurningReachEnabled()) {
-
-    // now check gaps
-    RouteLink e_last(RoutePoint(vertices.front(), 0),
-                     origin, parms.projection);
-    for (auto x_last = vertices.begin(), end = vertices.end(),
-         x = x_last + 1; x != end; x_last = x++) {
-      if (TooClose(*x, origin) || TooClose(*x_last, origin))
-        continue;
-
-      const RouteLink e(RoutePoint(*x, 0), origin, parms.projection);
-      // check if children need to be added
-      CheckGap(origin, e_last, e, parms);
-
-      e_last = e;
-    }
+  /* collect the gaps first, in the same order as FillGaps() would
+     check them */
+  const auto vertices = nodes[i].fan.GetVertices();
+
+  unsigned n_jobs = 0;
+  unsigned last = 0;
+  for (unsigned j = 1; j < vertices.size(); ++j) {
+    if (TooClose(vertices[j], origin) || TooClose(vertices[j - 1], origin))
+      continue;
+
+    if (n_jobs == gap_jobs.size())
+      gap_jobs.emplace_back();
+
+    gap_jobs[n_jobs].a = last;
+    gap_jobs[n_jobs].b = j;
+    ++n_jobs;
+
+    last = j;
   }
+
+  /* calculate the child fans; this does not modify the tree, and
+     #vertices stays valid */
+  parms.executor->ForEach(n_jobs, [&](unsigned j){
+    GapJob &job = gap_jobs[j];
+    const RouteLink e_1(RoutePoint(vertices[job.a], 0), origin,
+                        parms.projection);
+    const RouteLink e_2(RoutePoint(vertices[job.b], 0), origin,
+                        parms.projection);
+    job.found = FillGap(job.fan, origin, e_1, e_2, parms,
+                        job.index_low, job.index_high);
+  });
+
+  /* add them to the tree in the original order */
+  for (unsigned j = 0; j < n_jobs; ++j)
+    if (gap_jobs[j].found)
+      AddGap(i, std::move(gap_jobs[j].fan),
+             gap_jobs[j].index_low, gap_jobs[j].index_high, parms);
+}
+
+void
+FlatTriangleFanTree::AddGap(unsigned parent, FlatTriangleFan &&fan,
+                            int index_low, int index_high,
+                            ReachFanParms &parms) noexcept
+{
+  const unsigned child = AllocateNode(nodes[parent].depth + 1);
+
+  /* swap instead of move-assigning to recycle the vertex buffer of
+     the node */
+  std::swap(nodes[child].fan, fan);
+  nodes[child].index_low = index_low;
+  nodes[child].index_high = index_high;
+
+  parms.vertex_counter += nodes[child].fan.GetVertices().size();
+  parms.fan_counter++;
+  CommitNode(parent, child);
 }
 
 void
@@ -155,7 +395,7 @@ FlatTriangleFanTree::UpdateTerrainBase(const FlatGeoPoint o,
     return;
   }
 
-  for (const auto &x : fan.GetVertices()) {
+  for (const auto &x : GetRoot().fan.GetVertices()) {
     const FlatGeoPoint av = (o + x) * 0.5;
     const GeoPoint p = parms.projection.Unproject(av);
     const auto h = parms.terrain->GetHeight(p);
@@ -174,9 +414,31 @@ FlatTriangleFanTree::UpdateTerrainBase(const FlatGeoPoint o,
 }
 
 bool
-FlatTriangleFanTree::CheckGap(const AFlatGeoPoint &n, const RouteLink &e_1,
+FlatTriangleFanTree::CheckGap(unsigned i,
+                              const AFlatGeoPoint &n, const RouteLink &e_1,
                               const RouteLink &e_2,
                               ReachFanParms &parms) noexcept
+{
+  const unsigned child = AllocateNode(nodes[i].depth + 1);
+  int index_low, index_high;
+  if (!FillGap(nodes[child].fan, n, e_1, e_2, parms, index_low, index_high))
+    return false;
+
+  nodes[child].index_low = index_low;
+  nodes[child].index_high = index_high;
+
+  parms.vertex_counter += nodes[child].fan.GetVertices().size();
+  parms.fan_counter++;
+  CommitNode(i, child);
+  return true;
+}
+
+bool
+FlatTriangleFanTree::FillGap(FlatTriangleFan &fan,
+                             const AFlatGeoPoint &n, const RouteLink &e_1,
+                             const RouteLink &e_2,
+                             const ReachFanParms &parms,
+                             int &index_low, int &index_high) noexcept
 {
   const bool side = (e_1.d > e_2.d);
   const RouteLink &e_long = (side ? e_1 : e_2);
@@ -214,11 +476,10 @@ FlatTriangleFanTree::CheckGap(const AFlatGeoPoint &n, const RouteLink &e_1,
     // altitude calculated from pure glide from n to x
     const AFlatGeoPoint x(px, h);
 
-    FlatTriangleFanTree child(depth + 1);
-    if (child.FillReach(x, index_left, index_right, parms)) {
-      parms.vertex_counter += child.fan.GetVertices().size();
-      parms.fan_counter++;
-      children.emplace_front(std::move(child));
+    fan.Clear();
+    if (FillFan(fan, false, x, index_left, index_right, parms)) {
+      index_low = index_left;
+      index_high = index_right;
       return true;
     }
   }
@@ -231,23 +492,26 @@ FlatTriangleFanTree::DirectArrival(FlatGeoPoint dest,
                                    const ReachFanParms &parms) const noexcept
 {
   assert(!IsEmpty());
-  return parms.rpolars.CalcGlideArrival(fan.GetOrigin(), dest, parms.projection);
+  return parms.rpolars.CalcGlideArrival(GetRoot().fan.GetOrigin(), dest,
+                                        parms.projection);
 }
 
 bool
-FlatTriangleFanTree::FindPositiveArrival(const FlatGeoPoint n,
+FlatTriangleFanTree::FindPositiveArrival(unsigned i, const FlatGeoPoint n,
                                          const ReachFanParms &parms,
                                          int &arrival_height) const noexcept
 {
-  if (GetHeight() < arrival_height)
+  const Node &node = nodes[i];
+
+  if (node.fan.GetHeight() < arrival_height)
     return false; // can't possibly improve
 
-  if (!bb_children.IsInside(n))
+  if (!node.bb_children.IsInside(n))
     return false; // not in scope
 
-  if (fan.IsInside(n, IsRoot())) { // found in this segment
+  if (node.fan.IsInside(n, node.IsRoot())) { // found in this segment
     const int h =
-      parms.rpolars.CalcGlideArrival(fan.GetOrigin(), n, parms.projection);
+      parms.rpolars.CalcGlideArrival(node.fan.GetOrigin(), n, parms.projection);
     if (h > arrival_height) {
       arrival_height = h;
       return true;
@@ -259,8 +523,8 @@ FlatTriangleFanTree::FindPositiveArrival(const FlatGeoPoint n,
   }
 
   bool retval = false;
-  for (const auto &child : children)
-    if (child.FindPositiveArrival(n, parms, arrival_height))
+  for (unsigned c = node.first_child; c != NONE; c = nodes[c].next_sibling)
+    if (FindPositiveArrival(c, n, parms, arrival_height))
       /* no short-circuit here because another child may improve the
          arrival height */
       retval = true;
@@ -269,14 +533,16 @@ FlatTriangleFanTree::FindPositiveArrival(const FlatGeoPoint n,
 }
 
 void
-FlatTriangleFanTree::AcceptInRange(const FlatBoundingBox &bb,
+FlatTriangleFanTree::AcceptInRange(unsigned i, const FlatBoundingBox &bb,
                                    FlatTriangleFanVisitor &visitor) const noexcept
 {
-  if (!bb.Overlaps(bb_children))
+  const Node &node = nodes[i];
+
+  if (!bb.Overlaps(node.bb_children))
     return;
 
-  fan.AcceptInRange(bb, visitor, IsRoot());
+  node.fan.AcceptInRange(bb, visitor, node.IsRoot());
 
-  for (const auto &child : children)
-    child.AcceptInRange(bb, visitor);
+  for (unsigned c = node.first_child; c != NONE; c = nodes[c].next_sibling)
+    AcceptInRange(c, bb, visitor);
 }
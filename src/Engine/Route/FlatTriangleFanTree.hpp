@@ -4,11 +4,11 @@
 #pragma once
 
 #include "Geo/Flat/FlatBoundingBox.hpp"
-#include "util/SliceAllocator.hxx"
 #include "FlatTriangleFan.hpp"
 
+#include <cassert>
 #include <cstdint>
-#include <forward_list>
+#include <vector>
 
 class FlatProjection;
 struct GeoPoint;
@@ -17,6 +17,14 @@ struct AFlatGeoPoint;
 struct ReachFanParms;
 class FlatTriangleFanVisitor;
 
+/**
+ * A tree of #FlatTriangleFan objects: the root fan around the
+ * origin, and child fans which fill the gaps behind obstacles.
+ *
+ * All nodes are stored in one flat array, parents before their
+ * children.  Clearing the tree keeps the nodes (and their vertex
+ * buffers) allocated for the next calculation.
+ */
 class FlatTriangleFanTree
 {
   static constexpr unsigned BUFFER = 1;
@@ -24,46 +32,138 @@ class FlatTriangleFanTree
   static constexpr unsigned MAX_DEPTH = 4;
   static constexpr unsigned MAX_VERTICES = 2000;
 
+  static constexpr uint16_t NONE = UINT16_MAX;
+
 public:
   static constexpr unsigned MIN_STEP = 25;
   static constexpr unsigned MAX_FANS = 300;
 
 private:
-  FlatTriangleFan fan;
+  struct Node {
+    FlatTriangleFan fan;
+
+    /**
+     * The bounding box of this fan and all of its descendants.
+     */
+    FlatBoundingBox bb_children;
+
+    /**
+     * Array indices of the first child and of the next sibling, or
+     * #NONE.
+     */
+    uint16_t first_child, next_sibling;
+
+    /**
+     * The range of polar indices which #fan was calculated for; see
+     * FillFan().
+     */
+    int16_t index_low, index_high;
+
+    uint_least8_t depth;
+    bool gaps_filled;
+
+    bool IsRoot() const noexcept {
+      return depth == 0;
+    }
+  };
+
+  /**
+   * All nodes; the root is the first one.  Only the first #n_nodes
+   * elements are in use.
+   */
+  std::vector<Node> nodes;
+
+  unsigned n_nodes = 0;
+
+  /**
+   * A gap of a fan being filled by a #ParallelExecutor; see
+   * FillGapsParallel().
+   */
+  struct GapJob {
+    /**
+     * Indices of the two vertices enclosing the gap.
+     */
+    unsigned a, b;
+
+    FlatTriangleFan fan;
 
-  using LeafVector =
-    std::forward_list<FlatTriangleFanTree,
-                      GlobalSliceAllocator<FlatTriangleFanTree, 128u>>;
+    int index_low, index_high;
 
-  FlatBoundingBox bb_children;
-  LeafVector children;
-  uint_least8_t depth;
-  bool gaps_filled = false;
+    bool found;
+  };
+
+  /**
+   * Buffer for FillGapsParallel(), kept allocated for the next
+   * calculation.
+   */
+  std::vector<GapJob> gap_jobs;
 
 public:
   friend class PrintHelper;
 
-  explicit FlatTriangleFanTree(const uint_least8_t _depth = 0) noexcept
-    :depth(_depth) {}
+  FlatTriangleFanTree() noexcept = default;
+
+  FlatTriangleFanTree(const FlatTriangleFanTree &) = default;
+  FlatTriangleFanTree(FlatTriangleFanTree &&) noexcept = default;
+
+  /**
+   * Copy the nodes in use, reusing this object's buffers.
+   */
+  FlatTriangleFanTree &operator=(const FlatTriangleFanTree &src) noexcept;
+
+  FlatTriangleFanTree &operator=(FlatTriangleFanTree &&) noexcept = default;
 
   void Clear() noexcept {
-    fan.Clear();
-    children.clear();
+    n_nodes = 0;
   }
 
   [[gnu::pure]]
   bool IsEmpty() const noexcept {
-    return fan.IsEmpty();
+    return n_nodes == 0;
   }
 
   [[gnu::pure]]
   auto GetHeight() const noexcept {
-    return fan.GetHeight();
+    return GetRoot().fan.GetHeight();
+  }
+
+  [[gnu::pure]]
+  AFlatGeoPoint GetOrigin() const noexcept {
+    return GetRoot().fan.GetOrigin();
+  }
+
+  /**
+   * @return the number of fans in the tree
+   */
+  unsigned size() const noexcept {
+    return n_nodes;
   }
 
   void FillReach(const AFlatGeoPoint &origin, ReachFanParms &parms) noexcept;
   void DummyReach(const AFlatGeoPoint &origin) noexcept;
 
+  /**
+   * Build a new tree around a (slightly) different origin from a
+   * tree which was built by FillReach().  The root fan is calculated
+   * from scratch.  The child fans of the reference tree are
+   * recalculated over the terrain from their origins moved by the
+   * displacement, which saves searching for the gaps.  Child fans
+   * whose moved origin is not inside the new parent fan, whose
+   * moved origin cannot be reached from the parent's origin over the
+   * terrain, or which cannot be filled any more, are discarded
+   * (together with their descendants); gaps are not searched again,
+   * so the result never reaches farther than FillReach() would.
+   *
+   * @param reference the tree built by FillReach()
+   * @param reference_projection the projection of #reference; it may
+   * differ from the one in #parms
+   * @return false if the root fan could not be built
+   */
+  bool TranslateReach(const FlatTriangleFanTree &reference,
+                      const FlatProjection &reference_projection,
+                      const AFlatGeoPoint &origin,
+                      ReachFanParms &parms) noexcept;
+
   /**
    * Basic check for a state created by DummyReach().  If this method
    * returns true, then calls to FindPositiveArrival() are supposed to
@@ -71,7 +171,7 @@ public:
    */
   [[gnu::pure]]
   bool IsDummy() const noexcept {
-    return fan.IsOnlyOrigin() && children.empty();
+    return n_nodes == 1 && GetRoot().fan.IsOnlyOrigin();
   }
 
   /**
@@ -81,10 +181,14 @@ public:
    */
   bool FindPositiveArrival(FlatGeoPoint n,
                            const ReachFanParms &parms,
-                           int &arrival_height) const noexcept;
+                           int &arrival_height) const noexcept {
+    return FindPositiveArrival(0, n, parms, arrival_height);
+  }
 
   void AcceptInRange(const FlatBoundingBox &bb,
-                     FlatTriangleFanVisitor &visitor) const noexcept;
+                     FlatTriangleFanVisitor &visitor) const noexcept {
+    AcceptInRange(0, bb, visitor);
+  }
 
   void UpdateTerrainBase(FlatGeoPoint origin, ReachFanParms &parms) noexcept;
 
@@ -93,23 +197,100 @@ public:
                     const ReachFanParms &parms) const noexcept;
 
 private:
-  bool IsRoot() const noexcept {
-    return depth == 0;
+  const Node &GetRoot() const noexcept {
+    assert(n_nodes > 0);
+    return nodes.front();
   }
 
-  const FlatBoundingBox &CalcBoundingBox() noexcept;
+  /**
+   * Allocate a new (unlinked) node at the end of the array, reusing
+   * an old one if possible.  It will only be committed by
+   * CommitNode().
+   *
+   * @return the array index of the new node
+   */
+  unsigned AllocateNode(uint_least8_t depth) noexcept;
+
+  /**
+   * Commit the node allocated by AllocateNode() and insert it as the
+   * first child of the given parent.
+   */
+  void CommitNode(unsigned parent, unsigned i) noexcept;
+
+  /**
+   * Calculate the #bb_children attributes of all nodes.
+   */
+  void CalcBoundingBoxes() noexcept;
 
   /**
-   * @return true if a valid fan has been filled, false to discard
-   * this object
+   * Fill the given fan with the reach from the given origin.  This
+   * method does not modify the tree, and may be called concurrently.
+   *
+   * @return true if a valid fan has been filled, false to discard it
    */
-  bool FillReach(const AFlatGeoPoint &origin,
+  static bool FillFan(FlatTriangleFan &fan, bool is_root,
+                      const AFlatGeoPoint &origin,
+                      const int index_low, const int index_high,
+                      const ReachFanParms &parms) noexcept;
+
+  bool FillReach(unsigned i, const AFlatGeoPoint &origin,
                  const int index_low, const int index_high,
-                 const ReachFanParms &parms) noexcept;
+                 const ReachFanParms &parms) noexcept {
+    nodes[i].index_low = index_low;
+    nodes[i].index_high = index_high;
+    return FillFan(nodes[i].fan, nodes[i].IsRoot(), origin,
+                   index_low, index_high, parms);
+  }
 
-  bool FillDepth(const AFlatGeoPoint &origin, ReachFanParms &parms) noexcept;
-  void FillGaps(const AFlatGeoPoint &origin, ReachFanParms &parms) noexcept;
+  bool FillDepth(unsigned i, const AFlatGeoPoint &origin,
+                 ReachFanParms &parms) noexcept;
+  void FillGaps(unsigned i, const AFlatGeoPoint &origin,
+                ReachFanParms &parms) noexcept;
 
-  bool CheckGap(const AFlatGeoPoint &n, const RouteLink &e_1,
+  /**
+   * Like FillGaps(), but calculate the child fans concurrently with
+   * ReachFanParms::executor.  The resulting tree is the same.
+   */
+  void FillGapsParallel(unsigned i, const AFlatGeoPoint &origin,
+                        ReachFanParms &parms) noexcept;
+
+  /**
+   * Add a node with the fan to the given parent.
+   */
+  void AddGap(unsigned parent, FlatTriangleFan &&fan,
+              int index_low, int index_high,
+              ReachFanParms &parms) noexcept;
+
+  bool CheckGap(unsigned i, const AFlatGeoPoint &n, const RouteLink &e_1,
                 const RouteLink &e_2, ReachFanParms &parms) noexcept;
+
+  /**
+   * Find a fan which fills the gap between the two links.  This
+   * method does not modify the tree, and may be called concurrently.
+   *
+   * @param index_low, index_high receive the range of polar indices
+   * of the fan
+   * @return true if a fan was found
+   */
+  static bool FillGap(FlatTriangleFan &fan, const AFlatGeoPoint &n,
+                      const RouteLink &e_1, const RouteLink &e_2,
+                      const ReachFanParms &parms,
+                      int &index_low, int &index_high) noexcept;
+
+  /**
+   * Recalculate a child subtree of another tree with its origins
+   * moved by #delta, and add it to the given parent.
+   */
+  void RefillTranslated(const FlatTriangleFanTree &src,
+                        const FlatProjection &src_projection,
+                        unsigned src_index,
+                        unsigned parent, FlatGeoPoint delta,
+                        ReachFanParms &parms) noexcept;
+
+  bool FindPositiveArrival(unsigned i, FlatGeoPoint n,
+                           const ReachFanParms &parms,
+                           int &arrival_height) const noexcept;
+
+  void AcceptInRange(unsigned i, const FlatBoundingBox &bb,
+                     FlatTriangleFanVisitor &visitor) const noexcept;
 };
@@ -8,6 +8,27 @@
 
 static constexpr int MIN_FLOOR_CLEARANCE = 100;
 
+/**
+ * SolveIncremental() only reuses a reference solution whose origin is
+ * not farther away than this [m].
+ */
+static constexpr double MAX_INCREMENTAL_DISTANCE = 300;
+
+/**
+ * SolveIncremental() only reuses a reference solution if the aircraft
+ * has not lost more height than this since [m].  Gaps found from a
+ * higher altitude may not be reachable any more.
+ */
+static constexpr int MAX_INCREMENTAL_SINK = 10;
+
+/**
+ * SolveIncremental() only reuses a reference solution if the aircraft
+ * has not gained more height than this since [m].  Gaps which became
+ * reachable since are missed, which is safe, but the error should not
+ * grow too large.
+ */
+static constexpr int MAX_INCREMENTAL_CLIMB = 50;
+
 void
 ReachFan::Reset() noexcept
 {
@@ -17,7 +38,8 @@ ReachFan::Reset() noexcept
 
 bool
 ReachFan::Solve(const AGeoPoint origin, const RoutePolars &rpolars,
-                const RasterMap* terrain, const bool do_solve) noexcept
+                const RasterMap* terrain, const bool do_solve,
+                ParallelExecutor *executor) noexcept
 {
   Reset();
 
@@ -30,6 +52,7 @@ ReachFan::Solve(const AGeoPoint origin, const RoutePolars &rpolars,
   const int h2 = h.GetValueOr0();
 
   ReachFanParms parms(rpolars, projection, terrain_base, terrain);
+  parms.executor = executor;
   const AFlatGeoPoint ao(projection.ProjectInteger(origin), origin.altitude);
 
   // immediate exit if starting below terrain, or starting below floor
@@ -62,6 +85,67 @@ ReachFan::Solve(const AGeoPoint origin, const RoutePolars &rpolars,
   return true;
 }
 
+bool
+ReachFan::SolveIncremental(const ReachFan &reference, const AGeoPoint origin,
+                           const RoutePolars &rpolars,
+                           const RasterMap *terrain,
+                           ParallelExecutor *executor) noexcept
+{
+  if (reference.root.IsEmpty() || reference.root.IsDummy())
+    return false;
+
+  const AFlatGeoPoint reference_origin = reference.root.GetOrigin();
+
+  const int delta_height = origin.altitude - reference_origin.altitude;
+  if (delta_height < -MAX_INCREMENTAL_SINK ||
+      delta_height > MAX_INCREMENTAL_CLIMB)
+    return false;
+
+  if (FlatGeoPoint(reference.projection.ProjectInteger(origin))
+      .Distance(reference_origin) >
+      reference.projection.ProjectRangeInteger(origin, MAX_INCREMENTAL_DISTANCE))
+    return false;
+
+  const auto h = terrain
+    ? terrain->GetHeight(origin)
+    : TerrainHeight::Invalid();
+  const int h2 = h.GetValueOr0();
+
+  /* leave the special cases to Solve() */
+  if ((!h.IsInvalid() &&
+       (origin.altitude <= h2 + rpolars.GetSafetyHeight()))
+      || (origin.altitude < MIN_FLOOR_CLEARANCE + rpolars.GetFloor() + rpolars.GetSafetyHeight()))
+    return false;
+
+  Reset();
+
+  /* use the same projection as Solve(), so the root fan is exactly
+     the same */
+  projection = FlatProjection(origin);
+  const AFlatGeoPoint ao(projection.ProjectInteger(origin), origin.altitude);
+
+  ReachFanParms parms(rpolars, projection, terrain_base, terrain);
+  parms.executor = executor;
+  if (!root.TranslateReach(reference.root, reference.projection, ao, parms)) {
+    Reset();
+    return false;
+  }
+
+  if (!h.IsInvalid()) {
+    parms.terrain_base = h2;
+    parms.terrain_counter = 1;
+  } else {
+    parms.terrain_base = 0;
+    parms.terrain_counter = 0;
+  }
+
+  if (parms.terrain)
+    root.UpdateTerrainBase(ao, parms);
+
+  terrain_base = parms.terrain_base;
+  return true;
+}
+
 std::optional<ReachResult>
 ReachFan::FindPositiveArrival(const AGeoPoint dest,
                               const RoutePolars &rpolars) const noexcept
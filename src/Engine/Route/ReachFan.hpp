@@ -10,6 +10,7 @@
 
 class RoutePolars;
 class RasterMap;
+class ParallelExecutor;
 class GeoBounds;
 struct ReachResult;
 
@@ -32,8 +33,33 @@ public:
 
   void Reset() noexcept;
 
+  /**
+   * @param executor if not nullptr, then the calculation is split
+   * into parts which run concurrently
+   */
   bool Solve(const AGeoPoint origin, const RoutePolars &rpolars,
-             const RasterMap *terrain, const bool do_solve = true) noexcept;
+             const RasterMap *terrain, const bool do_solve = true,
+             ParallelExecutor *executor = nullptr) noexcept;
+
+  /**
+   * Like Solve(), but reuse the gaps found by a previous solution for
+   * a nearby origin.  The root fan is calculated from scratch; the
+   * gap fans behind obstacles are recalculated from their origins
+   * moved by the displacement of the aircraft, without searching for
+   * gaps again (see FlatTriangleFanTree::TranslateReach()).
+   *
+   * This fails if the origin is too far away from the reference
+   * origin, if the aircraft has lost too much height, or if the
+   * reference is not usable.  The caller shall then call Solve().
+   *
+   * @param reference a successful full solution by Solve() with the
+   * same #RoutePolars and terrain
+   * @return true on success
+   */
+  bool SolveIncremental(const ReachFan &reference, const AGeoPoint origin,
+                        const RoutePolars &rpolars,
+                        const RasterMap *terrain,
+                        ParallelExecutor *executor = nullptr) noexcept;
 
   /**
    * Find arrival height at destination.
@@ -7,11 +7,19 @@
 
 class FlatProjection;
 class RasterMap;
+class ParallelExecutor;
 
 struct ReachFanParms {
   const RoutePolars &rpolars;
   const FlatProjection &projection;
   const RasterMap *terrain;
+
+  /**
+   * If not nullptr, then fans are calculated concurrently with this
+   * object.
+   */
+  ParallelExecutor *executor = nullptr;
+
   int terrain_base;
   unsigned terrain_counter = 0;
   unsigned fan_counter = 0;
@@ -72,13 +72,20 @@ RoutePlanner::Solve(const AGeoPoint &origin, const AGeoPoint &destination,
   if (!rpolars_route.IsAchievable(e_test))
     return false;
 
-  bool retval = false;
-  planner.Restart(start);
+  n_expanded = 0;
+
+  bool retval = FollowProposedPath(start);
+  if (retval) {
+    solution_route.clear();
+    FindSolution(astar_goal, solution_route);
+  } else
+    planner.Restart(start);
 
   unsigned best_d = UINT_MAX;
 
-  while (!planner.IsEmpty()) {
+  while (!retval && !planner.IsEmpty()) {
     const RoutePoint node = planner.Pop();
+    ++n_expanded;
 
     h_min = std::min(h_min, node.altitude);
     h_max = std::max(h_max, node.altitude);
@@ -229,7 +236,7 @@ RoutePlanner::LinkCleared(const RouteLink &e) noexcept
 bool
 RoutePlanner::IsSetUnique(const RouteLinkBase &e) noexcept
 {
-  return unique_links.insert(e).second;
+  return unique_links.insert(e);
 }
 
 void
@@ -308,6 +315,47 @@ RoutePlanner::AddEdges(const RouteLink &e) noexcept
   AddShortcut(e.second);
 }
 
+bool
+RoutePlanner::FollowProposedPath(const RoutePoint &start) noexcept
+{
+  std::vector<FlatGeoPoint> path;
+  for (unsigned i = 0; i < MAX_PROPOSALS; ++i) {
+    if (!ProposePath(start, astar_goal, i > 0, path))
+      return false;
+
+    if (FollowPath(start, path))
+      return true;
+  }
+
+  return false;
+}
+
+bool
+RoutePlanner::FollowPath(const RoutePoint &start,
+                         const std::vector<FlatGeoPoint> &path) noexcept
+{
+  planner.Restart(start);
+
+  RoutePoint node = start;
+  for (const auto &p : path) {
+    const RouteLink e =
+      rpolars_route.GenerateIntermediate(node, RoutePoint(p, node.altitude),
+                                         projection);
+    if (e.IsShort())
+      continue;
+
+    if (!IsClear(e) || !rpolars_route.IsAchievable(e) || !LinkCleared(e))
+      return false;
+
+    node = e.second;
+    h_min = std::min(h_min, node.altitude);
+    h_max = std::max(h_max, node.altitude);
+  }
+
+  const RouteLink e(node, astar_goal, projection);
+  return IsClear(e) && rpolars_route.IsAchievable(e) && LinkCleared(e);
+}
+
 void
 RoutePlanner::UpdatePolar(const GlideSettings &settings,
                           const RoutePlannerConfig &config,
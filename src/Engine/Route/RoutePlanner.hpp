@@ -11,7 +11,7 @@
 #include "Geo/SearchPointVector.hpp"
 
 #include <utility>
-#include <unordered_set>
+#include <vector>
 
 #include <limits.h>
 
@@ -92,6 +92,12 @@ protected:
   int h_max;
 
 private:
+  /**
+   * The maximum number of paths obtained from ProposePath() in one
+   * Solve() call.
+   */
+  static constexpr unsigned MAX_PROPOSALS = 8;
+
   /** A* search algorithm */
   AStar<RoutePoint, RoutePointHasher> planner{0};
 
@@ -101,11 +107,14 @@ private:
    */
   SearchPointVector search_hull;
 
-  typedef std::unordered_set<RouteLinkBase, RouteLinkBaseHasher,
-                             RouteLinkBaseEqual> RouteLinkSet;
+  typedef FlatHashSet<RouteLinkBase, RouteLinkBaseHasher,
+                      RouteLinkBaseEqual> RouteLinkSet;
 
   /** Links that have been visited during solution */
-  RouteLinkSet unique_links{50000};
+  RouteLinkSet unique_links;
+
+  /** The number of nodes expanded by the last Solve() call */
+  unsigned n_expanded = 0;
   typedef std::queue< RouteLink> RouteLinkQueue;
   /** Link candidates to be processed for intersection tests */
   RouteLinkQueue links;
@@ -155,6 +164,15 @@ public:
     return solution_route;
   }
 
+  /**
+   * Returns the number of search nodes expanded by the last Solve()
+   * call (for benchmarking).  It is 0 if the path proposed by
+   * ProposePath() was the solution.
+   */
+  unsigned GetExpandedNodeCount() const noexcept {
+    return n_expanded;
+  }
+
   /**
    * Update aircraft performance model used for path planning.
    *
@@ -258,6 +276,25 @@ protected:
   virtual void OnSolve(const AGeoPoint &origin,
                        const AGeoPoint &destination) noexcept;
 
+  /**
+   * Hook which allows subclasses to propose a path before the A*
+   * search starts.  If all of its links are clear and achievable, it
+   * is the solution, and the search is skipped.  Otherwise, this
+   * method is called again (up to #MAX_PROPOSALS times), and may
+   * propose a different path.
+   *
+   * @param retry true if the previous proposal of this Solve() call
+   * has failed
+   * @param path receives the points between origin and destination
+   * @return false if there is no (more) proposal
+   */
+  virtual bool ProposePath([[maybe_unused]] const RoutePoint &origin,
+                           [[maybe_unused]] const RoutePoint &destination,
+                           [[maybe_unused]] bool retry,
+                           [[maybe_unused]] std::vector<FlatGeoPoint> &path) noexcept {
+    return false;
+  }
+
 private:
   /**
    * For a link known to not clear obstacles, generate whatever candidate edges
@@ -267,6 +304,23 @@ private:
    */
   void AddEdges(const RouteLink &e) noexcept;
 
+  /**
+   * Try the paths obtained from ProposePath() until one of them
+   * reaches #astar_goal.
+   *
+   * @return true if a path reaches #astar_goal
+   */
+  bool FollowProposedPath(const RoutePoint &start) noexcept;
+
+  /**
+   * Link the given path in the A* search.  Points too close to the
+   * previous one are skipped.
+   *
+   * @return true if all links are clear and achievable
+   */
+  bool FollowPath(const RoutePoint &start,
+                  const std::vector<FlatGeoPoint> &path) noexcept;
+
 protected:
   /**
    * Test whether a candidate destination is inside the area already searched
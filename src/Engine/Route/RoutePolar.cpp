@@ -8,6 +8,8 @@
 #include "Geo/Flat/FlatGeoPoint.hpp"
 #include "util/Macros.hpp"
 
+#include <algorithm>
+
 GlideResult
 RoutePolar::SolveTask(const GlideSettings &settings,
                       const GlidePolar& glide_polar,
@@ -21,6 +23,22 @@ RoutePolar::SolveTask(const GlideSettings &settings,
     : mac_cready.Solve(task);
 }
 
+bool
+RoutePolar::operator==(const RoutePolar &other) const noexcept
+{
+  return std::equal(std::begin(points), std::end(points),
+                    std::begin(other.points),
+                    [](const RoutePolarPoint &a, const RoutePolarPoint &b){
+                      if (a.valid != b.valid)
+                        return false;
+
+                      /* the other attributes of invalid points are
+                         undefined */
+                      return !a.valid ||
+                        (a.slowness == b.slowness && a.gradient == b.gradient);
+                    });
+}
+
 void
 RoutePolar::Initialise(const GlideSettings &settings, const GlidePolar& polar,
                        const SpeedVector& wind,
@@ -53,6 +53,11 @@ class RoutePolar
   RoutePolarPoint points[ROUTEPOLAR_POINTS];
 
 public:
+  /**
+   * Compare the performance data of all valid directions.
+   */
+  [[gnu::pure]]
+  bool operator==(const RoutePolar &other) const noexcept;
   /**
    * Populate internal structure with performance data.
    * To be called when the glide polar settings or wind changes.
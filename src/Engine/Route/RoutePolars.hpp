@@ -55,6 +55,20 @@ public:
                   const SpeedVector& wind,
                   const int _height_min_working=0) noexcept;
 
+  /**
+   * Would reach calculations with the other object yield the same
+   * results?  Unlike a full comparison, this ignores the cruise and
+   * ceiling altitudes, which are not used for reach.
+   */
+  [[gnu::pure]]
+  bool IsReachEquivalent(const RoutePolars &other) const noexcept {
+    return polar_glide == other.polar_glide &&
+      polar_cruise == other.polar_cruise &&
+      inv_mc == other.inv_mc &&
+      height_min_working == other.height_min_working &&
+      config == other.config;
+  }
+
   /**
    * Calculate the time required to fly the link.  Returns UINT_MAX
    * if flight is impossible.  Climbs above the cruise altitude
@@ -6,6 +6,12 @@
 #include "ReachFan.hpp"
 #include "Terrain/RasterMap.hpp"
 
+/**
+ * After this number of incremental reach solutions, a full one is
+ * calculated.
+ */
+static constexpr unsigned MAX_REACH_REUSE = 5;
+
 void
 TerrainRoute::UpdatePolar(const GlideSettings &settings,
                           const RoutePlannerConfig &config,
@@ -32,19 +38,42 @@ TerrainRoute::UpdatePolar(const GlideSettings &settings,
                                    height_min_working);
 }
 
-ReachFan
+void
 TerrainRoute::SolveReach(const AGeoPoint &origin,
                          const RoutePlannerConfig &config,
                          const int h_ceiling,
                          const bool do_solve,
-                         const bool working) noexcept
+                         const bool working,
+                         ReachFan &result) noexcept
 {
   auto &rpolars = working ? rpolars_reach_working : rpolars_reach;
   rpolars.SetConfig(config, origin.altitude, h_ceiling);
 
-  ReachFan reach;
-  reach.Solve(origin, rpolars, terrain, do_solve);
-  return reach;
+  const Serial terrain_serial = terrain != nullptr
+    ? terrain->GetSerial()
+    : Serial{};
+
+  auto &reference = reach_reference[working];
+  if (do_solve && reference.valid &&
+      reference.n_reused < MAX_REACH_REUSE &&
+      reference.terrain_serial == terrain_serial &&
+      reference.rpolars.IsReachEquivalent(rpolars) &&
+      result.SolveIncremental(reference.fan, origin, rpolars, terrain,
+                              executor)) {
+    ++reference.n_reused;
+    return;
+  }
+
+  const bool solved = result.Solve(origin, rpolars, terrain, do_solve,
+                                   executor);
+
+  reference.valid = solved && do_solve;
+  if (reference.valid) {
+    reference.fan = result;
+    reference.rpolars = rpolars;
+    reference.terrain_serial = terrain_serial;
+    reference.n_reused = 0;
+  }
 }
 
 /*
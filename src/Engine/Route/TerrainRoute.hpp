@@ -4,8 +4,10 @@
 #pragma once
 
 #include "RoutePlanner.hpp"
+#include "ReachFan.hpp"
+#include "util/Serial.hpp"
 
-class ReachFan;
+class ParallelExecutor;
 
 /**
  * Specialization of #RoutePlanner which implements terrain avoidance.
@@ -20,6 +22,12 @@ class TerrainRoute: public RoutePlanner
   /** Terrain raster */
   const RasterMap *terrain = nullptr;
 
+  /**
+   * Optional helper for calculating reach concurrently; see
+   * SetParallelExecutor().
+   */
+  ParallelExecutor *executor = nullptr;
+
   /** Aircraft performance model for reach to terrain */
   RoutePolars rpolars_reach;
   /** Aircraft performance model for reach to working floor */
@@ -27,6 +35,36 @@ class TerrainRoute: public RoutePlanner
 
   mutable RoutePoint m_inx_terrain;
 
+  /**
+   * The last full reach solution, which SolveReach() reuses while the
+   * aircraft stays nearby (see ReachFan::SolveIncremental()).
+   */
+  struct ReachReference {
+    ReachFan fan;
+
+    /**
+     * The polars #fan was calculated with.
+     */
+    RoutePolars rpolars;
+
+    /**
+     * The terrain tile serial #fan was calculated with.
+     */
+    Serial terrain_serial;
+
+    /**
+     * The number of incremental solutions based on #fan.
+     */
+    unsigned n_reused;
+
+    bool valid = false;
+  };
+
+  /**
+   * One #ReachReference for terrain reach and one for working reach.
+   */
+  ReachReference reach_reference[2];
+
 public:
   friend class PrintHelper;
 
@@ -36,6 +74,28 @@ public:
    */
   void SetTerrain(const RasterMap *_terrain) noexcept {
     terrain = _terrain;
+    ClearReachReference();
+  }
+
+  /**
+   * Allow SolveReach() to distribute the work over several threads.
+   * The caller must keep the terrain locked while SolveReach() runs
+   * (as usual); the other threads only read it.
+   *
+   * @param _executor the executor or nullptr to calculate in the
+   * calling thread only
+   */
+  void SetParallelExecutor(ParallelExecutor *_executor) noexcept {
+    executor = _executor;
+  }
+
+  /**
+   * Discard the reach solutions cached for SolveReach(), forcing the
+   * next call to do a full calculation.
+   */
+  void ClearReachReference() noexcept {
+    for (auto &i : reach_reference)
+      i.valid = false;
   }
 
   const auto &GetReachPolar() const noexcept {
@@ -52,14 +112,20 @@ public:
   /**
    * Solve reach footprint to terrain or working height.
    *
+   * If the previous full solution was calculated nearby with the same
+   * polars and terrain, it is updated incrementally (see
+   * ReachFan::SolveIncremental()).  A full calculation is done at
+   * least every few calls.
+   *
    * @param origin The start of the search (current aircraft location)
    * @param do_solve actually solve or just perform minimal calculations
+   * @param result the destination object; passing the same object
+   * again reuses its buffers
    */
-  [[gnu::pure]]
-  ReachFan SolveReach(const AGeoPoint &origin,
-                      const RoutePlannerConfig &config,
-                      int h_ceiling, bool do_solve,
-                      bool working) noexcept;
+  void SolveReach(const AGeoPoint &origin,
+                  const RoutePlannerConfig &config,
+                  int h_ceiling, bool do_solve,
+                  bool working, ReachFan &result) noexcept;
 
   /**
    * Determine if intersection with terrain occurs in forwards direction from
@@ -29,6 +29,8 @@ struct FinishConstraints {
 
   void SetDefaults();
 
+  bool operator==(const FinishConstraints &other) const noexcept = default;
+
   /**
    * Check whether aircraft height is within finish height limit
    *
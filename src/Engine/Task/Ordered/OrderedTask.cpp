@@ -27,8 +27,11 @@
 #include "Task/PathSolvers/TaskDijkstraMax.hpp"
 #include "Task/ObservationZones/ObservationZoneClient.hpp"
 #include "Task/ObservationZones/CylinderZone.hpp"
+#include "Task/ObservationZones/Boundary.hpp"
 #include "time/BrokenTime.hpp"
 
+#include <algorithm>
+
 /**
  * According to "FAI Sporting Code / Annex A to Section 3 - Gliding",
  * 6.3.1c and 6.3.2dii, the radius of the "start/finish ring" must be
@@ -444,6 +447,7 @@ OrderedTask::CheckTransitions(const AircraftState &state,
   const int t_min = std::max(0, (int)active_task_point - 1);
   const int t_max = std::min(n_task - 1, (int)active_task_point);
   bool full_update = false;
+  bool start_exited = false;
 
   for (int i = t_min; i <= t_max; i++) {
 
@@ -465,6 +469,9 @@ OrderedTask::CheckTransitions(const AircraftState &state,
                                         stats.pev_based_advance_ready, 
                                         i == 0);
 
+    if (i == 0 && transition_exit)
+      start_exited = true;
+
     if (i == (int)active_task_point) {
       const bool last_request_armed = task_advance.NeedToArm();
 
@@ -499,6 +506,15 @@ OrderedTask::CheckTransitions(const AircraftState &state,
   stats.task_finished = taskpoint_finish != nullptr &&
     taskpoint_finish->HasEntered();
 
+  if (start_exited)
+    start_candidates.Add(taskpoint_start->GetExitedState());
+
+  if (start_candidates.HasClosed(state.time)) {
+    SelectBestStart(state);
+    start_candidates.Clear();
+    full_update = true;
+  }
+
   if (TaskStarted()) {
     const AircraftState &start_state = taskpoint_start->GetExitedState();
     assert(start_state.HasTime());
@@ -655,9 +671,13 @@ void OrderedTask::UpdateAfterPEV(const AircraftState &state, BrokenTime bt) noex
 
           ots.start_constraints.open_time_span=ts;
 
-
-
-
+          /* the start stays open, but the crossings during the
+             configured window are still compared */
+          if (start.pev_start_window.count() > 0)
+            start_candidates.Arm(RoughTimeSpan(new_start,
+                                               new_start + RoughTimeDelta::FromDuration(start.pev_start_window)));
+          else
+            start_candidates.Clear();
       }else
       {
         
@@ -677,7 +697,9 @@ void OrderedTask::UpdateAfterPEV(const AircraftState &state, BrokenTime bt) noex
 
         ots.start_constraints.open_time_span=ts;
 
-      
+        /* collect all crossings of this window; the best one is
+           chosen when it closes */
+        start_candidates.Arm(ts);
       }
        
 }
@@ -1186,6 +1208,7 @@ OrderedTask::Reset() noexcept
   AbstractTask::Reset();
   stats.task_finished = false;
   stats.start.Reset();
+  start_candidates.Clear();
   task_advance.Reset();
   SetActiveTaskPoint(0);
   UpdateStatsGeometry();
@@ -1282,6 +1305,46 @@ OrderedTask::UpdateStartTransition(const AircraftState &state,
   // @todo: modify this for optional start?
 }
 
+void
+OrderedTask::SelectBestStart(const AircraftState &state) noexcept
+{
+  if (start_candidates.empty() || task_points.size() < 2 ||
+      !taskpoint_start->HasExited())
+    return;
+
+  /* the part of the task after the first turn point is the same for
+     all candidates */
+  double distance_after_next = 0;
+  for (unsigned i = 2; i < task_points.size(); ++i)
+    distance_after_next += task_points[i]->GetVectorPlanned().distance;
+
+  /* the finish time does not depend on which crossing is used; take
+     the estimate of the last MacCready solution */
+  TimeStamp finish_time = state.time;
+  if (stats.total.IsAchievable() &&
+      stats.total.time_remaining_now.count() > 0)
+    finish_time = finish_time + stats.total.time_remaining_now;
+
+  const auto *best =
+    start_candidates.FindBest(taskpoint_start->GetBoundary(),
+                              task_points[1]->GetLocationRemaining(),
+                              distance_after_next, finish_time);
+  if (best == nullptr ||
+      best->time == taskpoint_start->GetExitedState().time)
+    return;
+
+  AircraftState start_state = taskpoint_start->GetExitedState();
+  start_state.time = best->time;
+  start_state.location = best->location;
+  start_state.altitude = best->altitude;
+  start_state.ground_speed = best->ground_speed;
+  taskpoint_start->SetStartState(start_state, task_projection);
+
+  /* credit the boundary point which belongs to the chosen crossing */
+  taskpoint_start->find_best_start(start_state, *task_points[1],
+                                   task_projection);
+}
+
 bool
 OrderedTask::HasTargets() const noexcept
 {
@@ -1315,6 +1378,26 @@ OrderedTask::Clone(const TaskBehaviour &tb) const noexcept
   return new_task;
 }
 
+static bool
+Equals(const OrderedTask::OrderedTaskPointVector &a,
+       const OrderedTask::OrderedTaskPointVector &b) noexcept
+{
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                    [](const auto &x, const auto &y){
+                      return x->Equals(*y);
+                    });
+}
+
+bool
+OrderedTask::Equals(const OrderedTask &other) const noexcept
+{
+  return factory_mode == other.factory_mode &&
+    name == other.name &&
+    ordered_settings == other.ordered_settings &&
+    ::Equals(task_points, other.task_points) &&
+    ::Equals(optional_start_points, other.optional_start_points);
+}
+
 void
 OrderedTask::CheckDuplicateWaypoints(Waypoints& waypoints,
                                      OrderedTaskPointVector& points,
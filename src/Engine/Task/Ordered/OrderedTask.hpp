@@ -6,6 +6,7 @@
 #include "Geo/Flat/TaskProjection.hpp"
 #include "Task/AbstractTask.hpp"
 #include "SmartTaskAdvance.hpp"
+#include "StartCandidates.hpp"
 #include "Waypoint/Ptr.hpp"
 #include "util/DereferenceIterator.hxx"
 #include "util/StaticString.hxx"
@@ -69,6 +70,12 @@ private:
   std::unique_ptr<AbstractTaskFactory> active_factory;
   OrderedTaskSettings ordered_settings;
   SmartTaskAdvance task_advance;
+
+  /**
+   * Start sector crossings inside a start window opened by a pilot
+   * event; see SelectBestStart().
+   */
+  StartCandidates start_candidates;
   std::unique_ptr<TaskDijkstraMin> dijkstra_min;
   std::unique_ptr<TaskDijkstraMax> dijkstra_max;
 
@@ -151,6 +158,17 @@ public:
    */
   bool Commit(const OrderedTask& other) noexcept;
 
+  /**
+   * Compare the definition of this task with another one: factory,
+   * name, settings and (optional start) points.  The flight state
+   * (active task point, targets, samples) is not compared.
+   *
+   * @return True if a Commit() of the other task would not change
+   * this one
+   */
+  [[gnu::pure]]
+  bool Equals(const OrderedTask &other) const noexcept;
+
   /**
    * Retrieves the active task point index.
    *
@@ -467,6 +485,13 @@ private:
   void UpdateStartTransition(const AircraftState &state,
                              OrderedTaskPoint &start) noexcept;
 
+  /**
+   * Called when the start window opened by a pilot event has closed:
+   * replace the start with the recorded crossing which gives the best
+   * task speed.
+   */
+  void SelectBestStart(const AircraftState &state) noexcept;
+
   [[gnu::pure]]
   bool DistanceIsSignificant(const GeoPoint &location,
                              const GeoPoint &location_last) const noexcept;
@@ -3,9 +3,9 @@
 
 #include "StartPoint.hpp"
 #include "Task/Ordered/Settings.hpp"
+#include "Task/Ordered/StartCandidates.hpp"
 #include "Task/ObservationZones/Boundary.hpp"
 #include "Task/TaskBehaviour.hpp"
-#include "Geo/Math.hpp"
 
 #include <cassert>
 
@@ -60,26 +60,21 @@ StartPoint::find_best_start(const AircraftState &state,
   const OZBoundary boundary = GetBoundary();
   assert(!boundary.empty());
 
-  const auto end = boundary.end();
-  auto i = boundary.begin();
-  assert(i != end);
-
-  const GeoPoint &next_location = next.GetLocationRemaining();
-
-  GeoPoint best_location = *i;
-  auto best_distance = ::DoubleDistance(state.location, *i, next_location);
-
-  for (++i; i != end; ++i) {
-    auto distance = ::DoubleDistance(state.location, *i, next_location);
-    if (distance < best_distance) {
-      best_location = *i;
-      best_distance = distance;
-    }
-  }
+  const GeoPoint best_location =
+    StartCandidates::GetScoredLocation(boundary, state.location,
+                                       next.GetLocationRemaining());
 
   SetSearchMin(SearchPoint(best_location, projection));
 }
 
+void
+StartPoint::SetStartState(const AircraftState &state,
+                          const FlatProjection &projection) noexcept
+{
+  ClearSampleAllButLast(state, projection);
+  SetExitedState(state);
+}
+
 bool
 StartPoint::IsInSector(const AircraftState &state) const noexcept
 {
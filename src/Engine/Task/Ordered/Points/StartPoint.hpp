@@ -85,6 +85,14 @@ public:
                        const OrderedTaskPoint &next,
                        const FlatProjection &projection);
 
+  /**
+   * Use the given state as the start, replacing the last exit
+   * transition.  This is used to choose a different crossing of the
+   * start sector retrospectively.
+   */
+  void SetStartState(const AircraftState &state,
+                     const FlatProjection &projection) noexcept;
+
   /* virtual methods from class TaskPoint */
   double GetElevation() const noexcept override;
 
@@ -23,4 +23,6 @@ struct OrderedTaskSettings {
   FAITriangleSettings fai_triangle;
 
   void SetDefaults();
+
+  bool operator==(const OrderedTaskSettings &other) const noexcept = default;
 };
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "StartCandidates.hpp"
+#include "Navigation/Aircraft.hpp"
+#include "Task/ObservationZones/Boundary.hpp"
+#include "Geo/Math.hpp"
+
+bool
+StartCandidates::Add(const AircraftState &state) noexcept
+{
+  if (!IsArmed() || !state.HasTime() ||
+      !window.IsInside(RoughTime{state.time}))
+    return false;
+
+  if (candidates.full())
+    candidates.remove(0);
+
+  Candidate &c = candidates.append();
+  c.time = state.time;
+  c.location = state.location;
+  c.altitude = state.altitude;
+  c.ground_speed = state.ground_speed;
+  return true;
+}
+
+GeoPoint
+StartCandidates::GetScoredLocation(const OZBoundary &boundary,
+                                   const GeoPoint &location,
+                                   const GeoPoint &next_location) noexcept
+{
+  GeoPoint best_location = location;
+  double best_distance = -1;
+
+  for (const auto &i : boundary) {
+    const auto distance = ::DoubleDistance(location, i, next_location);
+    if (best_distance < 0 || distance < best_distance) {
+      best_location = i;
+      best_distance = distance;
+    }
+  }
+
+  return best_location;
+}
+
+const StartCandidates::Candidate *
+StartCandidates::FindBest(const OZBoundary &boundary,
+                          const GeoPoint &next_location,
+                          double distance_after_next,
+                          TimeStamp finish_time) const noexcept
+{
+  const Candidate *best = nullptr;
+  double best_speed = 0;
+
+  for (const auto &c : candidates) {
+    const auto duration = finish_time - c.time;
+    if (duration.count() <= 0)
+      continue;
+
+    const GeoPoint scored =
+      GetScoredLocation(boundary, c.location, next_location);
+    const double distance =
+      scored.Distance(next_location) + distance_after_next;
+    const double speed = distance / duration.count();
+    if (speed > best_speed) {
+      best = &c;
+      best_speed = speed;
+    }
+  }
+
+  return best;
+}
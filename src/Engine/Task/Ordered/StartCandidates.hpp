@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/GeoPoint.hpp"
+#include "time/RoughTime.hpp"
+#include "time/Stamp.hpp"
+#include "util/StaticArray.hxx"
+
+struct AircraftState;
+class OZBoundary;
+
+/**
+ * Remembers all valid start sector crossings during a start window
+ * which was opened by a pilot event.  When the window closes, the
+ * crossing which yields the best task speed can be chosen
+ * retrospectively instead of the last one.
+ */
+class StartCandidates {
+public:
+  struct Candidate {
+    TimeStamp time;
+    GeoPoint location;
+
+    /** [m MSL] */
+    double altitude;
+
+    /** [m/s] */
+    double ground_speed;
+  };
+
+  static constexpr std::size_t MAX_CANDIDATES = 32;
+
+private:
+  StaticArray<Candidate, MAX_CANDIDATES> candidates;
+
+  /**
+   * The start window which is being observed.  Candidates are only
+   * collected while this is defined and has an end.
+   */
+  RoughTimeSpan window = RoughTimeSpan::Invalid();
+
+public:
+  void Clear() noexcept {
+    candidates.clear();
+    window = RoughTimeSpan::Invalid();
+  }
+
+  /**
+   * Begin collecting crossings for a new start window.  Crossings
+   * recorded for a previous window are discarded.
+   */
+  void Arm(const RoughTimeSpan &_window) noexcept {
+    candidates.clear();
+    window = _window;
+  }
+
+  bool IsArmed() const noexcept {
+    return window.IsDefined() && window.GetEnd().IsValid();
+  }
+
+  bool empty() const noexcept {
+    return candidates.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return candidates.size();
+  }
+
+  const Candidate &operator[](std::size_t i) const noexcept {
+    return candidates[i];
+  }
+
+  /**
+   * Has the observed window been closed at the given time?
+   */
+  [[gnu::pure]]
+  bool HasClosed(TimeStamp now) const noexcept {
+    return IsArmed() && window.HasEnded(RoughTime{now});
+  }
+
+  /**
+   * Record a valid start sector crossing.  It is ignored if it is
+   * outside of the window.  If the buffer is full, the oldest
+   * crossing is dropped.
+   *
+   * @return true if the crossing was recorded
+   */
+  bool Add(const AircraftState &state) noexcept;
+
+  /**
+   * Determine the start location which is credited for a crossing at
+   * the given location: the boundary point which minimises the
+   * distance from the crossing via that point to the first turn point.
+   * This is the same point StartPoint::find_best_start() chooses.
+   *
+   * @param boundary the boundary of the start observation zone
+   * @return the credited location, or #location if the boundary is
+   * empty
+   */
+  [[gnu::pure]]
+  static GeoPoint GetScoredLocation(const OZBoundary &boundary,
+                                    const GeoPoint &location,
+                                    const GeoPoint &next_location) noexcept;
+
+  /**
+   * Find the crossing which gives the best task speed.  Since all
+   * candidates belong to the same flight, the finish time is the same
+   * for each of them; only the start time and the distance from the
+   * credited start location (see GetScoredLocation()) to the first
+   * turn point differ.
+   *
+   * @param boundary the boundary of the start observation zone
+   * @param next_location the (remaining) location of the first turn
+   * point
+   * @param distance_after_next the task distance from the first turn
+   * point to the finish [m]
+   * @param finish_time the (estimated) finish time
+   * @return the best candidate or nullptr if there is none
+   */
+  [[gnu::pure]]
+  const Candidate *FindBest(const OZBoundary &boundary,
+                            const GeoPoint &next_location,
+                            double distance_after_next,
+                            TimeStamp finish_time) const noexcept;
+};
@@ -62,6 +62,8 @@ struct StartConstraints {
 
   void SetDefaults();
 
+  bool operator==(const StartConstraints &other) const noexcept = default;
+
   /**
    * Check whether aircraft speed is within start speed limits
    *
@@ -124,6 +124,14 @@ public:
   }
 
 protected:
+  /**
+   * Replace the recorded exit state, e.g. to score a different
+   * crossing retrospectively.
+   */
+  void SetExitedState(const AircraftState &state) noexcept {
+    exited_state = state;
+  }
+
   /**
    * Check if aircraft has transitioned to inside sector
    *
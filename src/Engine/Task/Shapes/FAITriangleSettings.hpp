@@ -29,6 +29,8 @@ struct FAITriangleSettings {
 
   Threshold threshold;
 
+  constexpr bool operator==(const FAITriangleSettings &other) const noexcept = default;
+
   void SetDefaults() {
     threshold = Threshold::FAI;
   }
@@ -49,7 +49,7 @@ FlightStatistics::AddAltitudeTerrain(const FloatDuration tflight,
                                      const double terrainalt) noexcept
 {
   const std::lock_guard lock{mutex};
-  altitude_terrain.Update(ToNormalisedHours(tflight), terrainalt);
+  altitude_terrain.Add(ToNormalisedHours(tflight), terrainalt);
 }
 
 void
@@ -60,7 +60,7 @@ FlightStatistics::AddAltitude(const FloatDuration tflight,
 
   const std::lock_guard lock{mutex};
 
-  altitude.Update(t, alt);
+  altitude.Add(t, alt);
 
   // update working ceiling immediately if above
   if (!altitude_ceiling.IsEmpty() && (alt > altitude_ceiling.GetLastY()))
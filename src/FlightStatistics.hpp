@@ -5,6 +5,7 @@
 
 #include "Math/LeastSquares.hpp"
 #include "Math/ConvexFilter.hpp"
+#include "Math/TimeSeries.hpp"
 #include "Math/Histogram.hpp"
 #include "thread/Mutex.hxx"
 #include "time/FloatDuration.hxx"
@@ -12,11 +13,11 @@
 class FlightStatistics {
 public:
   LeastSquares thermal_average;
-  LeastSquares altitude;
+  TimeSeries altitude;
   ConvexFilter altitude_base;
   ConvexFilter altitude_ceiling;
   LeastSquares task_speed;
-  LeastSquares altitude_terrain;
+  TimeSeries altitude_terrain;
   Histogram vario_circling_histogram;
   Histogram vario_cruise_histogram;
   mutable Mutex mutex;
@@ -14,10 +14,14 @@
 #include "Look/AirspaceLook.hpp"
 #include "Engine/Task/Ordered/OrderedTask.hpp"
 #include "Engine/Task/Ordered/Points/OrderedTaskPoint.hpp"
+#include "Geo/Flat/TaskProjection.hpp"
 #include "Look/TaskLook.hpp"
 #include "Look/MapLook.hpp"
 #include "MapSettings.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 #ifndef ENABLE_OPENGL
 #include "ui/canvas/BufferCanvas.hpp"
 #else
@@ -82,19 +86,15 @@ RenderFAISectors(Canvas &canvas, const WindowProjection &projection,
                     false, settings);
 }
 
-void
-PaintTask(Canvas &canvas, const WindowProjection &projection,
-          const OrderedTask &task,
-          const GeoPoint &location,
-          const MapSettings &settings_map,
-          const TaskLook &task_look,
-          const AirspaceLook &airspace_look,
-          const RasterTerrain *terrain, const Airspaces *airspaces,
-          bool fai_sectors,
-          int highlight_index)
+/**
+ * Draw the terrain and the airspaces below the task.
+ */
+static void
+PaintBackground(Canvas &canvas, const WindowProjection &projection,
+                const MapSettings &settings_map,
+                const AirspaceLook &airspace_look,
+                const RasterTerrain *terrain, const Airspaces *airspaces)
 {
-  assert(!task.IsEmpty());
-
   BackgroundRenderer background;
   background.SetTerrain(terrain);
   background.Draw(canvas, projection, settings_map.terrain);
@@ -119,6 +119,23 @@ PaintTask(Canvas &canvas, const WindowProjection &projection,
   /* desaturate the map background, to focus on the task */
   canvas.FadeToWhite(0xc0);
 #endif
+}
+
+void
+PaintTask(Canvas &canvas, const WindowProjection &projection,
+          const OrderedTask &task,
+          const GeoPoint &location,
+          const MapSettings &settings_map,
+          const TaskLook &task_look,
+          const AirspaceLook &airspace_look,
+          const RasterTerrain *terrain, const Airspaces *airspaces,
+          bool fai_sectors,
+          int highlight_index)
+{
+  assert(!task.IsEmpty());
+
+  PaintBackground(canvas, projection, settings_map, airspace_look,
+                  terrain, airspaces);
 
   if (fai_sectors && IsFAITriangleApplicable(task)) {
     static constexpr Color fill_color = COLOR_YELLOW;
@@ -199,6 +216,36 @@ PaintTask(Canvas &canvas, const PixelRect &rc, const OrderedTask &task,
   RenderMapScale(canvas, projection, rc, overlay_look);
 }
 
+void
+PaintTaskSummary(Canvas &canvas, const PixelRect &rc,
+                 const TaskIndex::Summary &summary,
+                 const MapSettings &settings_map,
+                 const TaskLook &task_look,
+                 const AirspaceLook &airspace_look,
+                 const OverlayLook &overlay_look,
+                 const RasterTerrain *terrain, const Airspaces *airspaces)
+{
+  if (summary.locations.empty() || !summary.bounds.IsValid()) {
+    canvas.ClearWhite();
+    return;
+  }
+
+  ChartProjection projection(rc, TaskProjection(summary.bounds), 1);
+  PaintBackground(canvas, projection, settings_map, airspace_look,
+                  terrain, airspaces);
+
+  BulkPixelPoint points[64];
+  const std::size_t n = std::min(summary.locations.size(),
+                                 std::size(points));
+  for (std::size_t i = 0; i < n; ++i)
+    points[i] = projection.GeoToScreen(summary.locations[i]);
+
+  canvas.Select(task_look.leg_inactive_pen);
+  canvas.DrawPolyline(points, n);
+
+  RenderMapScale(canvas, projection, rc, overlay_look);
+}
+
 void
 PaintTaskPoint(Canvas &canvas, const PixelRect &rc,
                const OrderedTask &task, const OrderedTaskPoint &point,
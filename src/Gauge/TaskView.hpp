@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "Task/TaskIndex.hpp"
+
 struct PixelRect;
 class Canvas;
 class OrderedTask;
@@ -50,6 +52,20 @@ PaintTask(Canvas &canvas, const PixelRect &rc, const OrderedTask &task,
           bool fai_sectors=false,
           int highlight_index = -1);
 
+/**
+ * Draw a preview of a task from its #TaskIndex::Summary into a
+ * rectangle, i.e. without loading the task: only the legs between
+ * the task points are drawn, not the observation zones.
+ */
+void
+PaintTaskSummary(Canvas &canvas, const PixelRect &rc,
+                 const TaskIndex::Summary &summary,
+                 const MapSettings &settings_map,
+                 const TaskLook &task_look,
+                 const AirspaceLook &airspace_look,
+                 const OverlayLook &overlay_look,
+                 const RasterTerrain *terrain, const Airspaces *airspaces);
+
 /**
  * Draw a detailed view of a TaskPoint into a rectangle.
  * @highlight_index highlight the task point as beeing manually edited
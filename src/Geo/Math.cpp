@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "Math.hpp"
+#include "PreparedGeoPoint.hpp"
 #include "SimplifiedMath.hpp"
 #include "FAISphere.hpp"
 #include "WGS84.hpp"
@@ -138,17 +139,14 @@ Middle(const GeoPoint &a, const GeoPoint &b) noexcept
 }
 
 void
-DistanceBearing(const GeoPoint &loc1, const GeoPoint &loc2,
+DistanceBearing(const PreparedGeoPoint &p1, const PreparedGeoPoint &p2,
                 double *distance, Angle *bearing) noexcept
 {
+  const GeoPoint &loc1 = p1.location, &loc2 = p2.location;
   const auto lon21 = loc2.longitude - loc1.longitude;
 
-  auto u1 = atan((1 - FLATTENING) * loc1.latitude.tan()),
-    u2 = atan((1 - FLATTENING) * loc2.latitude.tan());
-
-  auto sinu1 = sin(u1), cosu1 = cos(u1);
-
-  auto sinu2 = sin(u2), cosu2 = cos(u2);
+  const auto sinu1 = p1.sin_u, cosu1 = p1.cos_u;
+  const auto sinu2 = p2.sin_u, cosu2 = p2.cos_u;
 
   auto lambda = lon21.Radians(), lambda_p = Angle::FullCircle().Radians();
 
@@ -219,6 +217,21 @@ DistanceBearing(const GeoPoint &loc1, const GeoPoint &loc2,
       cosu1 * sinu2 - sinu1 * cosu2 * cos(lambda))).AsBearing();
 }
 
+void
+DistanceBearing(const PreparedGeoPoint &loc1, const GeoPoint &loc2,
+                double *distance, Angle *bearing) noexcept
+{
+  DistanceBearing(loc1, PreparedGeoPoint{loc2}, distance, bearing);
+}
+
+void
+DistanceBearing(const GeoPoint &loc1, const GeoPoint &loc2,
+                double *distance, Angle *bearing) noexcept
+{
+  DistanceBearing(PreparedGeoPoint{loc1}, PreparedGeoPoint{loc2},
+                  distance, bearing);
+}
+
 double
 ProjectedDistance(const GeoPoint &loc1, const GeoPoint &loc2,
                   const GeoPoint &loc3) noexcept
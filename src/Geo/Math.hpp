@@ -11,6 +11,7 @@
 #pragma once
 
 struct GeoPoint;
+struct PreparedGeoPoint;
 class Angle;
 
 /**
@@ -25,6 +26,19 @@ void
 DistanceBearing(const GeoPoint &loc1, const GeoPoint &loc2,
                 double *distance, Angle *bearing) noexcept;
 
+/**
+ * Like DistanceBearing(const GeoPoint &, const GeoPoint &, double *,
+ * Angle *), but with precalculated locations.  The results are
+ * identical.
+ */
+void
+DistanceBearing(const PreparedGeoPoint &loc1, const PreparedGeoPoint &loc2,
+                double *distance, Angle *bearing) noexcept;
+
+void
+DistanceBearing(const PreparedGeoPoint &loc1, const GeoPoint &loc2,
+                double *distance, Angle *bearing) noexcept;
+
 /**
  * Calculates the distance between two locations
  * @param loc1 Location 1
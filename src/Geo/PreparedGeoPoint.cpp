@@ -0,0 +1,16 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "PreparedGeoPoint.hpp"
+#include "WGS84.hpp"
+
+#include <cmath>
+
+PreparedGeoPoint::PreparedGeoPoint(const GeoPoint &_location) noexcept
+  :location(_location)
+{
+  const auto u = std::atan((1 - WGS84::FLATTENING) *
+                           location.latitude.tan());
+  sin_u = std::sin(u);
+  cos_u = std::cos(u);
+}
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "GeoPoint.hpp"
+
+/**
+ * A #GeoPoint with the sine and cosine of its WGS84 reduced latitude
+ * precalculated.  This saves three of the trigonometric functions
+ * in each DistanceBearing() call if the location is used more than
+ * once, e.g. as the origin of many vectors.
+ */
+struct PreparedGeoPoint {
+  GeoPoint location;
+
+  double sin_u, cos_u;
+
+  explicit PreparedGeoPoint(const GeoPoint &_location) noexcept;
+};
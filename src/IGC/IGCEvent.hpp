@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "time/BrokenTime.hpp"
+
+#include <string.h>
+
+/**
+ * An IGC "E" record (event).
+ */
+struct IGCEvent {
+  /**
+   * The time of the event.
+   */
+  BrokenTime time;
+
+  /**
+   * 3-letter event code, e.g. "PEV" for a pilot event.
+   */
+  char code[4];
+
+  bool IsPilotEvent() const noexcept {
+    return strcmp(code, "PEV") == 0;
+  }
+};
@@ -6,6 +6,7 @@
 #include "IGCFix.hpp"
 #include "IGCExtensions.hpp"
 #include "IGCDeclaration.hpp"
+#include "IGCEvent.hpp"
 #include "time/BrokenDate.hpp"
 #include "time/BrokenTime.hpp"
 #include "util/CharUtil.hxx"
@@ -373,3 +374,24 @@ IGCParseDeclarationTurnpoint(const char *line, IGCDeclarationTurnpoint &tp)
   tp.name = line + 18;
   return true;
 }
+
+bool
+IGCParseEvent(const char *line, IGCEvent &event)
+{
+  if (*line != 'E' || strlen(line) < 10)
+    return false;
+
+  if (!IGCParseTime(line + 1, event.time))
+    return false;
+
+  for (unsigned i = 0; i < 3; ++i) {
+    const char ch = line[7 + i];
+    if (!IsUpperAlphaASCII(ch) && !IsDigitASCII(ch))
+      return false;
+
+    event.code[i] = ch;
+  }
+
+  event.code[3] = 0;
+  return true;
+}
@@ -8,6 +8,7 @@ struct IGCHeader;
 struct IGCExtensions;
 struct IGCDeclarationHeader;
 struct IGCDeclarationTurnpoint;
+struct IGCEvent;
 struct BrokenDate;
 struct BrokenTime;
 struct GeoPoint;
@@ -75,3 +76,11 @@ IGCParseDeclarationHeader(const char *line, IGCDeclarationHeader &header);
  */
 bool
 IGCParseDeclarationTurnpoint(const char *line, IGCDeclarationTurnpoint &tp);
+
+/**
+ * Parse an IGC "E" record.
+ *
+ * @return true on success, false if the line was not recognized
+ */
+bool
+IGCParseEvent(const char *line, IGCEvent &event);
@@ -8,7 +8,7 @@
 #include "Components.hpp"
 #include "Task/ProtectedTaskManager.hpp"
 #include "Engine/Util/Gradient.hpp"
-#include "Engine/Task/TaskManager.hpp"
+#include "Task/PublishedTask.hpp"
 #include "Engine/Task/Unordered/AlternateList.hpp"
 #include "Engine/Waypoint/Waypoint.hpp"
 #include "Dialogs/Task/TaskDialogs.hpp"
@@ -42,8 +42,8 @@ InfoBoxContentAlternateName::Update(InfoBoxData &data) noexcept
     return;
   }
 
-  ProtectedTaskManager::Lease lease{*backend_components->protected_task_manager};
-  const AlternateList &alternates = lease->GetAlternates();
+  const auto published = backend_components->protected_task_manager->GetPublished();
+  const AlternateList &alternates = published->alternates;
 
   const AlternatePoint *alternate;
   if (!alternates.empty()) {
@@ -88,8 +88,8 @@ InfoBoxContentAlternateGR::Update(InfoBoxData &data) noexcept
     return;
   }
 
-  ProtectedTaskManager::Lease lease{*backend_components->protected_task_manager};
-  const AlternateList &alternates = lease->GetAlternates();
+  const auto published = backend_components->protected_task_manager->GetPublished();
+  const AlternateList &alternates = published->alternates;
 
   const AlternatePoint *alternate;
   if (!alternates.empty()) {
@@ -38,9 +38,46 @@ void
 InfoBoxWindow::SetTitle(const TCHAR *_title)
 {
   data.SetTitle(_title);
+  text_layout.title_valid = false;
   Invalidate(title_rect);
 }
 
+inline void
+InfoBoxWindow::UpdateTitleLayout() noexcept
+{
+  if (text_layout.title_valid)
+    return;
+
+  text_layout.title_size = look.title_font.TextSize(data.title);
+  text_layout.title_valid = true;
+}
+
+inline void
+InfoBoxWindow::UpdateValueLayout() noexcept
+{
+  if (text_layout.value_valid)
+    return;
+
+  text_layout.value_font = &look.value_font;
+  text_layout.value_size = look.value_font.TextSize(data.value);
+  if (unsigned(text_layout.value_size.width + unit_width) > value_rect.GetWidth()) {
+    text_layout.value_font = &look.small_value_font;
+    text_layout.value_size = look.small_value_font.TextSize(data.value);
+  }
+
+  text_layout.value_valid = true;
+}
+
+inline void
+InfoBoxWindow::UpdateCommentLayout() noexcept
+{
+  if (text_layout.comment_valid)
+    return;
+
+  text_layout.comment_size = look.title_font.TextSize(data.comment);
+  text_layout.comment_valid = true;
+}
+
 void
 InfoBoxWindow::PaintTitle(Canvas &canvas)
 {
@@ -56,7 +93,8 @@ InfoBoxWindow::PaintTitle(Canvas &canvas)
   const Font &font = look.title_font;
   canvas.Select(font);
 
-  PixelSize tsize = canvas.CalcTextSize(data.title);
+  UpdateTitleLayout();
+  const PixelSize tsize = text_layout.title_size;
 
   int halftextwidth = (title_rect.left + title_rect.right - (int)tsize.width) / 2;
   int x = std::max(1, title_rect.left + halftextwidth);
@@ -101,15 +139,13 @@ InfoBoxWindow::PaintValue(Canvas &canvas, [[maybe_unused]] Color background_colo
 
   canvas.SetTextColor(look.GetValueColor(data.value_color));
 
-  canvas.Select(look.value_font);
-  int ascent_height = look.value_font.GetAscentHeight();
+  UpdateValueLayout();
 
-  PixelSize value_size = canvas.CalcTextSize(data.value);
-  if (unsigned(value_size.width + unit_width) > value_rect.GetWidth()) {
-    canvas.Select(look.small_value_font);
-    ascent_height = look.small_value_font.GetAscentHeight();
-    value_size = canvas.CalcTextSize(data.value);
-  }
+  const Font &font = *text_layout.value_font;
+  canvas.Select(font);
+  const int ascent_height = font.GetAscentHeight();
+
+  const PixelSize value_size = text_layout.value_size;
 
   const PixelSize value_unit_size = value_size + PixelSize{unit_width, 0u};
 
@@ -143,7 +179,8 @@ InfoBoxWindow::PaintComment(Canvas &canvas)
   const Font &font = look.title_font;
   canvas.Select(font);
 
-  PixelSize tsize = canvas.CalcTextSize(data.comment);
+  UpdateCommentLayout();
+  const PixelSize tsize = text_layout.comment_size;
 
   int x = std::max(1,
                    (comment_rect.left + comment_rect.right - (int)tsize.width) / 2);
@@ -211,6 +248,9 @@ InfoBoxWindow::SetContentProvider(std::unique_ptr<InfoBoxContent> _content)
   ++content_serial;
 
   data.SetInvalid();
+  unit_width = UnitSymbolRenderer::GetSize(look.unit_font,
+                                           data.value_unit).width;
+  text_layout.Invalidate();
   Invalidate();
 }
 
@@ -224,25 +264,41 @@ InfoBoxWindow::UpdateContent()
   content->Update(data);
   data.content_serial = content_serial;
 
+  /* only the parts whose visible output has changed need to be
+     measured and painted again */
+  const bool title_changed = !data.CompareTitle(old);
+  const bool value_changed = !data.CompareValue(old);
+  const bool comment_changed = !data.CompareComment(old);
+
+  if (title_changed)
+    text_layout.title_valid = false;
+
+  if (value_changed) {
+    text_layout.value_valid = false;
+
+    if (data.value_unit != old.value_unit)
+      unit_width = UnitSymbolRenderer::GetSize(look.unit_font,
+                                               data.value_unit).width;
+  }
+
+  if (comment_changed)
+    text_layout.comment_valid = false;
+
   if (old.GetCustom() || data.GetCustom()) {
     if (!data.CompareCustom(old))
       Invalidate();
   } else {
 #ifdef ENABLE_OPENGL
-    if (!data.CompareTitle(old) || !data.CompareValue(old) ||
-        !data.CompareComment(old))
+    if (title_changed || value_changed || comment_changed)
       Invalidate();
 #else
-    if (!data.CompareTitle(old))
+    if (title_changed)
       Invalidate(title_rect);
-    if (!data.CompareValue(old))
+    if (value_changed)
       Invalidate(value_rect);
-    if (!data.CompareComment(old))
+    if (comment_changed)
       Invalidate(comment_rect);
 #endif
-
-    unit_width = UnitSymbolRenderer::GetSize(look.unit_font,
-                                             data.value_unit).width;
   }
 }
 
@@ -314,6 +370,9 @@ InfoBoxWindow::OnResize(PixelSize new_size) noexcept
 
   value_and_comment_rect = value_rect;
   value_and_comment_rect.bottom = comment_rect.bottom;
+
+  /* the value font depends on the width of value_rect */
+  text_layout.value_valid = false;
 }
 
 bool
@@ -13,6 +13,7 @@
 struct InfoBoxSettings;
 struct InfoBoxLook;
 class Color;
+class Font;
 
 class InfoBoxWindow : public LazyPaintWindow
 {
@@ -63,6 +64,31 @@ class InfoBoxWindow : public LazyPaintWindow
 
   unsigned unit_width = 0;
 
+  /**
+   * Text measurements, cached until the text or the window size
+   * changes, so repainting an InfoBox (e.g. because another part of
+   * it has changed) does not measure all of its strings again.
+   */
+  struct TextLayout {
+    PixelSize title_size, value_size, comment_size;
+
+    /**
+     * The font chosen for the value: InfoBoxLook::value_font, or
+     * InfoBoxLook::small_value_font if the value is too wide.
+     */
+    const Font *value_font;
+
+    bool title_valid = false, value_valid = false, comment_valid = false;
+
+    void Invalidate() noexcept {
+      title_valid = value_valid = comment_valid = false;
+    }
+  } text_layout;
+
+  void UpdateTitleLayout() noexcept;
+  void UpdateValueLayout() noexcept;
+  void UpdateCommentLayout() noexcept;
+
   /**
    * Paints the InfoBox title to the given canvas
    * @param canvas The canvas to paint on
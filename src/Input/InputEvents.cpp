@@ -48,6 +48,7 @@ doc/html/advanced/input/ALL		http://xcsoar.sourceforge.net/advanced/input/
 #include "lua/InputEvent.hpp"
 
 #include <cassert>
+#include <chrono>
 #include <tchar.h>
 #include <stdio.h>
 #include <memory>
@@ -65,7 +66,23 @@ static Mode current_mode = InputEvents::MODE_DEFAULT;
  */
 static Mode overlay_mode = MODE_DEFAULT;
 
-static std::chrono::duration<unsigned> MenuTimeOut{};
+/**
+ * When was the menu last used?  It is hidden automatically after
+ * UISettings::menu_timeout.
+ */
+static std::chrono::steady_clock::time_point menu_used_time;
+
+/**
+ * Has the menu already been hidden after #menu_used_time?
+ */
+static bool menu_timed_out = false;
+
+static void
+ResetMenuTimeOut() noexcept
+{
+  menu_used_time = std::chrono::steady_clock::now();
+  menu_timed_out = false;
+}
 
 /**
  * True if a full menu update was postponed by drawButtons().
@@ -446,7 +463,7 @@ InputEvents::processGo(unsigned eventid) noexcept
     const InputConfig::Event &event = input_config.events[eventid];
     if (event.event != NULL) {
       event.event(event.misc);
-      MenuTimeOut = {};
+      ResetMenuTimeOut();
     }
 
     eventid = event.next;
@@ -463,7 +480,7 @@ void
 InputEvents::ShowMenu() noexcept
 {
   setMode(MODE_MENU);
-  MenuTimeOut = {};
+  ResetMenuTimeOut();
   ProcessMenuTimer();
 }
 
@@ -484,13 +501,20 @@ InputEvents::ProcessMenuTimer() noexcept
     /* no menu updates while a dialog is visible */
     return;
 
-  if (MenuTimeOut == CommonInterface::GetUISettings().menu_timeout)
+  /* the setting counts half seconds, the period of the old fixed
+     user interface timer; measure the real time because the timer
+     runs less often while idle */
+  using namespace std::chrono;
+  const auto menu_timeout =
+    duration_cast<milliseconds>(CommonInterface::GetUISettings().menu_timeout) / 2;
+  if (!menu_timed_out &&
+      steady_clock::now() - menu_used_time >= menu_timeout) {
+    menu_timed_out = true;
     HideMenu();
+  }
 
   // refresh visible buttons if still visible
   drawButtons(getModeID());
-
-  MenuTimeOut += std::chrono::seconds{1};
 }
 
 void
@@ -62,7 +62,7 @@ Logger::GUIStartLogger(const NMEAInfo& gps_info,
     return;
 
   auto task = protected_task_manager != nullptr
-    ? protected_task_manager->TaskClone()
+    ? protected_task_manager->GetTaskSnapshot()
     : nullptr;
   const Declaration decl(settings.logger, settings.plane, task.get());
 
@@ -495,7 +495,9 @@ MainWindow::Destroy() noexcept
 void
 MainWindow::FinishStartup() noexcept
 {
-  timer.Schedule(std::chrono::milliseconds(500)); // 2 times per second
+  /* the first tick; RunTimer() re-arms the timer for the next due
+     duty */
+  timer.Schedule(std::chrono::milliseconds(500));
 
   ResumeThreads();
 }
@@ -705,7 +707,7 @@ MainWindow::RunTimer() noexcept
     UI::event_queue->Inject(UI::Event::TASK_RECEIVED);
 #endif
 
-  ProcessTimer();
+  timer.Schedule(ProcessTimer());
 
   UpdateGaugeVisibility();
 
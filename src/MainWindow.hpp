@@ -4,7 +4,7 @@
 #pragma once
 
 #include "ui/window/SingleWindow.hpp"
-#include "ui/event/PeriodicTimer.hpp"
+#include "ui/event/Timer.hpp"
 #include "ui/event/Notify.hpp"
 #include "BatteryTimer.hpp"
 #include "Widget/ManagedWidget.hpp"
@@ -100,7 +100,7 @@ private:
    */
   UI::Notify restore_page_notify{[this]{ OnRestorePageNotify(); }};
 
-  UI::PeriodicTimer timer{[this]{ RunTimer(); }};
+  UI::Timer timer{[this]{ RunTimer(); }};
 
   BatteryTimer battery_timer;
 
@@ -7,8 +7,7 @@
 #include "Language/Language.hpp"
 #include "Screen/Layout.hpp"
 #include "Task/ProtectedTaskManager.hpp"
-#include "Engine/Task/TaskManager.hpp"
-#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Task/PublishedTask.hpp"
 #include "Renderer/TextInBox.hpp"
 #include "Weather/Rasp/RaspRenderer.hpp"
 #include "Formatter/UserUnits.hpp"
@@ -425,7 +424,7 @@ GlueMapWindow::DrawThermalBand(Canvas &canvas,
 
   const ThermalBandRenderer &renderer = thermal_band_renderer;
   if (task != nullptr) {
-    ProtectedTaskManager::Lease task_manager(*task);
+    const auto published = task->GetPublished();
     renderer.DrawThermalBand(Basic(),
                              Calculated(),
                              GetComputerSettings(),
@@ -433,7 +432,7 @@ GlueMapWindow::DrawThermalBand(Canvas &canvas,
                              tb_rect,
                              GetComputerSettings().task,
                              true,
-                             &task_manager->GetOrderedTask().GetOrderedTaskSettings());
+                             &published->ordered_settings);
   } else {
     renderer.DrawThermalBand(Basic(),
                              Calculated(),
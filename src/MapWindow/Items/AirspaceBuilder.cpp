@@ -11,6 +11,7 @@
 #include "Engine/Airspace/AirspaceWarningManager.hpp"
 #include "Airspace/AirspaceVisibility.hpp"
 #include "Airspace/ProtectedAirspaceWarningManager.hpp"
+#include "Airspace/AirspaceWarningSnapshot.hpp"
 #include "NMEA/Aircraft.hpp"
 
 class AirspaceWarningList
@@ -29,8 +30,8 @@ public:
   }
 
   void Fill(const ProtectedAirspaceWarningManager &awm) {
-    const ProtectedAirspaceWarningManager::Lease lease(awm);
-    Fill(lease);
+    for (const AirspaceWarning &as : *awm.GetSnapshot())
+      Add(as);
   }
 
   bool Contains(const AbstractAirspace& as) const {
@@ -11,6 +11,7 @@
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "NMEA/Aircraft.hpp"
 #include "Task/ProtectedTaskManager.hpp"
+#include "Task/PublishedTask.hpp"
 #include "Task/ProtectedRoutePlanner.hpp"
 #include "NMEA/Info.hpp"
 #include "Terrain/RasterTerrain.hpp"
@@ -82,11 +83,11 @@ MapItemListBuilder::AddWaypoints(const Waypoints &waypoints)
 void
 MapItemListBuilder::AddTaskOZs(const ProtectedTaskManager &task)
 {
-  ProtectedTaskManager::Lease task_manager(task);
-  if (task_manager->GetMode() != TaskType::ORDERED)
+  if (task.GetPublished()->mode != TaskType::ORDERED)
     return;
 
-  const OrderedTask &ordered_task = task_manager->GetOrderedTask();
+  const auto snapshot = task.GetTaskSnapshot();
+  const OrderedTask &ordered_task = *snapshot;
 
   AircraftState a;
   a.location = location;
@@ -8,7 +8,9 @@
 #include "Topography/TopographyStore.hpp"
 #include "Terrain/RasterTerrain.hpp"
 #include "Weather/Rasp/RaspRenderer.hpp"
+#include "Weather/Rasp/RaspMapCache.hpp"
 #include "Computer/GlideComputer.hpp"
+#include "Profiler/Profiler.hpp"
 
 #ifdef ENABLE_OPENGL
 #include "ui/canvas/opengl/Scissor.hpp"
@@ -121,6 +123,7 @@ MapWindow::OnPaintBuffer(Canvas &canvas) noexcept
 #endif
 
     // Render the moving map
+    const Profiler::ScopeTimer timer{Profiler::Section::MAP_RENDER};
     Render(canvas, GetClientRect());
     draw_sw.Finish();
   }
@@ -155,5 +158,9 @@ void
 MapWindow::SetRasp(const std::shared_ptr<RaspStore> &_rasp_store) noexcept
 {
   rasp_renderer.reset();
+  rasp_maps.reset();
   rasp_store = _rasp_store;
+
+  if (rasp_store != nullptr)
+    rasp_maps = std::make_unique<RaspMapCache>(*rasp_store);
 }
@@ -27,6 +27,7 @@ class TopographyStore;
 class CachedTopographyRenderer;
 class RasterTerrain;
 class RaspStore;
+class RaspMapCache;
 class RaspRenderer;
 class MapOverlay;
 class Waypoints;
@@ -105,6 +106,13 @@ protected:
 
   std::shared_ptr<RaspStore> rasp_store;
 
+  /**
+   * The decoded maps of #rasp_store; it outlives the #RaspRenderer
+   * instances, so switching back to a recently used parameter is
+   * quick.
+   */
+  std::unique_ptr<RaspMapCache> rasp_maps;
+
   /**
    * The current RASP renderer.  Modifications to this pointer (but
    * not to the #RaspRenderer instance) are protected by
@@ -54,7 +54,7 @@ MapWindow::RenderRasp(Canvas &canvas) noexcept
 #ifndef ENABLE_OPENGL
     const std::lock_guard lock{mutex};
 #endif
-    rasp_renderer.reset(new RaspRenderer(*rasp_store, state.map));
+    rasp_renderer.reset(new RaspRenderer(*rasp_maps, state.map));
   }
 
   rasp_renderer->SetTime(state.time);
@@ -9,6 +9,7 @@
 #include "Renderer/AircraftRenderer.hpp"
 #include "Renderer/MapScaleRenderer.hpp"
 #include "Task/ProtectedTaskManager.hpp"
+#include "Task/PublishedTask.hpp"
 #include "Interface.hpp"
 #include "Computer/GlideComputer.hpp"
 #include "Engine/Task/TaskManager.hpp"
@@ -119,28 +120,45 @@ TargetMapWindow::RenderAirspace(Canvas &canvas) noexcept
                            GetMapSettings().airspace);
 }
 
+inline void
+TargetMapWindow::DrawTask(Canvas &canvas, const AbstractTask &task,
+                          const TaskProjection &task_projection) noexcept
+{
+  if (IsError(task.CheckTask()))
+    return;
+
+  OZRenderer ozv(task_look, airspace_renderer.GetLook(),
+                 GetMapSettings().airspace);
+  TaskPointRenderer tpv(canvas, projection, task_look,
+                        task_projection,
+                        ozv, false,
+                        TaskPointRenderer::TargetVisibility::ALL,
+                        Basic().GetLocationOrInvalid());
+  tpv.SetTaskFinished(Calculated().task_stats.task_finished);
+  TaskRenderer dv(tpv, projection.GetScreenBounds());
+  dv.Draw(task);
+}
+
 inline void
 TargetMapWindow::DrawTask(Canvas &canvas) noexcept
 {
   if (task == nullptr)
     return;
 
-  ProtectedTaskManager::Lease task_manager(*task);
-  const AbstractTask *task = task_manager->GetActiveTask();
-  if (task && !IsError(task->CheckTask())) {
-    OZRenderer ozv(task_look, airspace_renderer.GetLook(),
-                   GetMapSettings().airspace);
-    TaskPointRenderer tpv(canvas, projection, task_look,
-                          /* we're accessing the OrderedTask here,
-                             which may be invalid at this point, but it
-                             will be used only if active, so it's ok */
-                          task_manager->GetOrderedTask().GetTaskProjection(),
-                          ozv, false,
-                          TaskPointRenderer::TargetVisibility::ALL,
-                          Basic().GetLocationOrInvalid());
-    tpv.SetTaskFinished(Calculated().task_stats.task_finished);
-    TaskRenderer dv(tpv, projection.GetScreenBounds());
-    dv.Draw(*task);
+  if (task->GetPublished()->mode == TaskType::ORDERED) {
+    /* the ordered task is the one being edited here; draw the
+       published copy, which doesn't block the calculation thread */
+    const auto snapshot = task->GetTaskSnapshot();
+    DrawTask(canvas, *snapshot, snapshot->GetTaskProjection());
+  } else {
+    ProtectedTaskManager::Lease task_manager(*task);
+    const AbstractTask *active_task = task_manager->GetActiveTask();
+    if (active_task != nullptr)
+      /* we're accessing the OrderedTask here, which may be invalid
+         at this point, but it will be used only if active, so it's
+         ok */
+      DrawTask(canvas, *active_task,
+               task_manager->GetOrderedTask().GetTaskProjection());
   }
 }
 
@@ -286,8 +304,8 @@ TargetMapWindow::SetTarget(unsigned index) noexcept
   double radius;
 
   {
-    ProtectedTaskManager::Lease lease(*task);
-    const OrderedTask &o_task = lease->GetOrderedTask();
+    const auto snapshot = task->GetTaskSnapshot();
+    const OrderedTask &o_task = *snapshot;
     if (!o_task.IsValidIndex(index))
       return;
 
@@ -26,6 +26,8 @@ class TopographyRenderer;
 class Waypoints;
 class Airspaces;
 class ProtectedTaskManager;
+class AbstractTask;
+class TaskProjection;
 class GlideComputer;
 
 class TargetMapWindow : public BufferWindow {
@@ -147,6 +149,8 @@ private:
 
   void DrawWaypoints(Canvas &canvas) noexcept;
 
+  void DrawTask(Canvas &canvas, const AbstractTask &task,
+                const TaskProjection &task_projection) noexcept;
   void DrawTask(Canvas &canvas) noexcept;
 
 private:
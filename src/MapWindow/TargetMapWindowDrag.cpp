@@ -48,8 +48,12 @@ TargetMapWindow::isClickOnTarget(const PixelPoint pc) const noexcept
   if (task == nullptr)
     return false;
 
-  ProtectedTaskManager::Lease task_manager(*task);
-  const GeoPoint t = task_manager->GetLocationTarget(target_index);
+  const auto snapshot = task->GetTaskSnapshot();
+  const AATPoint *ap = snapshot->GetAATTaskPoint(target_index);
+  if (ap == nullptr)
+    return false;
+
+  const GeoPoint t = ap->GetTargetLocation();
   if (!t.IsValid())
     return false;
 
@@ -67,7 +71,7 @@ TargetMapWindow::isInSector(PixelPoint pt) const noexcept
 
   GeoPoint gp = projection.ScreenToGeo(pt);
 
-  ProtectedTaskManager::Lease lease(*task);
-  AATPoint *p = lease->GetOrderedTask().GetAATTaskPoint(target_index);
+  const auto snapshot = task->GetTaskSnapshot();
+  const AATPoint *p = snapshot->GetAATTaskPoint(target_index);
   return p != nullptr && p->GetObservationZone().IsInSector(gp);
 }
@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TimeSeries.hpp"
+#include "Util.hpp"
+
+#include <algorithm>
+
+#include <math.h>
+
+void
+TimeSeries::Bucket::Merge(const Bucket &other) noexcept
+{
+  const bool min_is_ours = y_min <= other.y_min;
+  const bool max_is_ours = y_max >= other.y_max;
+
+  if (min_is_ours != max_is_ours)
+    /* one extreme from each bucket: the one from the older bucket
+       (this one) occurred first */
+    min_first = min_is_ours;
+  else if (!min_is_ours)
+    min_first = other.min_first;
+
+  y_min = std::min(y_min, other.y_min);
+  y_max = std::max(y_max, other.y_max);
+  y_sum += other.y_sum;
+  n += other.n;
+  x_last = other.x_last;
+}
+
+inline DoublePoint2D *
+TimeSeries::Bucket::Export(DoublePoint2D *p,
+                           Reduction reduction) const noexcept
+{
+  const double x_middle = (x_first + x_last) / 2;
+
+  switch (reduction) {
+  case Reduction::MEAN:
+    *p++ = {x_middle, GetMeanY()};
+    break;
+
+  case Reduction::MIN:
+    *p++ = {x_middle, y_min};
+    break;
+
+  case Reduction::MAX:
+    *p++ = {x_middle, y_max};
+    break;
+
+  case Reduction::ENVELOPE:
+    if (n == 1) {
+      *p++ = {x_first, y_min};
+    } else if (min_first) {
+      *p++ = {x_first, y_min};
+      *p++ = {x_last, y_max};
+    } else {
+      *p++ = {x_first, y_max};
+      *p++ = {x_last, y_min};
+    }
+    break;
+  }
+
+  return p;
+}
+
+void
+TimeSeries::Reset() noexcept
+{
+  for (auto &tier : tiers) {
+    tier.buckets.clear();
+    tier.n_pushed = 0;
+    tier.n_open = 0;
+  }
+
+  n = 0;
+  sum_x = sum_y = sum_xx = sum_xy = 0;
+}
+
+void
+TimeSeries::Push(unsigned i, const Bucket &bucket) noexcept
+{
+  Tier &tier = tiers[i];
+  tier.buckets.push(bucket);
+  ++tier.n_pushed;
+
+  if (i + 1 >= N_TIERS)
+    return;
+
+  Tier &next = tiers[i + 1];
+  if (next.n_open == 0)
+    next.open = bucket;
+  else
+    next.open.Merge(bucket);
+
+  if (++next.n_open == FACTOR) {
+    next.n_open = 0;
+    Push(i + 1, next.open);
+  }
+}
+
+void
+TimeSeries::Add(double x, double y) noexcept
+{
+  if (IsEmpty()) {
+    x_min = x_max = x;
+    y_min = y_max = y;
+  } else {
+    if (x < x_max)
+      return;
+
+    x_max = x;
+    y_min = std::min(y_min, y);
+    y_max = std::max(y_max, y);
+  }
+
+  ++n;
+  sum_x += x;
+  sum_y += y;
+  sum_xx += Square(x);
+  sum_xy += x * y;
+
+  Push(0, Bucket::FromSample(x, y));
+}
+
+double
+TimeSeries::GetGradient() const noexcept
+{
+  assert(!IsEmpty());
+
+  const double denom = n * sum_xx - Square(sum_x);
+  if (fabs(denom) > 0)
+    return (n * sum_xy - sum_x * sum_y) / denom;
+
+  return 0;
+}
+
+TimeSeries::Stitch
+TimeSeries::MakeStitch(unsigned finest) const noexcept
+{
+  Stitch stitch;
+  stitch.n_buckets = 0;
+
+  std::size_t end = tiers[finest].n_pushed;
+  for (unsigned i = finest;; ++i) {
+    const Tier &tier = tiers[i];
+    const std::size_t first = tier.n_pushed - tier.GetSize();
+
+    if (first == 0 || i + 1 >= N_TIERS) {
+      const std::size_t begin = std::min(first, end);
+      stitch.ranges[i] = {begin, end};
+      stitch.n_buckets += end - begin;
+      stitch.coarsest = i;
+      break;
+    }
+
+    /* the dropped buckets are covered by the next coarser tier,
+       which has complete buckets for all of them */
+    const std::size_t coarse_end = (first + FACTOR - 1) / FACTOR;
+    const std::size_t begin = std::min(coarse_end * FACTOR, end);
+    stitch.ranges[i] = {begin, end};
+    stitch.n_buckets += end - begin;
+
+    end = coarse_end;
+  }
+
+  /* the newest samples have not been merged into the finest tier
+     yet */
+  for (unsigned i = finest; i > 0; --i)
+    if (tiers[i].n_open > 0)
+      ++stitch.n_buckets;
+
+  return stitch;
+}
+
+std::size_t
+TimeSeries::Export(std::span<DoublePoint2D> dest,
+                   Reduction reduction) const noexcept
+{
+  if (IsEmpty())
+    return 0;
+
+  const std::size_t per_bucket = reduction == Reduction::ENVELOPE ? 2 : 1;
+
+  /* find the finest tier whose stitched series fits */
+  unsigned finest = 0;
+  Stitch stitch = MakeStitch(finest);
+  while (finest + 1 < N_TIERS && stitch.n_buckets * per_bucket > dest.size())
+    stitch = MakeStitch(++finest);
+
+  std::size_t skip = 0;
+  if (const std::size_t n_points = stitch.n_buckets * per_bucket;
+      n_points > dest.size())
+    skip = (n_points - dest.size() + per_bucket - 1) / per_bucket;
+
+  DoublePoint2D *p = dest.data();
+
+  auto emit = [&](const Bucket &bucket){
+    if (skip > 0)
+      --skip;
+    else
+      p = bucket.Export(p, reduction);
+  };
+
+  /* oldest first: from the coarsest tier to the finest one */
+  for (unsigned i = stitch.coarsest + 1; i-- > finest;) {
+    const Tier &tier = tiers[i];
+    const auto &range = stitch.ranges[i];
+
+    std::size_t index = tier.n_pushed - tier.GetSize();
+    for (const auto &bucket : tier.buckets) {
+      if (index >= range.end)
+        break;
+
+      if (index >= range.begin)
+        emit(bucket);
+
+      ++index;
+    }
+  }
+
+  for (unsigned i = finest; i > 0; --i)
+    if (tiers[i].n_open > 0)
+      emit(tiers[i].open);
+
+  assert(p <= dest.data() + dest.size());
+  return p - dest.data();
+}
@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Point2D.hpp"
+#include "util/OverwritingRingBuffer.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <span>
+
+/**
+ * Stores a time series of (x,y) samples at several resolutions.
+ *
+ * Tier 0 holds the raw samples; each following tier holds buckets
+ * which summarise #FACTOR buckets of the previous tier (minimum,
+ * maximum and mean).  All tiers are ring buffers, so adding a sample
+ * is O(1) and never moves old data.  The oldest raw samples are
+ * eventually overwritten, but the coarser tiers still cover the
+ * whole flight.
+ *
+ * Statistics over all samples (extrema, mean, linear regression)
+ * are maintained incrementally.
+ */
+class TimeSeries {
+public:
+  /**
+   * Number of buckets in each tier (one ring buffer slot is always
+   * unused).
+   */
+  static constexpr unsigned CAPACITY = 512;
+
+  /**
+   * Number of buckets of one tier which are combined into one bucket
+   * of the next tier.
+   */
+  static constexpr unsigned FACTOR = 8;
+
+  static constexpr unsigned N_TIERS = 3;
+
+  /**
+   * A buffer of this size is large enough for Export() to use tier 1
+   * or finer for the newest #CAPACITY buckets, with a coarser prefix
+   * for the older ones.
+   */
+  static constexpr std::size_t MAX_POINTS = 2 * (2 * CAPACITY + N_TIERS);
+
+  /**
+   * How Export() turns a bucket into chart points.
+   */
+  enum class Reduction : uint8_t {
+    MEAN,
+    MIN,
+    MAX,
+
+    /**
+     * Two points per bucket (minimum and maximum, in the order in
+     * which they occurred), which preserves peaks in a line graph.
+     */
+    ENVELOPE,
+  };
+
+private:
+  struct Bucket {
+    double x_first, x_last;
+    double y_min, y_max, y_sum;
+    unsigned n;
+
+    /**
+     * Did the minimum occur before the maximum?
+     */
+    bool min_first;
+
+    static constexpr Bucket FromSample(double x, double y) noexcept {
+      return {x, x, y, y, y, 1, true};
+    }
+
+    void Merge(const Bucket &other) noexcept;
+
+    double GetMeanY() const noexcept {
+      return y_sum / n;
+    }
+
+    DoublePoint2D *Export(DoublePoint2D *p,
+                          Reduction reduction) const noexcept;
+  };
+
+  struct Tier {
+    OverwritingRingBuffer<Bucket, CAPACITY> buckets;
+
+    /**
+     * The number of buckets ever pushed into #buckets.
+     */
+    std::size_t n_pushed;
+
+    /**
+     * The bucket which is currently being filled from the previous
+     * tier (unused in tier 0).
+     */
+    Bucket open;
+
+    /**
+     * The number of buckets merged into #open.
+     */
+    unsigned n_open;
+
+    /**
+     * Has this tier never dropped a bucket?
+     */
+    bool IsComplete() const noexcept {
+      return n_pushed < CAPACITY;
+    }
+
+    std::size_t GetSize() const noexcept {
+      return IsComplete() ? n_pushed : CAPACITY - 1;
+    }
+  };
+
+  std::array<Tier, N_TIERS> tiers;
+
+  /**
+   * Which buckets Export() takes from each tier.  Indices count all
+   * buckets ever pushed into the tier.
+   */
+  struct Stitch {
+    struct Range {
+      std::size_t begin, end;
+    };
+
+    std::array<Range, N_TIERS> ranges;
+
+    /**
+     * The coarsest tier which contributes buckets.
+     */
+    unsigned coarsest;
+
+    /**
+     * The total number of buckets, including the open ones.
+     */
+    std::size_t n_buckets;
+  };
+
+  unsigned n;
+  double x_min, x_max, y_min, y_max;
+  double sum_x, sum_y, sum_xx, sum_xy;
+
+public:
+  TimeSeries() noexcept {
+    Reset();
+  }
+
+  void Reset() noexcept;
+
+  /**
+   * Append a sample.  Samples which go back in time (x smaller than
+   * the previous one) are ignored.
+   */
+  void Add(double x, double y) noexcept;
+
+  bool IsEmpty() const noexcept {
+    return n == 0;
+  }
+
+  bool HasResult() const noexcept {
+    return n >= 2;
+  }
+
+  unsigned GetCount() const noexcept {
+    return n;
+  }
+
+  double GetMinX() const noexcept {
+    assert(!IsEmpty());
+
+    return x_min;
+  }
+
+  double GetMaxX() const noexcept {
+    assert(!IsEmpty());
+
+    return x_max;
+  }
+
+  double GetMinY() const noexcept {
+    assert(!IsEmpty());
+
+    return y_min;
+  }
+
+  double GetMaxY() const noexcept {
+    assert(!IsEmpty());
+
+    return y_max;
+  }
+
+  double GetAverageY() const noexcept {
+    assert(!IsEmpty());
+
+    return sum_y / n;
+  }
+
+  /**
+   * Returns the gradient of the least squares fit over all samples.
+   */
+  [[gnu::pure]]
+  double GetGradient() const noexcept;
+
+  /**
+   * Returns the most recent sample.
+   */
+  DoublePoint2D GetLast() const noexcept {
+    assert(!IsEmpty());
+
+    const Bucket &last = tiers.front().buckets.last();
+    return {last.x_last, last.GetMeanY()};
+  }
+
+  /**
+   * Copy the series into #dest at the finest resolution which fits
+   * into #dest.  If a tier has dropped its oldest buckets, the next
+   * coarser tier fills the gap, so the newest samples keep the fine
+   * resolution and the whole series is still covered.  If even the
+   * coarsest tiers do not fit, only the newest points are copied.
+   *
+   * @return the number of points written
+   */
+  std::size_t Export(std::span<DoublePoint2D> dest,
+                     Reduction reduction) const noexcept;
+
+private:
+  void Push(unsigned tier, const Bucket &bucket) noexcept;
+
+  /**
+   * Determine which buckets to export, with #finest being the tier
+   * for the newest samples.
+   */
+  [[gnu::pure]]
+  Stitch MakeStitch(unsigned finest) const noexcept;
+};
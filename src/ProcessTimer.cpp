@@ -8,7 +8,7 @@
 #include "Input/InputEvents.hpp"
 #include "Device/MultipleDevices.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
-#include "time/PeriodClock.hpp"
+#include "time/DutyScheduler.hpp"
 #include "MainWindow.hpp"
 #include "PopupMessage.hpp"
 #include "Simulator.hpp"
@@ -164,20 +164,6 @@ SettingsProcessTimer() noexcept
   ProcessAutoBugs();
 }
 
-static void
-CommonProcessTimer() noexcept
-{
-  BlackboardProcessTimer();
-
-  SettingsProcessTimer();
-
-  InfoBoxManager::ProcessTimer();
-  InputEvents::ProcessTimer();
-
-  MessageProcessTimer();
-  SystemProcessTimer();
-}
-
 static void
 ConnectionProcessTimer() noexcept
 {
@@ -216,35 +202,39 @@ ConnectionProcessTimer() noexcept
   backend_components->devices->AutoReopen(env);
 }
 
-void
-ProcessTimer() noexcept
+static void
+DeviceProcessTimer() noexcept
 {
-  CommonProcessTimer();
+  // now check GPS status
+  if (backend_components->devices != nullptr)
+    backend_components->devices->Tick();
 
-  if (!is_simulator()) {
-    // now check GPS status
-    if (backend_components->devices != nullptr)
-      backend_components->devices->Tick();
-
-    // also service replay logger
-    if (backend_components->replay && backend_components->replay->IsActive()) {
-      if (CommonInterface::MovementDetected())
-        backend_components->replay->Stop();
-    }
+  ConnectionProcessTimer();
+}
 
-    ConnectionProcessTimer();
-  } else {
-    static PeriodClock m_clock;
-
-    if (backend_components->replay && backend_components->replay->IsActive()) {
-      m_clock.Update();
-    } else if (m_clock.Elapsed() >= std::chrono::seconds(1)) {
-      m_clock.Update();
-      backend_components->device_blackboard->ProcessSimulation();
-    } else if (!m_clock.IsDefined())
-      m_clock.Update();
+static void
+ReplayProcessTimer() noexcept
+{
+  // stop the replay as soon as the aircraft really moves
+  if (backend_components->replay && backend_components->replay->IsActive()) {
+    if (CommonInterface::MovementDetected())
+      backend_components->replay->Stop();
   }
+}
 
+static void
+SimulatorProcessTimer() noexcept
+{
+  if (backend_components->replay && backend_components->replay->IsActive())
+    /* the replay generates the data */
+    return;
+
+  backend_components->device_blackboard->ProcessSimulation();
+}
+
+static void
+NetProcessTimer() noexcept
+{
   if (net_components != nullptr) {
 #ifdef HAVE_TRACKING
     if (net_components->tracking) {
@@ -260,3 +250,63 @@ ProcessTimer() noexcept
 #endif
   }
 }
+
+/**
+ * The interval of the duties which react to user input, and of those
+ * which update the user interface while data is flowing.
+ */
+static constexpr std::chrono::milliseconds UI_INTERVAL{500};
+
+/**
+ * The interval of the periodic background duties, and of the user
+ * interface duties while there is no data.
+ */
+static constexpr std::chrono::seconds IDLE_INTERVAL{1};
+
+static DutyScheduler
+MakeScheduler() noexcept
+{
+  using namespace std::chrono;
+
+  /* the tolerance compensates for jitter of the user interface
+     timer */
+  DutyScheduler scheduler(milliseconds(100));
+
+  /* these update the user interface; their interval is adjusted by
+     ProcessTimer() */
+  scheduler.Add(BlackboardProcessTimer, UI_INTERVAL);
+  scheduler.Add(InfoBoxManager::ProcessTimer, UI_INTERVAL);
+
+  /* these deliver queued input events and messages; slowing them
+     down would delay the user's actions */
+  scheduler.Add(InputEvents::ProcessTimer, UI_INTERVAL);
+  scheduler.Add(MessageProcessTimer, UI_INTERVAL);
+
+  scheduler.Add(SettingsProcessTimer, IDLE_INTERVAL);
+  scheduler.Add(SystemProcessTimer, seconds(5));
+
+  if (!is_simulator()) {
+    scheduler.Add(DeviceProcessTimer, IDLE_INTERVAL);
+    scheduler.Add(ReplayProcessTimer, IDLE_INTERVAL);
+  } else
+    scheduler.Add(SimulatorProcessTimer, IDLE_INTERVAL);
+
+  scheduler.Add(NetProcessTimer, IDLE_INTERVAL);
+
+  return scheduler;
+}
+
+std::chrono::steady_clock::duration
+ProcessTimer() noexcept
+{
+  static DutyScheduler scheduler = MakeScheduler();
+
+  /* exchange the blackboard twice per second only while data is
+     flowing */
+  const std::chrono::milliseconds ui_interval =
+    CommonInterface::Basic().alive ? UI_INTERVAL : IDLE_INTERVAL;
+  scheduler.SetInterval(BlackboardProcessTimer, ui_interval);
+  scheduler.SetInterval(InfoBoxManager::ProcessTimer, ui_interval);
+
+  return scheduler.Run(DutyScheduler::Clock::now());
+}
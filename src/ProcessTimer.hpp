@@ -2,5 +2,13 @@
 // Copyright The XCSoar Project
 #pragma once
 
-void
+#include <chrono>
+
+/**
+ * Run the periodic duties of the user interface thread which are
+ * due.
+ *
+ * @return the time until the next duty is due
+ */
+std::chrono::steady_clock::duration
 ProcessTimer() noexcept;
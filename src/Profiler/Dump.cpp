@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Profiler.hpp"
+#include "io/BufferedOutputStream.hxx"
+
+void
+Profiler::Dump(BufferedOutputStream &os)
+{
+  os.Write("section count p50_us p95_us max_us\n");
+
+  for (unsigned i = 0; i < unsigned(Section::COUNT); ++i) {
+    const Section section = Section(i);
+    const auto summary = GetSummary(section);
+
+    os.Fmt("{} {} {} {} {}\n", GetName(section), summary.count,
+           summary.p50.count(), summary.p95.count(),
+           summary.max.count());
+  }
+}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Profiler.hpp"
+#include "Language/Language.hpp"
+#include "thread/Mutex.hxx"
+#include "util/IntrusiveList.hxx"
+#include "util/StringAPI.hxx"
+
+#include <array>
+#include <cassert>
+
+namespace Profiler {
+
+std::atomic_bool enabled{false};
+
+struct SectionInfo {
+  const char *name;
+  const TCHAR *label;
+};
+
+/* one entry per Section, in the same order */
+static constexpr SectionInfo sections[] = {
+  { "calculation", N_("Calculation") },
+  { "process_gps", N_("GPS processing") },
+  { "process_idle", N_("Idle processing") },
+  { "task", N_("Task") },
+  { "airspace_warnings", N_("Airspace warnings") },
+  { "contest", N_("Contest") },
+  { "draw", N_("Drawing") },
+  { "map_render", N_("Map") },
+  { "terrain", N_("Terrain") },
+  { "topography", N_("Topography") },
+};
+
+static_assert(std::size(sections) == unsigned(Section::COUNT));
+
+/**
+ * The histograms of one thread.  They are registered in #threads
+ * while the thread exists.
+ */
+struct ThreadHistograms final : IntrusiveListHook<> {
+  std::array<TimingHistogram, unsigned(Section::COUNT)> histograms;
+
+  ThreadHistograms() noexcept;
+  ~ThreadHistograms() noexcept;
+};
+
+/**
+ * Protects #threads and #retired.
+ */
+static Mutex threads_mutex;
+
+static IntrusiveList<ThreadHistograms> threads;
+
+/**
+ * The accumulated histograms of threads which have exited.
+ */
+static std::array<TimingHistogram::Counts, unsigned(Section::COUNT)> retired;
+
+ThreadHistograms::ThreadHistograms() noexcept
+{
+  const std::lock_guard lock{threads_mutex};
+  threads.push_back(*this);
+}
+
+ThreadHistograms::~ThreadHistograms() noexcept
+{
+  const std::lock_guard lock{threads_mutex};
+
+  for (unsigned i = 0; i < unsigned(Section::COUNT); ++i)
+    histograms[i].AddTo(retired[i]);
+
+  threads.erase(threads.iterator_to(*this));
+}
+
+const char *
+GetName(Section section) noexcept
+{
+  assert(section < Section::COUNT);
+
+  return sections[unsigned(section)].name;
+}
+
+const TCHAR *
+GetLabel(Section section) noexcept
+{
+  assert(section < Section::COUNT);
+
+  return sections[unsigned(section)].label;
+}
+
+Section
+FindSection(const char *name) noexcept
+{
+  for (unsigned i = 0; i < unsigned(Section::COUNT); ++i)
+    if (StringIsEqual(sections[i].name, name))
+      return Section(i);
+
+  return Section::COUNT;
+}
+
+TimingHistogram &
+GetThreadHistogram(Section section) noexcept
+{
+  assert(section < Section::COUNT);
+
+  static thread_local ThreadHistograms thread_histograms;
+  return thread_histograms.histograms[unsigned(section)];
+}
+
+TimingHistogram::Summary
+GetSummary(Section section) noexcept
+{
+  assert(section < Section::COUNT);
+
+  const std::lock_guard lock{threads_mutex};
+
+  TimingHistogram::Counts counts = retired[unsigned(section)];
+  for (const auto &i : threads)
+    i.histograms[unsigned(section)].AddTo(counts);
+
+  return counts.GetSummary();
+}
+
+void
+Reset() noexcept
+{
+  const std::lock_guard lock{threads_mutex};
+
+  retired = {};
+
+  for (auto &i : threads)
+    for (auto &h : i.histograms)
+      h.Reset();
+}
+
+} // namespace Profiler
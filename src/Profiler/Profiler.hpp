@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "TimingHistogram.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <tchar.h>
+
+class BufferedOutputStream;
+
+/**
+ * Always compiled instrumentation of the hot code paths.  Each thread
+ * has its own #TimingHistogram per #Section, which is fed by
+ * #ScopeTimer; readers merge them.  The profiler is disabled by
+ * default (it can be enabled from Lua), and then a #ScopeTimer costs
+ * one relaxed atomic load.
+ */
+namespace Profiler {
+
+enum class Section : uint8_t {
+  CALCULATION,
+  PROCESS_GPS,
+  PROCESS_IDLE,
+  TASK,
+  AIRSPACE_WARNINGS,
+  CONTEST,
+  DRAW,
+  MAP_RENDER,
+  TERRAIN,
+  TOPOGRAPHY,
+
+  /**
+   * A dummy entry which marks the end of the list.
+   */
+  COUNT
+};
+
+extern std::atomic_bool enabled;
+
+static inline bool
+IsEnabled() noexcept
+{
+  return enabled.load(std::memory_order_relaxed);
+}
+
+static inline void
+SetEnabled(bool value) noexcept
+{
+  enabled.store(value, std::memory_order_relaxed);
+}
+
+/**
+ * Returns the machine readable name of the section, e.g. for the
+ * dump file or Lua.
+ */
+[[gnu::const]]
+const char *
+GetName(Section section) noexcept;
+
+/**
+ * Returns the (untranslated) human readable name of the section.
+ */
+[[gnu::const]]
+const TCHAR *
+GetLabel(Section section) noexcept;
+
+/**
+ * Look up a section by its name.
+ *
+ * @return Section::COUNT if there is no such section
+ */
+[[gnu::pure]]
+Section
+FindSection(const char *name) noexcept;
+
+/**
+ * Returns the calling thread's histogram of the given section.
+ */
+TimingHistogram &
+GetThreadHistogram(Section section) noexcept;
+
+/**
+ * Merge the histograms of all threads (including those which have
+ * exited) for the given section.
+ */
+TimingHistogram::Summary
+GetSummary(Section section) noexcept;
+
+/**
+ * Clear the histograms of all threads.
+ */
+void
+Reset() noexcept;
+
+/**
+ * Write one line per section with its name, the number of samples,
+ * p50, p95 and the maximum [us].
+ *
+ * Throws on I/O error.
+ */
+void
+Dump(BufferedOutputStream &os);
+
+/**
+ * Measures the time from construction to destruction and adds it to
+ * the histogram of a #Section.
+ */
+class ScopeTimer {
+  TimingHistogram *histogram;
+  std::chrono::steady_clock::time_point start;
+
+public:
+  explicit ScopeTimer(Section section) noexcept
+    :histogram(IsEnabled() ? &GetThreadHistogram(section) : nullptr) {
+    if (histogram != nullptr)
+      start = std::chrono::steady_clock::now();
+  }
+
+  ~ScopeTimer() noexcept {
+    if (histogram != nullptr)
+      histogram->Add(std::chrono::duration_cast<TimingHistogram::Duration>(std::chrono::steady_clock::now() - start));
+  }
+
+  ScopeTimer(const ScopeTimer &) = delete;
+  ScopeTimer &operator=(const ScopeTimer &) = delete;
+};
+
+} // namespace Profiler
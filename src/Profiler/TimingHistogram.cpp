@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TimingHistogram.hpp"
+
+#include <algorithm>
+#include <bit>
+
+unsigned
+TimingHistogram::ToBucket(uint32_t us) noexcept
+{
+  if (us < LINEAR_LIMIT)
+    return us;
+
+  /* the two bits below the most significant one select one of four
+     sub-buckets */
+  const unsigned e = std::bit_width(us) - 1;
+  const unsigned sub = (us >> (e - 2)) & 3;
+  return LINEAR_LIMIT + (e - 4) * 4 + sub;
+}
+
+uint32_t
+TimingHistogram::GetBucketMax(unsigned bucket) noexcept
+{
+  if (bucket < LINEAR_LIMIT)
+    return bucket;
+
+  const unsigned e = 4 + (bucket - LINEAR_LIMIT) / 4;
+  const unsigned sub = (bucket - LINEAR_LIMIT) % 4;
+  const uint64_t lower = uint64_t(4 + sub) << (e - 2);
+  return uint32_t(lower + (uint64_t(1) << (e - 2)) - 1);
+}
+
+void
+TimingHistogram::Add(Duration d) noexcept
+{
+  const auto n = d.count();
+  const uint32_t us = n <= 0
+    ? 0
+    : uint32_t(std::min<Duration::rep>(n, UINT32_MAX));
+
+  /* there is only one writer, so a plain load/store pair is enough
+     and avoids locked instructions */
+  auto &bucket = buckets[ToBucket(us)];
+  bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+               std::memory_order_relaxed);
+
+  if (us > max.load(std::memory_order_relaxed))
+    max.store(us, std::memory_order_relaxed);
+}
+
+void
+TimingHistogram::Reset() noexcept
+{
+  for (auto &i : buckets)
+    i.store(0, std::memory_order_relaxed);
+  max.store(0, std::memory_order_relaxed);
+}
+
+unsigned
+TimingHistogram::GetCount() const noexcept
+{
+  unsigned count = 0;
+  for (const auto &i : buckets)
+    count += i.load(std::memory_order_relaxed);
+  return count;
+}
+
+void
+TimingHistogram::AddTo(Counts &counts) const noexcept
+{
+  for (unsigned i = 0; i < N_BUCKETS; ++i)
+    counts.buckets[i] += buckets[i].load(std::memory_order_relaxed);
+
+  counts.max = std::max(counts.max, max.load(std::memory_order_relaxed));
+}
+
+TimingHistogram::Summary
+TimingHistogram::Counts::GetSummary() const noexcept
+{
+  uint64_t total = 0;
+  for (const auto i : buckets)
+    total += i;
+
+  Summary summary{unsigned(total), {}, {}, Duration{max}};
+  if (total == 0)
+    return summary;
+
+  /* the smallest bucket which covers the given fraction of all
+     samples; its upper bound is the reported percentile */
+  const uint64_t rank50 = (total * 50 + 99) / 100;
+  const uint64_t rank95 = (total * 95 + 99) / 100;
+
+  uint64_t sum = 0;
+  bool have50 = false;
+  for (unsigned i = 0; i < N_BUCKETS; ++i) {
+    sum += buckets[i];
+
+    if (!have50 && sum >= rank50) {
+      summary.p50 = Duration{std::min(GetBucketMax(i), max)};
+      have50 = true;
+    }
+
+    if (sum >= rank95) {
+      summary.p95 = Duration{std::min(GetBucketMax(i), max)};
+      break;
+    }
+  }
+
+  return summary;
+}
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * A histogram of durations with logarithmic buckets (four per power
+ * of two, i.e. up to 25% error).  Only one thread may call Add(), so
+ * it does not need atomic read-modify-write operations; other threads
+ * may read it at any time.
+ */
+class TimingHistogram {
+public:
+  using Duration = std::chrono::microseconds;
+
+  /**
+   * Durations below this value [us] have their own bucket.
+   */
+  static constexpr unsigned LINEAR_LIMIT = 16;
+
+  static constexpr unsigned N_BUCKETS = LINEAR_LIMIT + (32 - 4) * 4;
+
+  struct Summary {
+    unsigned count;
+    Duration p50, p95, max;
+  };
+
+  /**
+   * A plain copy of the counters, which may accumulate several
+   * histograms.
+   */
+  struct Counts {
+    std::array<uint32_t, N_BUCKETS> buckets{};
+    uint32_t max = 0;
+
+    [[gnu::pure]]
+    Summary GetSummary() const noexcept;
+  };
+
+private:
+  std::array<std::atomic_uint32_t, N_BUCKETS> buckets{};
+  std::atomic_uint32_t max{0};
+
+public:
+  /**
+   * Add a sample.  This must only be called by the owning thread.
+   */
+  void Add(Duration d) noexcept;
+
+  void Reset() noexcept;
+
+  unsigned GetCount() const noexcept;
+
+  /**
+   * Add a snapshot of this histogram to #counts.  This may be called
+   * while the owning thread is adding.
+   */
+  void AddTo(Counts &counts) const noexcept;
+
+  Summary GetSummary() const noexcept {
+    Counts counts;
+    AddTo(counts);
+    return counts.GetSummary();
+  }
+
+  [[gnu::const]]
+  static unsigned ToBucket(uint32_t us) noexcept;
+
+  /**
+   * Returns the largest value [us] which falls into the given bucket.
+   */
+  [[gnu::const]]
+  static uint32_t GetBucketMax(unsigned bucket) noexcept;
+};
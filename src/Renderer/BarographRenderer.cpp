@@ -81,9 +81,7 @@ RenderBarographSpark(Canvas &canvas, const PixelRect rc,
     else
       chart.GetCanvas().SelectBlackBrush();
 
-    const auto &slots = fs.altitude.GetSlots();
-    const auto &s = slots[fs.altitude.GetCount()-1];
-    chart.DrawDot(s, Layout::Scale(2));
+    chart.DrawDot(fs.altitude.GetLast(), Layout::Scale(2));
   }
 
   chart.Finish();
@@ -6,6 +6,7 @@
 #include "Screen/Layout.hpp"
 #include "Language/Language.hpp"
 #include "Math/LeastSquares.hpp"
+#include "Math/TimeSeries.hpp"
 #include "Math/Point2D.hpp"
 #include "util/StaticString.hxx"
 #include "util/StringFormat.hpp"
@@ -158,6 +159,26 @@ ChartRenderer::ScaleXFromData(const LeastSquares &lsdata) noexcept
     x.scale = rc_chart.GetWidth() / x.scale;
 }
 
+void
+ChartRenderer::ScaleYFromData(const TimeSeries &series) noexcept
+{
+  if (series.IsEmpty())
+    return;
+
+  ScaleYFromValue(series.GetMinY());
+  ScaleYFromValue(series.GetMaxY());
+}
+
+void
+ChartRenderer::ScaleXFromData(const TimeSeries &series) noexcept
+{
+  if (series.IsEmpty())
+    return;
+
+  ScaleXFromValue(series.GetMinX());
+  ScaleXFromValue(series.GetMaxX());
+}
+
 void
 ChartRenderer::ScaleYFromValue(const double value) noexcept
 {
@@ -395,6 +416,29 @@ ChartRenderer::DrawLineGraph(std::span<const DoublePoint2D> src,
   DrawLineGraph(src, look.GetPen(style), swap);
 }
 
+void
+ChartRenderer::DrawFilledLineGraph(const TimeSeries &series) noexcept
+{
+  auto *buffer = series_buffer.get(TimeSeries::MAX_POINTS);
+  const std::size_t n =
+    series.Export({buffer, TimeSeries::MAX_POINTS},
+                  TimeSeries::Reduction::MAX);
+  if (n >= 2)
+    DrawFilledLineGraph({buffer, n});
+}
+
+void
+ChartRenderer::DrawLineGraph(const TimeSeries &series,
+                             ChartLook::Style style) noexcept
+{
+  auto *buffer = series_buffer.get(TimeSeries::MAX_POINTS);
+  const std::size_t n =
+    series.Export({buffer, TimeSeries::MAX_POINTS},
+                  TimeSeries::Reduction::ENVELOPE);
+  if (n >= 2)
+    DrawLineGraph({buffer, n}, style);
+}
+
 void
 ChartRenderer::DrawFilledLineGraph(const XYDataStore &lsdata,
                                    bool swap) noexcept
@@ -15,6 +15,7 @@
 
 class XYDataStore;
 class LeastSquares;
+class TimeSeries;
 class Canvas;
 class Brush;
 class Pen;
@@ -36,6 +37,7 @@ class ChartRenderer
   BasicStringBuffer<TCHAR, 64> x_label, y_label;
 
   ReusableArray<BulkPixelPoint> point_buffer;
+  ReusableArray<DoublePoint2D> series_buffer;
 
   struct Axis {
     double scale, min, max;
@@ -96,6 +98,19 @@ public:
   void DrawLineGraph(const XYDataStore &lsdata, const Pen &pen, bool swap=false) noexcept;
   void DrawLineGraph(const XYDataStore &lsdata, ChartLook::Style style, bool swap=false) noexcept;
   void DrawTrend(const LeastSquares &lsdata, ChartLook::Style style) noexcept;
+
+  /**
+   * Fill the area below the maximum of each #TimeSeries bucket.
+   */
+  void DrawFilledLineGraph(const TimeSeries &series) noexcept;
+
+  /**
+   * Draw the minimum/maximum envelope of a #TimeSeries, at the finest
+   * resolution which covers the whole series.
+   */
+  void DrawLineGraph(const TimeSeries &series,
+                     ChartLook::Style style) noexcept;
+
   void DrawTrendN(const LeastSquares &lsdata, ChartLook::Style style) noexcept;
   void DrawLine(DoublePoint2D min, DoublePoint2D max,
                 const Pen &pen) noexcept;
@@ -113,6 +128,8 @@ public:
 
   void ScaleYFromData(const LeastSquares &lsdata) noexcept;
   void ScaleXFromData(const LeastSquares &lsdata) noexcept;
+  void ScaleYFromData(const TimeSeries &series) noexcept;
+  void ScaleXFromData(const TimeSeries &series) noexcept;
   void ScaleYFromValue(double val) noexcept;
   void ScaleXFromValue(double val) noexcept;
 
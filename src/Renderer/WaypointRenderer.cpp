@@ -9,6 +9,8 @@
 #include "Computer/Settings.hpp"
 #include "Task/Visitors/TaskPointVisitor.hpp"
 #include "Engine/Util/Gradient.hpp"
+#include "Geo/Math.hpp"
+#include "Geo/PreparedGeoPoint.hpp"
 #include "Engine/Waypoint/Waypoint.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "Engine/GlideSolvers/GlideState.hpp"
@@ -60,20 +62,22 @@ struct VisibleWaypoint {
     return ::IsReachable(reachable);
   }
 
-  void CalculateReachabilityDirect(const MoreData &basic,
+  void CalculateReachabilityDirect(const PreparedGeoPoint &location,
+                                   double altitude,
                                    const SpeedVector &wind,
                                    const MacCready &mac_cready,
                                    const TaskBehaviour &task_behaviour) noexcept {
-    assert(basic.location_available);
-    assert(basic.NavAltitudeAvailable());
-
     if (!waypoint->has_elevation)
       return;
 
     const auto elevation = waypoint->elevation +
       task_behaviour.safety_height_arrival;
-    const GlideState state(GeoVector(basic.location, waypoint->location),
-                           elevation, basic.nav_altitude, wind);
+
+    GeoVector vector;
+    DistanceBearing(location, waypoint->location,
+                    &vector.distance, &vector.bearing);
+
+    const GlideState state(vector, elevation, altitude, wind);
 
     const GlideResult result = mac_cready.SolveStraight(state);
     if (!result.IsOk())
@@ -419,11 +423,16 @@ public:
       : calculated.glide_polar_safety;
     const MacCready mac_cready(task_behaviour.glide, glide_polar);
 
+    /* the aircraft is the origin of all vectors; prepare it only
+       once */
+    const PreparedGeoPoint location(basic.location);
+
     for (VisibleWaypoint &vwp : waypoints) {
       const Waypoint &way_point = *vwp.waypoint;
 
       if (way_point.IsLandable() || way_point.flags.watched)
-        vwp.CalculateReachabilityDirect(basic, calculated.GetWindOrZero(),
+        vwp.CalculateReachabilityDirect(location, basic.nav_altitude,
+                                        calculated.GetWindOrZero(),
                                         mac_cready, task_behaviour);
     }
   }
@@ -474,8 +474,10 @@ Startup(UI::Display &display)
     const AircraftState aircraft_state =
       ToAircraftState(backend_components->device_blackboard->Basic(),
                       backend_components->device_blackboard->Calculated());
-    ProtectedAirspaceWarningManager::ExclusiveLease lease(backend_components->glide_computer->GetAirspaceWarnings());
+    auto &airspace_warnings = backend_components->glide_computer->GetAirspaceWarnings();
+    ProtectedAirspaceWarningManager::ExclusiveLease lease(airspace_warnings);
     lease->Reset(aircraft_state);
+    airspace_warnings.PublishSnapshot(lease);
   }
 
 #ifdef HAVE_NOAA
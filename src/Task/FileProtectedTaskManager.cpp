@@ -11,8 +11,7 @@
 void
 ProtectedTaskManager::TaskSave(Path path)
 {
-  std::unique_ptr<OrderedTask> task(TaskClone());
-  SaveTask(path, *task);
+  SaveTask(path, *GetTaskSnapshot());
 }
 
 void
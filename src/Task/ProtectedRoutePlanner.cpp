@@ -41,22 +41,24 @@ ProtectedRoutePlanner::SolveReach(const AGeoPoint &origin,
                                   const int h_ceiling,
                                   const bool do_solve) noexcept
 {
-  /* these local variables help avoid locking both mutexes at the same
+  /* the "next" fields help avoid locking both mutexes at the same
      time */
-  ReachFan rt, rw;
 
   {
     const std::scoped_lock lock{route_mutex};
-    rt = route_planner.SolveReach(origin, config, h_ceiling, do_solve, false);
-    rw = route_planner.SolveReach(origin, config, h_ceiling, do_solve, true);
+    route_planner.SolveReach(origin, config, h_ceiling, do_solve, false,
+                             next_reach_terrain);
+    route_planner.SolveReach(origin, config, h_ceiling, do_solve, true,
+                             next_reach_working);
     rpolars_reach = route_planner.GetReachPolar();
   }
 
   /* we lock this mutex not during the expensive reach calculation,
-     but only for moving the result to the mutex-protected fields */
+     but only for swapping the result with the mutex-protected
+     fields */
   const std::scoped_lock lock{reach_mutex};
-  reach_terrain = std::move(rt);
-  reach_working = std::move(rw);
+  std::swap(reach_terrain, next_reach_terrain);
+  std::swap(reach_working, next_reach_working);
 }
 
 const FlatProjection
@@ -37,6 +37,14 @@ class ProtectedRoutePlanner
   ReachFan reach_terrain;
   ReachFan reach_working;
 
+  /**
+   * The destination of the next SolveReach() call; it is swapped
+   * with #reach_terrain and #reach_working afterwards, which recycles
+   * their buffers.  Only used by SolveReach(), i.e. by the
+   * #CalculationThread.
+   */
+  ReachFan next_reach_terrain, next_reach_working;
+
 public:
   ProtectedRoutePlanner(RoutePlannerGlue &route, const Airspaces &_airspaces,
                         const ProtectedAirspaceWarningManager *_warnings) noexcept
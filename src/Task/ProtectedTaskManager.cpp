@@ -3,6 +3,7 @@
 
 #include "ProtectedTaskManager.hpp"
 #include "ProtectedRoutePlanner.hpp"
+#include "PublishedTask.hpp"
 #include "Engine/Task/TaskManager.hpp"
 #include "Engine/Task/Ordered/OrderedTask.hpp"
 #include "Engine/Task/Ordered/Points/OrderedTaskPoint.hpp"
@@ -14,6 +15,7 @@ ProtectedTaskManager::ProtectedTaskManager(TaskManager &_task_manager,
   :Guard<TaskManager>(_task_manager),
    task_behaviour(tb)
 {
+  Publish(_task_manager);
 }
 
 ProtectedTaskManager::~ProtectedTaskManager() noexcept
@@ -22,6 +24,49 @@ ProtectedTaskManager::~ProtectedTaskManager() noexcept
   lease->SetIntersectionTest(nullptr); // de-register
 }
 
+inline void
+ProtectedTaskManager::PublishTaskSnapshot(const OrderedTask &task) noexcept
+{
+  if (task_snapshot != nullptr && task_snapshot->Equals(task) &&
+      task_snapshot->GetActiveIndex() == task.GetActiveIndex())
+    return;
+
+  /* copy outside of the mutex, so readers don't have to wait */
+  std::shared_ptr<const OrderedTask> snapshot = task.Clone(task_behaviour);
+
+  const std::lock_guard lock{snapshot_mutex};
+  task_snapshot = std::move(snapshot);
+}
+
+void
+ProtectedTaskManager::Publish(const TaskManager &task_manager) noexcept
+{
+  PublishTaskSnapshot(task_manager.GetOrderedTask());
+
+  {
+    const std::lock_guard lock{published_mutex};
+
+    /* no reader holds the old state, and new readers need the mutex
+       to obtain it: update it in place */
+    if (published && published.use_count() == 1) {
+      published->Update(task_manager);
+      return;
+    }
+  }
+
+  auto p = std::make_shared<PublishedTask>(task_manager);
+
+  const std::lock_guard lock{published_mutex};
+  published = std::move(p);
+}
+
+std::shared_ptr<const PublishedTask>
+ProtectedTaskManager::GetPublished() const noexcept
+{
+  const std::lock_guard lock{published_mutex};
+  return published;
+}
+
 void 
 ProtectedTaskManager::SetGlidePolar(const GlidePolar &glide_polar) noexcept
 {
@@ -43,29 +88,18 @@ ProtectedTaskManager::SetPEV(const BrokenTime bt){
   ExclusiveLease lease(*this);
 
   return lease->SetPEV(bt);
-
 }
 
 const OrderedTaskSettings
 ProtectedTaskManager::GetOrderedTaskSettings() const noexcept
 {
-  Lease lease(*this);
-  return lease->GetOrderedTask().GetOrderedTaskSettings();
+  return GetPublished()->ordered_settings;
 }
 
 WaypointPtr
 ProtectedTaskManager::GetActiveWaypoint() const noexcept
 {
-  Lease lease(*this);
-  const auto *task = lease->GetActiveTask();
-  if (task == nullptr)
-    return nullptr;
-
-  const TaskWaypoint *tp = task->GetActiveTaskPoint();
-  if (tp)
-    return tp->GetWaypointPtr();
-
-  return nullptr;
+  return GetPublished()->active_waypoint;
 }
 
 bool
@@ -131,8 +165,14 @@ ProtectedTaskManager::DoGoto(WaypointPtr &&wp) noexcept
 std::unique_ptr<OrderedTask>
 ProtectedTaskManager::TaskClone() const noexcept
 {
-  Lease lease(*this);
-  return lease->Clone(task_behaviour);
+  return GetTaskSnapshot()->Clone(task_behaviour);
+}
+
+std::shared_ptr<const OrderedTask>
+ProtectedTaskManager::GetTaskSnapshot() const noexcept
+{
+  const std::lock_guard lock{snapshot_mutex};
+  return task_snapshot;
 }
 
 bool
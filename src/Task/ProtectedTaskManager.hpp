@@ -4,6 +4,7 @@
 #pragma once
 
 #include "thread/Guard.hpp"
+#include "thread/Mutex.hxx"
 #include "time/RoughTime.hpp"
 #include "Engine/Task/Unordered/AbortIntersectionTest.hpp"
 #include "Engine/Waypoint/Ptr.hpp"
@@ -19,6 +20,7 @@ class GlidePolar;
 class ProtectedRoutePlanner;
 class OrderedTask;
 class TaskManager;
+struct PublishedTask;
 
 class ReachIntersectionTest: public AbortIntersectionTest {
   const ProtectedRoutePlanner *route = nullptr;
@@ -41,22 +43,83 @@ protected:
   const TaskBehaviour &task_behaviour;
   ReachIntersectionTest intersection_test;
 
+  /**
+   * Protects #task_snapshot.  It is only held while the pointer is
+   * being copied or replaced.
+   */
+  mutable Mutex snapshot_mutex;
+
+  /**
+   * The copy returned by GetTaskSnapshot().  Publish() replaces it
+   * when the ordered task or its active task point has changed.
+   * Only the holder of an #ExclusiveLease writes it, so that thread
+   * may read it without #snapshot_mutex.
+   */
+  std::shared_ptr<const OrderedTask> task_snapshot;
+
+  /**
+   * Protects #published.  It is only held while the pointer is being
+   * copied or replaced, never during task calculations.
+   */
+  mutable Mutex published_mutex;
+
+  /**
+   * The state returned by GetPublished().  If nobody else holds a
+   * reference, Publish() updates it in place instead of allocating a
+   * new one.
+   */
+  std::shared_ptr<PublishedTask> published;
+
 public:
+  /**
+   * A writable lease which publishes the new #TaskManager state (see
+   * GetPublished()) when it is released, so every writer updates the
+   * published state.
+   */
+  class ExclusiveLease : public Guard<TaskManager>::ExclusiveLease {
+    ProtectedTaskManager &protected_task_manager;
+
+  public:
+    explicit ExclusiveLease(ProtectedTaskManager &_ptm) noexcept
+      :Guard<TaskManager>::ExclusiveLease(_ptm),
+       protected_task_manager(_ptm) {}
+
+    ~ExclusiveLease() noexcept {
+      protected_task_manager.Publish(*this);
+    }
+  };
+
   ProtectedTaskManager(TaskManager &_task_manager, const TaskBehaviour &tb) noexcept;
 
   ~ProtectedTaskManager() noexcept;
 
+private:
+  /**
+   * Publish a copy of the current #TaskManager state for
+   * GetPublished() and GetTaskSnapshot().  The caller must hold an
+   * exclusive lease.
+   */
+  void Publish(const TaskManager &task_manager) noexcept;
+
+  void PublishTaskSnapshot(const OrderedTask &task) noexcept;
+
+public:
+
+  /**
+   * Obtain the most recently published #TaskManager state.  This does
+   * not lock the #TaskManager and never returns nullptr.
+   */
+  std::shared_ptr<const PublishedTask> GetPublished() const noexcept;
+
   // common accessors for ui and calc clients
   void SetGlidePolar(const GlidePolar &glide_polar) noexcept;
 
-  [[gnu::pure]]
   const OrderedTaskSettings GetOrderedTaskSettings() const noexcept;
 
   void SetStartTimeSpan(const RoughTimeSpan &open_time_span) noexcept;
 
   bool SetPEV(const BrokenTime bt);
 
-  [[gnu::pure]]
   WaypointPtr GetActiveWaypoint() const noexcept;
 
   void IncrementActiveTaskPoint(int offset) noexcept;
@@ -68,8 +131,23 @@ public:
     return DoGoto(WaypointPtr(wp));
   }
 
+  /**
+   * Create a private copy of the ordered task which may be edited by
+   * the caller.  It is copied from GetTaskSnapshot(), i.e. without
+   * locking the #TaskManager.
+   */
   std::unique_ptr<OrderedTask> TaskClone() const noexcept;
 
+  /**
+   * Obtain a read-only copy of the ordered task.  It is published
+   * whenever an #ExclusiveLease is released and the task definition
+   * (see OrderedTask::Equals(), which includes the AAT targets) or
+   * the active task point has changed.  All callers share the same
+   * copy, and this does not lock the #TaskManager.  The other flight
+   * state of the copy (e.g. sampled points) is not kept up to date.
+   */
+  std::shared_ptr<const OrderedTask> GetTaskSnapshot() const noexcept;
+
   /**
    * Copy task into this task
    *
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "PublishedTask.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Task/Points/TaskWaypoint.hpp"
+
+void
+PublishedTask::Update(const TaskManager &task_manager) noexcept
+{
+  mode = task_manager.GetMode();
+  active_index = task_manager.GetActiveTaskPointIndex();
+  ordered_settings = task_manager.GetOrderedTask().GetOrderedTaskSettings();
+  alternates = task_manager.GetAlternates();
+
+  active_waypoint = nullptr;
+  if (const auto *task = task_manager.GetActiveTask())
+    if (const TaskWaypoint *tp = task->GetActiveTaskPoint())
+      active_waypoint = tp->GetWaypointPtr();
+}
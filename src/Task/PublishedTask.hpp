@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Engine/Task/TaskType.hpp"
+#include "Engine/Task/Ordered/Settings.hpp"
+#include "Engine/Task/Unordered/AlternateList.hpp"
+#include "Engine/Waypoint/Ptr.hpp"
+
+class TaskManager;
+
+/**
+ * A read-only copy of the #TaskManager state which is interesting to
+ * the user interface.  It is published whenever an
+ * ProtectedTaskManager::ExclusiveLease is released, and readers can
+ * use it without locking the #TaskManager, i.e. without waiting for
+ * the task solvers.
+ *
+ * The task statistics are not duplicated here; they are already
+ * available from the blackboard (DerivedInfo).
+ */
+struct PublishedTask {
+  TaskType mode;
+
+  unsigned active_index;
+
+  /**
+   * The waypoint of the active task point (or nullptr if there is
+   * none).
+   */
+  WaypointPtr active_waypoint;
+
+  OrderedTaskSettings ordered_settings;
+
+  AlternateList alternates;
+
+  explicit PublishedTask(const TaskManager &task_manager) noexcept {
+    Update(task_manager);
+  }
+
+  /**
+   * Copy the current state from the #TaskManager, reusing the memory
+   * allocated by this object.
+   */
+  void Update(const TaskManager &task_manager) noexcept;
+};
@@ -45,17 +45,17 @@ RoutePlannerGlue::Solve(const AGeoPoint &origin,
   return planner.Solve(origin, destination, config, h_ceiling);
 }
 
-ReachFan
+void
 RoutePlannerGlue::SolveReach(const AGeoPoint &origin,
                              const RoutePlannerConfig &config,
                              const int h_ceiling, const bool do_solve,
-                             const bool working) noexcept
+                             const bool working, ReachFan &result) noexcept
 {
   if (terrain) {
     RasterTerrain::Lease lease(*terrain);
-    return planner.SolveReach(origin, config, h_ceiling, do_solve, working);
+    planner.SolveReach(origin, config, h_ceiling, do_solve, working, result);
   } else {
-    return planner.SolveReach(origin, config, h_ceiling, do_solve, working);
+    planner.SolveReach(origin, config, h_ceiling, do_solve, working, result);
   }
 }
 
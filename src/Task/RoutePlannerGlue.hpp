@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include "VisibilityGraphThread.hpp"
 #include "Route/AirspaceRoute.hpp"
+#include "thread/WorkerPool.hpp"
 
 struct GlideSettings;
 class RasterTerrain;
@@ -11,9 +13,25 @@ class ProtectedAirspaceWarningManager;
 
 class RoutePlannerGlue {
   const RasterTerrain *terrain = nullptr;
+
+  /**
+   * Threads which help with the reach calculation.
+   */
+  WorkerPool reach_pool{"Reach"};
+
+  /**
+   * Builds the airspace visibility graph for #planner.
+   */
+  VisibilityGraphThread visibility_thread;
+
   AirspaceRoute planner;
 
 public:
+  RoutePlannerGlue() noexcept {
+    planner.SetParallelExecutor(&reach_pool);
+    planner.SetVisibilityGraphBuilder(&visibility_thread);
+  }
+
   void SetTerrain(const RasterTerrain *terrain);
 
   void UpdatePolar(const GlideSettings &settings,
@@ -43,9 +61,9 @@ public:
     return planner.GetSolution();
   }
 
-  [[gnu::pure]]
-  ReachFan SolveReach(const AGeoPoint &origin, const RoutePlannerConfig &config,
-                      int h_ceiling, bool do_solve, bool working) noexcept;
+  void SolveReach(const AGeoPoint &origin, const RoutePlannerConfig &config,
+                  int h_ceiling, bool do_solve, bool working,
+                  ReachFan &result) noexcept;
 
   const auto &GetReachPolar() const noexcept {
     return planner.GetReachPolar();
@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TaskIndex.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Task/Ordered/Points/OrderedTaskPoint.hpp"
+#include "io/FileReader.hxx"
+#include "io/BufferedReader.hxx"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "system/FileUtil.hpp"
+#include "util/tstring_view.hxx"
+
+#include <cassert>
+#include <stdexcept>
+
+static constexpr uint32_t TASK_INDEX_MAGIC = 0x58444954; // "TIDX"
+
+/**
+ * Increment this after changing the file format.  The TCHAR size is
+ * part of the version, because strings are stored as raw TCHAR
+ * arrays.
+ */
+static constexpr uint32_t TASK_INDEX_VERSION = 2 + (sizeof(TCHAR) << 16);
+
+/**
+ * Refuse to load absurd string lengths from a corrupt file.
+ */
+static constexpr uint32_t MAX_STRING_LENGTH = 4096;
+
+TaskIndex::Summary::Summary(const OrderedTask &task) noexcept
+  :type(task.GetFactoryType()),
+   has_targets(task.HasTargets()),
+   distance_nominal(task.GetStats().distance_nominal),
+   distance_min(task.GetStats().distance_min),
+   distance_max(task.GetStats().distance_max),
+   bounds(task.GetStats().bounds)
+{
+  turnpoints.reserve(task.TaskSize());
+  locations.reserve(task.TaskSize());
+  for (const auto &tp : task.GetPoints()) {
+    turnpoints.emplace_back(tp.GetWaypoint().name);
+    locations.push_back(tp.GetLocation());
+  }
+}
+
+TaskIndex::FileStamp
+TaskIndex::FileStamp::Read(Path path) noexcept
+{
+  return {File::GetLastModification(path), File::GetSize(path)};
+}
+
+static void
+WriteString(BufferedOutputStream &os, tstring_view s)
+{
+  os.WriteT(static_cast<uint32_t>(s.size()));
+  os.Write(std::as_bytes(std::span{s.data(), s.size()}));
+}
+
+static tstring
+ReadString(BufferedReader &r)
+{
+  const auto length = r.ReadFullT<uint32_t>();
+  if (length > MAX_STRING_LENGTH)
+    throw std::runtime_error("Malformed task index");
+
+  tstring s(length, _T('\0'));
+  r.ReadFull(std::as_writable_bytes(std::span{s.data(), s.size()}));
+  return s;
+}
+
+static void
+WriteSummary(BufferedOutputStream &os, const TaskIndex::Summary &summary)
+{
+  os.WriteT(summary.type);
+  os.WriteT(static_cast<uint8_t>(summary.has_targets));
+  os.WriteT(summary.distance_nominal);
+  os.WriteT(summary.distance_min);
+  os.WriteT(summary.distance_max);
+  os.WriteT(summary.bounds);
+
+  os.WriteT(static_cast<uint32_t>(summary.turnpoints.size()));
+  for (const auto &i : summary.turnpoints)
+    WriteString(os, i);
+
+  assert(summary.locations.size() == summary.turnpoints.size());
+  for (const auto &i : summary.locations)
+    os.WriteT(i);
+}
+
+static TaskIndex::Summary
+ReadSummary(BufferedReader &r)
+{
+  TaskIndex::Summary summary;
+  summary.type = r.ReadFullT<TaskFactoryType>();
+  if (summary.type >= TaskFactoryType::COUNT)
+    throw std::runtime_error("Malformed task index");
+
+  summary.has_targets = r.ReadFullT<uint8_t>() != 0;
+  summary.distance_nominal = r.ReadFullT<double>();
+  summary.distance_min = r.ReadFullT<double>();
+  summary.distance_max = r.ReadFullT<double>();
+  summary.bounds = r.ReadFullT<GeoBounds>();
+
+  const auto n = r.ReadFullT<uint32_t>();
+  if (n > 1024)
+    throw std::runtime_error("Malformed task index");
+
+  summary.turnpoints.reserve(n);
+  for (unsigned i = 0; i < n; ++i)
+    summary.turnpoints.emplace_back(ReadString(r));
+
+  summary.locations.reserve(n);
+  for (unsigned i = 0; i < n; ++i)
+    summary.locations.push_back(r.ReadFullT<GeoPoint>());
+
+  return summary;
+}
+
+void
+TaskIndex::Load(Path path) noexcept
+try {
+  files.clear();
+  modified = false;
+
+  FileReader file(path);
+  BufferedReader r(file);
+
+  if (r.ReadFullT<uint32_t>() != TASK_INDEX_MAGIC ||
+      r.ReadFullT<uint32_t>() != TASK_INDEX_VERSION)
+    return;
+
+  const auto n = r.ReadFullT<uint32_t>();
+
+  for (unsigned i = 0; i < n; ++i) {
+    auto file_path = ReadString(r);
+    const auto task_index = r.ReadFullT<uint32_t>();
+
+    FileStamp stamp;
+    stamp.mtime = std::chrono::system_clock::time_point{std::chrono::system_clock::duration{r.ReadFullT<int64_t>()}};
+    stamp.size = r.ReadFullT<uint64_t>();
+
+    auto summary = ReadSummary(r);
+
+    files[std::move(file_path)].insert_or_assign(task_index,
+                                                 Entry{stamp, std::move(summary)});
+  }
+} catch (...) {
+  /* a missing or broken index is not a problem, it will be
+     recreated */
+  files.clear();
+}
+
+void
+TaskIndex::Save(Path path)
+{
+  /* drop entries of deleted task files */
+  std::erase_if(files, [](const auto &i){
+    return !File::Exists(Path{i.first.c_str()});
+  });
+
+  FileOutputStream file(path);
+  BufferedOutputStream os(file);
+
+  std::size_t n = 0;
+  for (const auto &[file_path, entries] : files)
+    n += entries.size();
+
+  os.WriteT(TASK_INDEX_MAGIC);
+  os.WriteT(TASK_INDEX_VERSION);
+  os.WriteT(static_cast<uint32_t>(n));
+
+  for (const auto &[file_path, entries] : files) {
+    for (const auto &[task_index, e] : entries) {
+      WriteString(os, file_path);
+      os.WriteT(static_cast<uint32_t>(task_index));
+      os.WriteT(static_cast<int64_t>(e.stamp.mtime.time_since_epoch().count()));
+      os.WriteT(e.stamp.size);
+      WriteSummary(os, e.summary);
+    }
+  }
+
+  os.Flush();
+  file.Commit();
+
+  modified = false;
+}
+
+const TaskIndex::Summary *
+TaskIndex::Find(Path file, unsigned task_index,
+                const FileStamp &stamp) const noexcept
+{
+  const auto i = files.find(tstring_view{file.c_str()});
+  if (i == files.end())
+    return nullptr;
+
+  const auto j = i->second.find(task_index);
+  if (j == i->second.end() || j->second.stamp != stamp)
+    return nullptr;
+
+  return &j->second.summary;
+}
+
+void
+TaskIndex::Put(Path file, unsigned task_index, const FileStamp &stamp,
+               Summary &&summary)
+{
+  auto i = files.find(tstring_view{file.c_str()});
+  if (i == files.end())
+    i = files.emplace(file.c_str(), FileEntries{}).first;
+
+  i->second.insert_or_assign(task_index, Entry{stamp, std::move(summary)});
+  modified = true;
+}
@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Engine/Task/Factory/TaskFactoryType.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "system/Path.hpp"
+#include "util/tstring.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+class OrderedTask;
+
+/**
+ * An index of the task library: a #Summary for each task in each
+ * task file, stored in a small binary file.  This allows listing
+ * hundreds of tasks without parsing all of their files.
+ *
+ * An entry is only valid as long as the modification time and the
+ * size of its task file are unchanged.
+ */
+class TaskIndex {
+public:
+  /**
+   * The properties of a task which are needed to list and preview it
+   * without loading its task file.
+   */
+  struct Summary {
+    TaskFactoryType type = TaskFactoryType::RACING;
+
+    bool has_targets = false;
+
+    double distance_nominal = 0, distance_min = 0, distance_max = 0;
+
+    GeoBounds bounds = GeoBounds::Invalid();
+
+    /**
+     * The waypoint names of all task points, beginning with the start.
+     */
+    std::vector<tstring> turnpoints;
+
+    /**
+     * The locations of all task points, in the same order as
+     * #turnpoints.
+     */
+    std::vector<GeoPoint> locations;
+
+    Summary() noexcept = default;
+
+    /**
+     * Obtain the summary of a task.  The geometry of the task must be
+     * up to date (see OrderedTask::UpdateGeometry()).
+     */
+    explicit Summary(const OrderedTask &task) noexcept;
+  };
+
+  /**
+   * Identifies the version of a task file.
+   */
+  struct FileStamp {
+    std::chrono::system_clock::time_point mtime{};
+    uint64_t size = 0;
+
+    /**
+     * Obtain the stamp of the given file.
+     */
+    static FileStamp Read(Path path) noexcept;
+
+    constexpr bool operator==(const FileStamp &) const noexcept = default;
+  };
+
+private:
+  struct Entry {
+    FileStamp stamp;
+    Summary summary;
+  };
+
+  /**
+   * The entries of one task file, by task index.
+   */
+  using FileEntries = std::map<unsigned, Entry>;
+
+  /**
+   * All entries, by task file path.
+   */
+  std::map<tstring, FileEntries, std::less<>> files;
+
+  bool modified = false;
+
+public:
+  /**
+   * Load the index from a file.  A missing, outdated or malformed
+   * file results in an empty index.
+   */
+  void Load(Path path) noexcept;
+
+  /**
+   * Write the index to a file.  Entries of task files which do not
+   * exist anymore are omitted.
+   *
+   * Throws on error.
+   */
+  void Save(Path path);
+
+  /**
+   * Was the index modified since it was loaded or saved?
+   */
+  bool IsModified() const noexcept {
+    return modified;
+  }
+
+  bool empty() const noexcept {
+    return files.empty();
+  }
+
+  /**
+   * Look up the summary of a task.
+   *
+   * @param file the task file
+   * @param task_index the index of the task within the file
+   * @param stamp the current stamp of the task file
+   * @return the summary or nullptr if there is no entry, or if the
+   * task file was modified since the entry was created
+   */
+  [[gnu::pure]]
+  const Summary *Find(Path file, unsigned task_index,
+                      const FileStamp &stamp) const noexcept;
+
+  const Summary *Find(Path file, unsigned task_index) const noexcept {
+    return Find(file, task_index, FileStamp::Read(file));
+  }
+
+  /**
+   * Add or replace the summary of a task.
+   *
+   * @param stamp the stamp of the task file the summary was obtained
+   * from
+   *
+   * Throws on error.
+   */
+  void Put(Path file, unsigned task_index, const FileStamp &stamp,
+           Summary &&summary);
+
+  void Put(Path file, unsigned task_index, Summary &&summary) {
+    Put(file, task_index, FileStamp::Read(file), std::move(summary));
+  }
+};
@@ -4,6 +4,8 @@
 #include "Task/TaskStore.hpp"
 #include "Task/TaskFile.hpp"
 #include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Task/TaskBehaviour.hpp"
+#include "Job/Job.hpp"
 #include "system/FileUtil.hpp"
 #include "system/Path.hpp"
 #include "LocalPath.hpp"
@@ -13,6 +15,14 @@
 #include <algorithm>
 #include <memory>
 
+static const TCHAR *const task_index_name = _T("tasks.idx");
+
+static AllocatedPath
+GetTaskIndexPath() noexcept
+{
+  return AllocatedPath::Build(GetCachePath(), task_index_name);
+}
+
 class TaskFileVisitor: public File::Visitor
 {
 private:
@@ -32,6 +42,9 @@ public:
 
     const auto list = task_file->GetList();
 
+    /* all tasks of this file share the stamp; stat() only once */
+    const auto stamp = TaskIndex::FileStamp::Read(path);
+
     // Count the tasks in the task file
     unsigned count = list.size();
     // For each task in the task file
@@ -50,13 +63,82 @@ public:
       }
 
       // Add the task to the TaskStore
-      store.emplace_back(path, name.empty() ? path.c_str() : name, i);
+      store.emplace_back(path, name.empty() ? path.c_str() : name, i)
+        .stamp = stamp;
     }
   } catch (...) {
     LogError(std::current_exception());
   }
 };
 
+/**
+ * Parses task files to obtain the summaries which are missing in the
+ * #TaskIndex.
+ */
+class TaskStore::IndexJob final : public Job {
+  /* a copy, because the settings may be modified while this job
+     runs */
+  const TaskBehaviour task_behaviour;
+  const Waypoints *const waypoints;
+
+public:
+  struct Request {
+    /**
+     * The position of the #Item in the #TaskStore.
+     */
+    unsigned position;
+
+    AllocatedPath path;
+    unsigned task_index;
+  };
+
+  std::vector<Request> requests;
+
+  /**
+   * One result for each element of #requests, in the same order;
+   * std::nullopt if the task could not be loaded.  It may be shorter
+   * if the job was cancelled.
+   */
+  std::vector<std::optional<TaskIndex::Summary>> results;
+
+  IndexJob(const TaskBehaviour &_task_behaviour,
+           const Waypoints *_waypoints) noexcept
+    :task_behaviour(_task_behaviour), waypoints(_waypoints) {}
+
+  /* virtual methods from class Job */
+  void Run(OperationEnvironment &env) override {
+    results.reserve(requests.size());
+
+    for (const auto &i : requests) {
+      if (env.IsCancelled())
+        break;
+
+      auto &result = results.emplace_back();
+
+      try {
+        auto task = TaskFile::GetTask(i.path, task_behaviour,
+                                      waypoints, i.task_index);
+        if (task != nullptr) {
+          task->UpdateGeometry();
+          result.emplace(*task);
+        }
+      } catch (...) {
+        LogError(std::current_exception());
+      }
+    }
+  }
+};
+
+TaskStore::TaskStore() noexcept = default;
+
+TaskStore::~TaskStore() noexcept
+{
+  if (index_runner.IsBusy()) {
+    index_runner.Cancel();
+    index_runner.Wait();
+  }
+}
+
 void
 TaskStore::Clear()
 {
@@ -65,10 +147,22 @@ TaskStore::Clear()
 }
 
 void
-TaskStore::Scan(bool extra)
+TaskStore::Scan(const TaskBehaviour &task_behaviour, const Waypoints *waypoints,
+                UI::Notify &notify, bool extra)
 {
+  if (index_runner.IsBusy()) {
+    /* keep what has been parsed so far in the index */
+    index_runner.Cancel();
+    FinishIndex();
+  }
+
   Clear();
 
+  if (!index_loaded) {
+    index.Load(GetTaskIndexPath());
+    index_loaded = true;
+  }
+
   // scan files
   TaskFileVisitor tfv(store);
   VisitDataFiles(_T("*.tsk"), tfv);
@@ -79,6 +173,64 @@ TaskStore::Scan(bool extra)
   }
 
   std::sort(store.begin(), store.end());
+
+  auto job = std::make_unique<IndexJob>(task_behaviour, waypoints);
+
+  for (unsigned position = 0; position < store.size(); ++position) {
+    auto &i = store[position];
+    if (const auto *summary = i.stamp.size > 0
+        ? index.Find(i.filename, i.task_index, i.stamp)
+        : nullptr) {
+      i.summary = *summary;
+      continue;
+    }
+
+    /* not indexed yet (or modified): parse it once in background,
+       so the list and the preview never need to */
+    job->requests.push_back({position, Path{i.filename}, i.task_index});
+  }
+
+  if (job->requests.empty())
+    return;
+
+  index_job = std::move(job);
+  index_runner.Start(index_job.get(), index_env, &notify);
+}
+
+void
+TaskStore::FinishIndex() noexcept
+{
+  if (!index_runner.IsBusy())
+    return;
+
+  try {
+    index_runner.Wait();
+  } catch (...) {
+    LogError(std::current_exception());
+  }
+
+  const auto job = std::move(index_job);
+
+  for (std::size_t n = 0; n < job->results.size(); ++n) {
+    const auto &request = job->requests[n];
+    auto &result = job->results[n];
+    auto &i = store[request.position];
+
+    if (!result) {
+      i.valid = false;
+      continue;
+    }
+
+    try {
+      index.Put(i.filename, i.task_index, i.stamp,
+                TaskIndex::Summary{*result});
+    } catch (...) {
+      /* the index is only a cache; the summary will be obtained
+         again next time */
+    }
+
+    i.summary = std::move(result);
+  }
 }
 
 TaskStore::Item::~Item() noexcept = default;
@@ -114,9 +266,27 @@ TaskStore::GetPath(unsigned index) const
   return store[index].GetPath();
 }
 
+const TaskIndex::Summary *
+TaskStore::GetSummary(unsigned index) const noexcept
+{
+  return store[index].GetSummary();
+}
+
 const OrderedTask *
 TaskStore::GetTask(unsigned index, const TaskBehaviour &task_behaviour,
                    Waypoints *waypoints)
 {
   return store[index].GetTask(task_behaviour, waypoints);
 }
+
+void
+TaskStore::SaveIndex() noexcept
+try {
+  if (!index.IsModified())
+    return;
+
+  Directory::Create(GetCachePath());
+  index.Save(GetTaskIndexPath());
+} catch (...) {
+  LogError(std::current_exception(), "Failed to save the task index");
+}
@@ -3,18 +3,28 @@
 
 #pragma once
 
+#include "TaskIndex.hpp"
+#include "Job/Async.hpp"
+#include "Operation/Operation.hpp"
 #include "system/Path.hpp"
 #include "util/tstring.hpp"
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 struct TaskBehaviour;
 class OrderedTask;
 class Waypoints;
+namespace UI { class Notify; }
 
 /**
- * Class to load multiple tasks on demand, e.g. for browsing
+ * Class to load multiple tasks on demand, e.g. for browsing.
+ *
+ * Scan() obtains the summary of each task from the #TaskIndex, and
+ * parses the task files which are not indexed yet in a separate
+ * thread, so the list and the preview can be presented without
+ * loading the task files again.
  */
 class TaskStore 
 {
@@ -25,6 +35,17 @@ public:
     AllocatedPath filename;
     unsigned task_index;
     std::unique_ptr<OrderedTask> task;
+
+    /**
+     * The stamp of #filename at the time of the scan.
+     */
+    TaskIndex::FileStamp stamp;
+
+    /**
+     * The summary from the #TaskIndex, or from the loaded task.
+     */
+    std::optional<TaskIndex::Summary> summary;
+
     bool valid;
 
     Item(Path the_filename,
@@ -50,6 +71,10 @@ public:
       return filename;
     }
 
+    const TaskIndex::Summary *GetSummary() const noexcept {
+      return summary ? &*summary : nullptr;
+    }
+
     const OrderedTask *GetTask(const TaskBehaviour &task_behaviour,
                                Waypoints *waypoints) noexcept;
 
@@ -67,14 +92,52 @@ private:
    */
   ItemVector store;
 
+  TaskIndex index;
+  bool index_loaded = false;
+
+  /**
+   * Parses the tasks which are not in the #TaskIndex.
+   */
+  class IndexJob;
+  std::unique_ptr<IndexJob> index_job;
+
+  AsyncJobRunner index_runner;
+  NullOperationEnvironment index_env;
+
 public:
+  TaskStore() noexcept;
+  ~TaskStore() noexcept;
+
+  TaskStore(const TaskStore &) = delete;
+  TaskStore &operator=(const TaskStore &) = delete;
+
   /**
-   * Scan the XCSoarData folder for .tsk files and add them to the TaskStore
+   * Scan the XCSoarData folder for .tsk files and add them to the
+   * TaskStore.  Tasks which are in the #TaskIndex get their summary
+   * immediately.  The others are parsed in a separate thread; the
+   * given #UI::Notify is notified when that is finished, and then
+   * FinishIndex() must be called.
    *
    * @param extra scan all "extra" (non-XCSoar) task files, e.g. *.cup
    * and task declarations from *.igc
    */
-  void Scan(bool extra=false);
+  void Scan(const TaskBehaviour &task_behaviour, const Waypoints *waypoints,
+            UI::Notify &notify, bool extra=false);
+
+  /**
+   * Are tasks still being parsed in background?  Until then, their
+   * summaries are missing.
+   */
+  bool IsIndexing() const noexcept {
+    return index_runner.IsBusy();
+  }
+
+  /**
+   * Apply the summaries obtained by the background job to the tasks
+   * and to the #TaskIndex.  Call this when the #UI::Notify passed to
+   * Scan() has been notified.
+   */
+  void FinishIndex() noexcept;
 
   /**
    * Clear all the tasks from the TaskStore
@@ -108,6 +171,15 @@ public:
   [[gnu::pure]]
   Path GetPath(unsigned index) const;
 
+  /**
+   * Return the summary of the task defined by the given index,
+   * without loading it.
+   *
+   * @return the summary or nullptr if the task could not be loaded
+   */
+  [[gnu::pure]]
+  const TaskIndex::Summary *GetSummary(unsigned index) const noexcept;
+
   /**
    * Return the task defined by the given index
    * @param index TaskStore index of the desired Task
@@ -116,4 +188,10 @@ public:
   const OrderedTask *GetTask(unsigned index,
                              const TaskBehaviour &task_behaviour,
                              Waypoints *waypoints);
+
+  /**
+   * Write the #TaskIndex to the cache directory if it was modified.
+   * Errors are logged.
+   */
+  void SaveIndex() noexcept;
 };
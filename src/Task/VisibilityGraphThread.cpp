@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "VisibilityGraphThread.hpp"
+#include "LogFile.hpp"
+
+void
+VisibilityGraphThread::Start(unsigned serial,
+                             AirspaceVisibilityGraph::Obstacles &&obstacles) noexcept
+{
+  const std::lock_guard lock{mutex};
+
+  next_serial = serial;
+  next_obstacles = std::move(obstacles);
+  graph.reset();
+
+  try {
+    Trigger();
+  } catch (...) {
+    /* without the thread, the route planner keeps using its A*
+       search */
+    LogError(std::current_exception(), "Failed to start thread");
+  }
+}
+
+std::shared_ptr<const AirspaceVisibilityGraph>
+VisibilityGraphThread::Get(unsigned serial) noexcept
+{
+  const std::lock_guard lock{mutex};
+  return graph != nullptr && graph_serial == serial
+    ? graph
+    : nullptr;
+}
+
+void
+VisibilityGraphThread::Tick() noexcept
+{
+  SetLowPriority();
+
+  while (!next_obstacles.empty() && !IsStopped()) {
+    const unsigned serial = next_serial;
+    auto obstacles = std::move(next_obstacles);
+    next_obstacles.clear();
+
+    std::shared_ptr<const AirspaceVisibilityGraph> new_graph;
+
+    {
+      const ScopeUnlock unlock(mutex);
+      new_graph =
+        std::make_shared<const AirspaceVisibilityGraph>(std::move(obstacles));
+    }
+
+    if (serial == next_serial) {
+      graph = std::move(new_graph);
+      graph_serial = serial;
+    }
+  }
+}
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Engine/Route/AirspaceVisibilityGraph.hpp"
+#include "thread/StandbyThread.hpp"
+
+/**
+ * A thread which builds the airspace visibility graph for the route
+ * planner in background.
+ */
+class VisibilityGraphThread final
+  : public AirspaceVisibilityGraphBuilder, private StandbyThread {
+
+  /**
+   * The serial of the airspace set in #next_obstacles.
+   */
+  unsigned next_serial = 0;
+
+  AirspaceVisibilityGraph::Obstacles next_obstacles;
+
+  /**
+   * The serial of the airspace set #graph was built from.
+   */
+  unsigned graph_serial = 0;
+
+  std::shared_ptr<const AirspaceVisibilityGraph> graph;
+
+public:
+  VisibilityGraphThread() noexcept
+    :StandbyThread("VisibilityGraph") {}
+
+  ~VisibilityGraphThread() noexcept {
+    LockStop();
+  }
+
+  /* virtual methods from class AirspaceVisibilityGraphBuilder */
+  void Start(unsigned serial,
+             AirspaceVisibilityGraph::Obstacles &&obstacles) noexcept override;
+  std::shared_ptr<const AirspaceVisibilityGraph> Get(unsigned serial) noexcept override;
+
+private:
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override;
+};
@@ -68,6 +68,12 @@ public:
     return raster_tile_cache.GetSerial();
   }
 
+  [[gnu::pure]]
+  std::size_t GetMemoryUsage() const noexcept {
+    return sizeof(*this) - sizeof(raster_tile_cache) +
+      raster_tile_cache.GetMemoryUsage();
+  }
+
   const RasterProjection &GetProjection() const noexcept {
     return projection;
   }
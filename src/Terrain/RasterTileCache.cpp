@@ -144,6 +144,24 @@ RasterTileCache::PollTiles(SignedRasterLocation p, unsigned radius) noexcept
   return num_activate > 0;
 }
 
+std::size_t
+RasterTileCache::GetMemoryUsage() const noexcept
+{
+  const auto BufferSize = [](const RasterBuffer &b){
+    const auto s = b.GetSize();
+    return std::size_t(s.x) * s.y * sizeof(TerrainHeight);
+  };
+
+  std::size_t result = sizeof(*this) + BufferSize(overview) +
+    tiles.GetSize() * sizeof(RasterTile);
+
+  for (const auto &tile : tiles)
+    if (tile.IsLoaded())
+      result += BufferSize(tile.buffer);
+
+  return result;
+}
+
 TerrainHeight
 RasterTileCache::GetHeight(RasterLocation p) const noexcept
 {
@@ -11,6 +11,7 @@
 #include "util/Serial.hpp"
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 
@@ -284,6 +285,13 @@ public:
     return size << RasterTraits::SUBPIXEL_BITS;
   }
 
+  /**
+   * Estimate the number of bytes occupied by this object, including
+   * the overview and all loaded tiles.
+   */
+  [[gnu::pure]]
+  std::size_t GetMemoryUsage() const noexcept;
+
 private:
   RasterLocation GetFineTileSize() const noexcept {
     return {
@@ -5,6 +5,7 @@
 #include "RasterTerrain.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "thread/Util.hpp"
+#include "Profiler/Profiler.hpp"
 
 TerrainThread::TerrainThread(RasterTerrain &_terrain,
                              std::function<void()> &&_callback)
@@ -41,6 +42,7 @@ TerrainThread::Tick() noexcept
 
     {
       const ScopeUnlock unlock(mutex);
+      const Profiler::ScopeTimer timer{Profiler::Section::TERRAIN};
       again = terrain.UpdateTiles(center, radius);
     }
 
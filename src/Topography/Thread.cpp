@@ -3,6 +3,7 @@
 
 #include "Thread.hpp"
 #include "TopographyStore.hpp"
+#include "Profiler/Profiler.hpp"
 
 TopographyThread::TopographyThread(TopographyStore &_store,
                                    std::function<void()> &&_callback)
@@ -53,6 +54,7 @@ TopographyThread::Tick() noexcept
     const WindowProjection projection = next_projection;
 
     const ScopeUnlock unlock(mutex);
+    const Profiler::ScopeTimer timer{Profiler::Section::TOPOGRAPHY};
     again = store.ScanVisibility(projection, 1) > 0;
   }
 
@@ -53,6 +53,10 @@ Glue::SetSettings(const Settings &_settings)
     settings = _settings;
     state.ResetSession();
     client.SetServer(_settings.server);
+
+    const std::lock_guard lock{mutex};
+    backoff = {};
+    retry_time = {};
   } else {
     /* no fundamental setting changes */
     settings = _settings;
@@ -73,35 +77,61 @@ Glue::OnTimer(const MoreData &basic, const DerivedInfo &calculated)
     /* can't track without a valid GPS fix */
     return;
 
-  if (!clock.CheckUpdate(std::chrono::seconds(settings.interval)))
-    /* later */
-    return;
+  if (clock.CheckUpdate(std::chrono::seconds(settings.interval)))
+    QueuePosition(basic, calculated);
+
+  {
+    const std::lock_guard lock{mutex};
+
+    if (queue.empty() && !end_pending)
+      /* nothing to do */
+      return;
+
+    if (std::chrono::steady_clock::now() < retry_time)
+      /* backing off after an error */
+      return;
+  }
 
   if (inject_task)
-    /* still running, skip this submission */
+    /* still running; it will submit the new position, too */
     return;
 
-  date_time = basic.date_time_utc;
-  if (!date_time.IsDatePlausible())
-    /* use "today" if the GPS didn't provide a date */
-    (BrokenDate &)date_time = BrokenDate::TodayUTC();
-
-  location = basic.location;
-  /* XXX use nav_altitude? */
-  altitude = basic.NavAltitudeAvailable() && basic.nav_altitude > 0
-    ? (unsigned)basic.nav_altitude
-    : 0u;
-  ground_speed = basic.ground_speed_available
-    ? (unsigned)Units::ToUserUnit(basic.ground_speed, Unit::KILOMETER_PER_HOUR)
-    : 0u;
-  track = basic.track_available
-    ? basic.track
-    : Angle::Zero();
-
-  last_flying = flying;
+  inject_task.Start(Tick(settings), BIND_THIS_METHOD(OnCompletion));
+}
+
+void
+Glue::QueuePosition(const MoreData &basic, const DerivedInfo &calculated)
+{
+  const bool last_flying = flying;
   flying = calculated.flight.flying;
 
-  inject_task.Start(Tick(settings), BIND_THIS_METHOD(OnCompletion));
+  const std::lock_guard lock{mutex};
+
+  if (flying) {
+    Position position;
+    position.date_time = basic.date_time_utc;
+    if (!position.date_time.IsDatePlausible())
+      /* use "today" if the GPS didn't provide a date */
+      (BrokenDate &)position.date_time = BrokenDate::TodayUTC();
+
+    position.location = basic.location;
+    /* XXX use nav_altitude? */
+    position.altitude = basic.NavAltitudeAvailable() && basic.nav_altitude > 0
+      ? (unsigned)basic.nav_altitude
+      : 0u;
+    position.ground_speed = basic.ground_speed_available
+      ? (unsigned)Units::ToUserUnit(basic.ground_speed, Unit::KILOMETER_PER_HOUR)
+      : 0u;
+    position.track = basic.track_available
+      ? basic.track
+      : Angle::Zero();
+
+    queue.push_back(position);
+    end_pending = false;
+  } else if (last_flying)
+    /* landing: end the tracking session after the remaining
+       positions have been submitted */
+    end_pending = true;
 }
 
 Co::InvokeTask
@@ -109,19 +139,53 @@ Glue::Tick(Settings settings)
 {
   assert(settings.enabled);
 
-  if (!flying) {
-    if (last_flying && state.HasSession()) {
+  while (true) {
+    Position position;
+
+    {
+      const std::lock_guard lock{mutex};
+      if (queue.empty())
+        break;
+
+      position = queue.front();
+    }
+
+    co_await SendPosition(settings, position);
+
+    {
+      const std::lock_guard lock{mutex};
+      /* Thin() keeps the front item, so this is still the one we
+         have just submitted */
+      queue.pop_front();
+      backoff = {};
+    }
+  }
+
+  bool end;
+
+  {
+    const std::lock_guard lock{mutex};
+    end = end_pending;
+  }
+
+  if (end) {
+    if (state.HasSession()) {
       /* landing: end tracking session */
       co_await client.EndTracking(state.session_id, state.packet_id);
       state.ResetSession();
       last_timestamp = {};
     }
 
-    /* don't track if not flying */
-    co_return;
+    const std::lock_guard lock{mutex};
+    end_pending = false;
+    backoff = {};
   }
+}
 
-  const auto current_timestamp = date_time.ToTimePoint();
+Co::Task<void>
+Glue::SendPosition(Settings &settings, const Position &position)
+{
+  const auto current_timestamp = position.date_time.ToTimePoint();
 
   if (state.HasSession() &&
       current_timestamp + std::chrono::minutes(1) < last_timestamp) {
@@ -160,15 +224,24 @@ Glue::Tick(Settings settings)
   }
 
   co_await client.SendPosition(state.session_id, state.packet_id++,
-                               location, altitude, ground_speed, track,
+                               position.location, position.altitude,
+                               position.ground_speed, position.track,
                                current_timestamp);
 }
 
 void
 Glue::OnCompletion(std::exception_ptr error) noexcept
 {
-  if (error)
-    LogError(error, "LiveTrack24 error");
+  if (!error)
+    return;
+
+  LogError(error, "LiveTrack24 error");
+
+  const std::lock_guard lock{mutex};
+  backoff = backoff.count() > 0
+    ? std::min<std::chrono::steady_clock::duration>(backoff * 2, MAX_BACKOFF)
+    : MIN_BACKOFF;
+  retry_time = std::chrono::steady_clock::now() + backoff;
 }
 
 } // namespace Livetrack24
@@ -9,6 +9,10 @@
 #include "Geo/GeoPoint.hpp"
 #include "co/InjectTask.hxx"
 #include "time/BrokenDateTime.hpp"
+#include "thread/Mutex.hxx"
+#include "util/ThinningQueue.hpp"
+
+#include <chrono>
 
 struct MoreData;
 struct DerivedInfo;
@@ -16,7 +20,28 @@ class CurlGlobal;
 
 namespace LiveTrack24 {
 
+/**
+ * Submits the position to the LiveTrack24 server.  Positions are
+ * collected in a bounded queue, and one coroutine submits all of
+ * them, so a slow connection does not lose the fixes taken while a
+ * request is pending.  After an error, it waits with exponential
+ * backoff before trying again; if the queue overflows in the
+ * meantime, intermediate positions are dropped.
+ */
 class Glue final {
+  static constexpr std::chrono::steady_clock::duration MIN_BACKOFF =
+    std::chrono::seconds(15);
+  static constexpr std::chrono::steady_clock::duration MAX_BACKOFF =
+    std::chrono::minutes(5);
+
+  struct Position {
+    BrokenDateTime date_time;
+    GeoPoint location;
+    unsigned altitude;
+    unsigned ground_speed;
+    Angle track;
+  };
+
   struct State
   {
     LiveTrack24::SessionID session_id;
@@ -45,12 +70,36 @@ class Glue final {
    */
   std::chrono::system_clock::time_point last_timestamp{};
 
-  BrokenDateTime date_time;
-  GeoPoint location;
-  unsigned altitude;
-  unsigned ground_speed;
-  Angle track;
-  bool flying = false, last_flying;
+  bool flying = false;
+
+  /**
+   * Protects #queue, #end_pending, #backoff and #retry_time, which
+   * are shared between OnTimer() and the coroutine.
+   */
+  Mutex mutex;
+
+  /**
+   * Positions which have not been submitted yet.  The front one is
+   * removed only after the server has acknowledged it.
+   */
+  ThinningQueue<Position, 64> queue;
+
+  /**
+   * Has the aircraft landed, and shall the session be ended after
+   * the queue has been submitted?
+   */
+  bool end_pending = false;
+
+  /**
+   * The delay before retrying after the last error; zero after a
+   * successful submission.
+   */
+  std::chrono::steady_clock::duration backoff{};
+
+  /**
+   * Don't start a new coroutine before this time.
+   */
+  std::chrono::steady_clock::time_point retry_time{};
 
   Co::InjectTask inject_task;
 
@@ -61,7 +110,18 @@ public:
   void OnTimer(const MoreData &basic, const DerivedInfo &calculated);
 
 protected:
+  /**
+   * Add the current position to the queue, or note the landing.
+   */
+  void QueuePosition(const MoreData &basic, const DerivedInfo &calculated);
+
   Co::InvokeTask Tick(Settings settings);
+
+  /**
+   * Submit one position, starting a new session if necessary.
+   */
+  Co::Task<void> SendPosition(Settings &settings, const Position &position);
+
   void OnCompletion(std::exception_ptr error) noexcept;
 };
 
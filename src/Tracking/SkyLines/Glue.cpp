@@ -75,6 +75,12 @@ SkyLinesTracking::Glue::SendFixes(const NMEAInfo &basic)
   }
 
   if (queue != nullptr) {
+    /* append the current fix to the queue, so the server receives
+       all fixes in order; the queue drains much faster than fixes
+       arrive, so it is sent right away */
+    if (clock.CheckAdvance(basic.time, interval))
+      queue->PushLive(ToFix(client.GetKey(), basic));
+
     /* send queued fix packets, 8 at a time */
     unsigned n = 8;
     while (n-- > 0) {
@@ -4,7 +4,8 @@
 #pragma once
 
 #include "Protocol.hpp"
-#include "util/OverwritingRingBuffer.hpp"
+#include "util/ThinningQueue.hpp"
+#include "util/ByteOrder.hxx"
 
 #include <cstdint>
 
@@ -12,7 +13,9 @@ namespace SkyLinesTracking {
 
 /**
  * This class stores FixPacket elements while the data connection is
- * offline, so we can post it as soon as we're back online.
+ * offline, so we can post it as soon as we're back online.  When it
+ * is full, every second fix is dropped, so a long outage reduces the
+ * resolution of the track instead of losing its beginning.
  */
 class Queue {
   /**
@@ -20,27 +23,42 @@ class Queue {
    */
   static constexpr unsigned MIN_PERIOD_MS = 25000;
 
-  OverwritingRingBuffer<FixPacket, 256> queue;
+  ThinningQueue<FixPacket, 256> queue;
 
 public:
   bool IsEmpty() const {
     return queue.empty();
   }
 
+  /**
+   * Append a fix, unless it is too close to the previous one.
+   */
   void Push(const FixPacket &packet) {
-    if (!IsEmpty() && (packet.time > queue.last().time &&
-                       queue.last().time + MIN_PERIOD_MS < packet.time))
-      return;
+    if (!IsEmpty()) {
+      const uint32_t time = FromBE32(packet.time);
+      const uint32_t last_time = FromBE32(queue.back().time);
+      if (time > last_time && time < last_time + MIN_PERIOD_MS)
+        return;
+    }
+
+    queue.push_back(packet);
+  }
 
-    queue.push(packet);
+  /**
+   * Append a fix without throttling.  This is used for the live fixes
+   * while the backlog is being sent, which must not be thinned out to
+   * #MIN_PERIOD_MS.
+   */
+  void PushLive(const FixPacket &packet) {
+    queue.push_back(packet);
   }
 
   const FixPacket &Peek() {
-    return queue.peek();
+    return queue.front();
   }
 
-  const FixPacket &Pop() {
-    return queue.shift();
+  void Pop() {
+    queue.pop_front();
   }
 };
 
@@ -10,13 +10,20 @@
 #include "net/UniqueSocketDescriptor.hxx"
 #include "util/CRC16CCITT.hpp"
 
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
 static UniqueSocketDescriptor
-CreateBindUDP(SocketAddress address)
+CreateBindUDP(SocketAddress address, bool reuse_port)
 {
   UniqueSocketDescriptor s;
   if (!s.Create(address.GetFamily(), SOCK_DGRAM, 0))
     throw MakeSocketError("Failed to create socket");
 
+  if (reuse_port && !s.SetReusePort())
+    throw MakeSocketError("Failed to set SO_REUSEPORT");
+
   if (!s.Bind(address))
     throw MakeSocketError("Failed to connect socket");
 
@@ -26,9 +33,10 @@ CreateBindUDP(SocketAddress address)
 namespace SkyLinesTracking {
 
 Server::Server(EventLoop &event_loop,
-               SocketAddress server_address)
+               SocketAddress server_address, bool reuse_port)
   :socket(event_loop, BIND_THIS_METHOD(OnSocketReady),
-          CreateBindUDP(server_address).Release())
+          CreateBindUDP(server_address, reuse_port).Release()),
+   receive_buffer(std::make_unique<ReceiveBuffer>())
 {
   socket.ScheduleRead();
 }
@@ -43,7 +51,7 @@ Server::SendBuffer(SocketAddress address,
                    std::span<const std::byte> buffer) noexcept
 {
   try {
-    ssize_t nbytes = socket.GetSocket().WriteNoWait(buffer);
+    ssize_t nbytes = socket.GetSocket().WriteNoWait(buffer, address);
     if (nbytes < 0)
       throw MakeSocketError("Failed to send");
   } catch (...) {
@@ -165,22 +173,54 @@ Server::OnDatagramReceived(Client &&client,
 void
 Server::OnSocketReady(unsigned) noexcept
 try {
-  // TODO: use recvmmsg() on Linux
+  auto &b = *receive_buffer;
+
+#ifdef __linux__
+  /* receive a batch of datagrams with one system call */
+  struct iovec iov[RECEIVE_BATCH];
+  struct mmsghdr msgs[RECEIVE_BATCH];
+
+  for (unsigned i = 0; i < RECEIVE_BATCH; ++i) {
+    iov[i].iov_base = b.data[i].data();
+    iov[i].iov_len = b.data[i].size();
+
+    msgs[i] = {};
+    msgs[i].msg_hdr.msg_name = (struct sockaddr *)b.clients[i].address;
+    msgs[i].msg_hdr.msg_namelen = b.clients[i].address.GetCapacity();
+    msgs[i].msg_hdr.msg_iov = &iov[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
 
-  Client client;
-  socklen_t address_size = sizeof(client.address);
-  char buffer[4096];
+  int n = recvmmsg(socket.GetSocket().Get(), msgs, RECEIVE_BATCH,
+                   MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    if (IsSocketErrorReceiveWouldBlock(GetSocketError()))
+      return;
 
-  ssize_t nbytes = recvfrom(socket.GetSocket().Get(), buffer, sizeof(buffer),
-                            MSG_DONTWAIT,
-                            client.address, &address_size);
-  if (nbytes < 0)
     throw MakeSocketError("Failed to receive");
+  }
 
-  client.address.SetSize(address_size);
-  // TODO: set client.key
+  for (int i = 0; i < n; ++i) {
+    Client &client = b.clients[i];
+    client.address.SetSize(msgs[i].msg_hdr.msg_namelen);
+    OnDatagramReceived(std::move(client), b.data[i].data(), msgs[i].msg_len);
+  }
+#else
+  for (unsigned i = 0; i < RECEIVE_BATCH; ++i) {
+    Client &client = b.clients[i];
+
+    ssize_t nbytes = socket.GetSocket().ReadNoWait(b.data[i],
+                                                   client.address);
+    if (nbytes < 0) {
+      if (IsSocketErrorReceiveWouldBlock(GetSocketError()))
+        break;
 
-  OnDatagramReceived(std::move(client), buffer, nbytes);
+      throw MakeSocketError("Failed to receive");
+    }
+
+    OnDatagramReceived(std::move(client), b.data[i].data(), nbytes);
+  }
+#endif
 } catch (...) {
   socket.Close();
   OnError(std::current_exception());
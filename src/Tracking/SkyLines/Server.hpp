@@ -7,9 +7,11 @@
 #include "net/StaticSocketAddress.hxx"
 #include "util/SpanCast.hxx"
 
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <exception>
+#include <memory>
 #include <span>
 
 struct GeoPoint;
@@ -23,6 +25,14 @@ namespace SkyLinesTracking {
  * virtual methods.
  */
 class Server {
+  /**
+   * The maximum number of datagrams received in one
+   * OnSocketReady() call.
+   */
+  static constexpr unsigned RECEIVE_BATCH = 32;
+
+  static constexpr std::size_t MAX_DATAGRAM_SIZE = 4096;
+
   SocketEvent socket;
 
 public:
@@ -31,8 +41,24 @@ public:
     uint64_t key;
   };
 
+private:
+  struct ReceiveBuffer {
+    std::array<std::array<std::byte, MAX_DATAGRAM_SIZE>, RECEIVE_BATCH> data;
+    std::array<Client, RECEIVE_BATCH> clients;
+  };
+
+  const std::unique_ptr<ReceiveBuffer> receive_buffer;
+
 public:
-  Server(EventLoop &event_loop, SocketAddress server_address);
+  /**
+   * Throws on error.
+   *
+   * @param reuse_port set SO_REUSEPORT, allowing several servers
+   * (e.g. one per thread) to bind the same port; the kernel
+   * distributes the datagrams among them
+   */
+  Server(EventLoop &event_loop, SocketAddress server_address,
+         bool reuse_port=false);
 
   ~Server();
 
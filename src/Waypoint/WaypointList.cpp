@@ -3,6 +3,8 @@
 
 #include "WaypointList.hpp"
 #include "Waypoint/Waypoint.hpp"
+#include "Geo/Math.hpp"
+#include "Geo/PreparedGeoPoint.hpp"
 
 #include <algorithm>
 
@@ -21,9 +23,22 @@ WaypointListItem::GetVector(const GeoPoint &location) const noexcept
   return vec;
 }
 
+inline void
+WaypointListItem::UpdateVector(const PreparedGeoPoint &location) const noexcept
+{
+  if (!vec.IsValid())
+    DistanceBearing(location, waypoint->location, &vec.distance, &vec.bearing);
+}
+
 void
 WaypointList::SortByDistance(const GeoPoint &location) noexcept
 {
+  /* calculate all missing vectors in one pass before sorting,
+     sharing the origin's trigonometry */
+  const PreparedGeoPoint prepared(location);
+  for (const auto &i : *this)
+    i.UpdateVector(prepared);
+
   std::sort(begin(), end(), [location](const auto &a, const auto &b){
     return a.GetVector(location).distance < b.GetVector(location).distance;
   });
@@ -8,6 +8,8 @@
 
 #include <vector>
 
+struct PreparedGeoPoint;
+
 /**
  * Structure to hold Waypoint sorting information
  */
@@ -28,6 +30,11 @@ public:
 
   [[gnu::pure]]
   const GeoVector &GetVector(const GeoPoint &location) const noexcept;
+
+  /**
+   * Calculate the vector if it is not yet known.
+   */
+  void UpdateVector(const PreparedGeoPoint &location) const noexcept;
 };
 
 class WaypointList: public std::vector<WaypointListItem>
@@ -2,19 +2,15 @@
 // Copyright The XCSoar Project
 
 #include "RaspCache.hpp"
+#include "RaspMapCache.hpp"
 #include "RaspStore.hpp"
 #include "Terrain/RasterMap.hpp"
-#include "Terrain/Loader.hpp"
 #include "Language/Language.hpp"
-#include "system/Path.hpp"
-#include "io/ZipArchive.hpp"
-#include "LogFile.hpp"
 
 #include <cassert>
-#include <windef.h> // for MAX_PATH
 
-RaspCache::RaspCache(const RaspStore &_store, unsigned _parameter) noexcept
-  :store(_store), parameter(_parameter) {}
+RaspCache::RaspCache(RaspMapCache &_maps, unsigned _parameter) noexcept
+  :maps(_maps), store(_maps.GetStore()), parameter(_parameter) {}
 
 RaspCache::~RaspCache() noexcept = default;
 
@@ -85,27 +81,9 @@ RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
   if (effective_time == RaspStore::MAX_WEATHER_TIMES)
     return;
 
-  map.reset();
+  map = maps.Load(parameter, effective_time, operation);
 
-  auto archive = store.OpenArchive();
-  if (!archive)
-    return;
-
-  char new_name[MAX_PATH];
-  store.NarrowWeatherFilename(new_name, Path(store.GetItemInfo(parameter).name),
-                              effective_time);
-
-  auto new_map = std::make_unique<RasterMap>();
-  try {
-    LoadTerrainOverview(archive->get(), new_name, nullptr,
-                        new_map->GetTileCache(),
-                        true, operation);
-  } catch (...) {
-    LogError(std::current_exception(), "Failed to load RASP file");
-    return;
-  }
-
-  new_map->UpdateProjection();
-
-  map = std::move(new_map);
+  /* decode the other times of this parameter in the background, so
+     stepping through them will be quick */
+  maps.Preload(parameter, effective_time);
 }
@@ -10,14 +10,17 @@
 struct BrokenTime;
 struct GeoPoint;
 class RaspStore;
+class RaspMapCache;
 class RasterMap;
 class OperationEnvironment;
 
 /**
  * Class to manage the raster weather map, to be loaded/selected from
- * a #RaspStore instance.
+ * a #RaspStore instance.  The decoded maps are obtained from a
+ * #RaspMapCache.
  */
 class RaspCache {
+  RaspMapCache &maps;
   const RaspStore &store;
 
   const unsigned parameter;
@@ -25,10 +28,10 @@ class RaspCache {
   unsigned time = 0;
   unsigned last_time = 0;
 
-  std::unique_ptr<RasterMap> map;
+  std::shared_ptr<const RasterMap> map;
 
 public:
-  RaspCache(const RaspStore &_store, unsigned _parameter) noexcept;
+  RaspCache(RaspMapCache &_maps, unsigned _parameter) noexcept;
   ~RaspCache() noexcept;
 
   const RaspStore &GetStore() const {
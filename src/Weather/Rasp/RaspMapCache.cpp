@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "RaspMapCache.hpp"
+#include "RaspStore.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "Operation/Operation.hpp"
+#include "system/Path.hpp"
+#include "io/ZipArchive.hpp"
+#include "LogFile.hpp"
+
+#include <windef.h> // for MAX_PATH
+
+RaspMapCache::RaspMapCache(const RaspStore &_store,
+                           std::size_t _budget) noexcept
+  :StandbyThread("RaspCache"), store(_store), items(_budget) {}
+
+RaspMapCache::~RaspMapCache() noexcept
+{
+  LockStop();
+}
+
+std::unique_ptr<RasterMap>
+RaspMapCache::Decode(unsigned parameter, unsigned time,
+                     OperationEnvironment &operation) const noexcept
+try {
+  auto archive = store.OpenArchive();
+  if (!archive)
+    return nullptr;
+
+  char name[MAX_PATH];
+  if (!store.NarrowWeatherFilename(name,
+                                   Path(store.GetItemInfo(parameter).name),
+                                   time))
+    return nullptr;
+
+  auto map = std::make_unique<RasterMap>();
+  LoadTerrainOverview(archive->get(), name, nullptr,
+                      map->GetTileCache(),
+                      true, operation);
+  map->UpdateProjection();
+  return map;
+} catch (...) {
+  LogError(std::current_exception(), "Failed to load RASP file");
+  return nullptr;
+}
+
+std::shared_ptr<const RasterMap>
+RaspMapCache::Insert(unsigned parameter, unsigned time,
+                     std::shared_ptr<const RasterMap> map,
+                     bool &evicted_parameter) noexcept
+{
+  const std::size_t size = map->GetMemoryUsage();
+  return items.Insert(parameter, time, std::move(map), size,
+                      evicted_parameter);
+}
+
+std::shared_ptr<const RasterMap>
+RaspMapCache::Load(unsigned parameter, unsigned time,
+                   OperationEnvironment &operation) noexcept
+{
+  {
+    const std::lock_guard lock{mutex};
+    if (auto map = items.Get(parameter, time))
+      return map;
+  }
+
+  std::shared_ptr<const RasterMap> map = Decode(parameter, time, operation);
+  if (map == nullptr)
+    return nullptr;
+
+  const std::lock_guard lock{mutex};
+  bool evicted_parameter;
+  return Insert(parameter, time, std::move(map), evicted_parameter);
+}
+
+void
+RaspMapCache::Preload(unsigned parameter, unsigned time) noexcept
+{
+  const std::lock_guard lock{mutex};
+
+  if (parameter == preload_parameter && time == preload_time)
+    return;
+
+  preload_parameter = parameter;
+  preload_time = time;
+
+  if (FindPreloadTime() == NONE)
+    return;
+
+  try {
+    StandbyThread::Trigger();
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to start RASP thread");
+  }
+}
+
+unsigned
+RaspMapCache::FindPreloadTime() const noexcept
+{
+  if (preload_parameter == NONE)
+    return NONE;
+
+  const auto IsCached = [this](unsigned t){
+    return items.Contains(preload_parameter, t);
+  };
+
+  /* alternate forward and backward from the selected time */
+  for (unsigned d = 0; d < RaspStore::MAX_WEATHER_TIMES; ++d) {
+    if (preload_time + d < RaspStore::MAX_WEATHER_TIMES) {
+      const unsigned t = preload_time + d;
+      if (store.IsTimeAvailable(preload_parameter, t) && !IsCached(t))
+        return t;
+    }
+
+    if (d > 0 && d <= preload_time) {
+      const unsigned t = preload_time - d;
+      if (store.IsTimeAvailable(preload_parameter, t) && !IsCached(t))
+        return t;
+    }
+  }
+
+  return NONE;
+}
+
+void
+RaspMapCache::Tick() noexcept
+{
+  SetIdlePriority();
+
+  unsigned time;
+  while (!IsStopped() && (time = FindPreloadTime()) != NONE) {
+    const unsigned parameter = preload_parameter;
+
+    std::shared_ptr<const RasterMap> map;
+
+    {
+      const ScopeUnlock unlock(mutex);
+      NullOperationEnvironment operation;
+      map = Decode(parameter, time, operation);
+    }
+
+    if (map == nullptr)
+      break;
+
+    bool evicted_parameter;
+    Insert(parameter, time, std::move(map), evicted_parameter);
+    if (evicted_parameter)
+      /* the budget does not fit all times of this parameter; don't
+         keep evicting the ones we have just decoded */
+      break;
+  }
+}
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "RaspMapLRU.hpp"
+#include "thread/StandbyThread.hpp"
+
+#include <cstddef>
+#include <memory>
+
+class RaspStore;
+class RasterMap;
+class OperationEnvironment;
+
+/**
+ * A cache of decoded RASP maps, shared by all #RaspCache instances
+ * of one #RaspStore.  Decoding a map (a JPEG2000 file in the RASP
+ * archive) is expensive, so recently used maps are kept in memory
+ * (least recently used first out) up to a memory budget.
+ *
+ * When a parameter is selected, a background thread decodes all of
+ * its times, beginning with the ones nearest to the selected time,
+ * so stepping through the forecast does not need to decode anything.
+ */
+class RaspMapCache final : private StandbyThread {
+  static constexpr unsigned NONE = ~0u;
+
+#if defined(ANDROID)
+  static constexpr std::size_t DEFAULT_BUDGET = 16 * 1024 * 1024;
+#else
+  static constexpr std::size_t DEFAULT_BUDGET = 64 * 1024 * 1024;
+#endif
+
+  const RaspStore &store;
+
+  /**
+   * The cached maps.  Protected by StandbyThread::mutex.
+   */
+  RaspMapLRU items;
+
+  /**
+   * The parameter (and the time around which) the thread shall
+   * preload, or #NONE.
+   */
+  unsigned preload_parameter = NONE, preload_time;
+
+public:
+  explicit RaspMapCache(const RaspStore &_store,
+                        std::size_t _budget=DEFAULT_BUDGET) noexcept;
+  ~RaspMapCache() noexcept;
+
+  RaspMapCache(const RaspMapCache &) = delete;
+  RaspMapCache &operator=(const RaspMapCache &) = delete;
+
+  const RaspStore &GetStore() const noexcept {
+    return store;
+  }
+
+  /**
+   * Return the map for the given parameter and time index, decoding
+   * it in the calling thread if it is not cached yet.
+   *
+   * @return the map or nullptr on error
+   */
+  std::shared_ptr<const RasterMap> Load(unsigned parameter, unsigned time,
+                                        OperationEnvironment &operation) noexcept;
+
+  /**
+   * Decode all times of the given parameter in the background,
+   * beginning with the ones nearest to the given time index.
+   */
+  void Preload(unsigned parameter, unsigned time) noexcept;
+
+private:
+  /**
+   * Add a map to the cache.
+   *
+   * Caller must lock the mutex.
+   *
+   * @see RaspMapLRU::Insert()
+   */
+  std::shared_ptr<const RasterMap> Insert(unsigned parameter, unsigned time,
+                                          std::shared_ptr<const RasterMap> map,
+                                          bool &evicted_parameter) noexcept;
+
+  /**
+   * Find the next time index of #preload_parameter to be decoded.
+   *
+   * Caller must lock the mutex.
+   *
+   * @return the time index or #NONE if all are cached
+   */
+  [[gnu::pure]]
+  unsigned FindPreloadTime() const noexcept;
+
+  /**
+   * Decode a map from the RASP archive.
+   *
+   * @return the map or nullptr on error
+   */
+  std::unique_ptr<RasterMap> Decode(unsigned parameter, unsigned time,
+                                    OperationEnvironment &operation) const noexcept;
+
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override;
+};
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "RaspMapLRU.hpp"
+
+#include <algorithm>
+
+bool
+RaspMapLRU::Contains(unsigned parameter, unsigned time) const noexcept
+{
+  return std::any_of(items.begin(), items.end(), [=](const Item &item){
+    return item.parameter == parameter && item.time == time;
+  });
+}
+
+std::shared_ptr<const RasterMap>
+RaspMapLRU::Get(unsigned parameter, unsigned time) noexcept
+{
+  auto i = std::find_if(items.begin(), items.end(), [=](const Item &item){
+    return item.parameter == parameter && item.time == time;
+  });
+  if (i == items.end())
+    return nullptr;
+
+  items.splice(items.begin(), items, i);
+  return i->map;
+}
+
+std::shared_ptr<const RasterMap>
+RaspMapLRU::Insert(unsigned parameter, unsigned time,
+                   std::shared_ptr<const RasterMap> map,
+                   std::size_t size,
+                   bool &evicted_parameter) noexcept
+{
+  evicted_parameter = false;
+
+  if (auto existing = Get(parameter, time))
+    return existing;
+
+  items.push_front({parameter, time, map, size});
+  total_size += size;
+
+  while (total_size > budget && items.size() > 1) {
+    const Item &victim = items.back();
+    if (victim.parameter == parameter)
+      evicted_parameter = true;
+
+    total_size -= victim.size;
+    items.pop_back();
+  }
+
+  return map;
+}
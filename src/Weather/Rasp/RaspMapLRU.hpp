@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+
+class RasterMap;
+
+/**
+ * The bookkeeping of #RaspMapCache: a list of decoded RASP maps,
+ * keyed by parameter and time index, which evicts the least recently
+ * used ones when their total size exceeds a budget.
+ *
+ * This class is not thread-safe.
+ */
+class RaspMapLRU {
+  /**
+   * The maximum total size of all maps [bytes].
+   */
+  const std::size_t budget;
+
+  struct Item {
+    unsigned parameter, time;
+
+    std::shared_ptr<const RasterMap> map;
+
+    std::size_t size;
+  };
+
+  /**
+   * The maps, most recently used first.
+   */
+  std::list<Item> items;
+
+  /**
+   * The sum of all Item::size values.
+   */
+  std::size_t total_size = 0;
+
+public:
+  explicit RaspMapLRU(std::size_t _budget) noexcept
+    :budget(_budget) {}
+
+  std::size_t GetBudget() const noexcept {
+    return budget;
+  }
+
+  /**
+   * Returns the total size of all maps [bytes].
+   */
+  std::size_t GetSize() const noexcept {
+    return total_size;
+  }
+
+  std::size_t GetCount() const noexcept {
+    return items.size();
+  }
+
+  /**
+   * Is this map in the list?  Unlike Get(), this does not mark it as
+   * recently used.
+   */
+  [[gnu::pure]]
+  bool Contains(unsigned parameter, unsigned time) const noexcept;
+
+  /**
+   * Look up a map and mark it as most recently used.
+   */
+  std::shared_ptr<const RasterMap> Get(unsigned parameter,
+                                       unsigned time) noexcept;
+
+  /**
+   * Add a map, and evict the least recently used maps until the
+   * budget is met.  The new map itself is never evicted, even if it
+   * exceeds the budget on its own.  If the map is already in the
+   * list, the existing one is kept.
+   *
+   * @param size the memory usage of the map [bytes]
+   * @param evicted_parameter set to true if a map of the same
+   * parameter had to be evicted
+   * @return the map now in the list
+   */
+  std::shared_ptr<const RasterMap> Insert(unsigned parameter, unsigned time,
+                                          std::shared_ptr<const RasterMap> map,
+                                          std::size_t size,
+                                          bool &evicted_parameter) noexcept;
+};
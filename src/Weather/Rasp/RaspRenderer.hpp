@@ -25,8 +25,8 @@ class RaspRenderer {
   const ColorRamp *last_color_ramp = nullptr;
 
 public:
-  RaspRenderer(const RaspStore &_store, unsigned parameter)
-    :cache(_store, parameter) {}
+  RaspRenderer(RaspMapCache &maps, unsigned parameter)
+    :cache(maps, parameter) {}
 
   /**
    * Flush the cache.
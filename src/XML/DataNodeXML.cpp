@@ -20,7 +20,7 @@ WritableDataNodeXML::AppendChild(const char *name) noexcept
 std::unique_ptr<ConstDataNode>
 ConstDataNodeXML::GetChildNamed(const char *name) const noexcept
 {
-  const XMLNode *child = node.GetChildNode(name);
+  const auto *child = node.GetChild(name);
   if (child == nullptr)
     return nullptr;
 
@@ -31,8 +31,9 @@ ConstDataNode::List
 ConstDataNodeXML::ListChildren() const noexcept
 {
   List list;
-  for (const auto &i : node)
-    list.emplace_back(new ConstDataNodeXML(i));
+  for (const auto *i = node.GetFirstChild(); i != nullptr;
+       i = i->GetNextSibling())
+    list.emplace_back(new ConstDataNodeXML(*i));
   return list;
 }
 
@@ -40,9 +41,10 @@ ConstDataNode::List
 ConstDataNodeXML::ListChildrenNamed(const char *name) const noexcept
 {
   List list;
-  for (const auto &i : node)
-    if (StringIsEqualIgnoreCase(i.GetName(), name))
-      list.emplace_back(new ConstDataNodeXML(i));
+  for (const auto *i = node.GetFirstChild(); i != nullptr;
+       i = i->GetNextSibling())
+    if (StringIsEqualIgnoreCase(i->GetName(), name))
+      list.emplace_back(new ConstDataNodeXML(*i));
   return list;
 }
 
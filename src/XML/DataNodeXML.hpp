@@ -4,6 +4,7 @@
 #pragma once
 
 #include "DataNode.hpp"
+#include "Document.hpp"
 
 class XMLNode;
 
@@ -11,17 +12,17 @@ class XMLNode;
  * ConstDataNode implementation for XML files
  */
 class ConstDataNodeXML final : public ConstDataNode {
-  const XMLNode &node;
+  const XML::Document::Element &node;
 
 public:
   /**
-   * Construct a node from an XMLNode
+   * Construct a node from an element of a parsed XML::Document
    *
-   * @param the_node XML node reflecting this node
+   * @param the_node XML element reflecting this node
    *
    * @return Initialised object
    */
-  explicit ConstDataNodeXML(const XMLNode &_node) noexcept
+  explicit ConstDataNodeXML(const XML::Document::Element &_node) noexcept
     :node(_node) {}
 
   /* virtual methods from ConstDataNode */
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Document.hpp"
+#include "PullParser.hpp"
+#include "io/FileReader.hxx"
+#include "system/Path.hpp"
+#include "util/StringAPI.hxx"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace XML {
+
+/**
+ * Refuse to load files larger than this.
+ */
+static constexpr std::size_t MAX_FILE_SIZE = 16 * 1024 * 1024;
+
+const char *
+Document::Element::GetAttribute(const char *_name) const noexcept
+{
+  for (const auto &i : attributes)
+    if (StringIsEqualIgnoreCase(i.name.data(), _name))
+      return i.value.data();
+
+  return nullptr;
+}
+
+const Document::Element *
+Document::Element::GetChild(const char *_name) const noexcept
+{
+  for (const Element *i = first_child; i != nullptr; i = i->next_sibling)
+    if (StringIsEqualIgnoreCase(i->GetName(), _name))
+      return i;
+
+  return nullptr;
+}
+
+/**
+ * Resolve the entity references of a string which points into the
+ * writable document buffer.
+ */
+static std::string_view
+Unescape(char *buffer, std::string_view s)
+{
+  char *p = buffer + (s.data() - buffer);
+  return {p, UnescapeInPlace({p, s.size()})};
+}
+
+/**
+ * Null-terminate a string which points into the writable document
+ * buffer.
+ */
+static void
+Terminate(char *buffer, std::string_view s) noexcept
+{
+  buffer[s.data() - buffer + s.size()] = '\0';
+}
+
+Document::Document(std::unique_ptr<char[]> &&_buffer, std::size_t size)
+  :buffer(std::move(_buffer))
+{
+  char *const b = buffer.get();
+  const std::string_view src{b, size};
+
+  /* each element begins with a '<' and each attribute contains a
+     '=', which gives an upper bound for the array sizes; reserving
+     them up front keeps the pointers between elements valid */
+  elements.reserve(std::count(src.begin(), src.end(), '<'));
+  attributes.reserve(std::count(src.begin(), src.end(), '='));
+
+  struct Open {
+    Element *element, *last_child = nullptr;
+  };
+
+  std::vector<Open> stack;
+
+  PullParser parser{src};
+  PullParser::Event event;
+  while ((event = parser.Next()) != PullParser::Event::END) {
+    switch (event) {
+    case PullParser::Event::START_ELEMENT:
+      if (stack.empty() && !elements.empty())
+        throw std::runtime_error("Multiple root elements");
+
+      {
+        Element &e = elements.emplace_back();
+        e.name = parser.GetName();
+
+        const std::size_t first_attribute = attributes.size();
+        for (const auto &i : parser.GetAttributes())
+          attributes.push_back({i.name, Unescape(b, i.value)});
+
+        e.attributes = {
+          attributes.data() + first_attribute,
+          attributes.size() - first_attribute,
+        };
+
+        if (!stack.empty()) {
+          auto &parent = stack.back();
+          if (parent.last_child != nullptr)
+            parent.last_child->next_sibling = &e;
+          else
+            parent.element->first_child = &e;
+          parent.last_child = &e;
+        }
+
+        stack.push_back({&e});
+      }
+
+      break;
+
+    case PullParser::Event::END_ELEMENT:
+      stack.pop_back();
+      break;
+
+    case PullParser::Event::TEXT:
+      if (auto &e = *stack.back().element; e.text.data() == nullptr)
+        e.text = parser.IsCData()
+          ? parser.GetText()
+          : Unescape(b, parser.GetText());
+      break;
+
+    case PullParser::Event::END:
+      break;
+    }
+  }
+
+  if (elements.empty())
+    throw std::runtime_error("No elements found");
+
+  /* the terminators would overwrite characters the parser still
+     needs, so they are only written now that parsing is finished */
+  for (auto &e : elements) {
+    Terminate(b, e.name);
+
+    if (e.text.data() != nullptr)
+      Terminate(b, e.text);
+    else
+      e.text = "";
+  }
+
+  for (const auto &i : attributes) {
+    Terminate(b, i.name);
+    Terminate(b, i.value);
+  }
+}
+
+Document
+Document::Parse(std::string_view src)
+{
+  std::unique_ptr<char[]> buffer{new char[src.size() + 1]};
+  std::copy(src.begin(), src.end(), buffer.get());
+  buffer[src.size()] = '\0';
+
+  return Document{std::move(buffer), src.size()};
+}
+
+Document
+Document::Load(Path path)
+{
+  FileReader reader{path};
+
+  const auto size = reader.GetSize();
+  if (size > MAX_FILE_SIZE)
+    throw std::runtime_error("File is too large");
+
+  std::unique_ptr<char[]> buffer{new char[size + 1]};
+  const auto nbytes = reader.Read(std::as_writable_bytes(std::span{buffer.get(), static_cast<std::size_t>(size)}));
+  if (nbytes != size)
+    throw std::runtime_error{"Short read"};
+
+  buffer[nbytes] = '\0';
+
+  return Document{std::move(buffer), static_cast<std::size_t>(size)};
+}
+
+} // namespace XML
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+class Path;
+
+namespace XML {
+
+/**
+ * A read-only XML document parsed with #PullParser.  This is a
+ * lightweight alternative to #XMLNode: the document is parsed in
+ * place, i.e. all strings point into the one buffer which holds the
+ * file contents, and all elements and attributes are stored in two
+ * flat arrays.
+ *
+ * Only the first text section of each element is kept.
+ */
+class Document {
+public:
+  struct Attribute {
+    /**
+     * Both strings are null-terminated and unescaped.
+     */
+    std::string_view name, value;
+  };
+
+  class Element {
+    friend class Document;
+
+    std::string_view name, text;
+
+    std::span<const Attribute> attributes;
+
+    const Element *first_child = nullptr, *next_sibling = nullptr;
+
+  public:
+    /**
+     * @return the null-terminated element name
+     */
+    const char *GetName() const noexcept {
+      return name.data();
+    }
+
+    /**
+     * @return the null-terminated and unescaped text (empty if there
+     * is none)
+     */
+    const char *GetText() const noexcept {
+      return text.data();
+    }
+
+    std::span<const Attribute> GetAttributes() const noexcept {
+      return attributes;
+    }
+
+    /**
+     * @return the value of the attribute with the given name
+     * (case-insensitive) or nullptr if there is none
+     */
+    [[gnu::pure]]
+    const char *GetAttribute(const char *name) const noexcept;
+
+    /**
+     * @return the first child element with the given name
+     * (case-insensitive) or nullptr if there is none
+     */
+    [[gnu::pure]]
+    const Element *GetChild(const char *name) const noexcept;
+
+    const Element *GetFirstChild() const noexcept {
+      return first_child;
+    }
+
+    const Element *GetNextSibling() const noexcept {
+      return next_sibling;
+    }
+  };
+
+private:
+  std::unique_ptr<char[]> buffer;
+
+  std::vector<Element> elements;
+  std::vector<Attribute> attributes;
+
+  explicit Document(std::unique_ptr<char[]> &&_buffer,
+                    std::size_t size);
+
+public:
+  Document(Document &&) noexcept = default;
+  Document &operator=(Document &&) noexcept = default;
+
+  /**
+   * Parse a copy of the given string.
+   *
+   * Throws on error.
+   */
+  static Document Parse(std::string_view src);
+
+  /**
+   * Load and parse a file.
+   *
+   * Throws on error.
+   */
+  static Document Load(Path path);
+
+  const Element &GetRoot() const noexcept {
+    return elements.front();
+  }
+};
+
+} // namespace XML
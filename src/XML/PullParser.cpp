@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "PullParser.hpp"
+#include "util/CharUtil.hxx"
+#include "util/StringCompare.hxx"
+#include "util/StringStrip.hxx"
+#include "util/NumberParser.hpp"
+#include "util/UTF8.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace XML {
+
+static constexpr bool
+IsNameTerminator(char ch) noexcept
+{
+  return IsWhitespaceOrNull(ch) || ch == '/' || ch == '>' || ch == '=' ||
+    ch == '<';
+}
+
+inline void
+PullParser::SkipWhitespace() noexcept
+{
+  while (position < src.size() && IsWhitespaceOrNull(src[position]))
+    ++position;
+}
+
+void
+PullParser::SkipPast(std::string_view end)
+{
+  const auto i = src.find(end, position);
+  if (i == src.npos)
+    throw std::runtime_error("Unexpected end of file");
+
+  position = i + end.size();
+}
+
+std::string_view
+PullParser::ParseName()
+{
+  const std::size_t start = position;
+  while (position < src.size() && !IsNameTerminator(src[position]))
+    ++position;
+
+  if (position == start)
+    throw std::runtime_error("Missing name");
+
+  return src.substr(start, position - start);
+}
+
+inline void
+PullParser::ParseStartTag()
+{
+  name = ParseName();
+  attributes.clear();
+
+  while (true) {
+    SkipWhitespace();
+    if (position >= src.size())
+      throw std::runtime_error("Unexpected end of file");
+
+    const char ch = src[position];
+    if (ch == '>') {
+      ++position;
+      break;
+    }
+
+    if (ch == '/') {
+      if (position + 1 >= src.size() || src[position + 1] != '>')
+        throw std::runtime_error("Unexpected token found");
+
+      position += 2;
+      pending_end = true;
+      break;
+    }
+
+    const auto attribute_name = ParseName();
+
+    SkipWhitespace();
+    if (position >= src.size() || src[position] != '=')
+      throw std::runtime_error("Missing attribute value");
+    ++position;
+
+    SkipWhitespace();
+    if (position >= src.size() ||
+        (src[position] != '"' && src[position] != '\''))
+      throw std::runtime_error("Unquoted attribute value");
+
+    const char quote = src[position++];
+    const auto end = src.find(quote, position);
+    if (end == src.npos)
+      throw std::runtime_error("Unexpected end of file");
+
+    attributes.push_back({
+      attribute_name,
+      src.substr(position, end - position),
+    });
+    position = end + 1;
+  }
+
+  open.push_back(name);
+}
+
+inline void
+PullParser::ParseEndTag()
+{
+  name = ParseName();
+
+  SkipWhitespace();
+  if (position >= src.size() || src[position] != '>')
+    throw std::runtime_error("Missing end tag name");
+  ++position;
+
+  /* tag names are compared case-insensitively, just like
+     XML::ParseString() does */
+  if (open.empty() || !StringIsEqualIgnoreCase(open.back(), name))
+    throw std::runtime_error("Unmatched end tag");
+
+  open.pop_back();
+}
+
+inline bool
+PullParser::ParseText() noexcept
+{
+  const std::size_t start = position;
+  position = std::min(src.find('<', position), src.size());
+
+  text = Strip(src.substr(start, position - start));
+  cdata = false;
+  return !text.empty();
+}
+
+PullParser::Event
+PullParser::Next()
+{
+  using std::string_view_literals::operator""sv;
+
+  if (pending_end) {
+    pending_end = false;
+    open.pop_back();
+    return Event::END_ELEMENT;
+  }
+
+  while (true) {
+    if (position >= src.size()) {
+      if (!open.empty())
+        throw std::runtime_error("Unexpected end of file");
+
+      return Event::END;
+    }
+
+    if (src[position] != '<') {
+      if (ParseText()) {
+        if (open.empty())
+          throw std::runtime_error("Text outside of element");
+
+        return Event::TEXT;
+      }
+
+      continue;
+    }
+
+    const auto rest = src.substr(position);
+    if (rest.starts_with("<?"sv)) {
+      SkipPast("?>"sv);
+    } else if (rest.starts_with("<!--"sv)) {
+      SkipPast("-->"sv);
+    } else if (rest.starts_with("<![CDATA["sv)) {
+      position += 9;
+      const std::size_t start = position;
+      SkipPast("]]>"sv);
+
+      if (open.empty())
+        throw std::runtime_error("Text outside of element");
+
+      text = src.substr(start, position - 3 - start);
+      cdata = true;
+      return Event::TEXT;
+    } else if (rest.starts_with("<!"sv)) {
+      SkipPast(">"sv);
+    } else if (rest.starts_with("</"sv)) {
+      position += 2;
+      ParseEndTag();
+      return Event::END_ELEMENT;
+    } else {
+      ++position;
+      ParseStartTag();
+      return Event::START_ELEMENT;
+    }
+  }
+}
+
+/**
+ * Parse a numeric entity reference (the part after "&#" up to and
+ * including the semicolon) and write its UTF-8 representation.
+ *
+ * @return the new source position
+ */
+static const char *
+UnescapeNumeric(const char *src, const char *end, char *&dest)
+{
+  int base = 10;
+  if (src < end && (*src == 'x' || *src == 'X')) {
+    base = 16;
+    ++src;
+  }
+
+  char *endptr;
+  unsigned ch = ParseUnsigned(src, &endptr, base);
+  if (endptr == src || endptr >= end || *endptr != ';')
+    throw std::runtime_error("Malformed entity reference");
+
+  if (ch == 0)
+    ch = ' ';
+
+  /* the UTF-8 sequence is always shorter than the entity reference,
+     but UnicodeToUTF8() wants 6 bytes */
+  char buffer[6];
+  const std::size_t length = UnicodeToUTF8(ch, buffer) - buffer;
+  dest = std::copy_n(buffer, length, dest);
+
+  return endptr + 1;
+}
+
+std::size_t
+UnescapeInPlace(std::span<char> s)
+{
+  static constexpr struct {
+    std::string_view name;
+    char ch;
+  } entities[] = {
+    { "lt;", '<' },
+    { "gt;", '>' },
+    { "amp;", '&' },
+    { "apos;", '\'' },
+    { "quot;", '"' },
+  };
+
+  const char *src = s.data();
+  const char *const end = src + s.size();
+  char *dest = s.data();
+
+  while (true) {
+    const char *amp = (const char *)std::memchr(src, '&', end - src);
+    if (amp == nullptr)
+      break;
+
+    dest = std::copy(src, amp, dest);
+    src = amp + 1;
+
+    if (src < end && *src == '#') {
+      src = UnescapeNumeric(src + 1, end, dest);
+      continue;
+    }
+
+    const std::string_view rest{src, std::size_t(end - src)};
+    const auto *e = std::find_if(std::begin(entities), std::end(entities),
+                                 [rest](const auto &i){
+                                   return StringStartsWithIgnoreCase(rest, i.name);
+                                 });
+    if (e == std::end(entities))
+      throw std::runtime_error("Malformed entity reference");
+
+    *dest++ = e->ch;
+    src += e->name.size();
+  }
+
+  dest = std::copy(src, end, dest);
+  return dest - s.data();
+}
+
+} // namespace XML
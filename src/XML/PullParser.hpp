@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace XML {
+
+/**
+ * A non-validating streaming XML parser.  The caller pulls one event
+ * after another with Next().  Unlike XML::ParseString(), this does not
+ * build a tree, and all strings returned by this class point into the
+ * input buffer; entity references are not resolved (see
+ * UnescapeInPlace()).
+ *
+ * XML declarations, processing instructions, comments and DOCTYPE
+ * declarations are skipped.  Whitespace around text is stripped, and
+ * whitespace-only text is not reported.
+ */
+class PullParser {
+public:
+  enum class Event {
+    START_ELEMENT,
+    END_ELEMENT,
+    TEXT,
+    END,
+  };
+
+  struct Attribute {
+    std::string_view name, value;
+  };
+
+private:
+  const std::string_view src;
+  std::size_t position = 0;
+
+  std::string_view name, text;
+
+  /**
+   * The attributes of the current #START_ELEMENT.  This buffer is
+   * reused for all elements.
+   */
+  std::vector<Attribute> attributes;
+
+  /**
+   * The names of all open elements, to check the end tags.
+   */
+  std::vector<std::string_view> open;
+
+  /**
+   * Was the current element an empty-element tag ("<foo/>")?  Then
+   * the next call returns #END_ELEMENT.
+   */
+  bool pending_end = false;
+
+  bool cdata;
+
+public:
+  explicit PullParser(std::string_view _src) noexcept
+    :src(_src)
+  {
+    /* skip the UTF-8 byte order mark */
+    if (src.starts_with("\xef\xbb\xbf"))
+      position = 3;
+  }
+
+  /**
+   * Parse the next event.
+   *
+   * Throws on syntax error.
+   */
+  Event Next();
+
+  /**
+   * The element name after #START_ELEMENT or #END_ELEMENT.
+   */
+  std::string_view GetName() const noexcept {
+    return name;
+  }
+
+  /**
+   * The attributes after #START_ELEMENT.  The values are escaped.
+   */
+  std::span<const Attribute> GetAttributes() const noexcept {
+    return attributes;
+  }
+
+  /**
+   * The text after #TEXT.  It is escaped unless IsCData() returns
+   * true.
+   */
+  std::string_view GetText() const noexcept {
+    return text;
+  }
+
+  /**
+   * Was the current #TEXT event a CDATA section?
+   */
+  bool IsCData() const noexcept {
+    return cdata;
+  }
+
+  /**
+   * The nesting depth of the current position.
+   */
+  std::size_t GetDepth() const noexcept {
+    return open.size();
+  }
+
+private:
+  void SkipWhitespace() noexcept;
+  void SkipPast(std::string_view end);
+  std::string_view ParseName();
+  void ParseStartTag();
+  void ParseEndTag();
+  bool ParseText() noexcept;
+};
+
+/**
+ * Resolve the predefined and numeric entity references in the given
+ * escaped string.  This can only shrink the string.
+ *
+ * Throws on malformed entity reference.
+ *
+ * @return the new length
+ */
+std::size_t
+UnescapeInPlace(std::span<char> s);
+
+} // namespace XML
@@ -25,6 +25,7 @@
 #include "Tracking.hpp"
 #include "Replay.hpp"
 #include "InputEvent.hpp"
+#include "Profiler.hpp"
 
 lua_State *
 Lua::NewFullState()
@@ -48,6 +49,7 @@ Lua::NewFullState()
   InitTracking(L);
   InitReplay(L);
   InitInputEvent(L);
+  InitProfiler(L);
 
   {
     SetPackagePath(L,
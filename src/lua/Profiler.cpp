@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Profiler.hpp"
+#include "Error.hxx"
+#include "MetaTable.hxx"
+#include "Util.hxx"
+#include "Profiler/Profiler.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "system/Path.hpp"
+#include "time/FloatDuration.hxx"
+#include "util/ConvertString.hpp"
+#include "util/StringAPI.hxx"
+
+extern "C" {
+#include <lauxlib.h>
+}
+
+static int
+l_profiler_index(lua_State *L)
+{
+  const char *name = lua_tostring(L, 2);
+  if (name == nullptr)
+    return 0;
+  else if (StringIsEqual(name, "enabled")) {
+    Lua::Push(L, Profiler::IsEnabled());
+  } else
+    return 0;
+
+  return 1;
+}
+
+static int
+l_profiler_enable(lua_State *L)
+{
+  if (lua_gettop(L) != 0)
+    return luaL_error(L, "Invalid parameters");
+
+  Profiler::SetEnabled(true);
+  return 0;
+}
+
+static int
+l_profiler_disable(lua_State *L)
+{
+  if (lua_gettop(L) != 0)
+    return luaL_error(L, "Invalid parameters");
+
+  Profiler::SetEnabled(false);
+  return 0;
+}
+
+static int
+l_profiler_reset(lua_State *L)
+{
+  if (lua_gettop(L) != 0)
+    return luaL_error(L, "Invalid parameters");
+
+  Profiler::Reset();
+  return 0;
+}
+
+/**
+ * Returns a table with the fields "count", "p50", "p95" and "max"
+ * (durations in seconds) for the given section.
+ */
+static int
+l_profiler_get(lua_State *L)
+{
+  if (lua_gettop(L) != 1)
+    return luaL_error(L, "Invalid parameters");
+
+  const auto section = Profiler::FindSection(luaL_checkstring(L, 1));
+  if (section == Profiler::Section::COUNT)
+    return luaL_error(L, "No such section");
+
+  const auto summary = Profiler::GetSummary(section);
+
+  lua_newtable(L);
+  Lua::SetField(L, Lua::RelativeStackIndex{-1}, "count",
+                (lua_Integer)summary.count);
+  Lua::SetField(L, Lua::RelativeStackIndex{-1}, "p50",
+                FloatDuration{summary.p50}.count());
+  Lua::SetField(L, Lua::RelativeStackIndex{-1}, "p95",
+                FloatDuration{summary.p95}.count());
+  Lua::SetField(L, Lua::RelativeStackIndex{-1}, "max",
+                FloatDuration{summary.max}.count());
+  return 1;
+}
+
+static int
+l_profiler_dump(lua_State *L)
+{
+  if (lua_gettop(L) != 1)
+    return luaL_error(L, "Invalid parameters");
+
+  const UTF8ToWideConverter filename(luaL_checkstring(L, 1));
+  if (!filename.IsValid())
+    return luaL_error(L, "Invalid path");
+
+  try {
+    FileOutputStream file{Path{filename}};
+    BufferedOutputStream buffered{file};
+    Profiler::Dump(buffered);
+    buffered.Flush();
+    file.Commit();
+  } catch (...) {
+    Lua::RaiseCurrent(L);
+  }
+
+  return 0;
+}
+
+static constexpr struct luaL_Reg profiler_funcs[] = {
+  {"enable", l_profiler_enable},
+  {"disable", l_profiler_disable},
+  {"reset", l_profiler_reset},
+  {"get", l_profiler_get},
+  {"dump", l_profiler_dump},
+  {nullptr, nullptr}
+};
+
+void
+Lua::InitProfiler(lua_State *L)
+{
+  lua_getglobal(L, "xcsoar");
+
+  lua_newtable(L);
+
+  MakeIndexMetaTableFor(L, RelativeStackIndex{-1}, l_profiler_index);
+
+  luaL_setfuncs(L, profiler_funcs, 0);
+
+  lua_setfield(L, -2, "profiler");
+
+  lua_pop(L, 1);
+}
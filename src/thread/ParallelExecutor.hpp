@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <type_traits>
+
+/**
+ * An interface for running the iterations of a loop concurrently.
+ * Users of this interface (e.g. the route planner) do not need to
+ * link with the thread library.
+ */
+class ParallelExecutor {
+public:
+  using Function = void(*)(void *ctx, unsigned i) noexcept;
+
+  /**
+   * @return the maximum number of iterations which may run at the
+   * same time
+   */
+  [[gnu::pure]]
+  virtual unsigned GetConcurrency() const noexcept = 0;
+
+  /**
+   * Invoke the function for each index in the range [0, n), possibly
+   * concurrently in other threads, and wait for all of them to
+   * finish.  The calling thread participates.
+   */
+  virtual void Run(unsigned n, Function f, void *ctx) noexcept = 0;
+
+  /**
+   * Type-safe wrapper for Run() which accepts a callable (e.g. a
+   * lambda).
+   */
+  template<typename F>
+  void ForEach(unsigned n, F &&f) noexcept {
+    Run(n, [](void *ctx, unsigned i) noexcept {
+      (*(std::remove_reference_t<F> *)ctx)(i);
+    }, const_cast<void *>(static_cast<const void *>(&f)));
+  }
+
+protected:
+  ~ParallelExecutor() noexcept = default;
+};
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#ifdef HAVE_POSIX
+#include <unistd.h>
+#else
+#include <sysinfoapi.h>
+#endif
+
+/**
+ * More threads than this do not pay off for the small jobs this class
+ * is designed for.
+ */
+static constexpr unsigned MAX_THREADS = 8;
+
+static unsigned
+GetNumberOfCPUs() noexcept
+{
+#ifdef HAVE_POSIX
+  const long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? unsigned(n) : 1U;
+#else
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return std::max(unsigned(info.dwNumberOfProcessors), 1U);
+#endif
+}
+
+WorkerPool::WorkerPool(const char *_name, unsigned max_threads) noexcept
+  :name(_name),
+   max_workers(std::min(max_threads > 0 ? max_threads : GetNumberOfCPUs(),
+                        MAX_THREADS) - 1)
+{
+}
+
+WorkerPool::~WorkerPool() noexcept
+{
+  StopWorkers();
+}
+
+void
+WorkerPool::StartWorkers() noexcept
+{
+  assert(!started);
+  started = true;
+
+  workers.reserve(max_workers);
+
+  try {
+    while (workers.size() < max_workers) {
+      auto worker = std::make_unique<Worker>(*this);
+      worker->Start();
+      workers.push_back(std::move(worker));
+    }
+  } catch (...) {
+    /* continue with the threads we have; Run() falls back to the
+       calling thread if there are none */
+  }
+}
+
+void
+WorkerPool::StopWorkers() noexcept
+{
+  {
+    const std::scoped_lock lock{mutex};
+    stop = true;
+    command_cond.notify_all();
+  }
+
+  for (auto &i : workers)
+    i->Join();
+
+  workers.clear();
+}
+
+inline void
+WorkerPool::RunItems() noexcept
+{
+  unsigned i;
+  while ((i = next_item.fetch_add(1, std::memory_order_relaxed)) < n_items)
+    function(context, i);
+}
+
+void
+WorkerPool::Run(unsigned n, Function f, void *ctx) noexcept
+{
+  if (!started && n > 1)
+    StartWorkers();
+
+  if (n <= 1 || workers.empty()) {
+    for (unsigned i = 0; i < n; ++i)
+      f(ctx, i);
+    return;
+  }
+
+  {
+    const std::scoped_lock lock{mutex};
+    assert(n_busy == 0);
+
+    function = f;
+    context = ctx;
+    n_items = n;
+    next_item.store(0, std::memory_order_relaxed);
+
+    ++generation;
+    n_busy = workers.size();
+    command_cond.notify_all();
+  }
+
+  RunItems();
+
+  std::unique_lock lock{mutex};
+  done_cond.wait(lock, [this]{ return n_busy == 0; });
+}
+
+void
+WorkerPool::WorkerRun() noexcept
+{
+  unsigned seen_generation = 0;
+
+  std::unique_lock lock{mutex};
+
+  while (true) {
+    command_cond.wait(lock, [this, seen_generation]{
+      return stop || generation != seen_generation;
+    });
+
+    if (stop)
+      break;
+
+    seen_generation = generation;
+
+    {
+      const ScopeUnlock unlock{mutex};
+      RunItems();
+    }
+
+    if (--n_busy == 0)
+      done_cond.notify_one();
+  }
+}
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "ParallelExecutor.hpp"
+#include "Thread.hpp"
+#include "Mutex.hxx"
+#include "Cond.hxx"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * A #ParallelExecutor which owns a fixed number of threads, one less
+ * than the number of CPUs (the calling thread does its share of the
+ * work).  The threads are created on the first Run() call, and run
+ * at the priority of the thread which made it (the calling thread
+ * waits for them).  If creating them fails, all iterations are run
+ * in the calling thread.
+ *
+ * Only one thread may call Run() at a time.
+ */
+class WorkerPool final : public ParallelExecutor {
+  class Worker final : public Thread {
+    WorkerPool &pool;
+
+#ifndef HAVE_POSIX
+    /**
+     * The priority of the thread which created this worker.  POSIX
+     * threads inherit it, Windows threads do not.
+     */
+    const int priority = ::GetThreadPriority(::GetCurrentThread());
+#endif
+
+  public:
+    explicit Worker(WorkerPool &_pool) noexcept
+      :Thread(_pool.name), pool(_pool) {}
+
+  protected:
+    void Run() noexcept override {
+#ifndef HAVE_POSIX
+      ::SetThreadPriority(::GetCurrentThread(), priority);
+#endif
+
+      pool.WorkerRun();
+    }
+  };
+
+  const char *const name;
+
+  /**
+   * The maximum number of #Worker threads.
+   */
+  const unsigned max_workers;
+
+  std::vector<std::unique_ptr<Worker>> workers;
+
+  bool started = false;
+
+  /**
+   * Protects #generation, #n_busy and #stop.
+   */
+  Mutex mutex;
+
+  /**
+   * #command_cond wakes up the workers, #done_cond wakes up the
+   * thread waiting in Run().
+   */
+  Cond command_cond, done_cond;
+
+  /**
+   * Incremented by each Run() call; workers compare it with the value
+   * they have seen last to detect new work.
+   */
+  unsigned generation = 0;
+
+  /**
+   * The number of workers which have not yet finished the current
+   * generation.
+   */
+  unsigned n_busy = 0;
+
+  bool stop = false;
+
+  /* the current job; only modified while no worker is busy */
+  Function function;
+  void *context;
+  unsigned n_items;
+  std::atomic_uint next_item;
+
+public:
+  /**
+   * @param max_threads the maximum number of threads including the
+   * calling thread; 0 means the number of CPUs
+   */
+  explicit WorkerPool(const char *_name, unsigned max_threads=0) noexcept;
+  ~WorkerPool() noexcept;
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  /* virtual methods from class ParallelExecutor */
+  unsigned GetConcurrency() const noexcept override {
+    return max_workers + 1;
+  }
+
+  void Run(unsigned n, Function f, void *ctx) noexcept override;
+
+private:
+  void StartWorkers() noexcept;
+  void StopWorkers() noexcept;
+
+  /**
+   * Run iterations until there are none left.
+   */
+  void RunItems() noexcept;
+
+  void WorkerRun() noexcept;
+};
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "util/StaticArray.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+/**
+ * Multiplexes periodic duties onto one timer.  Each duty has its own
+ * interval, and Run() invokes only the duties whose deadline has
+ * passed, instead of having every duty check its own clock on each
+ * timer tick.
+ *
+ * A duty which has fallen behind (e.g. because the timer was
+ * blocked by a modal dialog) runs once and is then rescheduled
+ * relative to the current time; missed invocations are not caught
+ * up.
+ *
+ * Not thread safe.
+ */
+class DutyScheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Function = void (*)() noexcept;
+
+private:
+  static constexpr std::size_t MAX_DUTIES = 16;
+
+  struct Duty {
+    Function function;
+    Clock::duration interval;
+    Clock::time_point deadline;
+  };
+
+  StaticArray<Duty, MAX_DUTIES> duties;
+
+  /**
+   * Duties whose deadline is at most this far in the future are
+   * invoked, too.  This compensates for a timer which fires slightly
+   * early, which would otherwise delay the duty by a whole tick.
+   */
+  const Clock::duration tolerance;
+
+public:
+  explicit constexpr DutyScheduler(Clock::duration _tolerance={}) noexcept
+    :tolerance(_tolerance) {}
+
+  /**
+   * Register a duty.  It is first invoked by the next Run() call.
+   * Duties which are due at the same time are invoked in the order
+   * they were added.
+   */
+  void Add(Function function, Clock::duration interval) noexcept {
+    assert(function != nullptr);
+    assert(interval.count() > 0);
+
+    duties.push_back({function, interval, Clock::time_point::min()});
+  }
+
+  /**
+   * Change the interval of a registered duty.  Its next deadline is
+   * aligned with another duty which has the same interval, so both
+   * share one timer wake-up; if there is none, the next deadline is
+   * the new interval after the previous invocation.
+   */
+  void SetInterval(Function function, Clock::duration interval) noexcept {
+    assert(interval.count() > 0);
+
+    auto i = std::find_if(duties.begin(), duties.end(),
+                          [function](const Duty &d){
+                            return d.function == function;
+                          });
+    assert(i != duties.end());
+
+    if (i->interval == interval)
+      return;
+
+    if (i->deadline != Clock::time_point::min()) {
+      auto other = std::find_if(duties.begin(), duties.end(),
+                                [interval](const Duty &d){
+                                  return d.interval == interval &&
+                                    d.deadline != Clock::time_point::min();
+                                });
+      if (other != duties.end())
+        i->deadline = other->deadline;
+      else
+        i->deadline += interval - i->interval;
+    }
+
+    i->interval = interval;
+  }
+
+  /**
+   * Invoke all duties which are due.
+   *
+   * @return the time until the next deadline
+   */
+  Clock::duration Run(Clock::time_point now) noexcept {
+    assert(!duties.empty());
+
+    auto next = Clock::time_point::max();
+
+    for (auto &i : duties) {
+      if (i.deadline <= now + tolerance) {
+        i.function();
+
+        if (i.deadline == Clock::time_point::min() ||
+            i.deadline + i.interval <= now)
+          /* first run, or fallen behind */
+          i.deadline = now + i.interval;
+        else
+          /* keep the phase */
+          i.deadline += i.interval;
+      }
+
+      next = std::min(next, i.deadline);
+    }
+
+    return next - now;
+  }
+};
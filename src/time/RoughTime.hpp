@@ -170,6 +170,8 @@ public:
   constexpr RoughTimeSpan(RoughTime _start, RoughTime _end) noexcept
     :start(_start), end(_end) {}
 
+  constexpr bool operator==(const RoughTimeSpan &other) const noexcept = default;
+
   static constexpr RoughTimeSpan Invalid() noexcept {
     return RoughTimeSpan(RoughTime::Invalid(), RoughTime::Invalid());
   }
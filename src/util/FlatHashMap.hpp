@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * A hash map with open addressing (linear probing).
+ *
+ * The entries are stored in one array in insertion order (the
+ * "arena"), and the hash table only contains indices into it.
+ * Therefore an entry is identified by a stable index which remains
+ * valid until clear(), even when the table grows.  References to
+ * entries however are invalidated by insertions.
+ *
+ * Entries cannot be removed individually.  clear() keeps all memory
+ * allocated, so a map which is cleared and refilled repeatedly stops
+ * allocating after a while.
+ */
+template<typename K, typename V,
+         typename Hash=std::hash<K>, typename KeyEqual=std::equal_to<K>>
+class FlatHashMap {
+public:
+  struct Entry {
+    K key;
+    [[no_unique_address]] V value;
+  };
+
+  static constexpr std::size_t NPOS = SIZE_MAX;
+
+private:
+  /**
+   * A hash table slot.  The hash is stored to avoid calling the
+   * #KeyEqual for most collisions and for growing the table.
+   */
+  struct Slot {
+    /**
+     * The index into #entries plus one; 0 means the slot is empty.
+     */
+    uint32_t index_plus_one;
+
+    uint32_t hash;
+  };
+
+  std::vector<Entry> entries;
+
+  /**
+   * The hash table; its size is zero or a power of two.
+   */
+  std::vector<Slot> slots;
+
+  std::size_t mask = 0;
+
+  [[no_unique_address]] Hash hasher;
+  [[no_unique_address]] KeyEqual key_equal;
+
+public:
+  FlatHashMap() noexcept = default;
+
+  [[gnu::pure]]
+  std::size_t size() const noexcept {
+    return entries.size();
+  }
+
+  [[gnu::pure]]
+  bool empty() const noexcept {
+    return entries.empty();
+  }
+
+  /**
+   * Remove all entries, but keep the memory allocated.
+   */
+  void clear() noexcept {
+    if (entries.empty())
+      return;
+
+    entries.clear();
+    std::fill(slots.begin(), slots.end(), Slot{});
+  }
+
+  void reserve(std::size_t n) {
+    entries.reserve(n);
+    if (n * 2 > slots.size())
+      Rehash(std::bit_ceil(n * 2));
+  }
+
+  Entry &operator[](std::size_t i) noexcept {
+    assert(i < entries.size());
+    return entries[i];
+  }
+
+  const Entry &operator[](std::size_t i) const noexcept {
+    assert(i < entries.size());
+    return entries[i];
+  }
+
+  /**
+   * @return the index of the entry with the given key or #NPOS
+   */
+  [[gnu::pure]]
+  std::size_t find(const K &key) const noexcept {
+    if (slots.empty())
+      return NPOS;
+
+    const uint32_t hash = Mix(key);
+    for (std::size_t s = hash & mask;; s = (s + 1) & mask) {
+      const Slot &slot = slots[s];
+      if (slot.index_plus_one == 0)
+        return NPOS;
+
+      if (slot.hash == hash &&
+          key_equal(entries[slot.index_plus_one - 1].key, key))
+        return slot.index_plus_one - 1;
+    }
+  }
+
+  /**
+   * Insert a new entry if the key does not exist yet.
+   *
+   * @return the index of the (new or existing) entry and a flag
+   * indicating whether it was inserted
+   */
+  template<typename... Args>
+  std::pair<std::size_t, bool> try_emplace(const K &key, Args&&... args) {
+    if ((entries.size() + 1) * 2 > slots.size())
+      Rehash(slots.empty() ? 64 : slots.size() * 2);
+
+    const uint32_t hash = Mix(key);
+    std::size_t s = hash & mask;
+    for (;; s = (s + 1) & mask) {
+      const Slot &slot = slots[s];
+      if (slot.index_plus_one == 0)
+        break;
+
+      if (slot.hash == hash &&
+          key_equal(entries[slot.index_plus_one - 1].key, key))
+        return {slot.index_plus_one - 1, false};
+    }
+
+    const std::size_t i = entries.size();
+    entries.push_back(Entry{key, V(std::forward<Args>(args)...)});
+    slots[s] = {uint32_t(i + 1), hash};
+    return {i, true};
+  }
+
+private:
+  /**
+   * Apply Fibonacci hashing to the user-provided hash, which may be
+   * weak in the low bits.
+   */
+  [[gnu::pure]]
+  uint32_t Mix(const K &key) const noexcept {
+    return uint32_t((uint64_t(hasher(key)) * UINT64_C(0x9e3779b97f4a7c15)) >> 32);
+  }
+
+  void Rehash(std::size_t new_size) {
+    assert(std::has_single_bit(new_size));
+
+    slots.assign(new_size, Slot{});
+    mask = new_size - 1;
+
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      const uint32_t hash = Mix(entries[i].key);
+      std::size_t s = hash & mask;
+      while (slots[s].index_plus_one != 0)
+        s = (s + 1) & mask;
+      slots[s] = {uint32_t(i + 1), hash};
+    }
+  }
+};
+
+/**
+ * A set based on #FlatHashMap.
+ */
+template<typename K, typename Hash=std::hash<K>,
+         typename KeyEqual=std::equal_to<K>>
+class FlatHashSet {
+  struct Empty {};
+
+  FlatHashMap<K, Empty, Hash, KeyEqual> map;
+
+public:
+  [[gnu::pure]]
+  std::size_t size() const noexcept {
+    return map.size();
+  }
+
+  void clear() noexcept {
+    map.clear();
+  }
+
+  void reserve(std::size_t n) {
+    map.reserve(n);
+  }
+
+  [[gnu::pure]]
+  bool contains(const K &key) const noexcept {
+    return map.find(key) != map.NPOS;
+  }
+
+  /**
+   * @return true if the key was inserted, false if it existed
+   * already
+   */
+  bool insert(const K &key) {
+    return map.try_emplace(key).second;
+  }
+};
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+/**
+ * A fixed-size FIFO queue which, when it overflows, drops every
+ * second item instead of the oldest one.  The items which remain
+ * are spread over the whole period, which suits a track that could
+ * not be transmitted: it loses resolution, but not its beginning.
+ * The first and the last item are always kept.
+ *
+ * Not thread safe.
+ */
+template<class T, std::size_t N>
+class ThinningQueue {
+  static_assert(N >= 3);
+
+  std::array<T, N> data;
+
+  std::size_t head = 0, n = 0;
+
+  T &At(std::size_t i) noexcept {
+    return data[(head + i) % N];
+  }
+
+  const T &At(std::size_t i) const noexcept {
+    return data[(head + i) % N];
+  }
+
+public:
+  constexpr bool empty() const noexcept {
+    return n == 0;
+  }
+
+  constexpr bool full() const noexcept {
+    return n == N;
+  }
+
+  constexpr std::size_t size() const noexcept {
+    return n;
+  }
+
+  void clear() noexcept {
+    head = n = 0;
+  }
+
+  const T &front() const noexcept {
+    assert(!empty());
+
+    return At(0);
+  }
+
+  const T &back() const noexcept {
+    assert(!empty());
+
+    return At(n - 1);
+  }
+
+  const T &operator[](std::size_t i) const noexcept {
+    assert(i < n);
+
+    return At(i);
+  }
+
+  void push_back(const T &value) noexcept {
+    if (full())
+      Thin();
+
+    At(n++) = value;
+  }
+
+  void pop_front() noexcept {
+    assert(!empty());
+
+    head = (head + 1) % N;
+    --n;
+  }
+
+  /**
+   * Drop every second item, keeping the first and the last one.
+   */
+  void Thin() noexcept {
+    if (n < 3)
+      return;
+
+    std::size_t dest = 1;
+    for (std::size_t i = 2; i < n - 1; i += 2)
+      At(dest++) = At(i);
+
+    At(dest++) = At(n - 1);
+    n = dest;
+  }
+};
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> n_allocations{0}, n_allocated_bytes{0};
+
+void *
+operator new(std::size_t size)
+{
+  n_allocations.fetch_add(1, std::memory_order_relaxed);
+  n_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+  void *p = malloc(size > 0 ? size : 1);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+
+void
+operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+void
+operator delete(void *p, std::size_t) noexcept
+{
+  free(p);
+}
+
+uint64_t
+AllocationCounter::GetCount() noexcept
+{
+  return n_allocations.load(std::memory_order_relaxed);
+}
+
+uint64_t
+AllocationCounter::GetBytes() noexcept
+{
+  return n_allocated_bytes.load(std::memory_order_relaxed);
+}
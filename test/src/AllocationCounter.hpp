@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Linking AllocationCounter.cpp into a program replaces the global
+ * operator new with one which counts all heap allocations.  This is
+ * used by tests and benchmarks which verify that a code path does not
+ * allocate.
+ */
+namespace AllocationCounter {
+
+/**
+ * The number of allocations since the program was started.
+ */
+uint64_t
+GetCount() noexcept;
+
+/**
+ * The number of bytes allocated since the program was started.
+ */
+uint64_t
+GetBytes() noexcept;
+
+} // namespace AllocationCounter
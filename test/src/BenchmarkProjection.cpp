@@ -2,8 +2,12 @@
 // Copyright The XCSoar Project
 
 #include "Projection/Projection.hpp"
+#include "Geo/Math.hpp"
+#include "Geo/PreparedGeoPoint.hpp"
 #include "Screen/Layout.hpp"
 
+#include <string_view>
+
 unsigned Layout::scale_1024 = 1024;
 
 class TestProjection : public Projection {
@@ -16,12 +20,11 @@ public:
   }
 };
 
-int main()
+static long
+BenchmarkGeoToScreen(const GeoPoint &gp)
 {
   TestProjection projection;
 
-  GeoPoint gp = GeoPoint(Angle::Degrees(7.7061111111111114),
-                         Angle::Degrees(51.051944444444445));
   long x = 0, y = 0;
   for (unsigned i = 64 * 1024 * 1024; i-- > 0;) {
     auto rp = projection.GeoToScreen(gp);
@@ -33,3 +36,74 @@ int main()
 
   return x + y;
 }
+
+static constexpr unsigned N_LOCATIONS = 256;
+static constexpr unsigned N_DISTANCE_ITERATIONS = 4 * 1024;
+
+static void
+MakeLocations(const GeoPoint &origin, GeoPoint *locations)
+{
+  for (unsigned i = 0; i < N_LOCATIONS; ++i)
+    locations[i] = GeoPoint(origin.longitude + Angle::Degrees(0.01 * i),
+                            origin.latitude + Angle::Degrees(0.007 * i));
+}
+
+/**
+ * Distances and bearings from one origin, one pair at a time.
+ */
+static long
+BenchmarkDistance(const GeoPoint &origin)
+{
+  GeoPoint locations[N_LOCATIONS];
+  MakeLocations(origin, locations);
+
+  double sum = 0;
+  for (unsigned i = N_DISTANCE_ITERATIONS; i-- > 0;) {
+    for (const auto &location : locations) {
+      double distance;
+      Angle bearing;
+      DistanceBearing(origin, location, &distance, &bearing);
+      sum += distance + bearing.Native();
+    }
+  }
+
+  return (long)sum;
+}
+
+/**
+ * Like BenchmarkDistance(), but with a prepared origin.
+ */
+static long
+BenchmarkPreparedDistance(const GeoPoint &_origin)
+{
+  GeoPoint locations[N_LOCATIONS];
+  MakeLocations(_origin, locations);
+
+  double sum = 0;
+  for (unsigned i = N_DISTANCE_ITERATIONS; i-- > 0;) {
+    const PreparedGeoPoint origin{_origin};
+
+    for (const auto &location : locations) {
+      double distance;
+      Angle bearing;
+      DistanceBearing(origin, location, &distance, &bearing);
+      sum += distance + bearing.Native();
+    }
+  }
+
+  return (long)sum;
+}
+
+int main(int argc, char **argv)
+{
+  const GeoPoint gp = GeoPoint(Angle::Degrees(7.7061111111111114),
+                               Angle::Degrees(51.051944444444445));
+
+  const std::string_view mode = argc > 1 ? argv[1] : "";
+  if (mode == "distance")
+    return BenchmarkDistance(gp) == 0;
+  else if (mode == "prepared")
+    return BenchmarkPreparedDistance(gp) == 0;
+  else
+    return BenchmarkGeoToScreen(gp);
+}
@@ -5,10 +5,11 @@
 #include "io/FileLineReader.hpp"
 #include "IGC/IGCParser.hpp"
 #include "IGC/IGCFix.hpp"
+#include "IGC/IGCEvent.hpp"
 #include "Units/System.hpp"
 #include "system/Path.hpp"
 
-DebugReplay*
+DebugReplayIGC *
 DebugReplayIGC::Create(Path input_file)
 {
   FileLineReaderA *reader = new FileLineReaderA(input_file);
@@ -19,6 +20,7 @@ bool
 DebugReplayIGC::Next()
 {
   last_basic = computed_basic;
+  pilot_event_time = BrokenTime::Invalid();
 
   const char *line;
   while ((line = reader->ReadLine()) != NULL) {
@@ -39,6 +41,10 @@ DebugReplayIGC::Next()
       }
     } else if (line[0] == 'I') {
       IGCParseExtensions(line, extensions);
+    } else if (line[0] == 'E') {
+      IGCEvent event;
+      if (IGCParseEvent(line, event) && event.IsPilotEvent())
+        pilot_event_time = event.time;
     }
   }
 
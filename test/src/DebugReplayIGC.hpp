@@ -6,22 +6,40 @@
 #include "DebugReplayFile.hpp"
 #include "IGC/IGCExtensions.hpp"
 #include "io/FileLineReader.hpp"
+#include "time/BrokenTime.hpp"
 
 struct IGCFix;
 
 class DebugReplayIGC : public DebugReplayFile {
   IGCExtensions extensions;
 
+  /**
+   * The time of the last pilot event ("PEV" E record) which was read
+   * since the previous fix, or BrokenTime::Invalid().
+   */
+  BrokenTime pilot_event_time;
+
 private:
   DebugReplayIGC(FileLineReaderA *_reader)
-    : DebugReplayFile(_reader) {
+    : DebugReplayFile(_reader), pilot_event_time(BrokenTime::Invalid()) {
     extensions.clear();
   }
 
 public:
   virtual bool Next();
 
-  static DebugReplay *Create(Path input_file);
+  /**
+   * Was a pilot event recorded right before the current fix?
+   */
+  bool HasPilotEvent() const {
+    return pilot_event_time.IsPlausible();
+  }
+
+  const BrokenTime &GetPilotEventTime() const {
+    return pilot_event_time;
+  }
+
+  static DebugReplayIGC *Create(Path input_file);
 
 protected:
   void CopyFromFix(const IGCFix &fix);
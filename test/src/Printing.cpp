@@ -126,11 +126,8 @@ PrintHelper::print(const ReachFan& r)
 
 void
 PrintHelper::print(const FlatTriangleFanTree& r) {
-  print((const FlatTriangleFan&)r, r.depth);
-
-  for (auto it = r.children.begin(); it != r.children.end(); ++it) {
-    print(*it);
-  }
+  for (unsigned i = 0; i < r.n_nodes; ++i)
+    print(r.nodes[i].fan, r.nodes[i].depth);
 };
 
 void
@@ -80,6 +80,8 @@ Main([[maybe_unused]] TestMainWindow &main_window)
     airspace_warning.GetWarning(it->GetAirspacePtr())
       .UpdateSolution((AirspaceWarning::State)i, ais);
 
+  airspace_warnings->PublishSnapshot(airspace_warning);
+
   dlgAirspaceWarningsShowModal(*airspace_warnings);
 
   delete airspace_warnings;
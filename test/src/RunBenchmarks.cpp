@@ -0,0 +1,583 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Runs fixed input data through the hot code paths of the engine and
+ * prints one JSON object per benchmark: wall clock timings and the
+ * number of heap allocations.  "make bench" runs it on the files in
+ * test/data; the output is meant to be compared between commits.
+ */
+
+#include "IGC/IGCParser.hpp"
+#include "IGC/IGCFix.hpp"
+#include "IGC/IGCExtensions.hpp"
+#include "io/FileLineReader.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Trace/Vector.hpp"
+#include "Engine/Contest/ContestManager.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "Engine/Airspace/AirspaceWarningConfig.hpp"
+#include "Engine/Airspace/Predicate/AirspacePredicate.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/GlideSolvers/GlideSettings.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Engine/Route/Config.hpp"
+#include "Engine/Task/Stats/TaskStats.hpp"
+#include "Route/TerrainRoute.hpp"
+#include "Route/AirspaceRoute.hpp"
+#include "Route/ReachFan.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "Geo/GeoVector.hpp"
+#include "Operation/Operation.hpp"
+#include "thread/SharedMutex.hpp"
+#include "thread/WorkerPool.hpp"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringAPI.hxx"
+#include "util/StringCompare.hxx"
+#include "AllocationCounter.hpp"
+
+#include <zzip/zzip.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+
+using namespace std::chrono;
+
+/**
+ * The IGC files from test/data which are replayed by the trace and
+ * contest benchmarks.
+ */
+static constexpr const char *igc_files[] = {
+  "01lz1hq1.igc",
+  "0asljd01.igc",
+  "9crx3101.igc",
+  "apf-bug554.igc",
+};
+
+static constexpr char terrain_file[] = "benalla9.xcm";
+
+static unsigned iterations = 5;
+static const char *filter = nullptr;
+
+/**
+ * Time the given function and print one line of JSON.  The first
+ * call is not measured; it warms up caches and lazy
+ * initialisation.
+ */
+template<typename F>
+static void
+Run(const char *name, F &&f)
+{
+  if (filter != nullptr && StringFind(name, filter) == nullptr)
+    return;
+
+  f();
+
+  steady_clock::duration total{}, best = steady_clock::duration::max();
+
+  const uint64_t allocations_before = AllocationCounter::GetCount();
+  const uint64_t bytes_before = AllocationCounter::GetBytes();
+
+  for (unsigned i = 0; i < iterations; ++i) {
+    const auto start = steady_clock::now();
+    f();
+    const auto duration = steady_clock::now() - start;
+
+    total += duration;
+    best = std::min(best, duration);
+  }
+
+  const uint64_t allocations = AllocationCounter::GetCount() - allocations_before;
+  const uint64_t bytes = AllocationCounter::GetBytes() - bytes_before;
+
+  printf("{\"benchmark\": \"%s\", \"iterations\": %u"
+         ", \"mean_us\": %.1f, \"min_us\": %.1f"
+         ", \"allocations\": %.1f, \"allocated_bytes\": %.1f}\n",
+         name, iterations,
+         duration_cast<duration<double, std::micro>>(total).count() / iterations,
+         duration_cast<duration<double, std::micro>>(best).count(),
+         double(allocations) / iterations,
+         double(bytes) / iterations);
+  fflush(stdout);
+}
+
+static std::vector<TracePoint>
+LoadIGC(Path path)
+{
+  FileLineReaderA reader(path);
+
+  IGCExtensions extensions;
+  extensions.clear();
+
+  std::vector<TracePoint> points;
+
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    if (*line == 'I') {
+      IGCParseExtensions(line, extensions);
+      continue;
+    }
+
+    IGCFix fix;
+    if (!IGCParseFix(line, extensions, fix) || !fix.gps_valid)
+      continue;
+
+    const auto altitude = fix.pressure_altitude != 0
+      ? fix.pressure_altitude
+      : fix.gps_altitude;
+
+    points.emplace_back(fix.location,
+                        duration_cast<duration<unsigned>>(fix.time.DurationSinceMidnight()),
+                        altitude, 0, 0);
+  }
+
+  /* the contest solvers expect monotonic time */
+  auto i = std::is_sorted_until(points.begin(), points.end(),
+                                [](const TracePoint &a, const TracePoint &b){
+                                  return a.GetTime() < b.GetTime();
+                                });
+  points.erase(i, points.end());
+
+  return points;
+}
+
+static void
+BenchmarkTrace(const std::vector<std::vector<TracePoint>> &flights)
+{
+  Run("trace_thinning", [&flights](){
+    for (const auto &flight : flights) {
+      Trace trace({}, Trace::null_time, 512);
+      for (const auto &point : flight)
+        trace.push_back(point);
+
+      TracePointVector v;
+      trace.GetPoints(v);
+    }
+  });
+}
+
+static void
+BenchmarkContest(const std::vector<std::vector<TracePoint>> &flights,
+                 const char *name, Contest contest)
+{
+  Run(name, [&flights, contest](){
+    for (const auto &flight : flights) {
+      Trace full_trace({}, Trace::null_time, 512);
+      Trace triangle_trace({}, Trace::null_time, 1024);
+      Trace sprint_trace({}, minutes{150}, 128);
+
+      for (const auto &point : flight) {
+        full_trace.push_back(point);
+        triangle_trace.push_back(point);
+        sprint_trace.push_back(point);
+      }
+
+      ContestManager manager(contest,
+                             full_trace, triangle_trace, sprint_trace);
+      manager.SolveExhaustive();
+    }
+  });
+}
+
+/**
+ * Generate a reproducible set of airspaces around the given location.
+ */
+static void
+GenerateAirspaces(Airspaces &airspaces, GeoPoint center, unsigned n)
+{
+  std::minstd_rand rng(42);
+  std::uniform_real_distribution<double> offset(-1.5, 1.5);
+  std::uniform_real_distribution<double> radius(2000, 20000);
+  std::uniform_real_distribution<double> altitude(0, 4000);
+
+  for (unsigned i = 0; i < n; ++i) {
+    const GeoPoint c(center.longitude + Angle::Degrees(offset(rng)),
+                     center.latitude + Angle::Degrees(offset(rng)));
+
+    std::shared_ptr<AbstractAirspace> airspace;
+    if (i % 4 != 0) {
+      airspace = std::make_shared<AirspaceCircle>(c, radius(rng));
+    } else {
+      const double r = radius(rng);
+      std::vector<GeoPoint> points;
+      for (unsigned j = 0; j < 12; ++j) {
+        const Angle a = Angle::FullCircle() * j / 12;
+        points.push_back(GeoVector(r * (1 + (j % 3) * 0.2), a).EndPoint(c));
+      }
+
+      airspace = std::make_shared<AirspacePolygon>(points);
+    }
+
+    AirspaceAltitude base, top;
+    base.reference = top.reference = AltitudeReference::MSL;
+    base.altitude = altitude(rng);
+    top.altitude = base.altitude + 2000;
+    airspace->SetProperties(_T("Benchmark"), AirspaceClass(i % 14), {},
+                            base, top);
+
+    airspaces.Add(std::move(airspace));
+  }
+
+  airspaces.Optimise();
+}
+
+static void
+BenchmarkAirspaceWarnings()
+{
+  const GeoPoint center(Angle::Degrees(146.), Angle::Degrees(-36.));
+
+  Airspaces airspaces;
+  GenerateAirspaces(airspaces, center, 20000);
+
+  AirspaceWarningConfig config;
+  config.SetDefaults();
+
+  const GlidePolar glide_polar(1);
+
+  TaskStats task_stats;
+  task_stats.reset();
+
+  Run("airspace_warnings", [&](){
+    AirspaceWarningManager warnings(config, airspaces);
+
+    AircraftState state;
+    state.Reset();
+    state.location = center;
+    state.altitude = 1500;
+    state.ground_speed = 30;
+    state.track = Angle::Degrees(45);
+    state.time = TimeStamp{hours{12}};
+    state.flying = true;
+
+    warnings.Reset(state);
+
+    /* fly a straight line for 10 minutes */
+    for (unsigned i = 0; i < 600; ++i) {
+      state.location = GeoVector(state.ground_speed, state.track)
+        .EndPoint(state.location);
+      state.time += seconds{1};
+      warnings.Update(state, glide_polar, task_stats, false, seconds{1});
+    }
+  });
+}
+
+/**
+ * Builds the airspace visibility graph synchronously, like
+ * #AirspaceRoute without a builder, but measures how long that takes,
+ * because the application does it in a background thread.
+ */
+class TimingVisibilityGraphBuilder final
+  : public AirspaceVisibilityGraphBuilder {
+  unsigned serial = 0;
+  std::shared_ptr<const AirspaceVisibilityGraph> graph;
+
+public:
+  unsigned n_builds = 0;
+  steady_clock::duration build_duration{};
+
+  void Start(unsigned _serial,
+             AirspaceVisibilityGraph::Obstacles &&obstacles) noexcept override {
+    const auto start = steady_clock::now();
+    graph = std::make_shared<const AirspaceVisibilityGraph>(std::move(obstacles));
+    build_duration += steady_clock::now() - start;
+    ++n_builds;
+    serial = _serial;
+  }
+
+  std::shared_ptr<const AirspaceVisibilityGraph> Get(unsigned _serial) noexcept override {
+    return _serial == serial ? graph : nullptr;
+  }
+};
+
+/**
+ * Solve routes from an aircraft approaching a fixed destination
+ * through airspace, with and without the visibility graph.  The graph
+ * is built synchronously by Synchronise(), so its cost is included;
+ * the time spent in Solve() alone, which is what remains on the
+ * calculation thread when the graph is built in background, is
+ * printed separately along with the cost and size of the graph.
+ */
+static void
+BenchmarkAirspaceRoute()
+{
+  const GeoPoint center(Angle::Degrees(146.), Angle::Degrees(-36.));
+
+  /* sparse enough that most of the routes can be solved */
+  Airspaces airspaces;
+  GenerateAirspaces(airspaces, center, 1000);
+
+  GlideSettings settings;
+  settings.SetDefaults();
+  RoutePlannerConfig config;
+  config.SetDefaults();
+  config.mode = RoutePlannerConfig::Mode::AIRSPACE;
+
+  const GlidePolar polar(1);
+  const SpeedVector wind(Angle::Degrees(0), 0);
+
+  const AGeoPoint destination(GeoVector(30000, Angle::Degrees(60))
+                              .EndPoint(center), 1000);
+
+  for (const bool graph : {true, false}) {
+    const char *const name = graph ? "route_airspace" : "route_airspace_search";
+
+    TimingVisibilityGraphBuilder builder;
+    AirspaceRoute route;
+    route.UpdatePolar(settings, config, polar, polar, wind);
+    route.SetVisibilityGraphBuilder(&builder);
+    route.SetVisibilityGraphEnabled(graph);
+
+    unsigned n_runs = 0, n_solves = 0, n_solved = 0;
+    steady_clock::duration solve_duration{};
+
+    Run(name, [&](){
+      route.Reset();
+      ++n_runs;
+
+      for (unsigned i = 0; i < 60; ++i) {
+        const AGeoPoint origin(GeoVector(30000 - 300 * i, Angle::Degrees(240))
+                               .EndPoint(center), 1500);
+        route.Synchronise(airspaces, AirspacePredicateTrue,
+                          origin, destination);
+
+        const auto start = steady_clock::now();
+        if (route.Solve(origin, destination, config))
+          ++n_solved;
+        solve_duration += steady_clock::now() - start;
+        ++n_solves;
+      }
+    });
+
+    if (n_runs == 0)
+      /* filtered */
+      continue;
+
+    printf("{\"benchmark\": \"%s\", \"solved\": %u, \"solves\": %u"
+           ", \"solve_us\": %.1f",
+           name, n_solved, n_solves,
+           duration<double, std::micro>(solve_duration).count() / n_runs);
+
+    if (const auto *visibility = route.GetVisibilityGraph())
+      printf(", \"visibility_builds\": %u, \"visibility_build_us\": %.1f"
+             ", \"visibility_vertices\": %u, \"visibility_edges\": %u",
+             builder.n_builds,
+             duration<double, std::micro>(builder.build_duration).count() /
+             builder.n_builds,
+             visibility->GetVertexCount(), visibility->GetEdgeCount());
+
+    printf("}\n");
+  }
+}
+
+static bool
+LoadTerrain(RasterMap &map, Path path)
+{
+  ZZIP_DIR *dir = zzip_dir_open(path.c_str(), nullptr);
+  if (dir == nullptr)
+    return false;
+
+  {
+    NullOperationEnvironment operation;
+    LoadTerrainOverview(dir, map.GetTileCache(), operation);
+  }
+
+  map.UpdateProjection();
+
+  SharedMutex mutex;
+  do {
+    UpdateTerrainTiles(dir, map.GetTileCache(), mutex,
+                       map.GetProjection(),
+                       map.GetMapCenter(), 50000);
+  } while (map.IsDirty());
+
+  zzip_dir_close(dir);
+  return true;
+}
+
+static void
+BenchmarkTerrain(Path path)
+{
+  Run("terrain_load", [path](){
+    RasterMap map;
+    LoadTerrain(map, path);
+  });
+
+  RasterMap map;
+  if (!LoadTerrain(map, path)) {
+    fprintf(stderr, "Failed to open %s\n", path.c_str());
+    return;
+  }
+
+  const GeoPoint origin = map.GetMapCenter();
+
+  Run("terrain_scan", [&map, origin](){
+    int sum = 0;
+    for (unsigned i = 0; i < 256; ++i) {
+      for (unsigned j = 0; j < 256; ++j) {
+        const GeoPoint p(origin.longitude + Angle::Degrees((i / 255. - 0.5) * 1.2),
+                         origin.latitude + Angle::Degrees((j / 255. - 0.5) * 1.2));
+        sum += map.GetInterpolatedHeight(p).GetValueOr0();
+      }
+    }
+
+    /* prevent the compiler from optimizing the loop away */
+    if (sum == INT_MIN)
+      abort();
+  });
+
+  GlideSettings settings;
+  settings.SetDefaults();
+  RoutePlannerConfig config;
+  config.SetDefaults();
+
+  const GlidePolar polar(0.1);
+  const SpeedVector wind(Angle::Degrees(0), 0);
+
+  TerrainRoute route;
+  route.UpdatePolar(settings, config, polar, polar, wind, 0);
+  route.SetTerrain(&map);
+
+  const AGeoPoint aorigin(origin,
+                          map.GetHeight(origin).GetValueOr0() + 1000);
+
+  /* the route planner in all directions; the destinations differ, so
+     each Solve() call does a full search */
+  Run("route_terrain", [&route, &config, &map, aorigin](){
+    RoutePlannerConfig route_config = config;
+    route_config.mode = RoutePlannerConfig::Mode::BOTH;
+
+    for (unsigned i = 0; i < 16; ++i) {
+      const GeoPoint dest =
+        GeoVector(40000, Angle::FullCircle() * (i / 16.)).EndPoint(aorigin);
+      route.Solve(AGeoPoint(aorigin, aorigin.altitude - 900),
+                  AGeoPoint(dest, map.GetHeight(dest).GetValueOr0() + 100),
+                  route_config);
+    }
+  });
+
+  ReachFan reach;
+
+  Run("reach", [&route, &config, aorigin, &reach](){
+    route.ClearReachReference();
+    route.SolveReach(aorigin, config, INT_MAX, true, false, reach);
+  });
+
+  Run("reach_working", [&route, &config, aorigin, &reach](){
+    route.ClearReachReference();
+    route.SolveReach(aorigin, config, INT_MAX, true, true, reach);
+  });
+
+  /* a straight glide at 30 m/s with 1 m/s sink, one solution per
+     second, as done by the calculation thread */
+  Run("reach_track", [&route, &config, aorigin, &reach](){
+    route.ClearReachReference();
+
+    AGeoPoint p = aorigin;
+    for (unsigned i = 0; i < 60; ++i) {
+      route.SolveReach(p, config, INT_MAX, true, false, reach);
+      p = AGeoPoint(GeoVector(30, Angle::Degrees(90)).EndPoint(p),
+                    p.altitude - 1);
+    }
+  });
+
+  /* the same with turning reach, which searches gap fans; once with
+     and once without the reference solution */
+  RoutePlannerConfig turning_config = config;
+  turning_config.reach_calc_mode = RoutePlannerConfig::ReachMode::TURNING;
+
+  Run("reach_turning_track", [&route, &turning_config, aorigin, &reach](){
+    route.ClearReachReference();
+
+    AGeoPoint p = aorigin;
+    for (unsigned i = 0; i < 60; ++i) {
+      route.SolveReach(p, turning_config, INT_MAX, true, false, reach);
+      p = AGeoPoint(GeoVector(30, Angle::Degrees(90)).EndPoint(p),
+                    p.altitude - 1);
+    }
+  });
+
+  Run("reach_turning_track_full", [&route, &turning_config, aorigin, &reach](){
+    AGeoPoint p = aorigin;
+    for (unsigned i = 0; i < 60; ++i) {
+      route.ClearReachReference();
+      route.SolveReach(p, turning_config, INT_MAX, true, false, reach);
+      p = AGeoPoint(GeoVector(30, Angle::Degrees(90)).EndPoint(p),
+                    p.altitude - 1);
+    }
+  });
+
+  WorkerPool pool{"Reach"};
+  route.SetParallelExecutor(&pool);
+
+  Run("reach_parallel", [&route, &config, aorigin, &reach](){
+    route.ClearReachReference();
+    route.SolveReach(aorigin, config, INT_MAX, true, false, reach);
+  });
+
+  route.SetParallelExecutor(nullptr);
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "[options] [DATADIR]\n"
+            "Options:\n"
+            "  --iterations=N           Number of measured runs per benchmark (default = 5)\n"
+            "  --filter=STRING          Run only benchmarks whose name contains STRING");
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--iterations=")) != nullptr) {
+      iterations = strtoul(value, nullptr, 10);
+      if (iterations == 0)
+        args.UsageError();
+    } else if ((value = StringAfterPrefix(arg, "--filter=")) != nullptr) {
+      filter = value;
+    } else {
+      args.UsageError();
+    }
+  }
+
+  const char *data_dir = args.IsEmpty() ? "test/data" : args.GetNext();
+  args.ExpectEnd();
+
+  const AllocatedPath data_path{data_dir};
+
+  std::vector<std::vector<TracePoint>> flights;
+  for (const char *name : igc_files)
+    flights.emplace_back(LoadIGC(AllocatedPath::Build(data_path, name)));
+
+  BenchmarkTrace(flights);
+  BenchmarkContest(flights, "contest_olc_plus", Contest::OLC_PLUS);
+  BenchmarkContest(flights, "contest_dmst", Contest::DMST);
+  BenchmarkContest(flights, "contest_weglide_free", Contest::WEGLIDE_FREE);
+  BenchmarkAirspaceWarnings();
+  BenchmarkAirspaceRoute();
+  BenchmarkTerrain(AllocatedPath::Build(data_path, terrain_file));
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,366 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Simulate many SkyLines tracking clients sending fixes, traffic
+ * requests and pings to one server, and report the throughput and
+ * the ping/ACK round trip time.
+ *
+ * With --server=PROGRAM, the given xcsoar-cloud-server binary is
+ * launched on localhost once for each thread count in --threads, so
+ * the throughput can be compared between them.
+ */
+
+#include "Tracking/SkyLines/Client.hpp"
+#include "Tracking/SkyLines/Handler.hpp"
+#include "Tracking/SkyLines/Assemble.hpp"
+#include "Tracking/SkyLines/Protocol.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "net/Resolver.hxx"
+#include "net/AddressInfo.hxx"
+#include "system/Args.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "event/Loop.hxx"
+#include "event/FineTimerEvent.hxx"
+#include "util/NumberParser.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringCompare.hxx"
+#include "util/IterableSplitString.hxx"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+
+#ifdef HAVE_POSIX
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace std::chrono;
+
+/**
+ * The timer resolution; each tick serves a slice of the clients.
+ */
+static constexpr auto TICK = milliseconds(10);
+
+struct Statistics {
+  unsigned long n_fixes = 0, n_traffic_requests = 0, n_pings = 0;
+
+  unsigned long n_acks = 0, n_traffic = 0;
+
+  std::vector<steady_clock::duration> latencies;
+};
+
+class LoadClient final : public SkyLinesTracking::Handler {
+  Statistics &statistics;
+
+  SkyLinesTracking::Client client;
+
+  const GeoPoint origin;
+
+  uint16_t ping_id = 0;
+  steady_clock::time_point ping_time;
+
+  unsigned n_fixes = 0;
+
+public:
+  LoadClient(EventLoop &event_loop, Statistics &_statistics,
+             uint64_t key, GeoPoint _origin) noexcept
+    :statistics(_statistics), client(event_loop, this), origin(_origin) {
+    client.SetKey(key);
+  }
+
+  void Open(SocketAddress address) {
+    client.Open(address);
+  }
+
+  void Send() noexcept {
+    const GeoPoint location(origin.longitude + Angle::Degrees(0.001 * n_fixes),
+                            origin.latitude);
+
+    using SkyLinesTracking::FixPacket;
+    if (client.SendPacket(SkyLinesTracking::MakeFix(client.GetKey(),
+                                                    FixPacket::FLAG_LOCATION|
+                                                    FixPacket::FLAG_ALTITUDE,
+                                                    n_fixes * 1000, location,
+                                                    Angle::Zero(),
+                                                    0, 0, 1000, 0, 0)))
+      ++statistics.n_fixes;
+
+    ++n_fixes;
+
+    client.SendTrafficRequest(false, false, true);
+    ++statistics.n_traffic_requests;
+
+    ping_time = steady_clock::now();
+    if (client.SendPacket(SkyLinesTracking::MakePing(client.GetKey(),
+                                                     ++ping_id)))
+      ++statistics.n_pings;
+  }
+
+  /* virtual methods from SkyLinesTracking::Handler */
+  void OnAck(unsigned id) override {
+    if (id != ping_id)
+      /* late ACK for an older ping */
+      return;
+
+    ++statistics.n_acks;
+    statistics.latencies.push_back(steady_clock::now() - ping_time);
+  }
+
+  void OnTraffic(uint32_t, unsigned, const ::GeoPoint &, int) override {
+    ++statistics.n_traffic;
+  }
+
+  void OnSkyLinesError(std::exception_ptr e) override {
+    PrintException(e);
+  }
+};
+
+class LoadGenerator {
+  EventLoop &event_loop;
+
+  Statistics statistics;
+
+  std::vector<std::unique_ptr<LoadClient>> clients;
+
+  /**
+   * The number of timer ticks in which all clients send once.
+   */
+  const unsigned ticks_per_period;
+
+  FineTimerEvent tick_timer{event_loop, BIND_THIS_METHOD(OnTick)};
+  FineTimerEvent stop_timer{event_loop, BIND_THIS_METHOD(OnStop)};
+
+  unsigned tick = 0;
+
+public:
+  /**
+   * @param rate the number of times per second each client sends
+   */
+  LoadGenerator(EventLoop &_event_loop, SocketAddress address,
+                unsigned n_clients, unsigned rate) noexcept
+    :event_loop(_event_loop),
+     ticks_per_period(std::max(1u, unsigned(seconds(1) / TICK / rate))) {
+    clients.reserve(n_clients);
+
+    /* spread the clients over an area larger than the server's
+       traffic range, so the range queries return a few neighbours
+       each */
+    for (unsigned i = 0; i < n_clients; ++i) {
+      const GeoPoint origin(Angle::Degrees(7 + 0.01 * (i % 100)),
+                            Angle::Degrees(50 + 0.01 * (i / 100)));
+      auto &c = clients.emplace_back(std::make_unique<LoadClient>(event_loop,
+                                                                 statistics,
+                                                                 0x10000 + i,
+                                                                 origin));
+      c->Open(address);
+    }
+  }
+
+  void Start(steady_clock::duration run_time) noexcept {
+    tick_timer.Schedule(TICK);
+    stop_timer.Schedule(run_time);
+  }
+
+  void Report(steady_clock::duration run_time) noexcept {
+    auto &l = statistics.latencies;
+    std::sort(l.begin(), l.end());
+
+    const auto Percentile = [&l](unsigned p){
+      return l.empty()
+        ? 0.
+        : duration_cast<duration<double, std::micro>>(l[(l.size() - 1) * p / 100]).count();
+    };
+
+    const double seconds = duration_cast<duration<double>>(run_time).count();
+
+    const unsigned long n_sent = statistics.n_fixes +
+      statistics.n_traffic_requests + statistics.n_pings;
+
+    printf("clients=%zu fixes=%lu traffic_requests=%lu pings=%lu"
+           " acks=%lu traffic=%lu\n",
+           clients.size(), statistics.n_fixes,
+           statistics.n_traffic_requests, statistics.n_pings,
+           statistics.n_acks, statistics.n_traffic);
+    printf("throughput=%.0f packets/s acked=%.0f/s (%.1f%%)\n",
+           n_sent / seconds, statistics.n_acks / seconds,
+           statistics.n_pings > 0
+           ? 100. * statistics.n_acks / statistics.n_pings
+           : 0.);
+    printf("latency p50=%.0fus p99=%.0fus max=%.0fus\n",
+           Percentile(50), Percentile(99), Percentile(100));
+    fflush(stdout);
+  }
+
+private:
+  void OnTick() noexcept {
+    const std::size_t n = clients.size();
+    const std::size_t begin = n * tick / ticks_per_period;
+    const std::size_t end = n * (tick + 1) / ticks_per_period;
+
+    for (std::size_t i = begin; i < end; ++i)
+      clients[i]->Send();
+
+    tick = (tick + 1) % ticks_per_period;
+    tick_timer.Schedule(TICK);
+  }
+
+  void OnStop() noexcept {
+    tick_timer.Cancel();
+    event_loop.Break();
+  }
+};
+
+static void
+RunLoad(SocketAddress address, unsigned n_clients, unsigned rate,
+        steady_clock::duration run_time)
+{
+  EventLoop event_loop;
+
+  LoadGenerator generator(event_loop, address, n_clients, rate);
+
+  generator.Start(run_time);
+  event_loop.Run();
+
+  generator.Report(run_time);
+}
+
+#ifdef HAVE_POSIX
+
+/**
+ * Launches a cloud server process, and terminates it in the
+ * destructor.
+ */
+class ServerProcess {
+  pid_t pid;
+
+public:
+  ServerProcess(const char *program, const char *db_path,
+                unsigned n_threads) {
+    const std::string threads = std::to_string(n_threads);
+
+    /* don't let the child inherit buffered output */
+    fflush(stdout);
+
+    pid = fork();
+    if (pid < 0)
+      throw std::runtime_error("fork() failed");
+
+    if (pid == 0) {
+      /* the server logs every fix; that would only slow down this
+         benchmark */
+      freopen("/dev/null", "w", stdout);
+
+      execl(program, program, db_path, threads.c_str(), nullptr);
+      _exit(EXIT_FAILURE);
+    }
+
+    /* give it some time to bind the socket */
+    std::this_thread::sleep_for(milliseconds(500));
+  }
+
+  ~ServerProcess() noexcept {
+    kill(pid, SIGTERM);
+    waitpid(pid, nullptr, 0);
+  }
+
+  ServerProcess(const ServerProcess &) = delete;
+  ServerProcess &operator=(const ServerProcess &) = delete;
+};
+
+#endif
+
+int
+main(int argc, char *argv[])
+try {
+  Args args(argc, argv,
+            "[options] HOST [CLIENTS] [SECONDS]\n"
+            "Options:\n"
+            "  --rate=N                 Packets of each kind per client and second (default = 1)\n"
+#ifdef HAVE_POSIX
+            "  --server=PROGRAM         Launch this cloud server on HOST (which must be local)\n"
+            "  --threads=N,N,...        Server thread counts to compare (default = 1)\n"
+#endif
+            );
+
+  unsigned rate = 1;
+#ifdef HAVE_POSIX
+  const char *server = nullptr;
+  const char *threads = "1";
+#endif
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--rate=")) != nullptr) {
+      rate = ParseUnsigned(value);
+      if (rate == 0)
+        args.UsageError();
+#ifdef HAVE_POSIX
+    } else if ((value = StringAfterPrefix(arg, "--server=")) != nullptr) {
+      server = value;
+    } else if ((value = StringAfterPrefix(arg, "--threads=")) != nullptr) {
+      threads = value;
+#endif
+    } else {
+      args.UsageError();
+    }
+  }
+
+  const char *host = args.ExpectNext();
+  const unsigned n_clients = args.IsEmpty()
+    ? 500
+    : ParseUnsigned(args.GetNext());
+  const unsigned n_seconds = args.IsEmpty()
+    ? 10
+    : ParseUnsigned(args.GetNext());
+  args.ExpectEnd();
+
+  const auto address_list = Resolve(host,
+                                    SkyLinesTracking::Client::GetDefaultPort(),
+                                    0, SOCK_DGRAM);
+  const SocketAddress address = address_list.GetBest();
+
+  const steady_clock::duration run_time = seconds(n_seconds);
+
+#ifdef HAVE_POSIX
+  if (server != nullptr) {
+    static constexpr char db_path[] = "output/results/RunSkyLinesLoad.db";
+    Directory::Create(Path{"output/results"});
+
+    for (const std::string_view i : IterableSplitString(threads, ',')) {
+      const unsigned n_threads = ParseUnsigned(std::string{i}.c_str());
+      if (n_threads == 0)
+        args.UsageError();
+
+      printf("threads=%u\n", n_threads);
+
+      /* each server starts with an empty database */
+      File::Delete(Path{db_path});
+      File::Delete(Path{"output/results/RunSkyLinesLoad.db.journal"});
+      File::Delete(Path{"output/results/RunSkyLinesLoad.db.journal.old"});
+
+      const ServerProcess process(server, db_path, n_threads);
+      RunLoad(address, n_clients, rate, run_time);
+    }
+
+    return EXIT_SUCCESS;
+  }
+#endif
+
+  RunLoad(address, n_clients, rate, run_time);
+
+  return EXIT_SUCCESS;
+} catch (const std::exception &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
@@ -3,20 +3,89 @@
 
 #include "XML/Node.hpp"
 #include "XML/Parser.hpp"
+#include "XML/Document.hpp"
 #include "io/StdioOutputStream.hxx"
 #include "io/BufferedOutputStream.hxx"
 #include "system/Args.hpp"
 #include "util/PrintException.hxx"
+#include "util/StringCompare.hxx"
+
+#include <chrono>
 
 #include <stdio.h>
 #include <stdlib.h>
 
+using std::chrono::steady_clock;
+
+[[gnu::pure]]
+static unsigned
+CountElements(const XMLNode &node) noexcept
+{
+  unsigned n = 1;
+  for (const auto &i : node)
+    n += CountElements(i);
+  return n;
+}
+
+[[gnu::pure]]
+static unsigned
+CountElements(const XML::Document::Element &element) noexcept
+{
+  unsigned n = 1;
+  for (const auto *i = element.GetFirstChild(); i != nullptr;
+       i = i->GetNextSibling())
+    n += CountElements(*i);
+  return n;
+}
+
+/**
+ * Parse the file repeatedly and print the average duration.
+ */
+template<typename F>
+static void
+Benchmark(const char *name, unsigned iterations, F &&f)
+{
+  unsigned n_elements = 0;
+
+  const auto start = steady_clock::now();
+  for (unsigned i = 0; i < iterations; ++i)
+    n_elements = f();
+  const auto duration = steady_clock::now() - start;
+
+  printf("%s: %u elements, %.1f us per parse\n", name, n_elements,
+         std::chrono::duration<double, std::micro>(duration).count()
+         / iterations);
+}
+
 int main(int argc, char **argv)
 try {
-  Args args(argc, argv, "FILE");
+  Args args(argc, argv, "[--benchmark=N] FILE");
+
+  unsigned benchmark = 0;
+  while (!args.IsEmpty() && args.PeekNext()[0] == '-') {
+    const char *arg = args.GetNext();
+
+    if (const char *value = StringAfterPrefix(arg, "--benchmark="))
+      benchmark = strtoul(value, nullptr, 10);
+    else
+      args.UsageError();
+  }
+
   const auto path = args.ExpectNextPath();
   args.ExpectEnd();
 
+  if (benchmark > 0) {
+    Benchmark("XMLNode", benchmark, [&path]{
+      return CountElements(XML::ParseFile(path));
+    });
+
+    Benchmark("XML::Document", benchmark, [&path]{
+      return CountElements(XML::Document::Load(path).GetRoot());
+    });
+
+    return EXIT_SUCCESS;
+  }
+
   const auto node = XML::ParseFile(path);
 
   StdioOutputStream out(stdout);
@@ -0,0 +1,407 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Replays a directory of IGC files through the ordered task engine
+ * and reports the PEV based start of each pilot.  The flights are
+ * independent of each other, so they are distributed over one worker
+ * thread per CPU core.
+ */
+
+#include "system/Args.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "DebugReplayIGC.hpp"
+#include "Task/TaskFile.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "NMEA/Aircraft.hpp"
+#include "thread/Thread.hpp"
+#include "util/StringAPI.hxx"
+#include "util/StringCompare.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+struct PilotResult {
+  AllocatedPath path;
+
+  /**
+   * Did the file contain a usable flight?
+   */
+  bool valid = false;
+
+  /**
+   * Number of pilot events which were found in the file.
+   */
+  unsigned n_pev = 0;
+
+  /**
+   * The last pilot event before the start (or the last one at all if
+   * the task was not started).
+   */
+  BrokenTime pev_time = BrokenTime::Invalid();
+
+  /**
+   * The start gate which was opened by #pev_time.
+   */
+  RoughTimeSpan window = RoughTimeSpan::Invalid();
+
+  StartStats start;
+
+  bool task_finished = false;
+
+  explicit PilotResult(Path _path) noexcept
+    :path(_path) {
+    start.Reset();
+  }
+
+  /**
+   * Was the start inside the start window opened by the pilot event?
+   */
+  bool IsStartInWindow() const noexcept {
+    return start.HasStarted() && pev_time.IsPlausible() &&
+      window.IsInside(RoughTime{start.time});
+  }
+};
+
+static void
+Replay(DebugReplayIGC &replay, OrderedTask &task,
+       const GlidePolar &glide_polar, PilotResult &result) noexcept
+{
+  Validity last_location_available;
+  last_location_available.Clear();
+
+  AircraftState last_as;
+  bool last_as_valid = false;
+
+  while (replay.Next()) {
+    const MoreData &basic = replay.Basic();
+
+    if (replay.HasPilotEvent()) {
+      ++result.n_pev;
+
+      /* while the task has not been started, the most recent pilot
+         event defines the start window */
+      if (!result.start.HasStarted() &&
+          task.SetPEV(replay.GetPilotEventTime()))
+        result.pev_time = replay.GetPilotEventTime();
+    }
+
+    if (!basic.location_available) {
+      last_location_available.Clear();
+      continue;
+    }
+
+    const AircraftState current_as =
+      ToAircraftState(basic, replay.Calculated());
+
+    if (!last_location_available || !last_as_valid) {
+      last_as = current_as;
+      last_as_valid = true;
+      last_location_available = basic.location_available;
+      continue;
+    }
+
+    if (!basic.location_available.Modified(last_location_available))
+      continue;
+
+    task.Update(current_as, last_as, glide_polar);
+    task.SetTaskAdvance().SetArmed(true);
+
+    const TaskStats &stats = task.GetStats();
+    if (!result.start.HasStarted() && stats.start.HasStarted()) {
+      result.start = stats.start;
+      result.window =
+        task.GetOrderedTaskSettings().start_constraints.open_time_span;
+    }
+
+    result.valid = true;
+    last_as = current_as;
+    last_location_available = basic.location_available;
+  }
+
+  result.task_finished = task.GetStats().task_finished;
+}
+
+/**
+ * Takes flights from a shared list until there are none left.
+ */
+class ScoreThread final : public Thread {
+  std::vector<PilotResult> &results;
+  std::vector<std::unique_ptr<OrderedTask>> &tasks;
+  std::atomic_uint &next;
+  const GlidePolar &glide_polar;
+
+public:
+  ScoreThread(std::vector<PilotResult> &_results,
+              std::vector<std::unique_ptr<OrderedTask>> &_tasks,
+              std::atomic_uint &_next,
+              const GlidePolar &_glide_polar) noexcept
+    :Thread("score"),
+     results(_results), tasks(_tasks), next(_next),
+     glide_polar(_glide_polar) {}
+
+protected:
+  void Run() noexcept override {
+    unsigned i;
+    while ((i = next.fetch_add(1, std::memory_order_relaxed)) < results.size()) {
+      PilotResult &result = results[i];
+
+      std::unique_ptr<DebugReplayIGC> replay;
+      try {
+        replay.reset(DebugReplayIGC::Create(result.path));
+      } catch (...) {
+        continue;
+      }
+
+      Replay(*replay, *tasks[i], glide_polar, result);
+      tasks[i].reset();
+    }
+  }
+};
+
+class IGCCollector final : public File::Visitor {
+  std::vector<PilotResult> &results;
+
+public:
+  explicit IGCCollector(std::vector<PilotResult> &_results) noexcept
+    :results(_results) {}
+
+  void Visit(Path path, [[maybe_unused]] Path filename) override {
+    results.emplace_back(path);
+  }
+};
+
+static void
+FormatTime(char *buffer, size_t size, TimeStamp t) noexcept
+{
+  if (t.IsDefined()) {
+    const BrokenTime bt = BrokenTime::FromSinceMidnightChecked(t.ToDuration());
+    snprintf(buffer, size, "%02u:%02u:%02u", bt.hour, bt.minute, bt.second);
+  } else
+    *buffer = 0;
+}
+
+static void
+FormatTime(char *buffer, size_t size, const BrokenTime &t) noexcept
+{
+  if (t.IsPlausible())
+    snprintf(buffer, size, "%02u:%02u:%02u", t.hour, t.minute, t.second);
+  else
+    *buffer = 0;
+}
+
+static void
+FormatTime(char *buffer, size_t size, RoughTime t) noexcept
+{
+  if (t.IsValid())
+    snprintf(buffer, size, "%02u:%02u", t.GetHour(), t.GetMinute());
+  else
+    *buffer = 0;
+}
+
+struct FormattedResult {
+  char pev[16], start[16], open[16], close[16];
+
+  explicit FormattedResult(const PilotResult &r) noexcept {
+    FormatTime(pev, sizeof(pev), r.pev_time);
+    FormatTime(start, sizeof(start), r.start.time);
+    FormatTime(open, sizeof(open), r.window.GetStart());
+    FormatTime(close, sizeof(close), r.window.GetEnd());
+  }
+};
+
+/**
+ * Print a CSV field, quoted if it contains a special character.
+ */
+static void
+PrintCSVField(const char *value) noexcept
+{
+  if (strpbrk(value, ",\"\r\n") == nullptr) {
+    fputs(value, stdout);
+    return;
+  }
+
+  putchar('"');
+  for (const char *p = value; *p != 0; ++p) {
+    if (*p == '"')
+      putchar('"');
+    putchar(*p);
+  }
+  putchar('"');
+}
+
+/**
+ * Print a JSON string literal, including the quotes.
+ */
+static void
+PrintJSONString(const char *value) noexcept
+{
+  putchar('"');
+  for (const char *p = value; *p != 0; ++p) {
+    const unsigned char ch = *p;
+    if (ch == '"' || ch == '\\') {
+      putchar('\\');
+      putchar(ch);
+    } else if (ch < 0x20)
+      printf("\\u%04x", ch);
+    else
+      putchar(ch);
+  }
+  putchar('"');
+}
+
+static void
+PrintCSV(const std::vector<PilotResult> &results) noexcept
+{
+  printf("file,valid,pev_count,pev_time,start_time,start_altitude,"
+         "start_ground_speed,window_open,window_close,in_window,finished\n");
+
+  for (const auto &r : results) {
+    const FormattedResult f(r);
+    const bool started = r.start.HasStarted();
+
+    PrintCSVField(r.path.GetBase().c_str());
+    printf(",%d,%u,%s,%s,", r.valid, r.n_pev, f.pev, f.start);
+
+    if (started)
+      printf("%.0f,%.1f,", r.start.altitude, r.start.ground_speed);
+    else
+      printf(",,");
+
+    printf("%s,%s,%d,%d\n", f.open, f.close,
+           r.IsStartInWindow(), r.task_finished);
+  }
+}
+
+static void
+PrintJSON(const std::vector<PilotResult> &results) noexcept
+{
+  printf("[\n");
+
+  for (auto i = results.begin(); i != results.end(); ++i) {
+    const PilotResult &r = *i;
+    const FormattedResult f(r);
+
+    printf("  {\"file\": ");
+    PrintJSONString(r.path.GetBase().c_str());
+    printf(", \"valid\": %s, \"pev_count\": %u",
+           r.valid ? "true" : "false", r.n_pev);
+
+    if (r.pev_time.IsPlausible())
+      printf(", \"pev_time\": \"%s\"", f.pev);
+
+    if (r.start.HasStarted())
+      printf(", \"start_time\": \"%s\", \"start_altitude\": %.0f"
+             ", \"start_ground_speed\": %.1f",
+             f.start, r.start.altitude, r.start.ground_speed);
+
+    if (*f.open != 0)
+      printf(", \"window_open\": \"%s\"", f.open);
+    if (*f.close != 0)
+      printf(", \"window_close\": \"%s\"", f.close);
+
+    printf(", \"in_window\": %s, \"finished\": %s}%s\n",
+           r.IsStartInWindow() ? "true" : "false",
+           r.task_finished ? "true" : "false",
+           std::next(i) == results.end() ? "" : ",");
+  }
+
+  printf("]\n");
+}
+
+int main(int argc, char **argv)
+{
+  Args args(argc, argv,
+            "[options] TASKFILE IGCDIR\n"
+            "Options:\n"
+            "  --json                   Print JSON instead of CSV\n"
+            "  --threads=N              Number of worker threads (default = number of CPUs)");
+
+  bool json = false;
+  unsigned n_threads = 0;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if (StringIsEqual(arg, "--json")) {
+      json = true;
+    } else if ((value = StringAfterPrefix(arg, "--threads=")) != nullptr) {
+      n_threads = strtoul(value, nullptr, 10);
+      if (n_threads == 0) {
+        fputs("The threads parameter could not be parsed correctly.\n", stderr);
+        args.UsageError();
+      }
+    } else {
+      args.UsageError();
+    }
+  }
+
+  const auto task_path = args.ExpectNextPath();
+  const auto igc_path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+
+  auto task = TaskFile::GetTask(task_path, task_behaviour, nullptr, 0);
+  if (task == nullptr) {
+    fprintf(stderr, "Failed to load task\n");
+    return EXIT_FAILURE;
+  }
+
+  task->UpdateGeometry();
+
+  std::vector<PilotResult> results;
+  IGCCollector collector(results);
+  Directory::VisitSpecificFiles(igc_path, "*.igc", collector);
+
+  std::sort(results.begin(), results.end(),
+            [](const PilotResult &a, const PilotResult &b){
+              return strcmp(a.path.c_str(), b.path.c_str()) < 0;
+            });
+
+  /* each flight gets its own copy of the task; cloning is done here
+     so the workers never touch the shared prototype */
+  std::vector<std::unique_ptr<OrderedTask>> tasks;
+  tasks.reserve(results.size());
+  for (std::size_t i = 0; i < results.size(); ++i)
+    tasks.emplace_back(task->Clone(task_behaviour));
+
+  if (n_threads == 0) {
+    const long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    n_threads = n_cpus > 0 ? n_cpus : 1;
+  }
+
+  n_threads = std::min<std::size_t>(n_threads, std::max<std::size_t>(results.size(), 1));
+
+  const GlidePolar glide_polar(1);
+  std::atomic_uint next{0};
+
+  std::vector<std::unique_ptr<ScoreThread>> threads;
+  for (unsigned i = 0; i < n_threads; ++i) {
+    threads.emplace_back(new ScoreThread(results, tasks, next, glide_polar));
+    threads.back()->Start();
+  }
+
+  for (auto &thread : threads)
+    thread->Join();
+
+  if (json)
+    PrintJSON(results);
+  else
+    PrintCSV(results);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Route/AirspaceRoute.hpp"
+#include "Engine/Route/Config.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "Engine/Airspace/Predicate/AirspacePredicate.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/GlideSolvers/GlideSettings.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "Geo/GeoVector.hpp"
+#include "TestUtil.hpp"
+
+#include <random>
+#include <vector>
+
+static const GeoPoint center(Angle::Degrees(7.7), Angle::Degrees(51.0));
+
+/**
+ * Generate a reproducible, dense set of overlapping airspaces.
+ */
+static void
+GenerateAirspaces(Airspaces &airspaces, unsigned n)
+{
+  std::minstd_rand rng(1);
+  std::uniform_real_distribution<double> offset(-0.5, 0.5);
+  std::uniform_real_distribution<double> radius(1000, 6000);
+  std::uniform_real_distribution<double> altitude(0, 2000);
+
+  for (unsigned i = 0; i < n; ++i) {
+    const GeoPoint c(center.longitude + Angle::Degrees(offset(rng)),
+                     center.latitude + Angle::Degrees(offset(rng)));
+
+    std::shared_ptr<AbstractAirspace> airspace;
+    if (i % 3 != 0) {
+      airspace = std::make_shared<AirspaceCircle>(c, radius(rng));
+    } else {
+      const double r = radius(rng);
+      std::vector<GeoPoint> points;
+      for (unsigned j = 0; j < 6; ++j) {
+        const Angle a = Angle::FullCircle() * j / 6;
+        points.push_back(GeoVector(r * (1 + (j % 2) * 0.5), a).EndPoint(c));
+      }
+
+      airspace = std::make_shared<AirspacePolygon>(points);
+    }
+
+    AirspaceAltitude base, top;
+    base.reference = top.reference = AltitudeReference::MSL;
+    base.altitude = altitude(rng);
+    top.altitude = base.altitude + 1500;
+    airspace->SetProperties(_T("Test"), AirspaceClass::CLASSD, {},
+                            base, top);
+
+    airspaces.Add(std::move(airspace));
+  }
+
+  airspaces.Optimise();
+}
+
+static double
+GetLength(const Route &route)
+{
+  double length = 0;
+  for (std::size_t i = 1; i < route.size(); ++i)
+    length += route[i - 1].Distance(route[i]);
+  return length;
+}
+
+static AirspaceVisibilityGraph::Obstacle
+MakeSquare(int x, int y, int r, const AbstractAirspace &airspace,
+           int base, int top, bool wall)
+{
+  AirspaceVisibilityGraph::Obstacle o;
+  o.hull = {{x - r, y - r}, {x + r, y - r}, {x + r, y + r}, {x - r, y + r}};
+  o.border = o.hull;
+  o.box = FlatBoundingBox(o.hull.begin(), o.hull.end());
+  o.airspace = &airspace;
+  o.base = base;
+  o.top = top;
+  o.wall = wall;
+  return o;
+}
+
+static void
+TestGraph()
+{
+  /* only the addresses of these are used */
+  const AirspaceCircle first(center, 1000), second(center, 1000),
+    partial(center, 1000);
+
+  AirspaceVisibilityGraph::Obstacles obstacles;
+  obstacles.push_back(MakeSquare(0, 0, 10, first, 0, 5000, true));
+  obstacles.push_back(MakeSquare(40, 5, 10, second, 0, 5000, true));
+  obstacles.push_back(MakeSquare(0, 40, 10, partial, 1000, 2000, false));
+
+  const AirspaceVisibilityGraph graph(std::move(obstacles));
+  ok1(graph.GetVertexCount() == 12);
+  ok1(graph.GetEdgeCount() > 0);
+
+  const std::vector<const AbstractAirspace *> none, blocked{&partial},
+    ignored{&first};
+  std::vector<FlatGeoPoint> path;
+
+  /* level flight */
+  const auto level = [](FlatGeoPoint, int altitude, FlatGeoPoint){
+    return altitude;
+  };
+
+  /* the direct link is clear */
+  ok1(graph.FindPath({-20, 20}, 500, {20, 20}, level, none, none, path));
+  ok1(path.empty());
+
+  /* around the first square */
+  ok1(graph.FindPath({-20, 0}, 500, {20, 0}, level, none, none, path));
+  ok1(path.size() == 2);
+  ok1(path.size() == 2 && path[0].x == -10 && path[1].x == 10 &&
+      path[0].y == path[1].y && (path[0].y == 10 || path[0].y == -10));
+
+  /* around the first and second squares, along their lower edges */
+  ok1(graph.FindPath({-20, -3}, 500, {60, -3}, level, none, none, path));
+  ok1(path.size() == 3);
+  ok1(path.size() == 3 && path[0] == FlatGeoPoint(-10, -10) &&
+      path[1] == FlatGeoPoint(10, -10) && path[2] == FlatGeoPoint(50, -5));
+
+  /* a point inside a hull may leave it */
+  ok1(graph.FindPath({0, 0}, 500, {20, 0}, level, none, none, path));
+  ok1(path.empty());
+
+  /* the third square is avoided only within its altitude range or
+     if it is blocked */
+  ok1(graph.FindPath({-20, 40}, 500, {20, 40}, level, none, none, path));
+  ok1(path.empty());
+  ok1(graph.FindPath({-20, 40}, 1500, {20, 40}, level, none, none, path));
+  ok1(path.size() == 2 && path[0].x == -10 && path[1].x == 10);
+  ok1(graph.FindPath({-20, 40}, 500, {20, 40}, level, blocked, none, path));
+  ok1(path.size() == 2 && path[0].x == -10 && path[1].x == 10);
+
+  /* an ignored wall is not avoided */
+  ok1(graph.FindPath({-20, 0}, 500, {20, 0}, level, none, ignored, path));
+  ok1(path.empty());
+}
+
+/**
+ * Solve a series of routes from a moving aircraft to a fixed
+ * destination with and without the visibility graph, and compare the
+ * solutions.
+ */
+static void
+TestVisibilityGraph()
+{
+  Airspaces airspaces;
+  GenerateAirspaces(airspaces, 400);
+
+  GlideSettings settings;
+  settings.SetDefaults();
+  RoutePlannerConfig config;
+  config.SetDefaults();
+  config.mode = RoutePlannerConfig::Mode::AIRSPACE;
+
+  const GlidePolar polar(1);
+  const SpeedVector wind(Angle::Degrees(0), 0);
+
+  AirspaceRoute graph, search;
+  graph.UpdatePolar(settings, config, polar, polar, wind);
+  search.UpdatePolar(settings, config, polar, polar, wind);
+  search.SetVisibilityGraphEnabled(false);
+
+  const AGeoPoint destination(GeoVector(30000, Angle::Degrees(60))
+                              .EndPoint(center), 500);
+
+  unsigned n_solved = 0, n_missed = 0, n_graph = 0, n_detours = 0;
+  double graph_length = 0, search_length = 0;
+  for (unsigned i = 0; i < 60; ++i) {
+    const AGeoPoint origin(GeoVector(30000 - 300 * i, Angle::Degrees(240))
+                           .EndPoint(center), 1000);
+
+    graph.Synchronise(airspaces, AirspacePredicateTrue,
+                      origin, destination);
+    search.Synchronise(airspaces, AirspacePredicateTrue,
+                       origin, destination);
+
+    const bool a = graph.Solve(origin, destination, config);
+    const bool b = search.Solve(origin, destination, config);
+    if (!a || !b) {
+      /* the search may give up where the graph finds a route, but not
+         vice versa */
+      if (b)
+        ++n_missed;
+      continue;
+    }
+
+    ++n_solved;
+
+    if (graph.GetExpandedNodeCount() == 0)
+      ++n_graph;
+
+    if (graph.GetSolution().size() > 2)
+      ++n_detours;
+
+    graph_length += GetLength(graph.GetSolution());
+    search_length += GetLength(search.GetSolution());
+  }
+
+  ok1(graph.AirspaceSize() > 50);
+  ok1(graph.GetVisibilityGraph() != nullptr);
+  ok1(search.GetVisibilityGraph() == nullptr);
+  ok1(n_solved > 0);
+  ok1(n_detours > 0);
+  ok1(n_missed == 0);
+
+  /* most routes come from the graph, and they are not longer than
+     those of the A* search */
+  ok1(n_graph * 2 > n_solved);
+  ok1(graph_length <= search_length);
+
+  printf("# %u of %u routes from the graph, length %.0f m vs. %.0f m\n",
+         n_graph, n_solved, graph_length, search_length);
+}
+
+int main()
+{
+  plan_tests(28);
+
+  TestGraph();
+  TestVisibilityGraph();
+
+  return exit_status();
+}
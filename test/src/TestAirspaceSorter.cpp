@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Airspace/AirspaceSorter.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "util/StringAPI.hxx"
+#include "TestUtil.hpp"
+
+static const GeoPoint location(Angle::Degrees(7.7), Angle::Degrees(51.0));
+
+static void
+AddCircle(Airspaces &airspaces, const TCHAR *name, AirspaceClass cls,
+          double east)
+{
+  const GeoPoint center(location.longitude + Angle::Degrees(east),
+                        location.latitude);
+  auto as = std::make_shared<AirspaceCircle>(center, 1000);
+
+  AirspaceAltitude base, top;
+  base.reference = top.reference = AltitudeReference::MSL;
+  base.altitude = 0;
+  top.altitude = 3000;
+  as->SetProperties(name, cls, _T(""), base, top);
+  airspaces.Add(std::move(as));
+}
+
+static bool
+HasNames(const AirspaceSelectInfoVector &v,
+         std::initializer_list<const TCHAR *> names)
+{
+  if (v.size() != names.size())
+    return false;
+
+  auto i = v.begin();
+  for (const TCHAR *name : names)
+    if (!StringIsEqual((i++)->GetAirspace().GetName(), name))
+      return false;
+
+  return true;
+}
+
+int main()
+{
+  plan_tests(18);
+
+  Airspaces airspaces;
+  AddCircle(airspaces, _T("Bravo"), AirspaceClass::CLASSD, 0.5);
+  AddCircle(airspaces, _T("Alpha"), AirspaceClass::CLASSC, 0.2);
+  AddCircle(airspaces, _T("Alps"), AirspaceClass::CLASSD, 1.0);
+  AddCircle(airspaces, _T("Charlie"), AirspaceClass::CLASSC, 0.05);
+  airspaces.Optimise();
+
+  AirspaceFilterData filter;
+
+  /* no filter: sorted by name */
+  ok1(HasNames(FilterAirspaces(airspaces, location, filter),
+               {_T("Alpha"), _T("Alps"), _T("Bravo"), _T("Charlie")}));
+
+  /* distance filter: sorted by distance, exact range check */
+  filter.distance = 40000;
+  const auto near = FilterAirspaces(airspaces, location, filter);
+  ok1(HasNames(near, {_T("Charlie"), _T("Alpha"), _T("Bravo")}));
+  ok1(near.front().GetVector(location, airspaces.GetProjection()).distance < 3000);
+
+  /* direction filter: all are east of the location */
+  filter.distance = -1;
+  filter.direction = Angle::Degrees(90);
+  ok1(FilterAirspaces(airspaces, location, filter).size() == 4);
+  filter.direction = Angle::Degrees(270);
+  ok1(FilterAirspaces(airspaces, location, filter).empty());
+
+  AirspaceSearch search(airspaces);
+
+  AirspaceFilterData name_filter;
+  name_filter.name_prefix = _T("a");
+  ok1(HasNames(search.Update(location, name_filter),
+               {_T("Alpha"), _T("Alps")}));
+
+  /* refinements */
+  name_filter.name_prefix = _T("Alp");
+  ok1(HasNames(search.Update(location, name_filter),
+               {_T("Alpha"), _T("Alps")}));
+  name_filter.cls = AirspaceClass::CLASSD;
+  ok1(HasNames(search.Update(location, name_filter), {_T("Alps")}));
+  name_filter.name_prefix = _T("Alpx");
+  ok1(search.Update(location, name_filter).empty());
+
+  /* widening again */
+  name_filter.name_prefix = _T("B");
+  ok1(HasNames(search.Update(location, name_filter), {_T("Bravo")}));
+  name_filter.cls = AirspaceClass::AIRSPACECLASSCOUNT;
+  name_filter.name_prefix = nullptr;
+  ok1(search.Update(location, name_filter).size() == 4);
+
+  /* with a geo filter, too */
+  name_filter.distance = 40000;
+  ok1(HasNames(search.Update(location, name_filter),
+               {_T("Charlie"), _T("Alpha"), _T("Bravo")}));
+  name_filter.name_prefix = _T("al");
+  ok1(HasNames(search.Update(location, name_filter), {_T("Alpha")}));
+
+  /* the distance filter ends 100 m before "Bravo" */
+  const auto &projection = airspaces.GetProjection();
+  AirspaceFilterData near_filter;
+  near_filter.distance = FilterAirspaces(airspaces, location, {})[2]
+    .GetVector(location, projection).distance - 100;
+  ok1(HasNames(search.Update(location, near_filter),
+               {_T("Charlie"), _T("Alpha")}));
+
+  /* moving 150 m towards it is less than 1% of the distance filter:
+     the previous result is refined and misses "Bravo", but the
+     vectors refer to the new location */
+  const GeoPoint moved = GeoVector(150, Angle::Degrees(90)).EndPoint(location);
+  const auto &refined = search.Update(moved, near_filter);
+  ok1(HasNames(refined, {_T("Charlie"), _T("Alpha")}));
+  /* (the cached vector is returned regardless of the location
+     argument) */
+  ok1(refined.front().GetVector(location, projection).distance ==
+      AirspaceSelectInfo(refined.front().GetAirspacePtr())
+      .GetVector(moved, projection).distance);
+
+  /* the displacement is measured from the last full search, not
+     from the previous query, so small steps do not add up */
+  const GeoPoint moved2 = GeoVector(450, Angle::Degrees(90)).EndPoint(location);
+  ok1(HasNames(search.Update(moved2, near_filter),
+               {_T("Charlie"), _T("Alpha"), _T("Bravo")}));
+
+  /* a database change invalidates the index */
+  AddCircle(airspaces, _T("Delta"), AirspaceClass::CLASSC, 2.0);
+  airspaces.Optimise();
+  name_filter = {};
+  ok1(search.Update(location, name_filter).size() == 5);
+
+  return exit_status();
+}
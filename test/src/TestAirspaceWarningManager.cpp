@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Replays IGC files through the #AirspaceWarningManager and verifies
+ * that an update does not allocate heap memory unless the list of
+ * warnings changes.
+ */
+
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Engine/Task/Stats/TaskStats.hpp"
+#include "Geo/GeoVector.hpp"
+#include "IGC/IGCParser.hpp"
+#include "IGC/IGCFix.hpp"
+#include "IGC/IGCExtensions.hpp"
+#include "io/FileReader.hxx"
+#include "io/BufferedReader.hxx"
+#include "io/FileLineReader.hpp"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+#include "AllocationCounter.hpp"
+
+#include <tchar.h>
+
+using namespace std::chrono;
+
+/**
+ * Updates after which the buffers are expected to have reached their
+ * final size.
+ */
+static constexpr unsigned WARMUP_UPDATES = 60;
+
+struct ReplayResult {
+  /**
+   * The number of updates which were checked.
+   */
+  unsigned n_checked = 0;
+
+  /**
+   * The number of checked updates which allocated memory.
+   */
+  unsigned n_allocating = 0;
+
+  /**
+   * The number of checked updates with at least one warning.
+   */
+  unsigned n_warning = 0;
+};
+
+static ReplayResult
+Replay(Path path, const Airspaces &airspaces)
+{
+  AirspaceWarningConfig config;
+  config.SetDefaults();
+
+  AirspaceWarningManager warnings(config, airspaces);
+
+  const GlidePolar glide_polar(1);
+
+  TaskStats task_stats;
+  task_stats.reset();
+
+  FileLineReaderA reader(path);
+
+  IGCExtensions extensions;
+  extensions.clear();
+
+  AircraftState state, last_state;
+  bool have_last = false;
+
+  ReplayResult result;
+  unsigned n_updates = 0;
+
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    IGCFix fix;
+    if (!IGCParseFix(line, extensions, fix) || !fix.gps_valid)
+      continue;
+
+    state.Reset();
+    state.location = fix.location;
+    state.altitude = fix.gps_altitude;
+    state.time = TimeStamp{fix.time.DurationSinceMidnight()};
+    state.flying = true;
+
+    if (!have_last) {
+      warnings.Reset(state);
+      last_state = state;
+      have_last = true;
+      continue;
+    }
+
+    if (state.time <= last_state.time)
+      continue;
+
+    const auto dt = duration_cast<duration<unsigned>>(state.time - last_state.time);
+    const GeoVector vector(last_state.location, state.location);
+    state.track = vector.bearing;
+    state.ground_speed = vector.distance / dt.count();
+    state.vario = (state.altitude - last_state.altitude) / dt.count();
+
+    const Serial serial = warnings.GetSerial();
+    const uint64_t before = AllocationCounter::GetCount();
+
+    warnings.Update(state, glide_polar, task_stats, false, dt);
+
+    const uint64_t allocations = AllocationCounter::GetCount() - before;
+
+    /* new warnings are list nodes which need to be allocated; skip
+       those updates */
+    if (++n_updates > WARMUP_UPDATES && warnings.GetSerial() == serial) {
+      ++result.n_checked;
+      if (allocations > 0)
+        ++result.n_allocating;
+      if (!warnings.empty())
+        ++result.n_warning;
+    }
+
+    last_state = state;
+  }
+
+  return result;
+}
+
+static constexpr struct {
+  const TCHAR *path;
+
+  /**
+   * Does this flight come close enough to the airspaces in
+   * AirspaceAus-DAA.txt to raise warnings?
+   */
+  bool expect_warnings;
+} flights[] = {
+  { _T("test/data/01lz1hq1.igc"), false },
+  { _T("test/data/0asljd01.igc"), false },
+  { _T("test/data/9crx3101.igc"), true },
+};
+
+int
+main()
+{
+  plan_tests(7);
+
+  Airspaces airspaces;
+
+  {
+    FileReader file_reader{Path{_T("test/data/AirspaceAus-DAA.txt")}};
+    BufferedReader buffered_reader{file_reader};
+    ParseAirspaceFile(airspaces, buffered_reader);
+  }
+
+  airspaces.Optimise();
+  airspaces.SetFlightLevels(AtmosphericPressure::Standard());
+
+  for (const auto &flight : flights) {
+    const auto result = Replay(Path{flight.path}, airspaces);
+    ok1(result.n_checked > 1000);
+    ok(result.n_allocating == 0, "%u of %u updates allocated memory",
+       result.n_allocating, result.n_checked);
+
+    if (flight.expect_warnings)
+      /* the allocation check must also have covered updates with
+         active warnings */
+      ok(result.n_warning > 0, "%u updates with warnings",
+         result.n_warning);
+  }
+
+  return exit_status();
+}
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Airspace/ProtectedAirspaceWarningManager.hpp"
+#include "Airspace/AirspaceWarningSnapshot.hpp"
+#include "Airspace/ActivePredicate.hpp"
+#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "TestUtil.hpp"
+
+#include <future>
+#include <thread>
+
+static const GeoPoint location(Angle::Degrees(7.7), Angle::Degrees(51.0));
+
+static ConstAirspacePtr
+AddCircle(Airspaces &airspaces, const TCHAR *name)
+{
+  auto as = std::make_shared<AirspaceCircle>(location, 1000);
+
+  AirspaceAltitude base, top;
+  base.reference = top.reference = AltitudeReference::MSL;
+  base.altitude = 0;
+  top.altitude = 3000;
+  as->SetProperties(name, AirspaceClass::CLASSD, _T(""), base, top);
+  airspaces.Add(as);
+  return as;
+}
+
+int main()
+{
+  plan_tests(16);
+
+  Airspaces airspaces;
+  const auto alpha = AddCircle(airspaces, _T("Alpha"));
+  const auto bravo = AddCircle(airspaces, _T("Bravo"));
+  airspaces.Optimise();
+
+  AirspaceWarningConfig config;
+  config.SetDefaults();
+
+  AirspaceWarningManager awm(config, airspaces);
+  ProtectedAirspaceWarningManager protected_awm(awm);
+
+  /* initially empty */
+  ok1(protected_awm.IsEmpty());
+  ok1(!protected_awm.GetTopWarning());
+
+  /* a snapshot is not modified by later updates */
+  const auto before = protected_awm.GetSnapshot();
+  protected_awm.AcknowledgeDay(alpha);
+  ok1(before->empty());
+  ok1(protected_awm.GetAckDay(*alpha));
+  ok1(!protected_awm.GetSnapshot()->IsActive(*alpha));
+  ok1(protected_awm.GetSnapshot()->IsActive(*bravo));
+
+  /* the predicate uses the state at its construction */
+  const ActiveAirspacePredicate active(&protected_awm);
+  ok1(!active(*alpha));
+
+  protected_awm.Enable(alpha);
+  ok1(!protected_awm.GetAckDay(*alpha));
+  ok1(!active(*alpha));
+  ok1(ActiveAirspacePredicate(&protected_awm)(*alpha));
+
+  /* without a manager, only the airspace itself is checked */
+  ok1(ActiveAirspacePredicate(nullptr)(*alpha));
+
+  /* while another thread holds the lock, commands are queued */
+  std::promise<void> locked, release;
+  std::thread reader([&]{
+    const ProtectedAirspaceWarningManager::Lease lease(protected_awm);
+    locked.set_value();
+    release.get_future().wait();
+  });
+
+  locked.get_future().wait();
+  protected_awm.AcknowledgeDay(bravo);
+  ok1(!protected_awm.GetAckDay(*bravo));
+
+  release.set_value();
+  reader.join();
+
+  ok1(!protected_awm.GetAckDay(*bravo));
+  protected_awm.ProcessCommands();
+  ok1(protected_awm.GetAckDay(*bravo));
+
+  /* Clear() publishes immediately */
+  protected_awm.Clear();
+  ok1(protected_awm.IsEmpty());
+  ok1(!protected_awm.GetAckDay(*bravo));
+
+  return exit_status();
+}
@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Cloud/Journal.hpp"
+#include "Cloud/Data.hpp"
+#include "Cloud/Serialiser.hpp"
+#include "io/FileReader.hxx"
+#include "io/FileOutputStream.hxx"
+#include "net/IPv4Address.hxx"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static constexpr Path db_path{"output/results/Test-Cloud.db"};
+
+static const IPv4Address address(127, 0, 0, 1, 5597);
+
+static CloudClient
+MakeClient(uint64_t key, unsigned id, double longitude)
+{
+  return CloudClient(SocketAddress(address), key, id,
+                     GeoPoint(Angle::Degrees(longitude), Angle::Degrees(51)),
+                     1000);
+}
+
+static CloudThermal
+MakeThermal(uint64_t key)
+{
+  const GeoPoint location(Angle::Degrees(7), Angle::Degrees(51));
+  return CloudThermal(key, AGeoPoint(location, 500), AGeoPoint(location, 1500),
+                      2.5);
+}
+
+static std::size_t
+CountThermals(const CloudData &data)
+{
+  return std::distance(data.thermals.begin(), data.thermals.end());
+}
+
+/**
+ * Replay both journals like the server does at startup.
+ *
+ * @return false if a journal was malformed
+ */
+static bool
+Replay(CloudData &data, const CloudJournal &journal)
+{
+  for (const Path path : {journal.GetOldPath(), journal.GetPath()}) {
+    if (!File::Exists(path))
+      continue;
+
+    try {
+      ReplayCloudJournal(path, data);
+    } catch (const std::runtime_error &) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Remove the last bytes of a file, as if the process had crashed
+ * while appending a record.
+ */
+static void
+Truncate(Path path, std::size_t n)
+{
+  std::vector<std::byte> contents;
+
+  {
+    FileReader reader(path);
+    std::byte buffer[4096];
+    std::size_t nbytes;
+    while ((nbytes = reader.Read(buffer)) > 0)
+      contents.insert(contents.end(), buffer, buffer + nbytes);
+  }
+
+  FileOutputStream fos(path);
+  fos.Write(std::span{contents}.first(contents.size() - n));
+  fos.Commit();
+}
+
+static void
+TestGenerations()
+{
+  CloudJournal journal(db_path);
+  File::Delete(journal.GetPath());
+  File::Delete(journal.GetOldPath());
+
+  /* generation 1: client 1 */
+  journal.Start(1);
+  journal.Append(MakeClient(1, 1, 7));
+  journal.Flush();
+
+  /* generation 2: client 2 moves client 1, adds a thermal */
+  journal.Start(2);
+  journal.Append(MakeClient(1, 1, 8));
+  journal.Append(MakeClient(2, 2, 9));
+  journal.Append(MakeThermal(2));
+  journal.Flush();
+
+  ok1(File::Exists(journal.GetOldPath()));
+  ok1(File::Exists(journal.GetPath()));
+
+  {
+    /* a database saved with generation 2 already includes the
+       changes of generation 1, so that journal is skipped */
+    CloudData data;
+    data.generation = 2;
+    ok1(Replay(data, journal));
+
+    const CloudClient *client = data.clients.Find(1);
+    ok1(client != nullptr);
+    ok1(client != nullptr && client->location.longitude == Angle::Degrees(8));
+    ok1(data.clients.Find(2) != nullptr);
+    ok1(CountThermals(data) == 1);
+
+    /* a database with a newer generation skips everything */
+    CloudData newer;
+    newer.generation = 3;
+    ok1(Replay(newer, journal));
+    ok1(newer.clients.empty());
+    ok1(newer.thermals.empty());
+  }
+
+  {
+    /* an older database needs both journals */
+    CloudData data;
+    data.generation = 1;
+    ok1(Replay(data, journal));
+    ok1(data.clients.Find(1) != nullptr);
+    ok1(data.clients.Find(2) != nullptr);
+    ok1(data.clients.GetNextId() == 3);
+  }
+
+  /* after the snapshot has been committed */
+  journal.DeleteOld();
+  ok1(!File::Exists(journal.GetOldPath()));
+
+  {
+    CloudData data;
+    data.generation = 2;
+    ok1(Replay(data, journal));
+    ok1(data.clients.Find(1) != nullptr);
+    ok1(data.clients.Find(2) != nullptr);
+  }
+}
+
+static void
+TestTruncated()
+{
+  {
+    CloudJournal journal(db_path);
+    File::Delete(journal.GetPath());
+    File::Delete(journal.GetOldPath());
+
+    journal.Start(1);
+    journal.Append(MakeClient(1, 1, 7));
+    journal.Append(MakeThermal(1));
+    journal.Append(MakeClient(2, 2, 9));
+  }
+
+  const CloudJournal journal(db_path);
+
+  /* the complete journal */
+  {
+    CloudData data;
+    ok1(Replay(data, journal));
+    ok1(data.clients.Find(2) != nullptr);
+  }
+
+  /* the final record was cut off by a crash: the replay fails, but
+     all records before it have been applied */
+  Truncate(journal.GetPath(), 3);
+
+  CloudData data;
+  ok1(!Replay(data, journal));
+  ok1(data.clients.Find(1) != nullptr);
+  ok1(CountThermals(data) == 1);
+  ok1(data.clients.Find(2) == nullptr);
+
+  File::Delete(journal.GetPath());
+}
+
+/**
+ * The server's compaction: the records taken before Start() belong
+ * to the old generation, and those appended meanwhile to the new one.
+ * CompactCloudDatabase() folds the old journal into the database.
+ */
+static void
+TestCompact()
+{
+  CloudJournal journal(db_path);
+  File::Delete(journal.GetPath());
+  File::Delete(journal.GetOldPath());
+
+  /* a database of generation 1 with client 1 */
+  {
+    CloudData data;
+    data.clients.Restore(MakeClient(1, 1, 7));
+    SaveCloudSnapshot(db_path, data.MakeSnapshot(1));
+  }
+
+  journal.Start(1);
+  journal.Append(MakeClient(1, 1, 8));
+  journal.Append(MakeThermal(1));
+
+  const std::string records = journal.Take();
+  ok1(!journal.IsDirty());
+
+  /* appended by a worker thread after the lock was released */
+  journal.Append(MakeClient(2, 2, 9));
+
+  journal.Write(records);
+  journal.Start(2);
+  journal.Flush();
+
+  CompactCloudDatabase(db_path, journal.GetOldPath(), 2);
+  journal.DeleteOld();
+
+  CloudData data;
+
+  {
+    FileReader fr(db_path);
+    Deserialiser s(fr);
+    data.Load(s);
+  }
+
+  ok1(data.generation == 2);
+  const CloudClient *client = data.clients.Find(1);
+  ok1(client != nullptr && client->location.longitude == Angle::Degrees(8));
+  ok1(CountThermals(data) == 1);
+  ok1(data.clients.Find(2) == nullptr);
+
+  /* the new journal restores the rest at startup */
+  ok1(Replay(data, journal));
+  ok1(data.clients.Find(2) != nullptr);
+
+  File::Delete(journal.GetPath());
+  File::Delete(db_path);
+}
+
+int main()
+{
+  plan_tests(31);
+
+  Directory::Create(Path{"output/results"});
+
+  TestGenerations();
+  TestTruncated();
+  TestCompact();
+
+  return exit_status();
+}
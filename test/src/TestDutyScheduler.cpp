@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "time/DutyScheduler.hpp"
+#include "TestUtil.hpp"
+
+using namespace std::chrono;
+
+static unsigned fast_count, slow_count;
+
+static void
+Fast() noexcept
+{
+  ++fast_count;
+}
+
+static void
+Slow() noexcept
+{
+  ++slow_count;
+}
+
+int main()
+{
+  plan_tests(22);
+
+  DutyScheduler scheduler;
+  scheduler.Add(Fast, milliseconds(500));
+  scheduler.Add(Slow, seconds(2));
+
+  const DutyScheduler::Clock::time_point t0{};
+
+  /* all duties run on the first call */
+  ok1(scheduler.Run(t0) == milliseconds(500));
+  ok1(fast_count == 1);
+  ok1(slow_count == 1);
+
+  /* nothing is due yet */
+  ok1(scheduler.Run(t0 + milliseconds(100)) == milliseconds(400));
+  ok1(fast_count == 1);
+
+  /* a late tick keeps the phase */
+  ok1(scheduler.Run(t0 + milliseconds(600)) == milliseconds(400));
+  ok1(fast_count == 2);
+  ok1(slow_count == 1);
+
+  ok1(scheduler.Run(t0 + seconds(2)) == milliseconds(500));
+  ok1(slow_count == 2);
+
+  /* after a long stall, the duties run only once */
+  scheduler.Run(t0 + seconds(10));
+  ok1(fast_count == 4);
+  ok1(slow_count == 3);
+
+  /* an early tick within the tolerance */
+  DutyScheduler tolerant(milliseconds(50));
+  tolerant.Add(Fast, milliseconds(500));
+  tolerant.Run(t0);
+  ok1(tolerant.Run(t0 + milliseconds(480)) == milliseconds(520));
+  ok1(fast_count == 6);
+
+  /* slowing a duty down moves its pending deadline */
+  tolerant.SetInterval(Fast, seconds(1));
+  ok1(tolerant.Run(t0 + milliseconds(600)) == milliseconds(900));
+  ok1(fast_count == 6);
+  ok1(tolerant.Run(t0 + milliseconds(1500)) == seconds(1));
+  ok1(fast_count == 7);
+
+  /* speeding it up makes it due earlier */
+  tolerant.SetInterval(Fast, milliseconds(500));
+  ok1(tolerant.Run(t0 + milliseconds(1520)) == milliseconds(480));
+
+  /* a duty which changes to the interval of another one shares its
+     deadlines */
+  DutyScheduler aligned;
+  aligned.Add(Fast, milliseconds(500));
+  aligned.Add(Slow, seconds(1));
+  aligned.Run(t0);
+  aligned.Run(t0 + milliseconds(500));
+  aligned.SetInterval(Fast, seconds(1));
+  ok1(aligned.Run(t0 + milliseconds(600)) == milliseconds(400));
+  ok1(aligned.Run(t0 + seconds(1)) == seconds(1));
+  ok1(fast_count == 10 && slow_count == 5);
+
+  return exit_status();
+}
@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "Geo/Math.hpp"
+#include "Geo/PreparedGeoPoint.hpp"
 #include "Geo/SimplifiedMath.hpp"
 #include "TestUtil.hpp"
 
@@ -44,9 +45,37 @@ TestLinearDistance()
 
 }
 
+static void
+TestPrepared(const GeoPoint &a, const GeoPoint &b, const GeoPoint &c)
+{
+  const GeoPoint locations[] = { a, b, c };
+  const PreparedGeoPoint prepared_a{a};
+
+  /* the results with prepared locations are identical to the scalar
+     ones */
+  for (const auto &i : locations) {
+    double distance1, distance2, distance3;
+    Angle bearing1, bearing2, bearing3;
+    DistanceBearing(a, i, &distance1, &bearing1);
+    DistanceBearing(prepared_a, i, &distance2, &bearing2);
+    DistanceBearing(prepared_a, PreparedGeoPoint{i}, &distance3, &bearing3);
+    ok1(distance1 == distance2 && bearing1 == bearing2);
+    ok1(distance1 == distance3 && bearing1 == bearing3);
+  }
+
+  /* one output may be omitted */
+  double distance;
+  DistanceBearing(prepared_a, c, &distance, nullptr);
+  ok1(distance == Distance(a, c));
+
+  Angle bearing;
+  DistanceBearing(prepared_a, c, nullptr, &bearing);
+  ok1(bearing == Bearing(a, c));
+}
+
 int main()
 {
-  plan_tests(10 + 2 * 36 + 18);
+  plan_tests(10 + 2 * 36 + 18 + 8);
 
   const GeoPoint a(Angle::Degrees(7.7061111111111114),
                    Angle::Degrees(51.051944444444445));
@@ -84,6 +113,7 @@ int main()
   ok1(big_distance > 494000 && big_distance < 495000);
 
   TestLinearDistance();
+  TestPrepared(a, b, c);
 
   return exit_status();
 }
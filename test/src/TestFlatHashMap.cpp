@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "util/FlatHashMap.hpp"
+
+extern "C" {
+#include "tap.h"
+}
+
+/**
+ * A deliberately bad hash function which produces many collisions.
+ */
+struct BadHash {
+  std::size_t operator()(unsigned i) const noexcept {
+    return i % 7;
+  }
+};
+
+static void
+TestMap()
+{
+  FlatHashMap<unsigned, unsigned, BadHash> map;
+  ok1(map.empty());
+  ok1(map.find(42) == map.NPOS);
+
+  bool all_inserted = true;
+  for (unsigned i = 0; i < 1000; ++i)
+    if (!map.try_emplace(i * 3, i).second)
+      all_inserted = false;
+  ok1(all_inserted);
+  ok1(map.size() == 1000);
+
+  /* existing keys are not replaced */
+  const auto [index, inserted] = map.try_emplace(30, 4242U);
+  ok1(!inserted);
+  ok1(map[index].key == 30);
+  ok1(map[index].value == 10);
+
+  /* indices are stable across growing */
+  ok1(index == 10);
+  ok1(map[0].key == 0);
+  ok1(map[999].key == 2997);
+
+  bool all_found = true;
+  for (unsigned i = 0; i < 1000; ++i) {
+    const std::size_t j = map.find(i * 3);
+    if (j == map.NPOS || map[j].value != i)
+      all_found = false;
+  }
+  ok1(all_found);
+  ok1(map.find(1) == map.NPOS);
+  ok1(map.find(3000) == map.NPOS);
+
+  map.clear();
+  ok1(map.empty());
+  ok1(map.find(30) == map.NPOS);
+  ok1(map.try_emplace(30, 1U).second);
+  ok1(map.find(30) == 0);
+}
+
+static void
+TestSet()
+{
+  FlatHashSet<unsigned> set;
+  ok1(!set.contains(1));
+  ok1(set.insert(1));
+  ok1(!set.insert(1));
+  ok1(set.contains(1));
+  ok1(set.size() == 1);
+
+  set.clear();
+  ok1(!set.contains(1));
+  ok1(set.insert(1));
+}
+
+int main()
+{
+  plan_tests(24);
+
+  TestMap();
+  TestSet();
+
+  return exit_status();
+}
@@ -6,6 +6,7 @@
 #include "IGC/IGCFix.hpp"
 #include "IGC/IGCHeader.hpp"
 #include "IGC/IGCDeclaration.hpp"
+#include "IGC/IGCEvent.hpp"
 #include "time/BrokenDate.hpp"
 #include "time/BrokenTime.hpp"
 #include "TestUtil.hpp"
@@ -249,9 +250,30 @@ TestDeclarationTurnpoint()
   ok1(tp.name.empty());
 }
 
+static void
+TestEvent()
+{
+  IGCEvent event;
+  ok1(!IGCParseEvent("", event));
+  ok1(!IGCParseEvent("E1234", event));
+  ok1(!IGCParseEvent("B1122385103117N00742367EA004900048700000", event));
+  ok1(!IGCParseEvent("E256012PEV", event));
+  ok1(!IGCParseEvent("E123456pev", event));
+
+  ok1(IGCParseEvent("E123456PEV", event));
+  ok1(event.time == BrokenTime(12, 34, 56));
+  ok1(strcmp(event.code, "PEV") == 0);
+  ok1(event.IsPilotEvent());
+
+  ok1(IGCParseEvent("E081500STA", event));
+  ok1(event.time == BrokenTime(8, 15, 0));
+  ok1(strcmp(event.code, "STA") == 0);
+  ok1(!event.IsPilotEvent());
+}
+
 int main()
 {
-  plan_tests(148);
+  plan_tests(161);
 
   TestHeader();
   TestDate();
@@ -261,6 +283,7 @@ int main()
   TestFixTime();
   TestDeclarationHeader();
   TestDeclarationTurnpoint();
+  TestEvent();
 
   return exit_status();
 }
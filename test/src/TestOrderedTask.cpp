@@ -387,6 +387,54 @@ TestLowTPFinal()
   CheckTotal(aircraft, stats, tp1, tp2, tp3);
 }
 
+static void
+TestEquals()
+{
+  OrderedTask task(task_behaviour);
+  const StartPoint tp1(std::make_unique<LineSectorZone>(wp1->location),
+                       WaypointPtr(wp1), task_behaviour,
+                       ordered_task_settings.start_constraints);
+  task.Append(tp1);
+  const FinishPoint tp2(std::make_unique<LineSectorZone>(wp3->location),
+                        WaypointPtr(wp3), task_behaviour,
+                        ordered_task_settings.finish_constraints, false);
+  task.Append(tp2);
+  task.UpdateGeometry();
+
+  const auto copy = task.Clone(task_behaviour);
+  ok1(copy->Equals(task));
+  ok1(task.Equals(*copy));
+
+  /* flying the task does not change its definition */
+  const auto aircraft = MakeAircraft(0, 44.5, 1700);
+  task.Update(aircraft, aircraft, glide_polar);
+  ok1(copy->Equals(task));
+
+  task.SetName("foo");
+  ok1(!copy->Equals(task));
+  task.SetName(copy->GetName());
+  ok1(copy->Equals(task));
+
+  OrderedTaskSettings settings = task.GetOrderedTaskSettings();
+  settings.start_constraints.max_height += 100;
+  task.SetOrderedTaskSettings(settings);
+  ok1(!copy->Equals(task));
+  task.SetOrderedTaskSettings(copy->GetOrderedTaskSettings());
+  ok1(copy->Equals(task));
+
+  const FinishPoint tp3(std::make_unique<LineSectorZone>(wp4->location),
+                        WaypointPtr(wp4), task_behaviour,
+                        ordered_task_settings.finish_constraints, false);
+  task.Replace(tp3, 1);
+  ok1(!copy->Equals(task));
+  task.Replace(tp2, 1);
+  ok1(copy->Equals(task));
+
+  task.Remove(1);
+  ok1(!copy->Equals(task));
+  ok1(!task.Equals(*copy));
+}
+
 static void
 TestAll()
 {
@@ -399,12 +447,92 @@ TestAll()
   TestLowTPFinal();
 }
 
+static AircraftState
+MakeFlyingAircraft(double longitude, double latitude,
+                   std::chrono::seconds time) noexcept
+{
+  AircraftState aircraft = MakeAircraft(longitude, latitude, 5000);
+  aircraft.time = TimeStamp{std::chrono::hours{12} + time};
+  aircraft.flying = true;
+  return aircraft;
+}
+
+static void
+TestBestStart()
+{
+  using namespace std::chrono;
+
+  OrderedTaskSettings settings = ordered_task_settings;
+  settings.SetDefaults();
+  settings.start_constraints.pev_start_window = minutes{10};
+
+  OrderedTask task(task_behaviour);
+  task.SetOrderedTaskSettings(settings);
+
+  /* a 40 km start line; its western end is considerably further from
+     the turn point than its middle */
+  const StartPoint tp1(std::make_unique<LineSectorZone>(wp1->location, 40000),
+                       WaypointPtr(wp1), task_behaviour,
+                       settings.start_constraints);
+  task.Append(tp1);
+  const ASTPoint tp2(std::make_unique<LineSectorZone>(wp2->location),
+                     WaypointPtr(wp2), task_behaviour);
+  task.Append(tp2);
+  const FinishPoint tp3(std::make_unique<LineSectorZone>(wp3->location),
+                        WaypointPtr(wp3), task_behaviour,
+                        settings.finish_constraints, false);
+  task.Append(tp3);
+  task.UpdateGeometry();
+  ok1(!IsError(task.CheckTask()));
+
+  const AircraftState states[] = {
+    MakeFlyingAircraft(-0.2, 44.998, seconds{0}),
+    MakeFlyingAircraft(-0.2, 44.998, seconds{1}),
+
+    /* leave the start line at its western end */
+    MakeFlyingAircraft(-0.2, 45.002, minutes{2}),
+
+    /* return, and leave again in the middle a little later */
+    MakeFlyingAircraft(0, 44.998, minutes{2} + seconds{10}),
+    MakeFlyingAircraft(0, 45.002, minutes{2} + seconds{20}),
+
+    /* fly on until the window has closed */
+    MakeFlyingAircraft(0, 45.1, minutes{5}),
+    MakeFlyingAircraft(0, 45.2, minutes{11}),
+  };
+
+  const AircraftState *last = &states[0];
+  for (const auto &state : states) {
+    task.Update(state, *last, glide_polar);
+    last = &state;
+
+    if (&state == &states[0])
+      /* pilot event: observe the start window from now on */
+      ok1(task.SetPEV(BrokenTime(12, 0)));
+
+    if (&state == &states[4])
+      /* before the window closes, the last crossing counts; the
+         start is recorded at the last fix inside the sector */
+      ok1(task.GetStats().start.time == states[3].time);
+  }
+
+  /* the earlier crossing at the end of the line gives a longer task
+     in almost the same time, and replaces the last one */
+  const TaskStats &stats = task.GetStats();
+  ok1(stats.start.HasStarted());
+  ok1(stats.start.time == states[1].time);
+  ok1(task.GetPoint(0).GetExitedState().location == states[1].location);
+}
+
 int main()
 {
-  plan_tests(728);
+  plan_tests(745);
 
   task_behaviour.SetDefaults();
 
+  TestEquals();
+  TestBestStart();
+
   TestAll();
 
   glide_polar.SetMC(1);
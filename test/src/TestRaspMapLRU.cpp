@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Weather/Rasp/RaspMapLRU.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "TestUtil.hpp"
+
+static constexpr std::size_t MAP_SIZE = 1000;
+
+static std::shared_ptr<const RasterMap>
+Insert(RaspMapLRU &lru, unsigned parameter, unsigned time,
+       bool &evicted_parameter, std::size_t size=MAP_SIZE)
+{
+  return lru.Insert(parameter, time, std::make_shared<RasterMap>(), size,
+                    evicted_parameter);
+}
+
+static void
+TestEviction()
+{
+  /* room for three maps */
+  RaspMapLRU lru(3 * MAP_SIZE);
+  bool evicted;
+
+  ok1(lru.Get(0, 0) == nullptr);
+
+  const auto a = Insert(lru, 0, 0, evicted);
+  Insert(lru, 0, 1, evicted);
+  Insert(lru, 1, 0, evicted);
+  ok1(lru.GetCount() == 3);
+  ok1(lru.GetSize() == 3 * MAP_SIZE);
+  ok1(!evicted);
+
+  /* inserting a map twice keeps the cached one */
+  ok1(Insert(lru, 0, 0, evicted) == a);
+  ok1(lru.GetCount() == 3);
+
+  /* (0,0) is now the most recently used one; (0,1) is evicted */
+  ok1(lru.Get(0, 0) == a);
+  Insert(lru, 2, 0, evicted);
+  ok1(lru.GetCount() == 3);
+  ok1(lru.GetSize() == 3 * MAP_SIZE);
+  ok1(!evicted);
+  ok1(lru.Contains(0, 0));
+  ok1(!lru.Contains(0, 1));
+  ok1(lru.Contains(1, 0));
+  ok1(lru.Contains(2, 0));
+
+  /* Contains() does not touch the order: (1,0) is the oldest */
+  ok1(lru.Contains(1, 0));
+  Insert(lru, 1, 1, evicted);
+  ok1(evicted);
+  ok1(!lru.Contains(1, 0));
+  ok1(lru.Contains(0, 0));
+}
+
+static void
+TestBudget()
+{
+  RaspMapLRU lru(2500);
+  bool evicted;
+
+  Insert(lru, 0, 0, evicted);
+  Insert(lru, 0, 1, evicted);
+  ok1(lru.GetSize() == 2000);
+
+  /* a large map evicts as many maps as necessary */
+  Insert(lru, 1, 0, evicted, 2000);
+  ok1(lru.GetCount() == 1);
+  ok1(lru.GetSize() == 2000);
+  ok1(lru.GetSize() <= lru.GetBudget());
+
+  /* a map exceeding the whole budget is still kept */
+  Insert(lru, 2, 0, evicted, 5000);
+  ok1(lru.GetCount() == 1);
+  ok1(lru.GetSize() == 5000);
+  ok1(lru.Get(2, 0) != nullptr);
+
+  /* but evicted by the next one */
+  Insert(lru, 3, 0, evicted, 100);
+  ok1(lru.GetCount() == 1);
+  ok1(lru.GetSize() == 100);
+}
+
+int main()
+{
+  plan_tests(27);
+
+  TestEviction();
+  TestBudget();
+
+  return exit_status();
+}
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Tracking/SkyLines/Queue.hpp"
+#include "util/ByteOrder.hxx"
+#include "TestUtil.hpp"
+
+#include <vector>
+
+using namespace SkyLinesTracking;
+
+static FixPacket
+MakeFix(uint32_t time_ms)
+{
+  FixPacket packet{};
+  packet.time = ToBE32(time_ms);
+  return packet;
+}
+
+/**
+ * Remove all fixes from the queue and return their times.
+ */
+static std::vector<uint32_t>
+Drain(Queue &queue)
+{
+  std::vector<uint32_t> result;
+  while (!queue.IsEmpty()) {
+    result.push_back(FromBE32(queue.Peek().time));
+    queue.Pop();
+  }
+
+  return result;
+}
+
+int main()
+{
+  plan_tests(6);
+
+  Queue queue;
+  ok1(queue.IsEmpty());
+
+  /* fixes closer than 25 seconds are throttled; the times are chosen
+     so comparing the raw big-endian values would give the opposite
+     result */
+  queue.Push(MakeFix(0x000100ff));
+  queue.Push(MakeFix(0x000100ff + 256));
+  queue.Push(MakeFix(0x000100ff + 24999));
+  queue.Push(MakeFix(0x000100ff + 25001));
+  ok1(Drain(queue) == (std::vector<uint32_t>{0x000100ff, 0x000100ff + 25001}));
+
+  /* a fix which goes back in time (e.g. a new day) is kept */
+  queue.Push(MakeFix(3600000));
+  queue.Push(MakeFix(1000));
+  ok1(Drain(queue) == (std::vector<uint32_t>{3600000, 1000}));
+
+  /* live fixes are never throttled */
+  queue.Push(MakeFix(1000));
+  queue.PushLive(MakeFix(2000));
+  queue.PushLive(MakeFix(3000));
+  ok1(Drain(queue) == (std::vector<uint32_t>{1000, 2000, 3000}));
+
+  /* but they are still throttling Push() */
+  queue.PushLive(MakeFix(1000));
+  queue.Push(MakeFix(2000));
+  ok1(Drain(queue) == (std::vector<uint32_t>{1000}));
+
+  ok1(queue.IsEmpty());
+
+  return exit_status();
+}
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Task/Ordered/StartCandidates.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Engine/Task/ObservationZones/Boundary.hpp"
+#include "TestUtil.hpp"
+
+using namespace std::chrono;
+
+static AircraftState
+MakeState(TimeStamp time, const GeoPoint &location, double altitude)
+{
+  AircraftState state;
+  state.Reset();
+  state.time = time;
+  state.location = location;
+  state.altitude = altitude;
+  state.ground_speed = 30;
+  return state;
+}
+
+static void
+TestWindow()
+{
+  StartCandidates c;
+  const GeoPoint location(Angle::Degrees(7), Angle::Degrees(51));
+
+  /* not armed: nothing is recorded */
+  ok1(!c.IsArmed());
+  ok1(!c.Add(MakeState(TimeStamp{hours{12}}, location, 1000)));
+  ok1(c.empty());
+
+  /* a window without end is not observed */
+  c.Arm(RoughTimeSpan(RoughTime(12, 0), RoughTime::Invalid()));
+  ok1(!c.IsArmed());
+
+  c.Arm(RoughTimeSpan(RoughTime(12, 0), RoughTime(12, 10)));
+  ok1(c.IsArmed());
+  ok1(!c.Add(MakeState(TimeStamp{hours{11} + minutes{59}}, location, 1000)));
+  ok1(c.Add(MakeState(TimeStamp{hours{12} + minutes{1}}, location, 1000)));
+  ok1(c.Add(MakeState(TimeStamp{hours{12} + minutes{5}}, location, 900)));
+  ok1(!c.Add(MakeState(TimeStamp{hours{12} + minutes{11}}, location, 1000)));
+  ok1(c.size() == 2);
+  ok1(c[1].altitude == 900);
+
+  ok1(!c.HasClosed(TimeStamp{hours{12} + minutes{9}}));
+  ok1(c.HasClosed(TimeStamp{hours{12} + minutes{10}}));
+
+  /* a new window discards the old crossings */
+  c.Arm(RoughTimeSpan(RoughTime(13, 0), RoughTime(13, 10)));
+  ok1(c.empty());
+
+  c.Clear();
+  ok1(!c.IsArmed());
+}
+
+static void
+TestOverflow()
+{
+  StartCandidates c;
+  const GeoPoint location(Angle::Degrees(7), Angle::Degrees(51));
+  c.Arm(RoughTimeSpan(RoughTime(12, 0), RoughTime(13, 0)));
+
+  for (unsigned i = 0; i < StartCandidates::MAX_CANDIDATES + 5; ++i)
+    c.Add(MakeState(TimeStamp{hours{12} + seconds{i * 10}}, location, 1000));
+
+  ok1(c.size() == StartCandidates::MAX_CANDIDATES);
+  /* the oldest ones were dropped */
+  ok1(c[0].time == TimeStamp{hours{12} + seconds{50}});
+}
+
+static void
+TestFindBest()
+{
+  StartCandidates c;
+  const OZBoundary empty_boundary;
+  ok1(c.FindBest(empty_boundary, GeoPoint(Angle::Degrees(7), Angle::Degrees(52)),
+                 0, TimeStamp{hours{15}}) == nullptr);
+
+  const GeoPoint next(Angle::Degrees(7), Angle::Degrees(52));
+
+  /* a start line: a crossing on the line is credited where it
+     crossed */
+  OZBoundary line;
+  for (int i = 0; i <= 10; ++i)
+    line.emplace_front(Angle::Degrees(6.5 + i * 0.1), Angle::Degrees(51));
+
+  const GeoPoint west(Angle::Degrees(6.5), Angle::Degrees(51));
+  const GeoPoint middle(Angle::Degrees(7), Angle::Degrees(51));
+
+  c.Arm(RoughTimeSpan(RoughTime(12, 0), RoughTime(13, 0)));
+  c.Add(MakeState(TimeStamp{hours{12} + minutes{5}}, west, 1000));
+  c.Add(MakeState(TimeStamp{hours{12} + minutes{7}}, middle, 1000));
+
+  /* the earlier crossing at the end of the line is longer, and with
+     a long remaining task it is faster */
+  const auto *best = c.FindBest(line, next, 300000, TimeStamp{hours{17}});
+  ok1(best != nullptr);
+  ok1(best == &c[0]);
+
+  /* candidates after the finish estimate are ignored */
+  best = c.FindBest(line, next, 0, TimeStamp{hours{12} + minutes{6}});
+  ok1(best == &c[0]);
+
+  /* a crossing recorded beyond the end of the line is only credited
+     the end of the line, not the location where it was recorded */
+  const GeoPoint beyond(Angle::Degrees(6), Angle::Degrees(51));
+  ok1(StartCandidates::GetScoredLocation(line, beyond, next) == west);
+
+  c.Arm(RoughTimeSpan(RoughTime(12, 0), RoughTime(13, 0)));
+  c.Add(MakeState(TimeStamp{hours{12} + minutes{5}}, beyond, 1000));
+  c.Add(MakeState(TimeStamp{hours{12} + minutes{12}}, middle, 1000));
+
+  best = c.FindBest(line, next, 300000, TimeStamp{hours{17}});
+  ok1(best != nullptr);
+  ok1(best == &c[1]);
+}
+
+int main()
+{
+  plan_tests(24);
+
+  TestWindow();
+  TestOverflow();
+  TestFindBest();
+
+  return exit_status();
+}
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Task/TaskIndex.hpp"
+#include "Task/SaveFile.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Task/Ordered/Points/StartPoint.hpp"
+#include "Engine/Task/Ordered/Points/ASTPoint.hpp"
+#include "Engine/Task/Ordered/Points/FinishPoint.hpp"
+#include "Engine/Task/ObservationZones/CylinderZone.hpp"
+#include "io/FileOutputStream.hxx"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+
+static TaskBehaviour task_behaviour;
+static OrderedTaskSettings ordered_task_settings;
+static constexpr Path task_path{_T("output/results/Test-Index.tsk")};
+static constexpr Path index_path{_T("output/results/Test-Index.idx")};
+
+static WaypointPtr
+MakeWaypoint(double longitude, double latitude, const TCHAR *name) noexcept
+{
+  auto wp = std::make_shared<Waypoint>(GeoPoint{Angle::Degrees(longitude),
+                                                Angle::Degrees(latitude)});
+  wp->name = name;
+  return wp;
+}
+
+static std::unique_ptr<OrderedTask>
+MakeTask(unsigned n_turnpoints)
+{
+  auto task = std::make_unique<OrderedTask>(task_behaviour);
+
+  auto start = MakeWaypoint(0, 45, _T("Start"));
+  task->Append(StartPoint(std::make_unique<CylinderZone>(start->location, 500),
+                          std::move(start), task_behaviour,
+                          ordered_task_settings.start_constraints));
+
+  for (unsigned i = 0; i < n_turnpoints; ++i) {
+    auto tp = MakeWaypoint(0.2 * (i + 1), 45.3, _T("Turn"));
+    task->Append(ASTPoint(std::make_unique<CylinderZone>(tp->location, 500),
+                          std::move(tp), task_behaviour));
+  }
+
+  auto finish = MakeWaypoint(0, 46, _T("Finish"));
+  task->Append(FinishPoint(std::make_unique<CylinderZone>(finish->location, 500),
+                           std::move(finish), task_behaviour,
+                           ordered_task_settings.finish_constraints));
+
+  task->UpdateGeometry();
+  return task;
+}
+
+static void
+TestRoundTrip()
+{
+  const auto task = MakeTask(1);
+  SaveTask(task_path, *task);
+
+  {
+    TaskIndex index;
+    index.Load(index_path);
+    ok1(index.empty());
+    ok1(!index.IsModified());
+
+    index.Put(task_path, 0, TaskIndex::Summary{*task});
+    ok1(index.IsModified());
+    index.Save(index_path);
+    ok1(!index.IsModified());
+  }
+
+  TaskIndex index;
+  index.Load(index_path);
+  ok1(!index.empty());
+
+  const auto *summary = index.Find(task_path, 0);
+  ok1(summary != nullptr);
+  if (summary == nullptr) {
+    skip(9, 0, "no summary");
+    return;
+  }
+
+  ok1(summary->type == task->GetFactoryType());
+  ok1(summary->has_targets == task->HasTargets());
+  ok1(equals(summary->distance_nominal, task->GetStats().distance_nominal));
+  ok1(summary->bounds.IsValid());
+  ok1(summary->turnpoints.size() == 3);
+  ok1(summary->turnpoints.size() == 3 &&
+      summary->turnpoints[0] == _T("Start") &&
+      summary->turnpoints[2] == _T("Finish"));
+  ok1(summary->locations.size() == 3);
+  ok1(summary->locations.size() == 3 &&
+      summary->locations[1] == task->GetPoint(1).GetLocation());
+
+  /* another task in the same file is not indexed */
+  ok1(index.Find(task_path, 1) == nullptr);
+}
+
+static void
+TestStamp()
+{
+  const auto stamp = TaskIndex::FileStamp::Read(task_path);
+  ok1(stamp.size > 0);
+
+  TaskIndex index;
+  index.Load(index_path);
+
+  /* many tasks in one file share the stamp */
+  const auto task = MakeTask(2);
+  for (unsigned i = 1; i < 100; ++i)
+    index.Put(task_path, i, stamp, TaskIndex::Summary{*task});
+
+  ok1(index.Find(task_path, 0, stamp) != nullptr);
+  ok1(index.Find(task_path, 99, stamp) != nullptr);
+  ok1(index.Find(task_path, 99, stamp)->turnpoints.size() == 4);
+  ok1(index.Find(task_path, 100, stamp) == nullptr);
+
+  /* a different stamp invalidates the entry */
+  TaskIndex::FileStamp other = stamp;
+  ++other.size;
+  ok1(index.Find(task_path, 0, other) == nullptr);
+
+  index.Save(index_path);
+}
+
+static void
+TestModified()
+{
+  TaskIndex index;
+  index.Load(index_path);
+  ok1(index.Find(task_path, 0) != nullptr);
+
+  /* the file changes: the entry becomes invalid */
+  SaveTask(task_path, *MakeTask(3));
+  ok1(index.Find(task_path, 0) == nullptr);
+
+  /* deleted task files are dropped */
+  File::Delete(task_path);
+  index.Save(index_path);
+  index.Load(index_path);
+  ok1(index.empty());
+}
+
+static void
+TestMalformed()
+{
+  {
+    FileOutputStream file(index_path);
+    file.Write(std::as_bytes(std::span{"garbage"}));
+    file.Commit();
+  }
+
+  TaskIndex index;
+  index.Load(index_path);
+  ok1(index.empty());
+}
+
+int main()
+{
+  Directory::Create(Path{_T("output/results")});
+  File::Delete(index_path);
+
+  plan_tests(25);
+
+  TestRoundTrip();
+  TestStamp();
+  TestModified();
+  TestMalformed();
+
+  return exit_status();
+}
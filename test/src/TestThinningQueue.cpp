@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "util/ThinningQueue.hpp"
+#include "TestUtil.hpp"
+
+int main()
+{
+  plan_tests(17);
+
+  ThinningQueue<unsigned, 8> queue;
+  ok1(queue.empty());
+
+  queue.push_back(1);
+  ok1(!queue.empty());
+  ok1(queue.front() == 1);
+  ok1(queue.back() == 1);
+  queue.pop_front();
+  ok1(queue.empty());
+
+  /* wrap around the end of the array */
+  for (unsigned i = 2; i <= 9; ++i)
+    queue.push_back(i);
+  ok1(queue.full());
+  ok1(queue.front() == 2);
+  ok1(queue.back() == 9);
+
+  /* overflow: every second one between the first and the last one
+     is dropped */
+  queue.push_back(10);
+  ok1(queue.size() == 6);
+  ok1(queue[0] == 2);
+  ok1(queue[1] == 4);
+  ok1(queue[2] == 6);
+  ok1(queue[3] == 8);
+  ok1(queue[4] == 9);
+  ok1(queue[5] == 10);
+
+  queue.pop_front();
+  ok1(queue.front() == 4);
+
+  queue.clear();
+  ok1(queue.empty());
+
+  return exit_status();
+}
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Math/TimeSeries.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <array>
+
+static std::array<DoublePoint2D, TimeSeries::MAX_POINTS> points;
+
+static void
+TestLinear()
+{
+  TimeSeries series;
+  ok1(series.IsEmpty());
+  ok1(series.Export(points, TimeSeries::Reduction::MEAN) == 0);
+
+  for (unsigned i = 0; i < 100; ++i)
+    series.Add(i, 2 * i + 1);
+
+  ok1(series.GetCount() == 100);
+  ok1(series.GetMinX() == 0);
+  ok1(series.GetMaxX() == 99);
+  ok1(series.GetMinY() == 1);
+  ok1(series.GetMaxY() == 199);
+  ok1(equals(series.GetAverageY(), 100));
+  ok1(equals(series.GetGradient(), 2));
+  ok1(series.GetLast().x == 99 && series.GetLast().y == 199);
+
+  /* the raw samples fit */
+  ok1(series.Export(points, TimeSeries::Reduction::MEAN) == 100);
+  ok1(points[0].x == 0 && points[0].y == 1);
+  ok1(points[99].x == 99 && points[99].y == 199);
+
+  /* a smaller buffer gets the next tier: 12 full buckets plus the
+     open one with the newest 4 samples */
+  const std::span<DoublePoint2D> small{points.data(), 50};
+  ok1(series.Export(small, TimeSeries::Reduction::MAX) == 13);
+  ok1(points[0].y == 15);
+  ok1(points[12].y == 199);
+
+  series.Reset();
+  ok1(series.IsEmpty());
+}
+
+static void
+TestLong()
+{
+  /* more samples than tier 0 and tier 1 can hold, with a single
+     spike */
+  constexpr unsigned n = 10000;
+
+  TimeSeries series;
+  for (unsigned i = 0; i < n; ++i)
+    series.Add(i, i == 100 ? 1000 : 0);
+
+  ok1(series.GetMaxY() == 1000);
+
+  const std::size_t n_points =
+    series.Export(points, TimeSeries::Reduction::ENVELOPE);
+  ok1(n_points > 0 && n_points <= points.size());
+
+  const std::span<const DoublePoint2D> result{points.data(), n_points};
+
+  /* still covers the whole series */
+  ok1(result.front().x == 0);
+  ok1(result.back().x == n - 1);
+
+  /* the spike survives downsampling */
+  ok1(std::any_of(result.begin(), result.end(),
+                  [](const auto &p){ return p.y == 1000; }));
+
+  ok1(std::is_sorted(result.begin(), result.end(),
+                     [](const auto &a, const auto &b){ return a.x < b.x; }));
+}
+
+static void
+TestTwelveHours()
+{
+  /* a 12 hour barograph with one sample every 10 seconds (see
+     StatsComputer::BAROGRAPH_PERIOD) */
+  constexpr unsigned period = 10;
+  constexpr unsigned n = 12 * 3600 / period;
+
+  TimeSeries series;
+  for (unsigned i = 0; i < n; ++i)
+    series.Add(i * period, 1000 + (i % 360));
+
+  const std::size_t n_points =
+    series.Export(points, TimeSeries::Reduction::ENVELOPE);
+  const std::span<const DoublePoint2D> result{points.data(), n_points};
+
+  ok1(result.front().x == 0);
+  ok1(result.back().x == (n - 1) * period);
+  ok1(std::is_sorted(result.begin(), result.end(),
+                     [](const auto &a, const auto &b){ return a.x < b.x; }));
+
+  /* only the first hour may be coarse; after that, each bucket
+     spans two minutes or less */
+  double max_gap = 0;
+  for (std::size_t i = 1; i < result.size(); ++i)
+    if (result[i - 1].x >= 3600)
+      max_gap = std::max(max_gap, result[i].x - result[i - 1].x);
+
+  ok1(max_gap > 0);
+  ok1(max_gap <= 120);
+}
+
+int main()
+{
+  plan_tests(28);
+
+  TestLinear();
+  TestLong();
+  TestTwelveHours();
+
+  return exit_status();
+}
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Profiler/TimingHistogram.hpp"
+#include "Profiler/Profiler.hpp"
+#include "TestUtil.hpp"
+
+#include <thread>
+
+using Duration = TimingHistogram::Duration;
+
+static void
+TestBuckets()
+{
+  /* small values are exact */
+  ok1(TimingHistogram::ToBucket(0) == 0);
+  ok1(TimingHistogram::ToBucket(15) == 15);
+  ok1(TimingHistogram::GetBucketMax(15) == 15);
+
+  /* four buckets per power of two above that */
+  ok1(TimingHistogram::ToBucket(16) == 16);
+  ok1(TimingHistogram::ToBucket(19) == 16);
+  ok1(TimingHistogram::ToBucket(20) == 17);
+  ok1(TimingHistogram::ToBucket(31) == 19);
+  ok1(TimingHistogram::ToBucket(32) == 20);
+  ok1(TimingHistogram::GetBucketMax(16) == 19);
+  ok1(TimingHistogram::GetBucketMax(19) == 31);
+
+  ok1(TimingHistogram::ToBucket(UINT32_MAX) == TimingHistogram::N_BUCKETS - 1);
+  ok1(TimingHistogram::GetBucketMax(TimingHistogram::N_BUCKETS - 1) == UINT32_MAX);
+
+  /* every value is inside the range of its bucket */
+  bool consistent = true;
+  for (uint32_t i = 1; i < 1000000; i = i * 3 / 2 + 1) {
+    const unsigned b = TimingHistogram::ToBucket(i);
+    if (i > TimingHistogram::GetBucketMax(b) ||
+        (b > 0 && i <= TimingHistogram::GetBucketMax(b - 1)))
+      consistent = false;
+  }
+  ok1(consistent);
+}
+
+static void
+TestSummary()
+{
+  TimingHistogram h;
+
+  auto s = h.GetSummary();
+  ok1(s.count == 0);
+  ok1(s.max == Duration{});
+
+  /* 90 fast samples, 10 slow ones */
+  for (unsigned i = 0; i < 90; ++i)
+    h.Add(Duration{10});
+  for (unsigned i = 0; i < 10; ++i)
+    h.Add(Duration{1000 + i});
+
+  s = h.GetSummary();
+  ok1(h.GetCount() == 100);
+  ok1(s.count == 100);
+  ok1(s.p50 == Duration{10});
+  ok1(s.p95 >= Duration{1000});
+  ok1(s.p95 <= Duration{1009});
+  ok1(s.max == Duration{1009});
+
+  /* negative durations count as zero */
+  h.Add(Duration{-5});
+  ok1(h.GetSummary().count == 101);
+
+  h.Reset();
+  s = h.GetSummary();
+  ok1(s.count == 0);
+  ok1(s.max == Duration{});
+}
+
+static void
+TestProfiler()
+{
+  using Profiler::Section;
+
+  ok1(!Profiler::IsEnabled());
+
+  ok1(Profiler::FindSection(Profiler::GetName(Section::TASK)) == Section::TASK);
+  ok1(Profiler::FindSection("no_such_section") == Section::COUNT);
+
+  /* each thread has its own histograms; those of exited threads are
+     kept */
+  std::thread thread([]{
+    for (unsigned i = 0; i < 10; ++i)
+      Profiler::GetThreadHistogram(Section::TASK).Add(Duration{100});
+  });
+  thread.join();
+
+  for (unsigned i = 0; i < 5; ++i)
+    Profiler::GetThreadHistogram(Section::TASK).Add(Duration{2000});
+
+  ok1(Profiler::GetThreadHistogram(Section::TASK).GetCount() == 5);
+
+  const auto s = Profiler::GetSummary(Section::TASK);
+  ok1(s.count == 15);
+  ok1(s.max == Duration{2000});
+  ok1(Profiler::GetSummary(Section::CONTEST).count == 0);
+
+  Profiler::Reset();
+  ok1(Profiler::GetSummary(Section::TASK).count == 0);
+}
+
+int main()
+{
+  plan_tests(32);
+
+  TestBuckets();
+  TestSummary();
+  TestProfiler();
+
+  return exit_status();
+}
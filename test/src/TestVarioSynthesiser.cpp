@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Audio/VarioSynthesiser.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <array>
+
+static constexpr unsigned sample_rate = 44100;
+
+/**
+ * One second of samples.
+ */
+static std::array<int16_t, sample_rate> buffer;
+
+/**
+ * Estimate the tone frequency from the number of sign changes in
+ * #buffer.
+ */
+static unsigned
+CountFrequency() noexcept
+{
+  unsigned n = 0;
+  for (std::size_t i = 1; i < buffer.size(); ++i)
+    if ((buffer[i - 1] < 0) != (buffer[i] < 0))
+      ++n;
+  return n / 2;
+}
+
+/**
+ * Is the tone frequency within 2% of the expected one?  The ramp at
+ * the beginning of the buffer costs a few cycles.
+ */
+static bool
+HasFrequency(unsigned expected) noexcept
+{
+  const unsigned f = CountFrequency();
+  return f + expected / 50 >= expected && f <= expected + expected / 50;
+}
+
+static bool
+IsSilent() noexcept
+{
+  /* the current sine wave may be finished at the beginning */
+  return std::all_of(buffer.begin() + sample_rate / 10, buffer.end(),
+                     [](int16_t sample){ return sample == 0; });
+}
+
+int main()
+{
+  plan_tests(9);
+
+  VarioSynthesiser synthesiser(sample_rate);
+
+  /* silent until the first value arrives */
+  synthesiser.Synthesise(buffer.data(), buffer.size());
+  ok1(IsSilent());
+
+  /* sinking produces a continuous tone at the zero frequency */
+  synthesiser.SetVario(0);
+  synthesiser.Synthesise(buffer.data(), buffer.size());
+  ok1(!IsSilent());
+  ok1(HasFrequency(500));
+
+  /* new settings are applied to the current value at the next
+     Synthesise() call */
+  synthesiser.SetFrequencies(200, 800, 1500);
+  synthesiser.Synthesise(buffer.data(), buffer.size());
+  ok1(HasFrequency(800));
+
+  synthesiser.SetVario(-5);
+  synthesiser.Synthesise(buffer.data(), buffer.size());
+  ok1(HasFrequency(200));
+
+  /* the dead band silences the tone */
+  synthesiser.SetVario(0);
+  synthesiser.SetDeadBandRange(-0.5, 0.5);
+  synthesiser.SetDeadBand(true);
+  synthesiser.Synthesise(buffer.data(), buffer.size());
+  ok1(IsSilent());
+
+  synthesiser.SetDeadBand(false);
+  synthesiser.Synthesise(buffer.data(), buffer.size());
+  ok1(!IsSilent());
+
+  /* while climbing, the tone is interrupted by silence periodically */
+  synthesiser.SetPeriods(100, 200);
+  synthesiser.SetVario(5);
+  synthesiser.Synthesise(buffer.data(), buffer.size());
+  ok1(std::count(buffer.begin(), buffer.end(), 0) > (long)sample_rate / 4);
+
+  synthesiser.SetSilence();
+  synthesiser.Synthesise(buffer.data(), buffer.size());
+  ok1(IsSilent());
+
+  return exit_status();
+}
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "thread/WorkerPool.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+
+/**
+ * Run a loop and check that each iteration runs exactly once.
+ */
+static bool
+RunLoop(ParallelExecutor &executor, unsigned n) noexcept
+{
+  std::array<std::atomic_uint, 1000> counters{};
+  assert(n <= counters.size());
+
+  executor.ForEach(n, [&counters](unsigned i){
+    counters[i].fetch_add(1, std::memory_order_relaxed);
+  });
+
+  return std::all_of(counters.begin(), counters.begin() + n,
+                     [](const auto &c){ return c.load() == 1; }) &&
+    std::all_of(counters.begin() + n, counters.end(),
+                [](const auto &c){ return c.load() == 0; });
+}
+
+int main()
+{
+  plan_tests(9);
+
+  /* more threads than this machine may have CPUs */
+  WorkerPool pool{"Test", 4};
+  ok1(pool.GetConcurrency() == 4);
+
+  ok1(RunLoop(pool, 0));
+  ok1(RunLoop(pool, 1));
+  ok1(RunLoop(pool, 3));
+  ok1(RunLoop(pool, 1000));
+
+  /* the pool can be reused many times */
+  bool reused = true;
+  for (unsigned i = 0; i < 200; ++i)
+    reused = reused && RunLoop(pool, i % 17);
+  ok1(reused);
+
+  /* a const callable */
+  std::atomic_uint sum = 0;
+  const auto add = [&sum](unsigned i){
+    sum.fetch_add(i, std::memory_order_relaxed);
+  };
+  pool.ForEach(10, add);
+  ok1(sum.load() == 45);
+
+  /* a single thread runs everything in the calling thread */
+  WorkerPool single{"Single", 1};
+  ok1(single.GetConcurrency() == 1);
+  ok1(RunLoop(single, 100));
+
+  return exit_status();
+}
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "XML/PullParser.hpp"
+#include "XML/Document.hpp"
+#include "util/StringAPI.hxx"
+#include "TestUtil.hpp"
+
+#include <string>
+
+using std::string_view_literals::operator""sv;
+
+static constexpr std::string_view sample =
+  "\xef\xbb\xbf<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+  "<!-- a comment -->\n"
+  "<Task type=\"AAT\" name='a &amp; b'>\n"
+  "  <Point type=\"Start\"><Waypoint name=\"&lt;&#65;&#x42;&gt;\"/></Point>\n"
+  "  <Point type=\"Finish\"/>\n"
+  "  <Comment> some &quot;text&quot; </Comment>\n"
+  "  <Raw><![CDATA[a &amp; <b>]]></Raw>\n"
+  "</Task>\n";
+
+static void
+TestPullParser()
+{
+  using Event = XML::PullParser::Event;
+
+  XML::PullParser parser{sample};
+
+  ok1(parser.Next() == Event::START_ELEMENT);
+  ok1(parser.GetName() == "Task"sv);
+  ok1(parser.GetAttributes().size() == 2);
+  ok1(parser.GetAttributes()[1].value == "a &amp; b"sv);
+
+  ok1(parser.Next() == Event::START_ELEMENT);
+  ok1(parser.GetName() == "Point"sv);
+  ok1(parser.Next() == Event::START_ELEMENT);
+  ok1(parser.GetName() == "Waypoint"sv);
+  ok1(parser.GetDepth() == 3);
+  ok1(parser.Next() == Event::END_ELEMENT);
+  ok1(parser.Next() == Event::END_ELEMENT);
+  ok1(parser.GetName() == "Point"sv);
+
+  ok1(parser.Next() == Event::START_ELEMENT);
+  ok1(parser.Next() == Event::END_ELEMENT);
+
+  ok1(parser.Next() == Event::START_ELEMENT);
+  ok1(parser.Next() == Event::TEXT);
+  ok1(parser.GetText() == "some &quot;text&quot;"sv);
+  ok1(!parser.IsCData());
+  ok1(parser.Next() == Event::END_ELEMENT);
+
+  ok1(parser.Next() == Event::START_ELEMENT);
+  ok1(parser.Next() == Event::TEXT);
+  ok1(parser.GetText() == "a &amp; <b>"sv);
+  ok1(parser.IsCData());
+  ok1(parser.Next() == Event::END_ELEMENT);
+
+  ok1(parser.Next() == Event::END_ELEMENT);
+  ok1(parser.Next() == Event::END);
+}
+
+static bool
+Unescape(std::string s, std::string_view expected)
+{
+  s.resize(XML::UnescapeInPlace(s));
+  return s == expected;
+}
+
+static void
+TestUnescape()
+{
+  ok1(Unescape("", ""));
+  ok1(Unescape("no entities", "no entities"));
+  ok1(Unescape("&lt;&gt;&amp;&apos;&quot;", "<>&'\""));
+  ok1(Unescape("x&#65;&#x42;y", "xABy"));
+  ok1(Unescape("&#228;", "\xc3\xa4"));
+}
+
+static void
+TestDocument()
+{
+  const auto document = XML::Document::Parse(sample);
+  const auto &root = document.GetRoot();
+
+  ok1(StringIsEqual(root.GetName(), "Task"));
+  ok1(StringIsEqual(root.GetAttribute("TYPE"), "AAT"));
+  ok1(StringIsEqual(root.GetAttribute("name"), "a & b"));
+  ok1(root.GetAttribute("foo") == nullptr);
+
+  const auto *point = root.GetChild("Point");
+  ok1(point != nullptr);
+  ok1(StringIsEqual(point->GetAttribute("type"), "Start"));
+
+  const auto *waypoint = point->GetChild("Waypoint");
+  ok1(waypoint != nullptr);
+  ok1(StringIsEqual(waypoint->GetAttribute("name"), "<AB>"));
+  ok1(waypoint->GetFirstChild() == nullptr);
+  ok1(StringIsEqual(waypoint->GetText(), ""));
+
+  point = point->GetNextSibling();
+  ok1(StringIsEqual(point->GetAttribute("type"), "Finish"));
+
+  ok1(StringIsEqual(root.GetChild("comment")->GetText(), "some \"text\""));
+  ok1(StringIsEqual(root.GetChild("Raw")->GetText(), "a &amp; <b>"));
+  ok1(root.GetChild("Raw")->GetNextSibling() == nullptr);
+}
+
+static bool
+IsMalformed(std::string_view src)
+{
+  try {
+    XML::Document::Parse(src);
+    return false;
+  } catch (...) {
+    return true;
+  }
+}
+
+static void
+TestMalformed()
+{
+  ok1(IsMalformed(""));
+  ok1(IsMalformed("<a>"));
+  ok1(IsMalformed("<a></b>"));
+  ok1(IsMalformed("<a></a><b/>"));
+  ok1(IsMalformed("<a x=1/>"));
+  ok1(IsMalformed("<a x=\"&foo;\"/>"));
+  ok1(IsMalformed("text<a/>"));
+  ok1(!IsMalformed("<a></A>"));
+}
+
+int main()
+{
+  plan_tests(53);
+
+  TestPullParser();
+  TestUnescape();
+  TestDocument();
+  TestMalformed();
+
+  return exit_status();
+}
@@ -218,8 +218,10 @@ public:
     }
     GeoVector vec(state.location, c);
     vec.distance = 20000; // set big distance (for testing)
+    AirspaceIntersectionVector intersections;
     const AirspaceInterceptSolution solution =
-      as.Intercept(state, vec.EndPoint(state.location), projection, m_perf);
+      as.Intercept(state, vec.EndPoint(state.location), projection, m_perf,
+                   intersections);
     if (solution.IsValid()) {
       if (fout) {
         *fout << "# intercept in " << solution.elapsed_time.count() << " h " << solution.altitude << "\n";
@@ -15,6 +15,8 @@
 #include "GlideSolvers/GlideSettings.hpp"
 #include "GlideSolvers/GlidePolar.hpp"
 #include "Geo/SpeedVector.hpp"
+#include "Geo/GeoVector.hpp"
+#include "thread/WorkerPool.hpp"
 #include "Operation/Operation.hpp"
 #include "system/FileUtil.hpp"
 #include "util/PrintException.hxx"
@@ -42,12 +44,12 @@ test_reach(const RasterMap &map, double mwind, double mc, double height_min_work
   int horigin = map.GetHeight(origin).GetValueOr0() + 1000;
   AGeoPoint aorigin(origin, horigin);
 
-  const auto reach_terrain = route.SolveReach(aorigin, config, INT_MAX,
-                                              true, false);
+  ReachFan reach_terrain;
+  route.SolveReach(aorigin, config, INT_MAX, true, false, reach_terrain);
   PrintHelper::print(reach_terrain);
 
-  const auto reach_working = route.SolveReach(aorigin, config, INT_MAX,
-                                              true, true);
+  ReachFan reach_working;
+  route.SolveReach(aorigin, config, INT_MAX, true, true, reach_working);
   PrintHelper::print(reach_working);
 
   {
@@ -67,9 +69,8 @@ test_reach(const RasterMap &map, double mwind, double mc, double height_min_work
                                                              route.GetReachPolar());
         if ((i % 5 == 0) && (j % 5 == 0)) {
           AGeoPoint ao2(x, h + 1000);
-          [[maybe_unused]] auto reach2 =
-                             route.SolveReach(ao2, config, INT_MAX,
-                                              true, false);
+          ReachFan reach2;
+          route.SolveReach(ao2, config, INT_MAX, true, false, reach2);
         }
         fout << x.longitude.Degrees() << " "
              << x.latitude.Degrees() << " "
@@ -84,6 +85,151 @@ test_reach(const RasterMap &map, double mwind, double mc, double height_min_work
   //  printf("# pixel size %g\n", (double)pd);
 }
 
+/**
+ * Compare incremental reach solutions (see
+ * ReachFan::SolveIncremental()) with full ones over a grid of
+ * destinations along a glide: the incremental ones must never reach
+ * farther.
+ */
+static void
+test_incremental(const RasterMap &map)
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+  RoutePlannerConfig config;
+  config.SetDefaults();
+  config.reach_calc_mode = RoutePlannerConfig::ReachMode::TURNING;
+
+  GlidePolar polar(0.1);
+
+  /* this one keeps its reference solution along the glide */
+  TerrainRoute route;
+  route.UpdatePolar(settings, config, polar, polar, SpeedVector::Zero(), 0);
+  route.SetTerrain(&map);
+
+  TerrainRoute full_route;
+  full_route.UpdatePolar(settings, config, polar, polar,
+                         SpeedVector::Zero(), 0);
+  full_route.SetTerrain(&map);
+
+  const GeoPoint center = map.GetMapCenter();
+  AGeoPoint origin(center, map.GetHeight(center).GetValueOr0() + 1000);
+
+  ReachFan incremental, full;
+  route.SolveReach(origin, config, INT_MAX, true, false, incremental);
+
+  unsigned n_reachable = 0, n_mismatch = 0, n_optimistic = 0;
+  int max_delta = 0;
+
+  for (unsigned step = 1; step <= 4; ++step) {
+    /* 70 m east and 2 m down per step: all of these solutions are
+       incremental */
+    origin = AGeoPoint(GeoVector(70, Angle::Degrees(90)).EndPoint(origin),
+                       origin.altitude - 2);
+    route.SolveReach(origin, config, INT_MAX, true, false, incremental);
+
+    full_route.ClearReachReference();
+    full_route.SolveReach(origin, config, INT_MAX, true, false, full);
+
+    constexpr unsigned n = 40;
+    for (unsigned i = 0; i < n; ++i) {
+      for (unsigned j = 0; j < n; ++j) {
+        const GeoPoint x(center.longitude + Angle::Degrees(1.0 * i / n - 0.5),
+                         center.latitude + Angle::Degrees(1.0 * j / n - 0.5));
+        const AGeoPoint dest(x, map.GetInterpolatedHeight(x).GetValueOr0());
+
+        const auto a = incremental.FindPositiveArrival(dest, route.GetReachPolar());
+        const auto b = full.FindPositiveArrival(dest, route.GetReachPolar());
+        if (!a || !b)
+          continue;
+
+        if (b->IsReachableTerrain())
+          ++n_reachable;
+
+        if (a->IsReachableTerrain() != b->IsReachableTerrain())
+          ++n_mismatch;
+
+        if (a->IsReachableTerrain() &&
+            (!b->IsReachableTerrain() || a->terrain > b->terrain + 1))
+          ++n_optimistic;
+
+        if (a->IsReachableTerrain() && b->IsReachableTerrain())
+          max_delta = std::max(max_delta, std::abs(a->terrain - b->terrain));
+      }
+    }
+  }
+
+  printf("# reachable=%u mismatch=%u max_delta=%d\n",
+         n_reachable, n_mismatch, max_delta);
+  ok1(n_reachable > 0);
+  ok1(n_optimistic == 0);
+
+  /* gaps are not searched again, which may miss a few */
+  ok1(n_mismatch * 100 <= n_reachable);
+}
+
+/**
+ * Check that a reach solution calculated on a #WorkerPool is the same
+ * as a sequential one, over a grid of destinations.
+ */
+static void
+test_parallel(const RasterMap &map, int height)
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+  RoutePlannerConfig config;
+  config.SetDefaults();
+  config.reach_calc_mode = RoutePlannerConfig::ReachMode::TURNING;
+
+  GlidePolar polar(0.1);
+  TerrainRoute route;
+  route.UpdatePolar(settings, config, polar, polar, SpeedVector::Zero(), 0);
+  route.SetTerrain(&map);
+
+  const GeoPoint center = map.GetMapCenter();
+  const AGeoPoint origin(center,
+                         map.GetHeight(center).GetValueOr0() + height);
+
+  ReachFan sequential, parallel;
+  route.SolveReach(origin, config, INT_MAX, true, false, sequential);
+
+  /* at least two workers, even on a single CPU */
+  WorkerPool pool{"Reach", 4};
+  route.SetParallelExecutor(&pool);
+  route.ClearReachReference();
+  route.SolveReach(origin, config, INT_MAX, true, false, parallel);
+  route.SetParallelExecutor(nullptr);
+
+  unsigned n_reachable = 0, n_different = 0;
+
+  constexpr unsigned n = 40;
+  for (unsigned i = 0; i < n; ++i) {
+    for (unsigned j = 0; j < n; ++j) {
+      const GeoPoint x(center.longitude + Angle::Degrees(1.0 * i / n - 0.5),
+                       center.latitude + Angle::Degrees(1.0 * j / n - 0.5));
+      const AGeoPoint dest(x, map.GetInterpolatedHeight(x).GetValueOr0());
+
+      const auto a = sequential.FindPositiveArrival(dest, route.GetReachPolar());
+      const auto b = parallel.FindPositiveArrival(dest, route.GetReachPolar());
+      if (!a || !b) {
+        if (a.has_value() != b.has_value())
+          ++n_different;
+        continue;
+      }
+
+      if (a->IsReachableTerrain())
+        ++n_reachable;
+
+      if (a->terrain_valid != b->terrain_valid ||
+          a->terrain != b->terrain || a->direct != b->direct)
+        ++n_different;
+    }
+  }
+
+  ok1(n_reachable > 0);
+  ok1(n_different == 0);
+}
+
 int
 main(int argc, char **argv)
 try {
@@ -118,11 +264,14 @@ try {
   } while (map.IsDirty());
   zzip_dir_close(dir);
 
-  plan_tests(6);
+  plan_tests(7);
   test_reach(map, 0, 0.1, 0);
   test_reach(map, 0, 0.1, 750);
   test_reach(map, 0, 0.1, 500);
   test_reach(map, 0, 0.1, 250);
+  test_incremental(map);
+  test_parallel(map, 500);
+  test_parallel(map, 1500);
 
   return exit_status();
 } catch (const std::runtime_error &e) {
@@ -20,6 +20,8 @@
 
 #include <zzip/zzip.h>
 
+#include <chrono>
+
 #include <string.h>
 
 static void
@@ -68,6 +70,7 @@ test_troute(const RasterMap &map, double mwind, double mc, int ceiling)
 
     int hdest = map.GetHeight(dest).GetValueOr0() + 100;
 
+    const auto start = std::chrono::steady_clock::now();
     retval = route.Solve(AGeoPoint(origin,
                                    map.GetHeight(origin).GetValueOr0() + 100),
                          AGeoPoint(dest,
@@ -75,6 +78,12 @@ test_troute(const RasterMap &map, double mwind, double mc, int ceiling)
                                    ? hdest
                                    : std::max(hdest, 3200)),
                          config, ceiling);
+    const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+    printf("# expanded %u nodes in %.2f ms (%.0f nodes/ms)\n",
+           route.GetExpandedNodeCount(), elapsed.count(),
+           route.GetExpandedNodeCount() / elapsed.count());
+
     char buffer[128];
     sprintf(buffer,"terrain route solve, dir=%g, wind=%g, mc=%g ceiling=%d",
             (double)ang, (double)mwind, (double)mc, (int)ceiling);